@@ -1,4 +1,4 @@
-/* Copyright (c) 2020-2021, Arm Limited and Contributors
+/* Copyright (c) 2020-2023, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -17,6 +17,11 @@
 
 #include "benchmark_mode.h"
 
+#include <fstream>
+
+#include <json.hpp>
+
+#include "platform/filesystem.h"
 #include "platform/platform.h"
 
 namespace plugins
@@ -25,7 +30,7 @@ BenchmarkMode::BenchmarkMode() :
     BenchmarkModeTags("Benchmark Mode",
                       "Log frame averages after running an app.",
                       {vkb::Hook::OnUpdate, vkb::Hook::OnAppStart, vkb::Hook::OnAppClose},
-                      {&benchmark_flag})
+                      {&benchmark_flag, &output_flag})
 {
 }
 
@@ -39,23 +44,56 @@ void BenchmarkMode::init(const vkb::CommandParser &parser)
 	// Whilst in benchmark mode fix the fps so that separate runs are consistently simulated
 	// This will effect the graph outputs of framerate
 	platform->force_simulation_fps(60.0f);
+
+	if (parser.contains(&output_flag))
+	{
+		output_filename = parser.as<std::string>(&output_flag);
+	}
 }
 
 void BenchmarkMode::on_update(float delta_time)
 {
 	elapsed_time += delta_time;
 	total_frames++;
+
+	if (!output_filename.empty())
+	{
+		frame_times.push_back(delta_time * 1000.0f);
+	}
 }
 
 void BenchmarkMode::on_app_start(const std::string &app_id)
 {
 	elapsed_time = 0;
 	total_frames = 0;
+	frame_times.clear();
 	LOGI("Starting Benchmark for {}", app_id);
 }
 
 void BenchmarkMode::on_app_close(const std::string &app_id)
 {
 	LOGI("Benchmark for {} completed in {} seconds (ran {} frames, averaged {} fps)", app_id, elapsed_time, total_frames, total_frames / elapsed_time);
+
+	if (!output_filename.empty())
+	{
+		write_frame_times(app_id);
+	}
+}
+
+void BenchmarkMode::write_frame_times(const std::string &app_id)
+{
+	nlohmann::json data = {{"app", app_id},
+	                       {"frames", total_frames},
+	                       {"elapsed_time", elapsed_time},
+	                       {"frame_times_ms", frame_times}};
+
+	std::ofstream file{vkb::fs::path::get(vkb::fs::path::Type::Logs, output_filename), std::ios::out | std::ios::trunc};
+	if (!file.good())
+	{
+		LOGE("Failed to write benchmark output {}", output_filename);
+		return;
+	}
+
+	file << data.dump() << std::endl;
 }
 }        // namespace plugins
\ No newline at end of file
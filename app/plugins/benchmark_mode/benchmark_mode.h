@@ -1,4 +1,4 @@
-/* Copyright (c) 2020-2021, Arm Limited and Contributors
+/* Copyright (c) 2020-2023, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "platform/plugins/plugin_base.h"
 
 namespace plugins
@@ -30,7 +32,10 @@ using BenchmarkModeTags = vkb::PluginBase<BenchmarkMode, vkb::tags::Passive>;
  * 
  * When enabled frame time statistics of a samples run will be printed to the console when an application closes. The simulation frame time (delta time) is also locked to 60FPS so that statistics can be compared more accurately across different devices.
  * 
+ * The frame times can also be written to a JSON file in the logs folder, one entry per frame in milliseconds.
+ *
  * Usage: vulkan_samples sample afbc --benchmark
+ *        vulkan_samples sample afbc --benchmark --benchmark-output afbc.json
  * 
  */
 class BenchmarkMode : public BenchmarkModeTags
@@ -51,10 +56,18 @@ class BenchmarkMode : public BenchmarkModeTags
 	virtual void on_app_close(const std::string &app_info) override;
 
 	vkb::FlagCommand benchmark_flag = {vkb::FlagType::FlagOnly, "benchmark", "", "Enable benchmark mode"};
+	vkb::FlagCommand output_flag    = {vkb::FlagType::OneValue, "benchmark-output", "", "Write the frame times to a JSON file in the logs folder"};
 
   private:
+	void write_frame_times(const std::string &app_id);
+
 	uint32_t total_frames{0};
 
 	float elapsed_time{0.0f};
+
+	std::string output_filename;
+
+	/// Wall clock time of each frame in milliseconds, only kept when writing them out
+	std::vector<float> frame_times;
 };
 }        // namespace plugins
\ No newline at end of file
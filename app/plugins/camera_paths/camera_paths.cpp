@@ -0,0 +1,163 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "camera_paths.h"
+
+#include "platform/platform.h"
+
+namespace plugins
+{
+CameraPaths::CameraPaths() :
+    CameraPathsTags("Camera Paths",
+                    "Record or replay a keyframed camera path.",
+                    {vkb::Hook::OnUpdate, vkb::Hook::OnAppStart, vkb::Hook::OnAppClose},
+                    {&replay_flag, &record_flag, &interval_flag})
+{
+}
+
+bool CameraPaths::is_active(const vkb::CommandParser &parser)
+{
+	return parser.contains(&replay_flag) || parser.contains(&record_flag);
+}
+
+void CameraPaths::init(const vkb::CommandParser &parser)
+{
+	if (parser.contains(&replay_flag))
+	{
+		auto filename = parser.as<std::string>(&replay_flag);
+
+		try
+		{
+			path = vkb::CameraPath::load(filename);
+		}
+		catch (std::exception &e)
+		{
+			LOGE("{}", e.what());
+		}
+
+		if (path.empty())
+		{
+			LOGE("Camera path {} has no keyframes, the camera will not be moved", filename);
+			return;
+		}
+
+		replaying = true;
+
+		// Every frame of the replay is at the same point of the path, whatever the frame rate
+		platform->force_simulation_fps(REPLAY_FPS);
+	}
+	else
+	{
+		record_filename = parser.as<std::string>(&record_flag);
+
+		if (parser.contains(&interval_flag))
+		{
+			interval = parser.as<float>(&interval_flag);
+		}
+	}
+}
+
+void CameraPaths::on_app_start(const std::string &app_id)
+{
+	frame    = 0;
+	time     = 0.0f;
+	disabled = false;
+
+	if (!replaying)
+	{
+		path.clear();
+	}
+}
+
+void CameraPaths::on_update(float delta_time)
+{
+	if (disabled)
+	{
+		return;
+	}
+
+	if (replaying)
+	{
+		replay_frame();
+	}
+	else if (!record_filename.empty())
+	{
+		record_frame(delta_time);
+	}
+}
+
+void CameraPaths::replay_frame()
+{
+	float frame_time = static_cast<float>(frame) / REPLAY_FPS;
+
+	if (frame_time > path.get_duration())
+	{
+		LOGI("Camera path completed after {} frames", frame);
+		platform->close();
+		disabled = true;
+		return;
+	}
+
+	if (!platform->get_app().set_camera_pose(path.sample(frame_time)))
+	{
+		LOGW("{} has no camera that can follow a camera path", platform->get_app().get_name());
+		disabled = true;
+		return;
+	}
+
+	frame++;
+}
+
+void CameraPaths::record_frame(float delta_time)
+{
+	vkb::CameraPose pose;
+	if (!platform->get_app().get_camera_pose(pose))
+	{
+		LOGW("{} has no camera that can be recorded", platform->get_app().get_name());
+		disabled = true;
+		return;
+	}
+
+	// The pose is the one of the last rendered frame
+	if (path.empty() || (time - path.get_duration() >= interval))
+	{
+		path.add_keyframe({time, pose});
+	}
+
+	time += delta_time;
+}
+
+void CameraPaths::on_app_close(const std::string &app_id)
+{
+	if (record_filename.empty() || path.empty())
+	{
+		return;
+	}
+
+	// Keep the pose the camera ended at
+	vkb::CameraPose pose;
+	if (platform->get_app().get_camera_pose(pose) && time > path.get_duration())
+	{
+		path.add_keyframe({time, pose});
+	}
+
+	if (path.save(record_filename))
+	{
+		LOGI("Recorded {} camera path keyframes over {} seconds to {}", path.get_keyframes().size(), path.get_duration(), record_filename);
+	}
+}
+}        // namespace plugins
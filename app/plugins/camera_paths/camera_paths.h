@@ -0,0 +1,85 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "camera_path.h"
+#include "platform/plugins/plugin_base.h"
+
+namespace plugins
+{
+class CameraPaths;
+
+using CameraPathsTags = vkb::PluginBase<CameraPaths, vkb::tags::Passive>;
+
+/**
+ * @brief Camera Paths
+ *
+ * Records the camera of an interactive session to a camera path file, or moves the camera along a
+ * recorded path. A replay runs at a fixed 60 FPS timestep, so that frame N shows the same view on
+ * every build and device, and closes the app at the end of the path.
+ * Files are read from and written to output/camera_paths.
+ *
+ * Usage: vulkan_samples sample afbc --record-camera-path afbc.json
+ *        vulkan_samples sample afbc --camera-path afbc.json
+ *
+ */
+class CameraPaths : public CameraPathsTags
+{
+  public:
+	CameraPaths();
+
+	virtual ~CameraPaths() = default;
+
+	virtual bool is_active(const vkb::CommandParser &parser) override;
+
+	virtual void init(const vkb::CommandParser &parser) override;
+
+	virtual void on_update(float delta_time) override;
+
+	virtual void on_app_start(const std::string &app_id) override;
+
+	virtual void on_app_close(const std::string &app_id) override;
+
+	vkb::FlagCommand replay_flag   = {vkb::FlagType::OneValue, "camera-path", "", "Move the camera along a camera path at a fixed timestep, then close the app"};
+	vkb::FlagCommand record_flag   = {vkb::FlagType::OneValue, "record-camera-path", "", "Record the camera to a camera path file"};
+	vkb::FlagCommand interval_flag = {vkb::FlagType::OneValue, "camera-path-interval", "", "Seconds between two recorded keyframes (default 0.1)"};
+
+  private:
+	static constexpr float REPLAY_FPS = 60.0f;
+
+	void replay_frame();
+
+	void record_frame(float delta_time);
+
+	vkb::CameraPath path;
+
+	std::string record_filename;
+
+	bool replaying{false};
+
+	/// Seconds between two recorded keyframes
+	float interval{0.1f};
+
+	uint32_t frame{0};
+
+	float time{0.0f};
+
+	/// Set when the app has no camera, so that the plugin does nothing more
+	bool disabled{false};
+};
+}        // namespace plugins
@@ -0,0 +1,64 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "null_device.h"
+
+#include "core/null_device.h"
+#include "platform/platform.h"
+#include "platform/window.h"
+
+namespace plugins
+{
+NullDevice::NullDevice() :
+    NullDeviceTags("Null Device",
+                   "Run apps on a Vulkan device that doesn't execute commands, to measure the CPU cost of the framework.",
+                   {vkb::Hook::OnAppStart, vkb::Hook::OnAppClose},
+                   {&null_device_flag})
+{
+}
+
+bool NullDevice::is_active(const vkb::CommandParser &parser)
+{
+	return parser.contains(&null_device_flag);
+}
+
+void NullDevice::init(const vkb::CommandParser &parser)
+{
+	vkb::null_device::enable();
+
+	// The null device only provides headless surfaces
+	vkb::Window::OptionalProperties properties;
+	properties.mode             = vkb::Window::Mode::Headless;
+	properties.headless_surface = true;
+	platform->set_window_properties(properties);
+}
+
+void NullDevice::on_app_start(const std::string &app_id)
+{
+	vkb::null_device::reset_call_counts();
+}
+
+void NullDevice::on_app_close(const std::string &app_id)
+{
+	LOGI("Vulkan calls made by {} on the null device:", app_id);
+
+	for (auto &call_count : vkb::null_device::get_call_counts())
+	{
+		LOGI("\t{}: {}", call_count.first, call_count.second);
+	}
+}
+}        // namespace plugins
@@ -0,0 +1,55 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "platform/plugins/plugin_base.h"
+
+namespace plugins
+{
+class NullDevice;
+
+using NullDeviceTags = vkb::PluginBase<NullDevice, vkb::tags::Passive>;
+
+/**
+ * @brief Null Device
+ *
+ * Runs the app headless on a Vulkan device that records commands without executing them, so the CPU cost
+ * of the framework can be measured without a GPU. The number of calls to each Vulkan entry point is logged
+ * when the app closes. Combine with benchmark mode to log the frame times.
+ *
+ * Usage: vulkan_samples sample afbc --null-device --benchmark --stop-after-frame 1000
+ *
+ */
+class NullDevice : public NullDeviceTags
+{
+  public:
+	NullDevice();
+
+	virtual ~NullDevice() = default;
+
+	virtual bool is_active(const vkb::CommandParser &parser) override;
+
+	virtual void init(const vkb::CommandParser &parser) override;
+
+	virtual void on_app_start(const std::string &app_id) override;
+
+	virtual void on_app_close(const std::string &app_id) override;
+
+	vkb::FlagCommand null_device_flag = {vkb::FlagType::FlagOnly, "null-device", "", "Run headless on a Vulkan device that doesn't execute commands"};
+};
+}        // namespace plugins
@@ -0,0 +1,88 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sample_options.h"
+
+#include "vulkan_sample.h"
+
+namespace plugins
+{
+SampleOptions::SampleOptions() :
+    SampleOptionsTags("Sample Options",
+                      "Pass key=value options through to the running sample.",
+                      {vkb::Hook::OnAppStart},
+                      {&option_flag, &configuration_flag})
+{
+}
+
+bool SampleOptions::is_active(const vkb::CommandParser &parser)
+{
+	return parser.contains(&option_flag) || parser.contains(&configuration_flag);
+}
+
+void SampleOptions::init(const vkb::CommandParser &parser)
+{
+	if (parser.contains(&configuration_flag))
+	{
+		has_configuration = true;
+		configuration     = parser.as<uint32_t>(&configuration_flag);
+	}
+
+	if (!parser.contains(&option_flag))
+	{
+		return;
+	}
+
+	for (auto &option : parser.as<std::vector<std::string>>(&option_flag))
+	{
+		auto separator = option.find('=');
+		if (separator == std::string::npos)
+		{
+			// A bare key enables a switch
+			options[option] = "1";
+		}
+		else
+		{
+			options[option.substr(0, separator)] = option.substr(separator + 1);
+		}
+	}
+}
+
+void SampleOptions::on_app_start(const std::string &app_id)
+{
+	if (!has_configuration)
+	{
+		return;
+	}
+
+	auto *vulkan_app = dynamic_cast<vkb::VulkanSample *>(&platform->get_app());
+	if (vulkan_app && vulkan_app->get_configuration().select(configuration))
+	{
+		vulkan_app->get_configuration().set();
+		LOGI("Applied configuration {} of {}", configuration, app_id);
+	}
+	else
+	{
+		LOGW("{} has no configuration {}", app_id, configuration);
+	}
+}
+
+bool SampleOptions::contains(const std::string &key) const
+{
+	return options.find(key) != options.end();
+}
+}        // namespace plugins
@@ -0,0 +1,99 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <sstream>
+#include <unordered_map>
+
+#include "platform/plugins/plugin_base.h"
+
+namespace plugins
+{
+class SampleOptions;
+
+using SampleOptionsTags = vkb::PluginBase<SampleOptions, vkb::tags::Passive>;
+
+/**
+ * @brief Sample Options
+ *
+ * Passes key=value options through to the running sample, for sample specific modes that have no flag of their own.
+ * Samples query the plugin for the keys they understand and ignore the rest.
+ * The configuration flag applies one of the configurations batch mode cycles through, when the sample starts.
+ *
+ * Usage: vulkan_samples sample compute_nbody --option nbody_validate=10 --option nbody_tolerance=0.001
+ *        vulkan_samples sample descriptor_management --configuration 2
+ *
+ */
+class SampleOptions : public SampleOptionsTags
+{
+  public:
+	SampleOptions();
+
+	virtual ~SampleOptions() = default;
+
+	virtual bool is_active(const vkb::CommandParser &parser) override;
+
+	virtual void init(const vkb::CommandParser &parser) override;
+
+	virtual void on_app_start(const std::string &app_id) override;
+
+	bool contains(const std::string &key) const;
+
+	/**
+	 * @brief Returns the value of an option converted to T, or the fallback if the option is missing or can't be converted
+	 */
+	template <typename T>
+	T get(const std::string &key, const T &fallback) const;
+
+	vkb::FlagCommand option_flag        = {vkb::FlagType::ManyValues, "option", "", "Pass a key=value option to the sample"};
+	vkb::FlagCommand configuration_flag = {vkb::FlagType::OneValue, "configuration", "", "Apply the configuration with the given index of a sample"};
+
+  private:
+	std::unordered_map<std::string, std::string> options;
+
+	bool has_configuration{false};
+
+	uint32_t configuration{0};
+};
+
+template <typename T>
+T SampleOptions::get(const std::string &key, const T &fallback) const
+{
+	auto it = options.find(key);
+	if (it == options.end())
+	{
+		return fallback;
+	}
+
+	T                  value;
+	std::istringstream stream(it->second);
+	if (!(stream >> value))
+	{
+		return fallback;
+	}
+
+	return value;
+}
+
+template <>
+inline std::string SampleOptions::get(const std::string &key, const std::string &fallback) const
+{
+	auto it = options.find(key);
+	return it == options.end() ? fallback : it->second;
+}
+}        // namespace plugins
@@ -1,4 +1,4 @@
-/* Copyright (c) 2020-2022, Arm Limited and Contributors
+/* Copyright (c) 2020-2023, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -62,7 +62,12 @@ void WindowOptions::init(const vkb::CommandParser &parser)
 		properties.extent.height = height;
 	}
 
-	if (parser.contains(&headless_flag))
+	if (parser.contains(&headless_surface_flag))
+	{
+		properties.mode             = vkb::Window::Mode::Headless;
+		properties.headless_surface = true;
+	}
+	else if (parser.contains(&headless_flag))
 	{
 		properties.mode = vkb::Window::Mode::Headless;
 	}
@@ -17,6 +17,7 @@
 
 #include "api_vulkan_sample.h"
 
+#include "camera_path.h"
 #include "core/device.h"
 #include "core/swapchain.h"
 #include "gltf_loader.h"
@@ -99,6 +100,36 @@ void ApiVulkanSample::update(float delta_time)
 	platform->on_post_draw(get_render_context());
 }
 
+bool ApiVulkanSample::get_camera_pose(vkb::CameraPose &pose)
+{
+	// Same rotation as the view matrix of vkb::Camera: around x, then y, then z
+	glm::vec3 angles = glm::radians(camera.rotation);
+
+	pose.position = camera.position;
+	pose.rotation = glm::angleAxis(angles.x, glm::vec3(1.0f, 0.0f, 0.0f)) *
+	                glm::angleAxis(angles.y, glm::vec3(0.0f, 1.0f, 0.0f)) *
+	                glm::angleAxis(angles.z, glm::vec3(0.0f, 0.0f, 1.0f));
+
+	return true;
+}
+
+bool ApiVulkanSample::set_camera_pose(const vkb::CameraPose &pose)
+{
+	// Decompose the rotation matrix Rx * Ry * Rz back into the angles of vkb::Camera
+	glm::mat3 m = glm::mat3_cast(pose.rotation);
+
+	glm::vec3 angles;
+	angles.y = std::asin(glm::clamp(m[2][0], -1.0f, 1.0f));
+	angles.x = std::atan2(-m[2][1], m[2][2]);
+	angles.z = std::atan2(-m[1][0], m[0][0]);
+
+	camera.set_position(pose.position);
+	camera.set_rotation(glm::degrees(angles));
+	view_updated = true;
+
+	return true;
+}
+
 bool ApiVulkanSample::resize(const uint32_t _width, const uint32_t _height)
 {
 	if (!prepared)
@@ -1270,11 +1301,11 @@ Texture ApiVulkanSample::load_texture_cubemap(const std::string &file, vkb::sg::
 	return texture;
 }
 
-std::unique_ptr<vkb::sg::SubMesh> ApiVulkanSample::load_model(const std::string &file, uint32_t index)
+std::unique_ptr<vkb::sg::SubMesh> ApiVulkanSample::load_model(const std::string &file, uint32_t index, VkBufferUsageFlags buffer_usage)
 {
 	vkb::GLTFLoader loader{*device};
 
-	std::unique_ptr<vkb::sg::SubMesh> model = loader.read_model_from_file(file, index);
+	std::unique_ptr<vkb::sg::SubMesh> model = loader.read_model_from_file(file, index, buffer_usage);
 
 	if (!model)
 	{
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2022, Sascha Willems
+/* Copyright (c) 2019-2023, Sascha Willems
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -89,6 +89,17 @@ class ApiVulkanSample : public vkb::VulkanSample
 
 	virtual void input_event(const vkb::InputEvent &input_event) override;
 
+	/**
+	 * @brief Gets the pose of the camera as its view space position and rotation, unlike the node
+	 *        transform VulkanSample uses, so the paths of both types of samples are not interchangeable
+	 */
+	virtual bool get_camera_pose(vkb::CameraPose &pose) override;
+
+	/**
+	 * @brief Sets the view space position and rotation of the camera, see get_camera_pose()
+	 */
+	virtual bool set_camera_pose(const vkb::CameraPose &pose) override;
+
 	virtual void update(float delta_time) override;
 
 	virtual bool resize(const uint32_t width, const uint32_t height) override;
@@ -214,8 +225,9 @@ class ApiVulkanSample : public vkb::VulkanSample
 	 * @brief Loads in a single model from a GLTF file
 	 * @param file The filename of the model to load
 	 * @param index The index of the model to load from the GLTF file (default: 0)
+	 * @param buffer_usage Usage flags added to the vertex and index buffers (default: 0)
 	 */
-	std::unique_ptr<vkb::sg::SubMesh> load_model(const std::string &file, uint32_t index = 0);
+	std::unique_ptr<vkb::sg::SubMesh> load_model(const std::string &file, uint32_t index = 0, VkBufferUsageFlags buffer_usage = 0);
 
 	/**
 	 * @brief Records the necessary drawing commands to a command buffer
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2022, Arm Limited and Contributors
+/* Copyright (c) 2019-2023, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -31,9 +31,15 @@ BufferBlock::BufferBlock(Device &device, VkDeviceSize size, VkBufferUsageFlags u
 	{
 		alignment = device.get_gpu().get_properties().limits.minUniformBufferOffsetAlignment;
 	}
-	else if (usage == VK_BUFFER_USAGE_STORAGE_BUFFER_BIT)
+	else if ((usage & ~VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT) == VK_BUFFER_USAGE_STORAGE_BUFFER_BIT)
 	{
 		alignment = device.get_gpu().get_properties().limits.minStorageBufferOffsetAlignment;
+
+		// The addresses of allocations may be read as buffer references, which are 16 byte aligned
+		if (usage & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT)
+		{
+			alignment = std::max<VkDeviceSize>(alignment, 16);
+		}
 	}
 	else if (usage == VK_BUFFER_USAGE_UNIFORM_TEXEL_BUFFER_BIT)
 	{
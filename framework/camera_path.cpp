@@ -0,0 +1,176 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "camera_path.h"
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+#include <json.hpp>
+
+#include "common/logging.h"
+#include "platform/filesystem.h"
+
+namespace vkb
+{
+namespace
+{
+glm::vec3 catmull_rom(const glm::vec3 &p0, const glm::vec3 &p1, const glm::vec3 &p2, const glm::vec3 &p3, float t)
+{
+	float t2 = t * t;
+	float t3 = t2 * t;
+
+	return 0.5f * ((2.0f * p1) +
+	               (p2 - p0) * t +
+	               (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * t2 +
+	               (3.0f * p1 - p0 - 3.0f * p2 + p3) * t3);
+}
+}        // namespace
+
+CameraPath CameraPath::load(const std::string &filename)
+{
+	std::ifstream file{fs::path::get(fs::path::Type::CameraPaths, filename)};
+	if (!file.is_open())
+	{
+		throw std::runtime_error("Failed to open camera path: " + filename);
+	}
+
+	CameraPath path;
+
+	try
+	{
+		nlohmann::json data = nlohmann::json::parse(file);
+
+		for (auto &entry : data.at("keyframes"))
+		{
+			auto &position = entry.at("position");
+			auto &rotation = entry.at("rotation");
+
+			Keyframe keyframe;
+			keyframe.time          = entry.at("time").get<float>();
+			keyframe.pose.position = glm::vec3(position.at(0).get<float>(), position.at(1).get<float>(), position.at(2).get<float>());
+			keyframe.pose.rotation = glm::normalize(glm::quat(rotation.at(0).get<float>(), rotation.at(1).get<float>(), rotation.at(2).get<float>(), rotation.at(3).get<float>()));
+
+			path.add_keyframe(keyframe);
+		}
+	}
+	catch (nlohmann::json::exception &e)
+	{
+		throw std::runtime_error("Invalid camera path " + filename + ": " + e.what());
+	}
+
+	return path;
+}
+
+bool CameraPath::save(const std::string &filename) const
+{
+	nlohmann::json entries = nlohmann::json::array();
+
+	for (auto &keyframe : keyframes)
+	{
+		auto &position = keyframe.pose.position;
+		auto &rotation = keyframe.pose.rotation;
+
+		entries.push_back({{"time", keyframe.time},
+		                   {"position", {position.x, position.y, position.z}},
+		                   {"rotation", {rotation.w, rotation.x, rotation.y, rotation.z}}});
+	}
+
+	nlohmann::json data = {{"keyframes", entries}};
+
+	std::ofstream file{fs::path::get(fs::path::Type::CameraPaths, filename), std::ios::out | std::ios::trunc};
+	if (!file.good())
+	{
+		LOGE("Failed to write camera path: {}", filename);
+		return false;
+	}
+
+	file << data.dump(1, '\t') << std::endl;
+
+	return true;
+}
+
+void CameraPath::add_keyframe(const Keyframe &keyframe)
+{
+	if (!keyframes.empty() && keyframe.time <= keyframes.back().time)
+	{
+		throw std::runtime_error("Camera path keyframes must be in increasing time order");
+	}
+
+	keyframes.push_back(keyframe);
+}
+
+void CameraPath::clear()
+{
+	keyframes.clear();
+}
+
+bool CameraPath::empty() const
+{
+	return keyframes.empty();
+}
+
+float CameraPath::get_duration() const
+{
+	return keyframes.empty() ? 0.0f : keyframes.back().time;
+}
+
+const std::vector<CameraPath::Keyframe> &CameraPath::get_keyframes() const
+{
+	return keyframes;
+}
+
+CameraPose CameraPath::sample(float time) const
+{
+	if (keyframes.empty())
+	{
+		return {};
+	}
+
+	if (time <= keyframes.front().time)
+	{
+		return keyframes.front().pose;
+	}
+
+	if (time >= keyframes.back().time)
+	{
+		return keyframes.back().pose;
+	}
+
+	// First keyframe later than the time, the path is between it and the previous one
+	auto next = std::upper_bound(keyframes.begin(), keyframes.end(), time,
+	                             [](float value, const Keyframe &keyframe) { return value < keyframe.time; });
+
+	size_t i1 = static_cast<size_t>(next - keyframes.begin());
+	size_t i0 = i1 - 1;
+
+	auto &k0 = keyframes[i0];
+	auto &k1 = keyframes[i1];
+	float t  = (time - k0.time) / (k1.time - k0.time);
+
+	// The end keyframes are repeated to get the tangents at both ends of the path
+	auto &before = keyframes[i0 > 0 ? i0 - 1 : i0];
+	auto &after  = keyframes[std::min(i1 + 1, keyframes.size() - 1)];
+
+	CameraPose pose;
+	pose.position = catmull_rom(before.pose.position, k0.pose.position, k1.pose.position, after.pose.position, t);
+	pose.rotation = glm::slerp(k0.pose.rotation, k1.pose.rotation, t);
+
+	return pose;
+}
+}        // namespace vkb
@@ -0,0 +1,113 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "common/error.h"
+
+VKBP_DISABLE_WARNINGS()
+#include "common/glm_common.h"
+#include <glm/gtc/quaternion.hpp>
+VKBP_ENABLE_WARNINGS()
+
+namespace vkb
+{
+/**
+ * @brief Position and orientation of the camera an application renders from
+ *
+ * What the values are relative to is up to the application, for a scene graph camera
+ * they are the local transform of its node. ApiVulkanSample stores the position and rotation
+ * of its vkb::Camera instead, which are those of the view, so paths recorded with one type of
+ * sample cannot be replayed with the other.
+ */
+struct CameraPose
+{
+	glm::vec3 position{0.0f};
+
+	glm::quat rotation{1.0f, 0.0f, 0.0f, 0.0f};
+};
+
+/**
+ * @brief A keyframed camera path, which can be sampled at any time
+ *
+ * Positions follow a Catmull-Rom spline through the keyframes, rotations are interpolated
+ * spherically between consecutive keyframes. Paths are stored as JSON in the camera paths
+ * output directory:
+ *
+ * {
+ *     "keyframes": [
+ *         { "time": 0.0, "position": [x, y, z], "rotation": [w, x, y, z] },
+ *         ...
+ *     ]
+ * }
+ */
+class CameraPath
+{
+  public:
+	struct Keyframe
+	{
+		/// Time of the keyframe in seconds from the start of the path
+		float time{0.0f};
+
+		CameraPose pose;
+	};
+
+	CameraPath() = default;
+
+	/**
+	 * @brief Loads a camera path
+	 * @param filename Name of the file in the camera paths output directory
+	 * @throws std::runtime_error if the file cannot be read or is not a valid camera path
+	 */
+	static CameraPath load(const std::string &filename);
+
+	/**
+	 * @brief Saves the camera path
+	 * @param filename Name of the file in the camera paths output directory
+	 * @return True if the file was written
+	 */
+	bool save(const std::string &filename) const;
+
+	/**
+	 * @brief Adds a keyframe at the end of the path
+	 * @throws std::runtime_error if the keyframe is not later than the last one
+	 */
+	void add_keyframe(const Keyframe &keyframe);
+
+	void clear();
+
+	bool empty() const;
+
+	/**
+	 * @return The time of the last keyframe
+	 */
+	float get_duration() const;
+
+	const std::vector<Keyframe> &get_keyframes() const;
+
+	/**
+	 * @brief Interpolates the pose at a time, clamped to the duration of the path
+	 */
+	CameraPose sample(float time) const;
+
+  private:
+	std::vector<Keyframe> keyframes;
+};
+}        // namespace vkb
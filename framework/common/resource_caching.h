@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2021, Arm Limited and Contributors
+/* Copyright (c) 2018-2023, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -255,6 +255,36 @@ struct hash<VkDescriptorImageInfo>
 	}
 };
 
+template <>
+struct hash<VkSamplerCreateInfo>
+{
+	std::size_t operator()(const VkSamplerCreateInfo &sampler_info) const
+	{
+		std::size_t result = 0;
+
+		// Extension structures are not followed, samplers with a different chain are only shared if it is the same chain
+		vkb::hash_combine(result, sampler_info.pNext);
+		vkb::hash_combine(result, sampler_info.flags);
+		vkb::hash_combine(result, static_cast<std::underlying_type<VkFilter>::type>(sampler_info.magFilter));
+		vkb::hash_combine(result, static_cast<std::underlying_type<VkFilter>::type>(sampler_info.minFilter));
+		vkb::hash_combine(result, static_cast<std::underlying_type<VkSamplerMipmapMode>::type>(sampler_info.mipmapMode));
+		vkb::hash_combine(result, static_cast<std::underlying_type<VkSamplerAddressMode>::type>(sampler_info.addressModeU));
+		vkb::hash_combine(result, static_cast<std::underlying_type<VkSamplerAddressMode>::type>(sampler_info.addressModeV));
+		vkb::hash_combine(result, static_cast<std::underlying_type<VkSamplerAddressMode>::type>(sampler_info.addressModeW));
+		vkb::hash_combine(result, sampler_info.mipLodBias);
+		vkb::hash_combine(result, sampler_info.anisotropyEnable);
+		vkb::hash_combine(result, sampler_info.maxAnisotropy);
+		vkb::hash_combine(result, sampler_info.compareEnable);
+		vkb::hash_combine(result, static_cast<std::underlying_type<VkCompareOp>::type>(sampler_info.compareOp));
+		vkb::hash_combine(result, sampler_info.minLod);
+		vkb::hash_combine(result, sampler_info.maxLod);
+		vkb::hash_combine(result, static_cast<std::underlying_type<VkBorderColor>::type>(sampler_info.borderColor));
+		vkb::hash_combine(result, sampler_info.unnormalizedCoordinates);
+
+		return result;
+	}
+};
+
 template <>
 struct hash<VkWriteDescriptorSet>
 {
@@ -487,19 +517,43 @@ struct hash<vkb::PipelineState>
 			vkb::hash_combine(result, binding);
 		}
 
+		// Dynamic state is recorded by the command buffer, so only the states a pipeline is created with are part of its key
+		const auto &extended_dynamic_state = pipeline_state.get_extended_dynamic_state();
+
+		vkb::hash_combine(result, extended_dynamic_state.extended_dynamic_state);
+		vkb::hash_combine(result, extended_dynamic_state.patch_control_points);
+
 		// VkPipelineInputAssemblyStateCreateInfo
 		vkb::hash_combine(result, pipeline_state.get_input_assembly_state().primitive_restart_enable);
-		vkb::hash_combine(result, static_cast<std::underlying_type<VkPrimitiveTopology>::type>(pipeline_state.get_input_assembly_state().topology));
+
+		if (extended_dynamic_state.extended_dynamic_state)
+		{
+			vkb::hash_combine(result, static_cast<std::underlying_type<VkPrimitiveTopology>::type>(vkb::get_topology_class(pipeline_state.get_input_assembly_state().topology)));
+		}
+		else
+		{
+			vkb::hash_combine(result, static_cast<std::underlying_type<VkPrimitiveTopology>::type>(pipeline_state.get_input_assembly_state().topology));
+		}
+
+		// VkPipelineTessellationStateCreateInfo
+		if (!extended_dynamic_state.patch_control_points)
+		{
+			vkb::hash_combine(result, pipeline_state.get_tessellation_state().patch_control_points);
+		}
 
 		//VkPipelineViewportStateCreateInfo
 		vkb::hash_combine(result, pipeline_state.get_viewport_state().viewport_count);
 		vkb::hash_combine(result, pipeline_state.get_viewport_state().scissor_count);
 
 		// VkPipelineRasterizationStateCreateInfo
-		vkb::hash_combine(result, pipeline_state.get_rasterization_state().cull_mode);
+		if (!extended_dynamic_state.extended_dynamic_state)
+		{
+			vkb::hash_combine(result, pipeline_state.get_rasterization_state().cull_mode);
+			vkb::hash_combine(result, static_cast<std::underlying_type<VkFrontFace>::type>(pipeline_state.get_rasterization_state().front_face));
+		}
+
 		vkb::hash_combine(result, pipeline_state.get_rasterization_state().depth_bias_enable);
 		vkb::hash_combine(result, pipeline_state.get_rasterization_state().depth_clamp_enable);
-		vkb::hash_combine(result, static_cast<std::underlying_type<VkFrontFace>::type>(pipeline_state.get_rasterization_state().front_face));
 		vkb::hash_combine(result, static_cast<std::underlying_type<VkPolygonMode>::type>(pipeline_state.get_rasterization_state().polygon_mode));
 		vkb::hash_combine(result, pipeline_state.get_rasterization_state().rasterizer_discard_enable);
 
@@ -514,9 +568,14 @@ struct hash<vkb::PipelineState>
 		// VkPipelineDepthStencilStateCreateInfo
 		vkb::hash_combine(result, pipeline_state.get_depth_stencil_state().back);
 		vkb::hash_combine(result, pipeline_state.get_depth_stencil_state().depth_bounds_test_enable);
-		vkb::hash_combine(result, static_cast<std::underlying_type<VkCompareOp>::type>(pipeline_state.get_depth_stencil_state().depth_compare_op));
-		vkb::hash_combine(result, pipeline_state.get_depth_stencil_state().depth_test_enable);
-		vkb::hash_combine(result, pipeline_state.get_depth_stencil_state().depth_write_enable);
+
+		if (!extended_dynamic_state.extended_dynamic_state)
+		{
+			vkb::hash_combine(result, static_cast<std::underlying_type<VkCompareOp>::type>(pipeline_state.get_depth_stencil_state().depth_compare_op));
+			vkb::hash_combine(result, pipeline_state.get_depth_stencil_state().depth_test_enable);
+			vkb::hash_combine(result, pipeline_state.get_depth_stencil_state().depth_write_enable);
+		}
+
 		vkb::hash_combine(result, pipeline_state.get_depth_stencil_state().front);
 		vkb::hash_combine(result, pipeline_state.get_depth_stencil_state().stencil_test_enable);
 
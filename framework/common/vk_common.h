@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2021, Arm Limited and Contributors
+/* Copyright (c) 2018-2023, Arm Limited and Contributors
  * Copyright (c) 2019-2021, Sascha Willems
  *
  * SPDX-License-Identifier: Apache-2.0
@@ -122,6 +122,19 @@ struct ImageMemoryBarrier
 	uint32_t new_queue_family{VK_QUEUE_FAMILY_IGNORED};
 };
 
+/**
+ * @brief How the commands recorded next use an image, from which the barrier
+ *        transitioning it from the state tracked by core::Image is computed
+ */
+struct ImageUsage
+{
+	VkImageLayout layout{VK_IMAGE_LAYOUT_UNDEFINED};
+
+	VkPipelineStageFlags stage_mask{VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT};
+
+	VkAccessFlags access_mask{0};
+};
+
 /**
 * @brief Buffer memory barrier structure used to define
 *        memory access for a buffer during command recording.
@@ -1,4 +1,4 @@
-/* Copyright (c) 2021, Sascha Willems
+/* Copyright (c) 2021-2023, Sascha Willems
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -32,6 +32,8 @@ AccelerationStructure::AccelerationStructure(Device &                       devi
 
 AccelerationStructure::~AccelerationStructure()
 {
+	release_uncompacted();
+
 	if (handle != VK_NULL_HANDLE)
 	{
 		vkDestroyAccelerationStructureKHR(device.get_handle(), handle, nullptr);
@@ -127,42 +129,63 @@ void AccelerationStructure::update_instance_geometry(uint64_t
 }
 
 void AccelerationStructure::build(VkQueue queue, VkBuildAccelerationStructureFlagsKHR flags, VkBuildAccelerationStructureModeKHR mode)
+{
+	// Create a scratch buffer as a temporary storage for the acceleration structure build
+	scratch_buffer = std::make_unique<vkb::core::ScratchBuffer>(device, prepare_build(flags, mode));
+
+	// Build the acceleration structure on the device via a one-time command buffer submission
+	VkCommandBuffer command_buffer       = device.create_command_buffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
+	auto           &build_info           = get_build_geometry_info(scratch_buffer->get_device_address());
+	auto            as_build_range_infos = get_build_range_infos();
+	vkCmdBuildAccelerationStructuresKHR(
+	    command_buffer,
+	    1,
+	    &build_info,
+	    &as_build_range_infos);
+	device.flush_command_buffer(command_buffer, queue);
+	scratch_buffer.reset();
+}
+
+VkDeviceSize AccelerationStructure::prepare_build(VkBuildAccelerationStructureFlagsKHR flags, VkBuildAccelerationStructureModeKHR mode)
 {
 	assert(!geometries.empty());
 
-	std::vector<VkAccelerationStructureGeometryKHR>       acceleration_structure_geometries;
-	std::vector<VkAccelerationStructureBuildRangeInfoKHR> acceleration_structure_build_range_infos;
-	std::vector<uint32_t>                                 primitive_counts;
+	// An update needs the structure it refits, fall back to a full build otherwise
+	if (handle == VK_NULL_HANDLE)
+	{
+		mode = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
+	}
+
+	build_geometries.clear();
+	build_range_infos.clear();
+
+	// An update must list the same geometries as the build it refits
+	std::vector<uint32_t> primitive_counts;
 	for (auto &geometry : geometries)
 	{
-		if (mode == VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR && !geometry.second.updated)
-		{
-			continue;
-		}
-		acceleration_structure_geometries.push_back(geometry.second.geometry);
+		build_geometries.push_back(geometry.second.geometry);
 		// Infer build range info from geometry
 		VkAccelerationStructureBuildRangeInfoKHR build_range_info;
 		build_range_info.primitiveCount  = geometry.second.primitive_count;
 		build_range_info.primitiveOffset = 0;
 		build_range_info.firstVertex     = 0;
 		build_range_info.transformOffset = geometry.second.transform_offset;
-		acceleration_structure_build_range_infos.push_back(build_range_info);
+		build_range_infos.push_back(build_range_info);
 		primitive_counts.push_back(geometry.second.primitive_count);
 		geometry.second.updated = false;
 	}
 
-	VkAccelerationStructureBuildGeometryInfoKHR build_geometry_info{};
+	build_geometry_info       = {};
 	build_geometry_info.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR;
 	build_geometry_info.type  = type;
 	build_geometry_info.flags = flags;
 	build_geometry_info.mode  = mode;
-	if (mode == VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR && handle != VK_NULL_HANDLE)
+	if (mode == VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR)
 	{
 		build_geometry_info.srcAccelerationStructure = handle;
-		build_geometry_info.dstAccelerationStructure = handle;
 	}
-	build_geometry_info.geometryCount = static_cast<uint32_t>(acceleration_structure_geometries.size());
-	build_geometry_info.pGeometries   = acceleration_structure_geometries.data();
+	build_geometry_info.geometryCount = static_cast<uint32_t>(build_geometries.size());
+	build_geometry_info.pGeometries   = build_geometries.data();
 
 	// Get required build sizes
 	build_sizes_info.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_SIZES_INFO_KHR;
@@ -173,50 +196,97 @@ void AccelerationStructure::build(VkQueue queue, VkBuildAccelerationStructureFla
 	    primitive_counts.data(),
 	    &build_sizes_info);
 
-	// Create a buffer for the acceleration structure
-	if (!buffer || buffer->get_size() != build_sizes_info.accelerationStructureSize)
+	// Create a buffer for the acceleration structure, an update refits the existing one in place
+	if (mode == VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR && (!buffer || buffer->get_size() != build_sizes_info.accelerationStructureSize))
 	{
-		buffer = std::make_unique<vkb::core::Buffer>(
-		    device,
-		    build_sizes_info.accelerationStructureSize,
-		    VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR,
-		    VMA_MEMORY_USAGE_GPU_ONLY);
-
-		VkAccelerationStructureCreateInfoKHR acceleration_structure_create_info{};
-		acceleration_structure_create_info.sType  = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR;
-		acceleration_structure_create_info.buffer = buffer->get_handle();
-		acceleration_structure_create_info.size   = build_sizes_info.accelerationStructureSize;
-		acceleration_structure_create_info.type   = type;
-		VkResult result                           = vkCreateAccelerationStructureKHR(device.get_handle(), &acceleration_structure_create_info, nullptr, &handle);
-
-		if (result != VK_SUCCESS)
+		// A rebuild, which always happens for a compacted structure, replaces the previous storage.
+		// Frames in flight may still trace against it, so it is destroyed once they completed
+		if (handle != VK_NULL_HANDLE)
 		{
-			throw VulkanException{result, "Could not create acceleration structure"};
+			VkDevice                   device_handle  = device.get_handle();
+			VkAccelerationStructureKHR retired_handle = handle;
+
+			device.get_deletion_queue().push_callback([device_handle, retired_handle]() {
+				vkDestroyAccelerationStructureKHR(device_handle, retired_handle, nullptr);
+			});
+			device.get_deletion_queue().push(std::move(buffer));
+
+			handle = VK_NULL_HANDLE;
 		}
+
+		create_storage(build_sizes_info.accelerationStructureSize, handle, buffer);
+	}
+
+	build_flags                                  = flags;
+	build_geometry_info.dstAccelerationStructure = handle;
+
+	return mode == VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR ? build_sizes_info.updateScratchSize : build_sizes_info.buildScratchSize;
+}
+
+const VkAccelerationStructureBuildGeometryInfoKHR &AccelerationStructure::get_build_geometry_info(uint64_t scratch_address)
+{
+	build_geometry_info.scratchData.deviceAddress = scratch_address;
+	return build_geometry_info;
+}
+
+const VkAccelerationStructureBuildRangeInfoKHR *AccelerationStructure::get_build_range_infos() const
+{
+	return build_range_infos.data();
+}
+
+void AccelerationStructure::record_compaction(VkCommandBuffer command_buffer, VkDeviceSize compacted_size)
+{
+	assert(handle != VK_NULL_HANDLE && uncompacted_handle == VK_NULL_HANDLE);
+
+	// The source stays alive until the copy has executed, see release_uncompacted()
+	uncompacted_handle = handle;
+	uncompacted_buffer = std::move(buffer);
+
+	create_storage(compacted_size, handle, buffer);
+
+	VkCopyAccelerationStructureInfoKHR copy_info{};
+	copy_info.sType = VK_STRUCTURE_TYPE_COPY_ACCELERATION_STRUCTURE_INFO_KHR;
+	copy_info.src   = uncompacted_handle;
+	copy_info.dst   = handle;
+	copy_info.mode  = VK_COPY_ACCELERATION_STRUCTURE_MODE_COMPACT_KHR;
+	vkCmdCopyAccelerationStructureKHR(command_buffer, &copy_info);
+}
+
+void AccelerationStructure::release_uncompacted()
+{
+	if (uncompacted_handle != VK_NULL_HANDLE)
+	{
+		vkDestroyAccelerationStructureKHR(device.get_handle(), uncompacted_handle, nullptr);
+		uncompacted_handle = VK_NULL_HANDLE;
+	}
+	uncompacted_buffer.reset();
+}
+
+void AccelerationStructure::create_storage(VkDeviceSize size, VkAccelerationStructureKHR &storage_handle, std::unique_ptr<vkb::core::Buffer> &storage_buffer)
+{
+	storage_buffer = std::make_unique<vkb::core::Buffer>(
+	    device,
+	    size,
+	    VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR,
+	    VMA_MEMORY_USAGE_GPU_ONLY);
+
+	VkAccelerationStructureCreateInfoKHR acceleration_structure_create_info{};
+	acceleration_structure_create_info.sType  = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR;
+	acceleration_structure_create_info.buffer = storage_buffer->get_handle();
+	acceleration_structure_create_info.size   = size;
+	acceleration_structure_create_info.type   = type;
+	VkResult result                           = vkCreateAccelerationStructureKHR(device.get_handle(), &acceleration_structure_create_info, nullptr, &storage_handle);
+
+	if (result != VK_SUCCESS)
+	{
+		throw VulkanException{result, "Could not create acceleration structure"};
 	}
 
 	// Get the acceleration structure's handle
 	VkAccelerationStructureDeviceAddressInfoKHR acceleration_device_address_info{};
 	acceleration_device_address_info.sType                 = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_DEVICE_ADDRESS_INFO_KHR;
-	acceleration_device_address_info.accelerationStructure = handle;
+	acceleration_device_address_info.accelerationStructure = storage_handle;
 	device_address                                         = vkGetAccelerationStructureDeviceAddressKHR(device.get_handle(), &acceleration_device_address_info);
-
-	// Create a scratch buffer as a temporary storage for the acceleration structure build
-	scratch_buffer = std::make_unique<vkb::core::ScratchBuffer>(device, build_sizes_info.buildScratchSize);
-
-	build_geometry_info.scratchData.deviceAddress = scratch_buffer->get_device_address();
-	build_geometry_info.dstAccelerationStructure  = handle;
-
-	// Build the acceleration structure on the device via a one-time command buffer submission
-	VkCommandBuffer command_buffer       = device.create_command_buffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
-	auto            as_build_range_infos = &*acceleration_structure_build_range_infos.data();
-	vkCmdBuildAccelerationStructuresKHR(
-	    command_buffer,
-	    1,
-	    &build_geometry_info,
-	    &as_build_range_infos);
-	device.flush_command_buffer(command_buffer, queue);
-	scratch_buffer.reset();
 }
 
 VkAccelerationStructureKHR AccelerationStructure::get_handle() const
@@ -234,5 +304,20 @@ uint64_t AccelerationStructure::get_device_address() const
 	return device_address;
 }
 
+VkAccelerationStructureTypeKHR AccelerationStructure::get_type() const
+{
+	return type;
+}
+
+VkBuildAccelerationStructureFlagsKHR AccelerationStructure::get_build_flags() const
+{
+	return build_flags;
+}
+
+VkDeviceSize AccelerationStructure::get_size() const
+{
+	return buffer ? buffer->get_size() : 0;
+}
+
 }        // namespace core
 }        // namespace vkb
\ No newline at end of file
@@ -1,4 +1,4 @@
-/* Copyright (c) 2021, Sascha Willems
+/* Copyright (c) 2021-2023, Sascha Willems
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -114,12 +114,56 @@ class AccelerationStructure
 	           VkBuildAccelerationStructureFlagsKHR flags = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR,
 	           VkBuildAccelerationStructureModeKHR  mode  = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR);
 
+	/**
+	 * @brief Sets up a build of the added geometries without recording it, creating the storage if needed
+	 * @param flags Build flags
+	 * @param mode Build mode (build or update), an update without a previous build is a build
+	 * @returns The scratch size in bytes the build needs
+	 */
+	VkDeviceSize prepare_build(VkBuildAccelerationStructureFlagsKHR flags, VkBuildAccelerationStructureModeKHR mode);
+
+	/**
+	 * @brief Gets the build set up by prepare_build, to record it with other builds
+	 * @param scratch_address Device address of at least the scratch size returned by prepare_build
+	 */
+	const VkAccelerationStructureBuildGeometryInfoKHR &get_build_geometry_info(uint64_t scratch_address);
+
+	/**
+	 * @return The build ranges of the build set up by prepare_build, one per geometry
+	 */
+	const VkAccelerationStructureBuildRangeInfoKHR *get_build_range_infos() const;
+
+	/**
+	 * @brief Records a copy of the built structure into new storage of the compacted size
+	 *        The uncompacted structure is kept until release_uncompacted() is called
+	 * @param command_buffer Command buffer executed after the build
+	 * @param compacted_size Size queried with VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR
+	 */
+	void record_compaction(VkCommandBuffer command_buffer, VkDeviceSize compacted_size);
+
+	/**
+	 * @brief Frees the uncompacted structure, once the compaction copy has executed
+	 */
+	void release_uncompacted();
+
 	VkAccelerationStructureKHR get_handle() const;
 
 	const VkAccelerationStructureKHR *get() const;
 
 	uint64_t get_device_address() const;
 
+	VkAccelerationStructureTypeKHR get_type() const;
+
+	/**
+	 * @return The flags of the last build, an update needs VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR
+	 */
+	VkBuildAccelerationStructureFlagsKHR get_build_flags() const;
+
+	/**
+	 * @return The size in bytes of the storage of the acceleration structure
+	 */
+	VkDeviceSize get_size() const;
+
 	vkb::core::Buffer *get_buffer() const
 	{
 		return buffer.get();
@@ -131,6 +175,8 @@ class AccelerationStructure
 	}
 
   private:
+	void create_storage(VkDeviceSize size, VkAccelerationStructureKHR &storage_handle, std::unique_ptr<vkb::core::Buffer> &storage_buffer);
+
 	Device &device;
 
 	VkAccelerationStructureKHR handle{VK_NULL_HANDLE};
@@ -154,6 +200,18 @@ class AccelerationStructure
 	std::map<uint64_t, Geometry> geometries{};
 
 	std::unique_ptr<vkb::core::Buffer> buffer{nullptr};
+
+	VkBuildAccelerationStructureFlagsKHR build_flags{0};
+
+	VkAccelerationStructureBuildGeometryInfoKHR build_geometry_info{};
+
+	std::vector<VkAccelerationStructureGeometryKHR> build_geometries;
+
+	std::vector<VkAccelerationStructureBuildRangeInfoKHR> build_range_infos;
+
+	VkAccelerationStructureKHR uncompacted_handle{VK_NULL_HANDLE};
+
+	std::unique_ptr<vkb::core::Buffer> uncompacted_buffer{nullptr};
 };
 }        // namespace core
 }        // namespace vkb
\ No newline at end of file
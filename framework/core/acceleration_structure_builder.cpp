@@ -0,0 +1,245 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "acceleration_structure_builder.h"
+
+#include "common/logging.h"
+#include "device.h"
+#include "timer.h"
+
+namespace vkb
+{
+namespace core
+{
+namespace
+{
+VkDeviceSize align_up(VkDeviceSize value, VkDeviceSize alignment)
+{
+	return (value + alignment - 1) / alignment * alignment;
+}
+
+void record_acceleration_structure_barrier(VkCommandBuffer command_buffer)
+{
+	VkMemoryBarrier barrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER};
+	barrier.srcAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+	barrier.dstAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR;
+
+	vkCmdPipelineBarrier(command_buffer,
+	                     VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+	                     VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+	                     0, 1, &barrier, 0, nullptr, 0, nullptr);
+}
+}        // namespace
+
+AccelerationStructureBuilder::AccelerationStructureBuilder(Device &device) :
+    device{device}
+{
+	VkPhysicalDeviceAccelerationStructurePropertiesKHR acceleration_structure_properties{};
+	acceleration_structure_properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_PROPERTIES_KHR;
+
+	VkPhysicalDeviceProperties2KHR device_properties{};
+	device_properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2_KHR;
+	device_properties.pNext = &acceleration_structure_properties;
+	vkGetPhysicalDeviceProperties2KHR(device.get_gpu().get_handle(), &device_properties);
+
+	if (acceleration_structure_properties.minAccelerationStructureScratchOffsetAlignment != 0)
+	{
+		scratch_alignment = acceleration_structure_properties.minAccelerationStructureScratchOffsetAlignment;
+	}
+}
+
+void AccelerationStructureBuilder::add_build(AccelerationStructure &acceleration_structure, VkBuildAccelerationStructureFlagsKHR flags)
+{
+	requests.push_back({&acceleration_structure, flags, VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR, 0});
+}
+
+void AccelerationStructureBuilder::add_refit(AccelerationStructure &acceleration_structure)
+{
+	auto flags = acceleration_structure.get_build_flags();
+
+	if (acceleration_structure.get_handle() == VK_NULL_HANDLE || !(flags & VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR))
+	{
+		LOGW("Acceleration structure does not allow updates, rebuilding it");
+		requests.push_back({&acceleration_structure, flags, VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR, 0});
+		return;
+	}
+
+	requests.push_back({&acceleration_structure, flags, VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR, 0});
+}
+
+const AccelerationStructureBuilder::Stats &AccelerationStructureBuilder::build(VkQueue queue)
+{
+	stats = {};
+
+	if (requests.empty())
+	{
+		return stats;
+	}
+
+	Timer timer;
+	timer.start();
+
+	// Sub-allocate the scratch memory of every build
+	for (auto &request : requests)
+	{
+		request.scratch_offset = stats.scratch_size;
+
+		stats.scratch_size += align_up(request.acceleration_structure->prepare_build(request.flags, request.mode), scratch_alignment);
+
+		if (request.mode == VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR)
+		{
+			stats.refit_count++;
+		}
+		else
+		{
+			stats.build_count++;
+		}
+	}
+
+	// The buffer is only guaranteed the alignment of storage buffers, so the base address is aligned here
+	if (!scratch_buffer || scratch_buffer->get_size() < stats.scratch_size + scratch_alignment)
+	{
+		scratch_buffer = std::make_unique<ScratchBuffer>(device, stats.scratch_size + scratch_alignment);
+	}
+
+	uint64_t scratch_address = align_up(scratch_buffer->get_device_address(), scratch_alignment);
+
+	// Top-level builds read the bottom-level structures, so they are recorded after them
+	std::vector<VkAccelerationStructureBuildGeometryInfoKHR>      bottom_level_infos;
+	std::vector<const VkAccelerationStructureBuildRangeInfoKHR *> bottom_level_ranges;
+	std::vector<VkAccelerationStructureBuildGeometryInfoKHR>      top_level_infos;
+	std::vector<const VkAccelerationStructureBuildRangeInfoKHR *> top_level_ranges;
+	std::vector<AccelerationStructure *>                          compacted;
+
+	for (auto &request : requests)
+	{
+		auto &acceleration_structure = *request.acceleration_structure;
+		auto &build_info             = acceleration_structure.get_build_geometry_info(scratch_address + request.scratch_offset);
+
+		if (acceleration_structure.get_type() == VK_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL_KHR)
+		{
+			top_level_infos.push_back(build_info);
+			top_level_ranges.push_back(acceleration_structure.get_build_range_infos());
+		}
+		else
+		{
+			bottom_level_infos.push_back(build_info);
+			bottom_level_ranges.push_back(acceleration_structure.get_build_range_infos());
+		}
+
+		// Refitted structures keep the size of their first build
+		if (build_info.mode == VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR && (request.flags & VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR))
+		{
+			compacted.push_back(&acceleration_structure);
+		}
+	}
+
+	VkCommandBuffer command_buffer = device.create_command_buffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
+
+	if (!bottom_level_infos.empty())
+	{
+		vkCmdBuildAccelerationStructuresKHR(command_buffer, to_u32(bottom_level_infos.size()), bottom_level_infos.data(), bottom_level_ranges.data());
+	}
+
+	if (!top_level_infos.empty())
+	{
+		if (!bottom_level_infos.empty())
+		{
+			record_acceleration_structure_barrier(command_buffer);
+		}
+
+		vkCmdBuildAccelerationStructuresKHR(command_buffer, to_u32(top_level_infos.size()), top_level_infos.data(), top_level_ranges.data());
+	}
+
+	if (!compacted.empty())
+	{
+		record_compaction_queries(command_buffer, compacted);
+	}
+
+	device.flush_command_buffer(command_buffer, queue);
+
+	if (!compacted.empty())
+	{
+		std::vector<VkDeviceSize> compacted_sizes(compacted.size());
+
+		VK_CHECK(query_pool->get_results(0, to_u32(compacted_sizes.size()),
+		                                 compacted_sizes.size() * sizeof(VkDeviceSize), compacted_sizes.data(), sizeof(VkDeviceSize),
+		                                 VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT));
+
+		command_buffer = device.create_command_buffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
+
+		for (size_t i = 0; i < compacted.size(); ++i)
+		{
+			stats.uncompacted_size += compacted[i]->get_size();
+			stats.compacted_size   += compacted_sizes[i];
+
+			compacted[i]->record_compaction(command_buffer, compacted_sizes[i]);
+		}
+
+		device.flush_command_buffer(command_buffer, queue);
+
+		for (auto acceleration_structure : compacted)
+		{
+			acceleration_structure->release_uncompacted();
+		}
+
+		stats.compaction_count = to_u32(compacted.size());
+	}
+
+	requests.clear();
+
+	stats.build_time = timer.stop<Timer::Milliseconds>();
+
+	return stats;
+}
+
+const AccelerationStructureBuilder::Stats &AccelerationStructureBuilder::get_stats() const
+{
+	return stats;
+}
+
+void AccelerationStructureBuilder::record_compaction_queries(VkCommandBuffer command_buffer, const std::vector<AccelerationStructure *> &compacted)
+{
+	auto count = to_u32(compacted.size());
+
+	if (count > query_count)
+	{
+		VkQueryPoolCreateInfo query_pool_info{VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO};
+		query_pool_info.queryType  = VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR;
+		query_pool_info.queryCount = count;
+
+		query_pool  = std::make_unique<QueryPool>(device, query_pool_info);
+		query_count = count;
+	}
+
+	std::vector<VkAccelerationStructureKHR> handles;
+	for (auto acceleration_structure : compacted)
+	{
+		handles.push_back(acceleration_structure->get_handle());
+	}
+
+	vkCmdResetQueryPool(command_buffer, query_pool->get_handle(), 0, count);
+
+	// The sizes are only known once the builds are complete
+	record_acceleration_structure_barrier(command_buffer);
+
+	vkCmdWriteAccelerationStructuresPropertiesKHR(command_buffer, count, handles.data(),
+	                                              VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR,
+	                                              query_pool->get_handle(), 0);
+}
+}        // namespace core
+}        // namespace vkb
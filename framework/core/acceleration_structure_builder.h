@@ -0,0 +1,124 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "common/helpers.h"
+#include "common/vk_common.h"
+#include "core/acceleration_structure.h"
+#include "core/query_pool.h"
+#include "core/scratch_buffer.h"
+
+namespace vkb
+{
+class Device;
+
+namespace core
+{
+/**
+ * @brief Builds many acceleration structures with one queue submission
+ *
+ * The builds share one scratch buffer, sub-allocated per build and kept for the next batches.
+ * Bottom-level builds are recorded before top-level builds, so a batch may hold both.
+ *
+ * Structures built with VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR are compacted
+ * with a second submission. Compaction moves them, so instance buffers must be written with their
+ * device address after the batch compacting them.
+ */
+class AccelerationStructureBuilder
+{
+  public:
+	/**
+	 * @brief Numbers of the last batch
+	 */
+	struct Stats
+	{
+		uint32_t build_count{0};
+
+		uint32_t refit_count{0};
+
+		uint32_t compaction_count{0};
+
+		/// Size of the scratch memory shared by the builds
+		VkDeviceSize scratch_size{0};
+
+		/// Storage size of the compacted structures before compaction
+		VkDeviceSize uncompacted_size{0};
+
+		/// Storage size of the compacted structures after compaction
+		VkDeviceSize compacted_size{0};
+
+		/// Time from the start of the recording to the end of the batch on the device, in milliseconds
+		double build_time{0.0};
+	};
+
+	AccelerationStructureBuilder(Device &device);
+
+	/**
+	 * @brief Adds a full build of an acceleration structure to the batch
+	 * @param acceleration_structure Structure with at least one geometry, which must outlive the batch
+	 * @param flags Build flags
+	 */
+	void add_build(AccelerationStructure &acceleration_structure, VkBuildAccelerationStructureFlagsKHR flags = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR);
+
+	/**
+	 * @brief Adds an update of an acceleration structure to the batch, refitting it to its moved geometry
+	 *        A structure not built with VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR is rebuilt instead
+	 * @param acceleration_structure Structure with the same geometries as its last build
+	 */
+	void add_refit(AccelerationStructure &acceleration_structure);
+
+	/**
+	 * @brief Records the batch, submits it and waits for it to complete
+	 * @param queue Queue supporting compute to use for the builds
+	 * @return The stats of the batch
+	 */
+	const Stats &build(VkQueue queue);
+
+	const Stats &get_stats() const;
+
+  private:
+	struct Request
+	{
+		AccelerationStructure *acceleration_structure;
+
+		VkBuildAccelerationStructureFlagsKHR flags;
+
+		VkBuildAccelerationStructureModeKHR mode;
+
+		VkDeviceSize scratch_offset;
+	};
+
+	void record_compaction_queries(VkCommandBuffer command_buffer, const std::vector<AccelerationStructure *> &compacted);
+
+	Device &device;
+
+	/// Alignment of the scratch address of each build
+	VkDeviceSize scratch_alignment{256};
+
+	std::vector<Request> requests;
+
+	std::unique_ptr<ScratchBuffer> scratch_buffer;
+
+	std::unique_ptr<QueryPool> query_pool;
+
+	uint32_t query_count{0};
+
+	Stats stats;
+};
+}        // namespace core
+}        // namespace vkb
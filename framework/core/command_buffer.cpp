@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2022, Arm Limited and Contributors
+/* Copyright (c) 2019-2023, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -29,6 +29,92 @@ VKBP_ENABLE_WARNINGS()
 
 namespace vkb
 {
+namespace
+{
+/**
+ * @brief The subresource range of an image view, covering both aspects of depth stencil images as barriers must
+ */
+VkImageSubresourceRange get_barrier_subresource_range(const core::ImageView &image_view)
+{
+	auto subresource_range = image_view.get_subresource_range();
+	auto format            = image_view.get_format();
+	if (is_depth_only_format(format))
+	{
+		subresource_range.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+	}
+	else if (is_depth_stencil_format(format))
+	{
+		subresource_range.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+	}
+
+	return subresource_range;
+}
+
+/**
+ * @brief Fills the buffer info of a bound resource
+ * @return False if the resource isn't a buffer matching the descriptor type
+ */
+bool get_buffer_info(const ResourceInfo &resource_info, VkDescriptorType descriptor_type, VkDescriptorBufferInfo &buffer_info)
+{
+	if (resource_info.buffer == nullptr || !is_buffer_descriptor_type(descriptor_type))
+	{
+		return false;
+	}
+
+	buffer_info.buffer = resource_info.buffer->get_handle();
+	buffer_info.offset = resource_info.offset;
+	buffer_info.range  = resource_info.range;
+
+	return true;
+}
+
+/**
+ * @brief Fills the image info of a bound resource, with the layout expected by the descriptor type
+ * @return False if the resource has no image or the descriptor type doesn't take one
+ */
+bool get_image_info(const ResourceInfo &resource_info, VkDescriptorType descriptor_type, VkDescriptorImageInfo &image_info)
+{
+	auto &sampler    = resource_info.sampler;
+	auto &image_view = resource_info.image_view;
+
+	// Array elements below the highest bound element may be unbound
+	if (image_view == nullptr)
+	{
+		return false;
+	}
+
+	// Sampler can be null for input attachments
+	image_info.sampler   = sampler ? sampler->get_handle() : VK_NULL_HANDLE;
+	image_info.imageView = image_view->get_handle();
+
+	// Add image layout info based on descriptor type
+	switch (descriptor_type)
+	{
+		case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+			image_info.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+			break;
+		case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
+			if (is_depth_stencil_format(image_view->get_format()))
+			{
+				image_info.imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+			}
+			else
+			{
+				image_info.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+			}
+			break;
+		case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+			image_info.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+			break;
+
+		default:
+			return false;
+	}
+
+	return true;
+}
+}        // namespace
+
 CommandBuffer::CommandBuffer(CommandPool &command_pool, VkCommandBufferLevel level) :
     VulkanResource{VK_NULL_HANDLE, &command_pool.get_device()},
     command_pool{command_pool},
@@ -73,6 +159,11 @@ bool CommandBuffer::is_recording() const
 	return state == State::Recording;
 }
 
+CommandBuffer::ResetMode CommandBuffer::get_reset_mode() const
+{
+	return command_pool.get_reset_mode();
+}
+
 void CommandBuffer::clear(VkClearAttachment attachment, VkClearRect rect)
 {
 	vkCmdClearAttachments(handle, 1, &attachment, 1, &rect);
@@ -104,9 +195,12 @@ VkResult CommandBuffer::begin(VkCommandBufferUsageFlags flags, const RenderPass
 
 	// Reset state
 	pipeline_state.reset();
+	pipeline_state.set_extended_dynamic_state(get_device().get_extended_dynamic_state());
+	reset_bindings();
 	resource_binding_state.reset();
 	descriptor_set_layout_binding_state.clear();
 	stored_push_constants.clear();
+	stats = {};
 
 	VkCommandBufferBeginInfo       begin_info{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
 	VkCommandBufferInheritanceInfo inheritance = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO};
@@ -142,6 +236,8 @@ VkResult CommandBuffer::end()
 
 	state = State::Executable;
 
+	get_device().add_command_buffer_stats(stats);
+
 	return VK_SUCCESS;
 }
 
@@ -149,6 +245,11 @@ void CommandBuffer::flush(VkPipelineBindPoint pipeline_bind_point)
 {
 	flush_pipeline_state(pipeline_bind_point);
 
+	if (pipeline_bind_point == VK_PIPELINE_BIND_POINT_GRAPHICS)
+	{
+		flush_dynamic_state();
+	}
+
 	flush_push_constants();
 
 	flush_descriptor_state(pipeline_bind_point);
@@ -167,6 +268,19 @@ void CommandBuffer::begin_render_pass(const RenderTarget &render_target, const s
 	begin_render_pass(render_target, render_pass, framebuffer, clear_values, contents);
 }
 
+void CommandBuffer::begin_render_pass(const RenderTarget &render_target, const std::vector<LoadStoreInfo> &load_store_infos, const std::vector<VkClearValue> &clear_values, const std::vector<Subpass *> &subpasses, VkSubpassContents contents)
+{
+	// Reset state
+	pipeline_state.reset();
+	resource_binding_state.reset();
+	descriptor_set_layout_binding_state.clear();
+
+	auto &render_pass = get_render_pass(render_target, load_store_infos, subpasses);
+	auto &framebuffer = get_device().get_resource_cache().request_framebuffer(render_target, render_pass);
+
+	begin_render_pass(render_target, render_pass, framebuffer, clear_values, contents);
+}
+
 void CommandBuffer::begin_render_pass(const RenderTarget &render_target, const RenderPass &render_pass, const Framebuffer &framebuffer, const std::vector<VkClearValue> &clear_values, VkSubpassContents contents)
 {
 	current_render_pass.render_pass = &render_pass;
@@ -227,6 +341,9 @@ void CommandBuffer::next_subpass()
 void CommandBuffer::execute_commands(CommandBuffer &secondary_command_buffer)
 {
 	vkCmdExecuteCommands(get_handle(), 1, &secondary_command_buffer.get_handle());
+
+	// Executed commands leave the bound state undefined
+	reset_bindings();
 }
 
 void CommandBuffer::execute_commands(std::vector<CommandBuffer *> &secondary_command_buffers)
@@ -235,6 +352,9 @@ void CommandBuffer::execute_commands(std::vector<CommandBuffer *> &secondary_com
 	std::transform(secondary_command_buffers.begin(), secondary_command_buffers.end(), sec_cmd_buf_handles.begin(),
 	               [](const vkb::CommandBuffer *sec_cmd_buf) { return sec_cmd_buf->get_handle(); });
 	vkCmdExecuteCommands(get_handle(), to_u32(sec_cmd_buf_handles.size()), sec_cmd_buf_handles.data());
+
+	// Executed commands leave the bound state undefined
+	reset_bindings();
 }
 
 void CommandBuffer::end_render_pass()
@@ -244,7 +364,20 @@ void CommandBuffer::end_render_pass()
 
 void CommandBuffer::bind_pipeline_layout(PipelineLayout &pipeline_layout)
 {
-	pipeline_state.set_pipeline_layout(pipeline_layout);
+	auto render_frame = command_pool.get_render_frame();
+
+	// Swap in the variant of the layout whose most frequently updated set is pushed, if the device supports it
+	if (render_frame &&
+	    render_frame->get_descriptor_management_strategy() == DescriptorManagementStrategy::PushDescriptors &&
+	    get_device().get_max_push_descriptors() > 0 &&
+	    !pipeline_layout.uses_push_descriptors())
+	{
+		pipeline_state.set_pipeline_layout(get_device().get_resource_cache().request_pipeline_layout(pipeline_layout.get_shader_modules(), true));
+	}
+	else
+	{
+		pipeline_state.set_pipeline_layout(pipeline_layout);
+	}
 }
 
 void CommandBuffer::set_specialization_constant(uint32_t constant_id, const std::vector<uint8_t> &data)
@@ -289,15 +422,54 @@ void CommandBuffer::bind_input(const core::ImageView &image_view, uint32_t set,
 
 void CommandBuffer::bind_vertex_buffers(uint32_t first_binding, const std::vector<std::reference_wrapper<const vkb::core::Buffer>> &buffers, const std::vector<VkDeviceSize> &offsets)
 {
+	if (vertex_buffer_bindings.size() < first_binding + buffers.size())
+	{
+		vertex_buffer_bindings.resize(first_binding + buffers.size());
+	}
+
+	// Only record the bind if any of the buffers or offsets differ from the bound ones
+	bool changed = false;
+
+	for (size_t i = 0; i < buffers.size(); ++i)
+	{
+		auto &binding = vertex_buffer_bindings[first_binding + i];
+
+		if (binding.buffer != buffers[i].get().get_handle() || binding.offset != offsets[i])
+		{
+			binding.buffer = buffers[i].get().get_handle();
+			binding.offset = offsets[i];
+
+			changed = true;
+		}
+	}
+
+	if (!changed)
+	{
+		stats.binds_skipped++;
+		return;
+	}
+
 	std::vector<VkBuffer> buffer_handles(buffers.size(), VK_NULL_HANDLE);
 	std::transform(buffers.begin(), buffers.end(), buffer_handles.begin(),
 	               [](const core::Buffer &buffer) { return buffer.get_handle(); });
 	vkCmdBindVertexBuffers(get_handle(), first_binding, to_u32(buffer_handles.size()), buffer_handles.data(), offsets.data());
+
+	stats.binds_issued++;
 }
 
 void CommandBuffer::bind_index_buffer(const core::Buffer &buffer, VkDeviceSize offset, VkIndexType index_type)
 {
+	if (index_buffer_binding.buffer == buffer.get_handle() && index_buffer_binding.offset == offset && index_buffer_binding.index_type == index_type)
+	{
+		stats.binds_skipped++;
+		return;
+	}
+
 	vkCmdBindIndexBuffer(get_handle(), buffer.get_handle(), offset, index_type);
+
+	index_buffer_binding = {buffer.get_handle(), offset, index_type};
+
+	stats.binds_issued++;
 }
 
 void CommandBuffer::bind_lighting(LightingState &lighting_state, uint32_t set, uint32_t binding)
@@ -344,6 +516,11 @@ void CommandBuffer::set_color_blend_state(const ColorBlendState &state_info)
 	pipeline_state.set_color_blend_state(state_info);
 }
 
+void CommandBuffer::set_tessellation_state(const TessellationState &state_info)
+{
+	pipeline_state.set_tessellation_state(state_info);
+}
+
 void CommandBuffer::set_viewport(uint32_t first_viewport, const std::vector<VkViewport> &viewports)
 {
 	vkCmdSetViewport(get_handle(), first_viewport, to_u32(viewports.size()), viewports.data());
@@ -379,6 +556,8 @@ void CommandBuffer::draw(uint32_t vertex_count, uint32_t instance_count, uint32_
 	flush(VK_PIPELINE_BIND_POINT_GRAPHICS);
 
 	vkCmdDraw(get_handle(), vertex_count, instance_count, first_vertex, first_instance);
+
+	stats.draws++;
 }
 
 void CommandBuffer::draw_indexed(uint32_t index_count, uint32_t instance_count, uint32_t first_index, int32_t vertex_offset, uint32_t first_instance)
@@ -386,6 +565,8 @@ void CommandBuffer::draw_indexed(uint32_t index_count, uint32_t instance_count,
 	flush(VK_PIPELINE_BIND_POINT_GRAPHICS);
 
 	vkCmdDrawIndexed(get_handle(), index_count, instance_count, first_index, vertex_offset, first_instance);
+
+	stats.draws++;
 }
 
 void CommandBuffer::draw_indexed_indirect(const core::Buffer &buffer, VkDeviceSize offset, uint32_t draw_count, uint32_t stride)
@@ -393,6 +574,8 @@ void CommandBuffer::draw_indexed_indirect(const core::Buffer &buffer, VkDeviceSi
 	flush(VK_PIPELINE_BIND_POINT_GRAPHICS);
 
 	vkCmdDrawIndexedIndirect(get_handle(), buffer.get_handle(), offset, draw_count, stride);
+
+	stats.draws++;
 }
 
 void CommandBuffer::dispatch(uint32_t group_count_x, uint32_t group_count_y, uint32_t group_count_z)
@@ -400,6 +583,8 @@ void CommandBuffer::dispatch(uint32_t group_count_x, uint32_t group_count_y, uin
 	flush(VK_PIPELINE_BIND_POINT_COMPUTE);
 
 	vkCmdDispatch(get_handle(), group_count_x, group_count_y, group_count_z);
+
+	stats.dispatches++;
 }
 
 void CommandBuffer::dispatch_indirect(const core::Buffer &buffer, VkDeviceSize offset)
@@ -407,6 +592,8 @@ void CommandBuffer::dispatch_indirect(const core::Buffer &buffer, VkDeviceSize o
 	flush(VK_PIPELINE_BIND_POINT_COMPUTE);
 
 	vkCmdDispatchIndirect(get_handle(), buffer.get_handle(), offset);
+
+	stats.dispatches++;
 }
 
 void CommandBuffer::update_buffer(const core::Buffer &buffer, VkDeviceSize offset, const std::vector<uint8_t> &data)
@@ -455,19 +642,9 @@ void CommandBuffer::copy_image_to_buffer(const core::Image &image, VkImageLayout
 	                       buffer.get_handle(), to_u32(regions.size()), regions.data());
 }
 
-void CommandBuffer::image_memory_barrier(const core::ImageView &image_view, const ImageMemoryBarrier &memory_barrier) const
+void CommandBuffer::image_memory_barrier(const core::ImageView &image_view, const ImageMemoryBarrier &memory_barrier)
 {
-	// Adjust barrier's subresource range for depth images
-	auto subresource_range = image_view.get_subresource_range();
-	auto format            = image_view.get_format();
-	if (is_depth_only_format(format))
-	{
-		subresource_range.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
-	}
-	else if (is_depth_stencil_format(format))
-	{
-		subresource_range.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
-	}
+	auto subresource_range = get_barrier_subresource_range(image_view);
 
 	VkImageMemoryBarrier image_memory_barrier{VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
 	image_memory_barrier.oldLayout           = memory_barrier.old_layout;
@@ -491,6 +668,57 @@ void CommandBuffer::image_memory_barrier(const core::ImageView &image_view, cons
 	    0, nullptr,
 	    1,
 	    &image_memory_barrier);
+
+	stats.barriers_issued++;
+
+	// Later barriers computed from the state of the image start from this one
+	image_view.get_image().set_usage(subresource_range, {memory_barrier.new_layout, dst_stage_mask, memory_barrier.dst_access_mask});
+}
+
+void CommandBuffer::image_usage_barrier(const core::ImageView &image_view, const ImageUsage &usage)
+{
+	image_usage_barriers({{&image_view, usage}});
+}
+
+void CommandBuffer::image_usage_barriers(const std::vector<ImageViewUsage> &image_view_usages)
+{
+	std::vector<VkImageMemoryBarrier> image_memory_barriers;
+
+	VkPipelineStageFlags src_stage_mask = 0;
+	VkPipelineStageFlags dst_stage_mask = 0;
+
+	for (auto &image_view_usage : image_view_usages)
+	{
+		auto &image_view = *image_view_usage.image_view;
+
+		auto wait_stages = image_view.get_image().transition(get_barrier_subresource_range(image_view), image_view_usage.usage, image_memory_barriers);
+		if (wait_stages == 0)
+		{
+			stats.barriers_skipped++;
+			continue;
+		}
+
+		src_stage_mask |= wait_stages;
+		dst_stage_mask |= image_view_usage.usage.stage_mask;
+	}
+
+	if (image_memory_barriers.empty())
+	{
+		return;
+	}
+
+	// Without synchronization2 the stage masks are shared by all barriers of the command
+	vkCmdPipelineBarrier(
+	    get_handle(),
+	    src_stage_mask,
+	    dst_stage_mask,
+	    0,
+	    0, nullptr,
+	    0, nullptr,
+	    to_u32(image_memory_barriers.size()),
+	    image_memory_barriers.data());
+
+	stats.barriers_issued += to_u32(image_memory_barriers.size());
 }
 
 void CommandBuffer::buffer_memory_barrier(const core::Buffer &buffer, VkDeviceSize offset, VkDeviceSize size, const BufferMemoryBarrier &memory_barrier)
@@ -513,6 +741,22 @@ void CommandBuffer::buffer_memory_barrier(const core::Buffer &buffer, VkDeviceSi
 	    0, nullptr,
 	    1, &buffer_memory_barrier,
 	    0, nullptr);
+
+	stats.barriers_issued++;
+}
+
+void CommandBuffer::reset_bindings()
+{
+	dynamic_state_binding   = {};
+	bound_graphics_pipeline = VK_NULL_HANDLE;
+	bound_compute_pipeline  = VK_NULL_HANDLE;
+	index_buffer_binding    = {};
+	pushed_constants_layout = VK_NULL_HANDLE;
+
+	descriptor_set_bindings.clear();
+	pushed_descriptor_set_layouts.clear();
+	vertex_buffer_bindings.clear();
+	pushed_constants.clear();
 }
 
 void CommandBuffer::flush_pipeline_state(VkPipelineBindPoint pipeline_bind_point)
@@ -531,22 +775,100 @@ void CommandBuffer::flush_pipeline_state(VkPipelineBindPoint pipeline_bind_point
 		pipeline_state.set_render_pass(*current_render_pass.render_pass);
 		auto &pipeline = get_device().get_resource_cache().request_graphics_pipeline(pipeline_state);
 
+		// Dirty state can still resolve to the pipeline already bound
+		if (bound_graphics_pipeline == pipeline.get_handle())
+		{
+			stats.binds_skipped++;
+			return;
+		}
+
 		vkCmdBindPipeline(get_handle(),
 		                  pipeline_bind_point,
 		                  pipeline.get_handle());
+
+		bound_graphics_pipeline = pipeline.get_handle();
 	}
 	else if (pipeline_bind_point == VK_PIPELINE_BIND_POINT_COMPUTE)
 	{
 		auto &pipeline = get_device().get_resource_cache().request_compute_pipeline(pipeline_state);
 
+		if (bound_compute_pipeline == pipeline.get_handle())
+		{
+			stats.binds_skipped++;
+			return;
+		}
+
 		vkCmdBindPipeline(get_handle(),
 		                  pipeline_bind_point,
 		                  pipeline.get_handle());
+
+		bound_compute_pipeline = pipeline.get_handle();
 	}
 	else
 	{
 		throw "Only graphics and compute pipeline bind points are supported now";
 	}
+
+	stats.binds_issued++;
+}
+
+void CommandBuffer::flush_dynamic_state()
+{
+	const auto &extended_dynamic_state = pipeline_state.get_extended_dynamic_state();
+
+	if (extended_dynamic_state.extended_dynamic_state)
+	{
+		const auto &rasterization_state  = pipeline_state.get_rasterization_state();
+		const auto &input_assembly_state = pipeline_state.get_input_assembly_state();
+		const auto &depth_stencil_state  = pipeline_state.get_depth_stencil_state();
+
+		if (dynamic_state_binding.cull_mode != rasterization_state.cull_mode)
+		{
+			vkCmdSetCullModeEXT(get_handle(), rasterization_state.cull_mode);
+			dynamic_state_binding.cull_mode = rasterization_state.cull_mode;
+		}
+
+		if (dynamic_state_binding.front_face != rasterization_state.front_face)
+		{
+			vkCmdSetFrontFaceEXT(get_handle(), rasterization_state.front_face);
+			dynamic_state_binding.front_face = rasterization_state.front_face;
+		}
+
+		if (dynamic_state_binding.topology != input_assembly_state.topology)
+		{
+			vkCmdSetPrimitiveTopologyEXT(get_handle(), input_assembly_state.topology);
+			dynamic_state_binding.topology = input_assembly_state.topology;
+		}
+
+		if (dynamic_state_binding.depth_test_enable != depth_stencil_state.depth_test_enable)
+		{
+			vkCmdSetDepthTestEnableEXT(get_handle(), depth_stencil_state.depth_test_enable);
+			dynamic_state_binding.depth_test_enable = depth_stencil_state.depth_test_enable;
+		}
+
+		if (dynamic_state_binding.depth_write_enable != depth_stencil_state.depth_write_enable)
+		{
+			vkCmdSetDepthWriteEnableEXT(get_handle(), depth_stencil_state.depth_write_enable);
+			dynamic_state_binding.depth_write_enable = depth_stencil_state.depth_write_enable;
+		}
+
+		if (dynamic_state_binding.depth_compare_op != depth_stencil_state.depth_compare_op)
+		{
+			vkCmdSetDepthCompareOpEXT(get_handle(), depth_stencil_state.depth_compare_op);
+			dynamic_state_binding.depth_compare_op = depth_stencil_state.depth_compare_op;
+		}
+	}
+
+	if (extended_dynamic_state.patch_control_points)
+	{
+		uint32_t patch_control_points = pipeline_state.get_tessellation_state().patch_control_points;
+
+		if (patch_control_points > 0 && dynamic_state_binding.patch_control_points != patch_control_points)
+		{
+			vkCmdSetPatchControlPointsEXT(get_handle(), patch_control_points);
+			dynamic_state_binding.patch_control_points = patch_control_points;
+		}
+	}
 }
 
 void CommandBuffer::flush_descriptor_state(VkPipelineBindPoint pipeline_bind_point)
@@ -593,10 +915,16 @@ void CommandBuffer::flush_descriptor_state(VkPipelineBindPoint pipeline_bind_poi
 		resource_binding_state.clear_dirty();
 
 		// Iterate over all of the resource sets bound by the command buffer
-		for (auto &resource_set_it : resource_binding_state.get_resource_sets())
+		const uint32_t bound_sets = resource_binding_state.get_bound_sets();
+
+		for (uint32_t descriptor_set_id = 0; descriptor_set_id < ResourceBindingState::max_sets; ++descriptor_set_id)
 		{
-			uint32_t descriptor_set_id = resource_set_it.first;
-			auto &   resource_set      = resource_set_it.second;
+			if (!(bound_sets & (1u << descriptor_set_id)))
+			{
+				continue;
+			}
+
+			auto &resource_set = resource_binding_state.get_resource_set(descriptor_set_id);
 
 			// Don't update resource set if it's not in the update list OR its state hasn't changed
 			if (!resource_set.is_dirty() && (update_descriptor_sets.find(descriptor_set_id) == update_descriptor_sets.end()))
@@ -604,12 +932,16 @@ void CommandBuffer::flush_descriptor_state(VkPipelineBindPoint pipeline_bind_poi
 				continue;
 			}
 
+			const uint32_t dirty_bindings = resource_set.get_dirty_bindings();
+
 			// Clear dirty flag for resource set
 			resource_binding_state.clear_dirty(descriptor_set_id);
 
 			// Skip resource set if a descriptor set layout doesn't exist for it
 			if (!pipeline_layout.has_descriptor_set_layout(descriptor_set_id))
 			{
+				// The changes were not pushed, so the next push of the set must write all of it
+				pushed_descriptor_set_layouts.erase(descriptor_set_id);
 				continue;
 			}
 
@@ -618,40 +950,81 @@ void CommandBuffer::flush_descriptor_state(VkPipelineBindPoint pipeline_bind_poi
 			// Make descriptor set layout bound for current set
 			descriptor_set_layout_binding_state[descriptor_set_id] = &descriptor_set_layout;
 
+			if (descriptor_set_layout.is_push_descriptor())
+			{
+				// Push descriptors are updated incrementally, so only the changed bindings are written,
+				// unless the set was not pushed yet with this pipeline layout or was disturbed since
+				auto pushed_layout_it = pushed_descriptor_set_layouts.find(descriptor_set_id);
+				bool incremental      = pushed_layout_it != pushed_descriptor_set_layouts.end() &&
+				                        pushed_layout_it->second == pipeline_layout.get_handle() &&
+				                        update_descriptor_sets.find(descriptor_set_id) == update_descriptor_sets.end();
+
+				push_descriptor_set(pipeline_bind_point, pipeline_layout, descriptor_set_layout, resource_set,
+				                    incremental ? dirty_bindings : resource_set.get_bound_bindings());
+
+				stats.binds_issued++;
+
+				// Other pushed sets are disturbed like bound ones, by a pipeline layout they are not compatible with
+				for (auto pushed_it = pushed_descriptor_set_layouts.begin(); pushed_it != pushed_descriptor_set_layouts.end();)
+				{
+					if (pushed_it->second != pipeline_layout.get_handle())
+					{
+						pushed_it = pushed_descriptor_set_layouts.erase(pushed_it);
+					}
+					else
+					{
+						++pushed_it;
+					}
+				}
+
+				pushed_descriptor_set_layouts[descriptor_set_id] = pipeline_layout.get_handle();
+
+				// Pushing replaces the set, and like a bind it may disturb sets bound with another pipeline layout
+				for (auto set_binding_it = descriptor_set_bindings.begin(); set_binding_it != descriptor_set_bindings.end();)
+				{
+					if (set_binding_it->first == descriptor_set_id || set_binding_it->second.pipeline_layout != pipeline_layout.get_handle())
+					{
+						set_binding_it = descriptor_set_bindings.erase(set_binding_it);
+					}
+					else
+					{
+						++set_binding_it;
+					}
+				}
+
+				continue;
+			}
+
 			BindingMap<VkDescriptorBufferInfo> buffer_infos;
 			BindingMap<VkDescriptorImageInfo>  image_infos;
 
 			std::vector<uint32_t> dynamic_offsets;
 
 			// Iterate over all resource bindings
-			for (auto &binding_it : resource_set.get_resource_bindings())
+			const uint32_t bound_bindings = resource_set.get_bound_bindings();
+
+			for (uint32_t binding_index = 0; binding_index < ResourceSet::max_bindings; ++binding_index)
 			{
-				auto  binding_index     = binding_it.first;
-				auto &binding_resources = binding_it.second;
+				if (!(bound_bindings & (1u << binding_index)))
+				{
+					continue;
+				}
 
 				// Check if binding exists in the pipeline layout
 				if (auto binding_info = descriptor_set_layout.get_layout_binding(binding_index))
 				{
+					auto &binding_resources = resource_set.get_binding(binding_index);
+
 					// Iterate over all binding resources
-					for (auto &element_it : binding_resources)
+					for (uint32_t array_element = 0; array_element < binding_resources.get_element_count(); ++array_element)
 					{
-						auto  array_element = element_it.first;
-						auto &resource_info = element_it.second;
+						auto &resource_info = binding_resources.get_element(array_element);
 
-						// Pointer references
-						auto &buffer     = resource_info.buffer;
-						auto &sampler    = resource_info.sampler;
-						auto &image_view = resource_info.image_view;
+						VkDescriptorBufferInfo buffer_info{};
+						VkDescriptorImageInfo  image_info{};
 
-						// Get buffer info
-						if (buffer != nullptr && is_buffer_descriptor_type(binding_info->descriptorType))
+						if (get_buffer_info(resource_info, binding_info->descriptorType, buffer_info))
 						{
-							VkDescriptorBufferInfo buffer_info{};
-
-							buffer_info.buffer = resource_info.buffer->get_handle();
-							buffer_info.offset = resource_info.offset;
-							buffer_info.range  = resource_info.range;
-
 							if (is_dynamic_buffer_descriptor_type(binding_info->descriptorType))
 							{
 								dynamic_offsets.push_back(to_u32(buffer_info.offset));
@@ -661,42 +1034,8 @@ void CommandBuffer::flush_descriptor_state(VkPipelineBindPoint pipeline_bind_poi
 
 							buffer_infos[binding_index][array_element] = buffer_info;
 						}
-
-						// Get image info
-						else if (image_view != nullptr || sampler != nullptr)
+						else if (get_image_info(resource_info, binding_info->descriptorType, image_info))
 						{
-							// Can be null for input attachments
-							VkDescriptorImageInfo image_info{};
-							image_info.sampler   = sampler ? sampler->get_handle() : VK_NULL_HANDLE;
-							image_info.imageView = image_view->get_handle();
-
-							if (image_view != nullptr)
-							{
-								// Add image layout info based on descriptor type
-								switch (binding_info->descriptorType)
-								{
-									case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
-										image_info.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-										break;
-									case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
-										if (is_depth_stencil_format(image_view->get_format()))
-										{
-											image_info.imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
-										}
-										else
-										{
-											image_info.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-										}
-										break;
-									case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
-										image_info.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
-										break;
-
-									default:
-										continue;
-								}
-							}
-
 							image_infos[binding_index][array_element] = image_info;
 						}
 					}
@@ -714,6 +1053,19 @@ void CommandBuffer::flush_descriptor_state(VkPipelineBindPoint pipeline_bind_poi
 			                                                            update_after_bind,
 			                                                            command_pool.get_thread_index());
 
+			// Skip the bind if the same descriptor set is bound with the same layout and dynamic offsets
+			auto bound_set_it = descriptor_set_bindings.find(descriptor_set_id);
+
+			if (bound_set_it != descriptor_set_bindings.end() &&
+			    bound_set_it->second.pipeline_bind_point == pipeline_bind_point &&
+			    bound_set_it->second.pipeline_layout == pipeline_layout.get_handle() &&
+			    bound_set_it->second.descriptor_set == descriptor_set_handle &&
+			    bound_set_it->second.dynamic_offsets == dynamic_offsets)
+			{
+				stats.binds_skipped++;
+				continue;
+			}
+
 			// Bind descriptor set
 			vkCmdBindDescriptorSets(get_handle(),
 			                        pipeline_bind_point,
@@ -722,10 +1074,131 @@ void CommandBuffer::flush_descriptor_state(VkPipelineBindPoint pipeline_bind_poi
 			                        1, &descriptor_set_handle,
 			                        to_u32(dynamic_offsets.size()),
 			                        dynamic_offsets.data());
+
+			stats.binds_issued++;
+
+			// Sets bound with another pipeline layout may have been disturbed, so stop tracking them
+			for (auto set_binding_it = descriptor_set_bindings.begin(); set_binding_it != descriptor_set_bindings.end();)
+			{
+				if (set_binding_it->second.pipeline_layout != pipeline_layout.get_handle())
+				{
+					set_binding_it = descriptor_set_bindings.erase(set_binding_it);
+				}
+				else
+				{
+					++set_binding_it;
+				}
+			}
+
+			// The same goes for pushed sets, and the bound set replaces any set pushed at its index
+			for (auto pushed_it = pushed_descriptor_set_layouts.begin(); pushed_it != pushed_descriptor_set_layouts.end();)
+			{
+				if (pushed_it->first == descriptor_set_id || pushed_it->second != pipeline_layout.get_handle())
+				{
+					pushed_it = pushed_descriptor_set_layouts.erase(pushed_it);
+				}
+				else
+				{
+					++pushed_it;
+				}
+			}
+
+			descriptor_set_bindings[descriptor_set_id] = {pipeline_bind_point, pipeline_layout.get_handle(), descriptor_set_handle, std::move(dynamic_offsets)};
 		}
 	}
 }
 
+void CommandBuffer::push_descriptor_set(VkPipelineBindPoint        pipeline_bind_point,
+                                        const PipelineLayout &     pipeline_layout,
+                                        const DescriptorSetLayout &descriptor_set_layout,
+                                        const ResourceSet &        resource_set,
+                                        uint32_t                   bindings)
+{
+	const uint32_t bound_bindings = resource_set.get_bound_bindings() & bindings;
+
+	// Reserve the infos upfront, so the pointers stored in the writes stay valid
+	size_t element_count = 0;
+
+	for (uint32_t binding_index = 0; binding_index < ResourceSet::max_bindings; ++binding_index)
+	{
+		if (bound_bindings & (1u << binding_index))
+		{
+			element_count += resource_set.get_binding(binding_index).get_element_count();
+		}
+	}
+
+	std::vector<VkDescriptorBufferInfo> buffer_infos;
+	std::vector<VkDescriptorImageInfo>  image_infos;
+	std::vector<VkWriteDescriptorSet>   write_descriptor_sets;
+
+	buffer_infos.reserve(element_count);
+	image_infos.reserve(element_count);
+	write_descriptor_sets.reserve(element_count);
+
+	for (uint32_t binding_index = 0; binding_index < ResourceSet::max_bindings; ++binding_index)
+	{
+		if (!(bound_bindings & (1u << binding_index)))
+		{
+			continue;
+		}
+
+		auto binding_info = descriptor_set_layout.get_layout_binding(binding_index);
+
+		if (!binding_info)
+		{
+			continue;
+		}
+
+		auto &binding_resources = resource_set.get_binding(binding_index);
+
+		for (uint32_t array_element = 0; array_element < binding_resources.get_element_count(); ++array_element)
+		{
+			auto &resource_info = binding_resources.get_element(array_element);
+
+			VkWriteDescriptorSet write_descriptor_set{VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET};
+
+			write_descriptor_set.dstBinding      = binding_index;
+			write_descriptor_set.descriptorType  = binding_info->descriptorType;
+			write_descriptor_set.dstArrayElement = array_element;
+			write_descriptor_set.descriptorCount = 1;
+
+			VkDescriptorBufferInfo buffer_info{};
+			VkDescriptorImageInfo  image_info{};
+
+			if (get_buffer_info(resource_info, binding_info->descriptorType, buffer_info))
+			{
+				buffer_infos.push_back(buffer_info);
+				write_descriptor_set.pBufferInfo = &buffer_infos.back();
+			}
+			else if (get_image_info(resource_info, binding_info->descriptorType, image_info))
+			{
+				image_infos.push_back(image_info);
+				write_descriptor_set.pImageInfo = &image_infos.back();
+			}
+			else
+			{
+				continue;
+			}
+
+			write_descriptor_sets.push_back(write_descriptor_set);
+		}
+	}
+
+	if (write_descriptor_sets.empty())
+	{
+		return;
+	}
+
+	stats.descriptor_writes += to_u32(write_descriptor_sets.size());
+
+	vkCmdPushDescriptorSetKHR(get_handle(),
+	                          pipeline_bind_point,
+	                          pipeline_layout.get_handle(),
+	                          descriptor_set_layout.get_index(),
+	                          to_u32(write_descriptor_sets.size()),
+	                          write_descriptor_sets.data());
+}
+
 void CommandBuffer::flush_push_constants()
 {
 	if (stored_push_constants.empty())
@@ -737,13 +1210,50 @@ void CommandBuffer::flush_push_constants()
 
 	VkShaderStageFlags shader_stage = pipeline_layout.get_push_constant_range_stage(to_u32(stored_push_constants.size()));
 
-	if (shader_stage)
+	if (pushed_constants_layout == pipeline_layout.get_handle() && pushed_constants == stored_push_constants)
+	{
+		stats.binds_skipped++;
+	}
+	else if (shader_stage)
 	{
 		vkCmdPushConstants(get_handle(), pipeline_layout.get_handle(), shader_stage, 0, to_u32(stored_push_constants.size()), stored_push_constants.data());
+
+		pushed_constants_layout = pipeline_layout.get_handle();
+		pushed_constants        = stored_push_constants;
+
+		stats.binds_issued++;
 	}
 	else
 	{
-		LOGW("Push constant range [{}, {}] not found", 0, stored_push_constants.size());
+		// The constants may span the ranges of several stages, like the draw constants of the vertex shader
+		// followed by the material of the fragment shader, so each range is pushed with its own stages
+		uint32_t pushed_size = 0;
+
+		for (auto &push_constant_resource : pipeline_layout.get_resources(ShaderResourceType::PushConstant))
+		{
+			if (push_constant_resource.offset >= stored_push_constants.size())
+			{
+				continue;
+			}
+
+			uint32_t size = std::min(push_constant_resource.size, to_u32(stored_push_constants.size()) - push_constant_resource.offset);
+
+			vkCmdPushConstants(get_handle(), pipeline_layout.get_handle(), push_constant_resource.stages, push_constant_resource.offset, size, stored_push_constants.data() + push_constant_resource.offset);
+
+			pushed_size += size;
+		}
+
+		if (pushed_size > 0)
+		{
+			pushed_constants_layout = pipeline_layout.get_handle();
+			pushed_constants        = stored_push_constants;
+
+			stats.binds_issued++;
+		}
+		else
+		{
+			LOGW("Push constant range [{}, {}] not found", 0, stored_push_constants.size());
+		}
 	}
 
 	stored_push_constants.clear();
@@ -754,6 +1264,11 @@ const CommandBuffer::State CommandBuffer::get_state() const
 	return state;
 }
 
+const CommandBufferStats &CommandBuffer::get_stats() const
+{
+	return stats;
+}
+
 void CommandBuffer::set_update_after_bind(bool update_after_bind_)
 {
 	update_after_bind = update_after_bind_;
@@ -816,13 +1331,21 @@ VkResult CommandBuffer::reset(ResetMode reset_mode)
 }
 
 RenderPass &CommandBuffer::get_render_pass(const vkb::RenderTarget &render_target, const std::vector<LoadStoreInfo> &load_store_infos, const std::vector<std::unique_ptr<Subpass>> &subpasses)
+{
+	std::vector<Subpass *> subpass_pointers(subpasses.size());
+	std::transform(subpasses.begin(), subpasses.end(), subpass_pointers.begin(), [](const std::unique_ptr<Subpass> &subpass) { return subpass.get(); });
+
+	return get_render_pass(render_target, load_store_infos, subpass_pointers);
+}
+
+RenderPass &CommandBuffer::get_render_pass(const vkb::RenderTarget &render_target, const std::vector<LoadStoreInfo> &load_store_infos, const std::vector<Subpass *> &subpasses)
 {
 	// Create render pass
 	assert(subpasses.size() > 0 && "Cannot create a render pass without any subpass");
 
 	std::vector<vkb::SubpassInfo> subpass_infos(subpasses.size());
 	auto                          subpass_info_it = subpass_infos.begin();
-	for (auto &subpass : subpasses)
+	for (auto subpass : subpasses)
 	{
 		subpass_info_it->input_attachments                = subpass->get_input_attachments();
 		subpass_info_it->output_attachments               = subpass->get_output_attachments();
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2022, Arm Limited and Contributors
+/* Copyright (c) 2019-2023, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -35,6 +35,7 @@ namespace vkb
 {
 class CommandPool;
 class DescriptorSet;
+class DescriptorSetLayout;
 class Framebuffer;
 class Pipeline;
 class PipelineLayout;
@@ -43,6 +44,42 @@ class RenderTarget;
 class Subpass;
 struct LightingState;
 
+/**
+ * @brief Counts of the state changes and work recorded into command buffers,
+ *        used to quantify recording overhead
+ */
+struct CommandBufferStats
+{
+	/// Pipeline, descriptor set, vertex/index buffer and push constant binds recorded
+	uint32_t binds_issued{0};
+
+	/// Binds not recorded because they matched the state already bound
+	uint32_t binds_skipped{0};
+
+	uint32_t draws{0};
+
+	uint32_t dispatches{0};
+
+	/// Descriptors written with vkUpdateDescriptorSets or pushed for the descriptor sets of the commands
+	uint32_t descriptor_writes{0};
+
+	/// Image and buffer memory barriers recorded
+	uint32_t barriers_issued{0};
+
+	/// Image usages which needed no barrier, as the state tracked by their image already matched them
+	uint32_t barriers_skipped{0};
+};
+
+/**
+ * @brief An image view and how the commands recorded next use it
+ */
+struct ImageViewUsage
+{
+	const core::ImageView *image_view;
+
+	ImageUsage usage;
+};
+
 /**
  * @brief Helper class to manage and record a command buffer, building and
  *        keeping track of pipeline state and resource bindings
@@ -75,6 +112,52 @@ class CommandBuffer : public core::VulkanResource<VkCommandBuffer, VK_OBJECT_TYP
 		const Framebuffer *framebuffer;
 	};
 
+	/**
+	 * @brief Helper structure used to track the dynamic pipeline state last recorded
+	 */
+	struct DynamicStateBinding
+	{
+		VkCullModeFlags cull_mode{VK_CULL_MODE_FLAG_BITS_MAX_ENUM};
+
+		VkFrontFace front_face{VK_FRONT_FACE_MAX_ENUM};
+
+		VkPrimitiveTopology topology{VK_PRIMITIVE_TOPOLOGY_MAX_ENUM};
+
+		VkBool32 depth_test_enable{~0U};
+
+		VkBool32 depth_write_enable{~0U};
+
+		VkCompareOp depth_compare_op{VK_COMPARE_OP_MAX_ENUM};
+
+		uint32_t patch_control_points{0};
+	};
+
+	/**
+	 * @brief Helper structure used to track a bound descriptor set
+	 */
+	struct DescriptorSetBinding
+	{
+		VkPipelineBindPoint pipeline_bind_point;
+
+		VkPipelineLayout pipeline_layout;
+
+		VkDescriptorSet descriptor_set;
+
+		std::vector<uint32_t> dynamic_offsets;
+	};
+
+	/**
+	 * @brief Helper structure used to track a bound vertex or index buffer
+	 */
+	struct BufferBinding
+	{
+		VkBuffer buffer{VK_NULL_HANDLE};
+
+		VkDeviceSize offset{0};
+
+		VkIndexType index_type{VK_INDEX_TYPE_MAX_ENUM};
+	};
+
 	CommandBuffer(CommandPool &command_pool, VkCommandBufferLevel level);
 
 	CommandBuffer(const CommandBuffer &) = delete;
@@ -89,6 +172,11 @@ class CommandBuffer : public core::VulkanResource<VkCommandBuffer, VK_OBJECT_TYP
 
 	bool is_recording() const;
 
+	/**
+	 * @return The reset mode of the pool the command buffer was allocated from
+	 */
+	CommandBuffer::ResetMode get_reset_mode() const;
+
 	/**
 	 * @brief Flushes the command buffer, pushing the new changes
 	 * @param pipeline_bind_point The type of pipeline we want to flush
@@ -123,6 +211,11 @@ class CommandBuffer : public core::VulkanResource<VkCommandBuffer, VK_OBJECT_TYP
 
 	void begin_render_pass(const RenderTarget &render_target, const std::vector<LoadStoreInfo> &load_store_infos, const std::vector<VkClearValue> &clear_values, const std::vector<std::unique_ptr<Subpass>> &subpasses, VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE);
 
+	/**
+	 * @brief Begins a render pass made of subpasses owned elsewhere, e.g. by several render pipelines
+	 */
+	void begin_render_pass(const RenderTarget &render_target, const std::vector<LoadStoreInfo> &load_store_infos, const std::vector<VkClearValue> &clear_values, const std::vector<Subpass *> &subpasses, VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE);
+
 	void begin_render_pass(const RenderTarget &render_target, const RenderPass &render_pass, const Framebuffer &framebuffer, const std::vector<VkClearValue> &clear_values, VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE);
 
 	void next_subpass();
@@ -190,6 +283,8 @@ class CommandBuffer : public core::VulkanResource<VkCommandBuffer, VK_OBJECT_TYP
 
 	void set_color_blend_state(const ColorBlendState &state_info);
 
+	void set_tessellation_state(const TessellationState &state_info);
+
 	void set_viewport(uint32_t first_viewport, const std::vector<VkViewport> &viewports);
 
 	void set_scissor(uint32_t first_scissor, const std::vector<VkRect2D> &scissors);
@@ -226,12 +321,36 @@ class CommandBuffer : public core::VulkanResource<VkCommandBuffer, VK_OBJECT_TYP
 
 	void copy_image_to_buffer(const core::Image &image, VkImageLayout image_layout, const core::Buffer &buffer, const std::vector<VkBufferImageCopy> &regions);
 
-	void image_memory_barrier(const core::ImageView &image_view, const ImageMemoryBarrier &memory_barrier) const;
+	/**
+	 * @brief Records a barrier from the given state, which the image of the view tracks as its new usage
+	 */
+	void image_memory_barrier(const core::ImageView &image_view, const ImageMemoryBarrier &memory_barrier);
+
+	/**
+	 * @brief Records the barrier making an image view ready for a new usage, computed from the state its image tracks
+	 * @param image_view The image view, whose subresources are transitioned
+	 * @param usage The layout, stages and accesses of the commands recorded next
+	 */
+	void image_usage_barrier(const core::ImageView &image_view, const ImageUsage &usage);
+
+	/**
+	 * @brief Records the barriers making image views ready for new usages, computed from the states their images track
+	 *
+	 * Views already in the layout of their usage, with their last write visible to it, are skipped.
+	 * The barriers of the others are recorded with a single vkCmdPipelineBarrier.
+	 * @param image_view_usages The image views and how the commands recorded next use them
+	 */
+	void image_usage_barriers(const std::vector<ImageViewUsage> &image_view_usages);
 
 	void buffer_memory_barrier(const core::Buffer &buffer, VkDeviceSize offset, VkDeviceSize size, const BufferMemoryBarrier &memory_barrier);
 
 	const State get_state() const;
 
+	/**
+	 * @return The binds, draws and dispatches counted since the command buffer began recording
+	 */
+	const CommandBufferStats &get_stats() const;
+
 	void set_update_after_bind(bool update_after_bind_);
 
 	void reset_query_pool(const QueryPool &query_pool, uint32_t first_query, uint32_t query_count);
@@ -250,6 +369,8 @@ class CommandBuffer : public core::VulkanResource<VkCommandBuffer, VK_OBJECT_TYP
 
 	RenderPass &get_render_pass(const vkb::RenderTarget &render_target, const std::vector<LoadStoreInfo> &load_store_infos, const std::vector<std::unique_ptr<Subpass>> &subpasses);
 
+	RenderPass &get_render_pass(const vkb::RenderTarget &render_target, const std::vector<LoadStoreInfo> &load_store_infos, const std::vector<Subpass *> &subpasses);
+
 	const VkCommandBufferLevel level;
 
   private:
@@ -261,6 +382,27 @@ class CommandBuffer : public core::VulkanResource<VkCommandBuffer, VK_OBJECT_TYP
 
 	PipelineState pipeline_state;
 
+	DynamicStateBinding dynamic_state_binding;
+
+	VkPipeline bound_graphics_pipeline{VK_NULL_HANDLE};
+
+	VkPipeline bound_compute_pipeline{VK_NULL_HANDLE};
+
+	std::unordered_map<uint32_t, DescriptorSetBinding> descriptor_set_bindings;
+
+	/// The pipeline layout each push descriptor set was last pushed with, while its descriptors stay valid
+	std::unordered_map<uint32_t, VkPipelineLayout> pushed_descriptor_set_layouts;
+
+	std::vector<BufferBinding> vertex_buffer_bindings;
+
+	BufferBinding index_buffer_binding;
+
+	VkPipelineLayout pushed_constants_layout{VK_NULL_HANDLE};
+
+	std::vector<uint8_t> pushed_constants;
+
+	CommandBufferStats stats;
+
 	ResourceBindingState resource_binding_state;
 
 	std::vector<uint8_t> stored_push_constants;
@@ -286,11 +428,21 @@ class CommandBuffer : public core::VulkanResource<VkCommandBuffer, VK_OBJECT_TYP
 	 */
 	const bool is_render_size_optimal(const VkExtent2D &extent, const VkRect2D &render_area);
 
+	/**
+	 * @brief Clear the tracked bindings, so that the next binds are recorded
+	 */
+	void reset_bindings();
+
 	/**
 	 * @brief Flush the piplines state
 	 */
 	void flush_pipeline_state(VkPipelineBindPoint pipeline_bind_point);
 
+	/**
+	 * @brief Flush the dynamic pipeline state, recording only the values that changed
+	 */
+	void flush_dynamic_state();
+
 	/**
 	 * @brief Flush the descriptor set state
 	 */
@@ -300,6 +452,16 @@ class CommandBuffer : public core::VulkanResource<VkCommandBuffer, VK_OBJECT_TYP
 	 * @brief Flush the push constant state
 	 */
 	void flush_push_constants();
+
+	/**
+	 * @brief Record the descriptors of a set created with a push descriptor layout
+	 * @param bindings A mask of the bindings to write, the other descriptors keep the values pushed before
+	 */
+	void push_descriptor_set(VkPipelineBindPoint        pipeline_bind_point,
+	                         const PipelineLayout &     pipeline_layout,
+	                         const DescriptorSetLayout &descriptor_set_layout,
+	                         const ResourceSet &        resource_set,
+	                         uint32_t                   bindings);
 };
 
 template <class T>
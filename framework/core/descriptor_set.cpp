@@ -204,6 +204,8 @@ void DescriptorSet::update(const std::vector<uint32_t> &bindings_to_update)
 		                       write_operations.data(),
 		                       0,
 		                       nullptr);
+
+		device.add_descriptor_writes(to_u32(write_operations.size()));
 	}
 
 	// Store the bindings from the write operations that were executed by vkUpdateDescriptorSets (and their hash)
@@ -221,6 +223,8 @@ void DescriptorSet::apply_writes() const
 	                       write_descriptor_sets.data(),
 	                       0,
 	                       nullptr);
+
+	device.add_descriptor_writes(to_u32(write_descriptor_sets.size()));
 }
 
 DescriptorSet::DescriptorSet(DescriptorSet &&other) :
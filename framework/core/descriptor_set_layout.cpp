@@ -97,9 +97,11 @@ inline bool validate_flags(const PhysicalDevice &gpu, const std::vector<VkDescri
 DescriptorSetLayout::DescriptorSetLayout(Device &                           device,
                                          const uint32_t                     set_index,
                                          const std::vector<ShaderModule *> &shader_modules,
-                                         const std::vector<ShaderResource> &resource_set) :
+                                         const std::vector<ShaderResource> &resource_set,
+                                         bool                               push_descriptor) :
     device{device},
     set_index{set_index},
+    push_descriptor{push_descriptor},
     shader_modules{shader_modules}
 {
 	// NOTE: `shader_modules` is passed in mainly for hashing their handles in `request_resource`.
@@ -155,6 +157,11 @@ DescriptorSetLayout::DescriptorSetLayout(Device &                           devi
 	create_info.bindingCount = to_u32(bindings.size());
 	create_info.pBindings    = bindings.data();
 
+	if (push_descriptor)
+	{
+		create_info.flags |= VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR;
+	}
+
 	// Handle update-after-bind extensions
 	if (std::find_if(resource_set.begin(), resource_set.end(),
 	                 [](const ShaderResource &shader_resource) { return shader_resource.mode == ShaderResourceMode::UpdateAfterBind; }) != resource_set.end())
@@ -193,6 +200,7 @@ DescriptorSetLayout::DescriptorSetLayout(DescriptorSetLayout &&other) :
     shader_modules{other.shader_modules},
     handle{other.handle},
     set_index{other.set_index},
+    push_descriptor{other.push_descriptor},
     bindings{std::move(other.bindings)},
     binding_flags{std::move(other.binding_flags)},
     bindings_lookup{std::move(other.bindings_lookup)},
@@ -272,4 +280,8 @@ const std::vector<ShaderModule *> &DescriptorSetLayout::get_shader_modules() con
 	return shader_modules;
 }
 
+bool DescriptorSetLayout::is_push_descriptor() const
+{
+	return push_descriptor;
+}
 }        // namespace vkb
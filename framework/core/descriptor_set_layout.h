@@ -41,11 +41,13 @@ class DescriptorSetLayout
 	 * @param set_index The descriptor set index this layout maps to
 	 * @param shader_modules The shader modules this set layout will be used for
 	 * @param resource_set A grouping of shader resources belonging to the same set
+	 * @param push_descriptor Whether the set is recorded with push descriptors instead of being allocated from a pool
 	 */
 	DescriptorSetLayout(Device &                           device,
 	                    const uint32_t                     set_index,
 	                    const std::vector<ShaderModule *> &shader_modules,
-	                    const std::vector<ShaderResource> &resource_set);
+	                    const std::vector<ShaderResource> &resource_set,
+	                    bool                               push_descriptor = false);
 
 	DescriptorSetLayout(const DescriptorSetLayout &) = delete;
 
@@ -73,6 +75,8 @@ class DescriptorSetLayout
 
 	const std::vector<ShaderModule *> &get_shader_modules() const;
 
+	bool is_push_descriptor() const;
+
   private:
 	Device &device;
 
@@ -80,6 +84,8 @@ class DescriptorSetLayout
 
 	const uint32_t set_index;
 
+	bool push_descriptor{false};
+
 	std::vector<VkDescriptorSetLayoutBinding> bindings;
 
 	std::vector<VkDescriptorBindingFlagsEXT> binding_flags;
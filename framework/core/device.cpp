@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2022, Arm Limited and Contributors
+/* Copyright (c) 2019-2023, Arm Limited and Contributors
  * Copyright (c) 2019-2022, Sascha Willems
  *
  * SPDX-License-Identifier: Apache-2.0
@@ -117,10 +117,76 @@ Device::Device(PhysicalDevice &                       gpu,
 		}
 	}
 
+	// Extended dynamic state allows command buffers to record cull mode, front face, topology, depth state
+	// and patch control points at draw time, so that these no longer multiply the number of pipelines
+	if (gpu.get_instance().is_enabled(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME) &&
+	    is_extension_supported(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME))
+	{
+		auto &extended_dynamic_state_features = gpu.request_extension_features<VkPhysicalDeviceExtendedDynamicStateFeaturesEXT>(VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_FEATURES_EXT);
+
+		if (extended_dynamic_state_features.extendedDynamicState)
+		{
+			enabled_extensions.push_back(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME);
+			supported_extended_dynamic_state.extended_dynamic_state = VK_TRUE;
+			LOGI("Extended dynamic state enabled");
+		}
+
+		if (is_extension_supported(VK_EXT_EXTENDED_DYNAMIC_STATE_2_EXTENSION_NAME) && gpu.get_requested_features().tessellationShader)
+		{
+			auto &extended_dynamic_state_2_features = gpu.request_extension_features<VkPhysicalDeviceExtendedDynamicState2FeaturesEXT>(VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_2_FEATURES_EXT);
+
+			if (extended_dynamic_state_2_features.extendedDynamicState2PatchControlPoints)
+			{
+				enabled_extensions.push_back(VK_EXT_EXTENDED_DYNAMIC_STATE_2_EXTENSION_NAME);
+				supported_extended_dynamic_state.patch_control_points = VK_TRUE;
+				LOGI("Dynamic patch control points enabled");
+			}
+		}
+	}
+
+	extended_dynamic_state = supported_extended_dynamic_state;
+
+	// Push descriptors let command buffers record small descriptor sets directly, without allocating and updating them
+	if (gpu.get_instance().is_enabled(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME) &&
+	    is_extension_supported(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME))
+	{
+		VkPhysicalDevicePushDescriptorPropertiesKHR push_descriptor_properties{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PUSH_DESCRIPTOR_PROPERTIES_KHR};
+		VkPhysicalDeviceProperties2KHR              device_properties{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2_KHR};
+		device_properties.pNext = &push_descriptor_properties;
+		vkGetPhysicalDeviceProperties2KHR(gpu.get_handle(), &device_properties);
+
+		enabled_extensions.push_back(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
+		max_push_descriptors = push_descriptor_properties.maxPushDescriptors;
+		LOGI("Push descriptors enabled");
+	}
+
+	// Present ids and present wait let the render context measure when presented images are displayed
+	bool presents = std::any_of(requested_extensions.begin(), requested_extensions.end(),
+	                            [](auto &extension) { return strcmp(extension.first, VK_KHR_SWAPCHAIN_EXTENSION_NAME) == 0; });
+	if (presents && gpu.get_instance().is_enabled(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME) &&
+	    is_extension_supported(VK_KHR_PRESENT_ID_EXTENSION_NAME) && is_extension_supported(VK_KHR_PRESENT_WAIT_EXTENSION_NAME))
+	{
+		auto &present_id_features   = gpu.request_extension_features<VkPhysicalDevicePresentIdFeaturesKHR>(VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR);
+		auto &present_wait_features = gpu.request_extension_features<VkPhysicalDevicePresentWaitFeaturesKHR>(VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR);
+
+		if (present_id_features.presentId && present_wait_features.presentWait)
+		{
+			enabled_extensions.push_back(VK_KHR_PRESENT_ID_EXTENSION_NAME);
+			enabled_extensions.push_back(VK_KHR_PRESENT_WAIT_EXTENSION_NAME);
+			LOGI("Present wait enabled");
+		}
+	}
+
 	// Check that extensions are supported before trying to create the device
 	std::vector<const char *> unsupported_extensions{};
 	for (auto &extension : requested_extensions)
 	{
+		if (is_enabled(extension.first))
+		{
+			// Already enabled by the device itself
+			continue;
+		}
+
 		if (is_extension_supported(extension.first))
 		{
 			enabled_extensions.emplace_back(extension.first);
@@ -256,6 +322,9 @@ Device::Device(PhysicalDevice &gpu, VkDevice &vulkan_device, VkSurfaceKHR surfac
 
 Device::~Device()
 {
+	// The objects still queued need the device and its allocator
+	deletion_queue.flush();
+
 	resource_cache.clear();
 
 	command_pool.reset();
@@ -711,11 +780,74 @@ VkFence Device::request_fence() const
 
 VkResult Device::wait_idle() const
 {
+	wait_idle_count++;
+
 	return vkDeviceWaitIdle(handle);
 }
 
+uint32_t Device::get_wait_idle_count() const
+{
+	return wait_idle_count;
+}
+
 ResourceCache &Device::get_resource_cache()
 {
 	return resource_cache;
 }
+
+DeletionQueue &Device::get_deletion_queue()
+{
+	return deletion_queue;
+}
+
+void Device::add_command_buffer_stats(const CommandBufferStats &stats)
+{
+	std::lock_guard<std::mutex> lock(command_buffer_stats_mutex);
+
+	command_buffer_stats.binds_issued += stats.binds_issued;
+	command_buffer_stats.binds_skipped += stats.binds_skipped;
+	command_buffer_stats.draws += stats.draws;
+	command_buffer_stats.dispatches += stats.dispatches;
+	command_buffer_stats.descriptor_writes += stats.descriptor_writes;
+	command_buffer_stats.barriers_issued += stats.barriers_issued;
+	command_buffer_stats.barriers_skipped += stats.barriers_skipped;
+}
+
+void Device::add_descriptor_writes(uint32_t count)
+{
+	std::lock_guard<std::mutex> lock(command_buffer_stats_mutex);
+
+	command_buffer_stats.descriptor_writes += count;
+}
+
+CommandBufferStats Device::reset_command_buffer_stats()
+{
+	std::lock_guard<std::mutex> lock(command_buffer_stats_mutex);
+
+	CommandBufferStats stats = command_buffer_stats;
+
+	command_buffer_stats = {};
+
+	return stats;
+}
+
+const ExtendedDynamicState &Device::get_extended_dynamic_state() const
+{
+	return extended_dynamic_state;
+}
+
+const ExtendedDynamicState &Device::get_supported_extended_dynamic_state() const
+{
+	return supported_extended_dynamic_state;
+}
+
+void Device::set_extended_dynamic_state_enabled(bool enable)
+{
+	extended_dynamic_state = enable ? supported_extended_dynamic_state : ExtendedDynamicState{};
+}
+
+uint32_t Device::get_max_push_descriptors() const
+{
+	return max_push_descriptors;
+}
 }        // namespace vkb
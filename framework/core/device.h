@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2022, Arm Limited and Contributors
+/* Copyright (c) 2019-2023, Arm Limited and Contributors
  * Copyright (c) 2019-2022, Sascha Willems
  *
  * SPDX-License-Identifier: Apache-2.0
@@ -18,6 +18,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "common/helpers.h"
 #include "common/logging.h"
 #include "common/vk_common.h"
@@ -36,6 +38,7 @@
 #include "core/shader_module.h"
 #include "core/swapchain.h"
 #include "core/vulkan_resource.h"
+#include "deletion_queue.h"
 #include "fence_pool.h"
 #include "rendering/pipeline_state.h"
 #include "rendering/render_target.h"
@@ -221,10 +224,65 @@ class Device : public core::VulkanResource<VkDevice, VK_OBJECT_TYPE_DEVICE>
 	 */
 	VkFence request_fence() const;
 
+	/**
+	 * @brief Waits for all the queues of the device to idle, which stalls the CPU and the GPU
+	 *        Prefer queueing objects to destroy to the deletion queue
+	 */
 	VkResult wait_idle() const;
 
+	/**
+	 * @return The number of times wait_idle() was called since the device was created
+	 */
+	uint32_t get_wait_idle_count() const;
+
 	ResourceCache &get_resource_cache();
 
+	/**
+	 * @return The queue of objects destroyed once the frames using them completed
+	 */
+	DeletionQueue &get_deletion_queue();
+
+	/**
+	 * @brief Adds the binds, draws and dispatches counted by a command buffer to the totals of this device
+	 * @param stats The counts of a command buffer that finished recording
+	 */
+	void add_command_buffer_stats(const CommandBufferStats &stats);
+
+	/**
+	 * @brief Adds descriptors written to descriptor sets outside of command buffers to the totals of this device
+	 * @param count The number of descriptors written by vkUpdateDescriptorSets
+	 */
+	void add_descriptor_writes(uint32_t count);
+
+	/**
+	 * @brief Returns the totals accumulated since the previous call and starts counting again
+	 * @return The binds, draws and dispatches recorded by all command buffers
+	 */
+	CommandBufferStats reset_command_buffer_stats();
+
+	/**
+	 * @return The pipeline state command buffers record dynamically: what the device supports,
+	 *         unless its use has been disabled
+	 */
+	const ExtendedDynamicState &get_extended_dynamic_state() const;
+
+	/**
+	 * @return The pipeline state this device supports setting dynamically
+	 */
+	const ExtendedDynamicState &get_supported_extended_dynamic_state() const;
+
+	/**
+	 * @brief Enables or disables the use of extended dynamic state by command buffers,
+	 *        which has no effect if the device does not support it
+	 * @param enable Whether supported extended dynamic state should be used
+	 */
+	void set_extended_dynamic_state_enabled(bool enable);
+
+	/**
+	 * @return The maximum number of descriptors in a push descriptor set, or 0 if push descriptors are not supported
+	 */
+	uint32_t get_max_push_descriptors() const;
+
   private:
 	const PhysicalDevice &gpu;
 
@@ -247,5 +305,20 @@ class Device : public core::VulkanResource<VkDevice, VK_OBJECT_TYPE_DEVICE>
 	std::unique_ptr<FencePool> fence_pool;
 
 	ResourceCache resource_cache;
+
+	DeletionQueue deletion_queue;
+
+	ExtendedDynamicState supported_extended_dynamic_state{};
+
+	ExtendedDynamicState extended_dynamic_state{};
+
+	uint32_t max_push_descriptors{0};
+
+	/// Totals of the command buffers that finished recording since the last reset
+	CommandBufferStats command_buffer_stats{};
+
+	std::mutex command_buffer_stats_mutex;
+
+	mutable std::atomic<uint32_t> wait_idle_count{0};
 };
 }        // namespace vkb
@@ -622,10 +622,16 @@ void HPPCommandBuffer::flush_descriptor_state(vk::PipelineBindPoint pipeline_bin
 		resource_binding_state.clear_dirty();
 
 		// Iterate over all of the resource sets bound by the command buffer
-		for (auto &resource_set_it : resource_binding_state.get_resource_sets())
+		const uint32_t bound_sets = resource_binding_state.get_bound_sets();
+
+		for (uint32_t descriptor_set_id = 0; descriptor_set_id < vkb::HPPResourceBindingState::max_sets; ++descriptor_set_id)
 		{
-			uint32_t descriptor_set_id = resource_set_it.first;
-			auto    &resource_set      = resource_set_it.second;
+			if (!(bound_sets & (1u << descriptor_set_id)))
+			{
+				continue;
+			}
+
+			auto &resource_set = resource_binding_state.get_resource_set(descriptor_set_id);
 
 			// Don't update resource set if it's not in the update list OR its state hasn't changed
 			if (!resource_set.is_dirty() && (update_descriptor_sets.find(descriptor_set_id) == update_descriptor_sets.end()))
@@ -653,19 +659,24 @@ void HPPCommandBuffer::flush_descriptor_state(vk::PipelineBindPoint pipeline_bin
 			std::vector<uint32_t> dynamic_offsets;
 
 			// Iterate over all resource bindings
-			for (auto &binding_it : resource_set.get_resource_bindings())
+			const uint32_t bound_bindings = resource_set.get_bound_bindings();
+
+			for (uint32_t binding_index = 0; binding_index < vkb::HPPResourceSet::max_bindings; ++binding_index)
 			{
-				auto  binding_index     = binding_it.first;
-				auto &binding_resources = binding_it.second;
+				if (!(bound_bindings & (1u << binding_index)))
+				{
+					continue;
+				}
 
 				// Check if binding exists in the pipeline layout
 				if (auto binding_info = descriptor_set_layout.get_layout_binding(binding_index))
 				{
+					auto &binding_resources = resource_set.get_binding(binding_index);
+
 					// Iterate over all binding resources
-					for (auto &element_it : binding_resources)
+					for (uint32_t array_element = 0; array_element < binding_resources.get_element_count(); ++array_element)
 					{
-						auto  array_element = element_it.first;
-						auto &resource_info = element_it.second;
+						auto &resource_info = binding_resources.get_element(array_element);
 
 						// Pointer references
 						auto &buffer     = resource_info.buffer;
@@ -686,10 +697,10 @@ void HPPCommandBuffer::flush_descriptor_state(vk::PipelineBindPoint pipeline_bin
 							buffer_infos[binding_index][array_element] = buffer_info;
 						}
 
-						// Get image info
-						else if (image_view != nullptr || sampler != nullptr)
+						// Get image info, array elements below the highest bound element may be unbound
+						else if (image_view != nullptr)
 						{
-							// Can be null for input attachments
+							// Sampler can be null for input attachments
 							vk::DescriptorImageInfo image_info(sampler ? sampler->get_handle() : nullptr, image_view->get_handle());
 
 							if (image_view != nullptr)
@@ -232,6 +232,9 @@ HPPDevice::HPPDevice(vkb::core::HPPPhysicalDevice               &gpu,
 
 HPPDevice::~HPPDevice()
 {
+	// The objects still queued need the device and its allocator
+	deletion_queue.flush();
+
 	resource_cache.clear();
 
 	command_pool.reset();
@@ -22,6 +22,7 @@
 #include <core/hpp_physical_device.h>
 #include <core/hpp_queue.h>
 #include <core/hpp_vulkan_resource.h>
+#include <deletion_queue.h>
 #include <hpp_fence_pool.h>
 #include <hpp_resource_cache.h>
 #include <vulkan/vulkan.hpp>
@@ -149,6 +150,8 @@ class HPPDevice : public vkb::core::HPPVulkanResource<vk::Device>
 	std::unique_ptr<vkb::HPPFencePool> fence_pool;
 
 	vkb::HPPResourceCache resource_cache;
+
+	vkb::DeletionQueue deletion_queue;
 };
 }        // namespace core
 }        // namespace vkb
@@ -70,6 +70,8 @@ HPPImage::HPPImage(HPPDevice              &device,
 	subresource.mipLevel   = mip_levels;
 	subresource.arrayLayer = array_layers;
 
+	subresource_states.resize(mip_levels * array_layers);
+
 	vk::ImageCreateInfo image_info(flags, type, format, extent, mip_levels, array_layers, sample_count, tiling, image_usage);
 
 	if (num_queue_families != 0)
@@ -110,6 +112,8 @@ HPPImage::HPPImage(HPPDevice              &device,
 {
 	subresource.mipLevel   = 1;
 	subresource.arrayLayer = 1;
+
+	subresource_states.resize(1);
 }
 
 HPPImage::HPPImage(HPPImage &&other) :
@@ -124,7 +128,8 @@ HPPImage::HPPImage(HPPImage &&other) :
     subresource(std::exchange(other.subresource, {})),
     views(std::exchange(other.views, {})),
     mapped_data(std::exchange(other.mapped_data, {})),
-    mapped(std::exchange(other.mapped, {}))
+    mapped(std::exchange(other.mapped, {})),
+    subresource_states(std::move(other.subresource_states))
 {
 	// Update image views references to this image to avoid dangling pointers
 	for (auto &view : views)
@@ -18,7 +18,9 @@
 #pragma once
 
 #include "core/hpp_vulkan_resource.h"
+#include <mutex>
 #include <unordered_set>
+#include <vector>
 #include <vk_mem_alloc.h>
 
 namespace vkb
@@ -28,6 +30,19 @@ namespace core
 class HPPDevice;
 class HPPImageView;
 
+/**
+ * @brief facade helper struct mirroring vkb::core::ImageSubresourceState
+ */
+struct HPPImageSubresourceState
+{
+	vk::ImageLayout        layout = vk::ImageLayout::eUndefined;
+	vk::PipelineStageFlags write_stages;
+	vk::AccessFlags        write_access;
+	vk::PipelineStageFlags read_stages;
+	vk::PipelineStageFlags visible_stages;
+	vk::AccessFlags        visible_access;
+};
+
 class HPPImage : public vkb::core::HPPVulkanResource<vk::Image>
 {
   public:
@@ -97,6 +112,8 @@ class HPPImage : public vkb::core::HPPVulkanResource<vk::Image>
 	std::unordered_set<vkb::core::HPPImageView *> views;        /// HPPImage views referring to this image
 	uint8_t                                      *mapped_data = nullptr;
 	bool                                          mapped      = false;        /// Whether it was mapped with vmaMapMemory
+	mutable std::vector<HPPImageSubresourceState> subresource_states;         /// Mirrors vkb::core::Image, which tracks it
+	mutable std::mutex                            subresource_states_mutex;
 };
 }        // namespace core
 }        // namespace vkb
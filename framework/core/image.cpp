@@ -63,6 +63,38 @@ inline VkImageType find_image_type(VkExtent3D extent)
 
 	return result;
 }
+
+/// The accesses which write memory, the others only read it
+constexpr VkAccessFlags write_access_flags = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
+                                             VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_HOST_WRITE_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+
+/**
+ * @brief Whether the barriers of two layers can be merged, which is the case
+ *        when the same mip levels of both are transitioned from the same state
+ */
+inline bool is_same_layer_barriers(const std::vector<VkImageMemoryBarrier> &barriers, size_t previous_layer_begin, size_t layer_begin)
+{
+	if (layer_begin - previous_layer_begin != barriers.size() - layer_begin)
+	{
+		return false;
+	}
+
+	for (size_t i = 0; i < layer_begin - previous_layer_begin; ++i)
+	{
+		auto &previous = barriers[previous_layer_begin + i];
+		auto &current  = barriers[layer_begin + i];
+
+		if (previous.subresourceRange.baseMipLevel != current.subresourceRange.baseMipLevel ||
+		    previous.subresourceRange.levelCount != current.subresourceRange.levelCount ||
+		    previous.oldLayout != current.oldLayout ||
+		    previous.srcAccessMask != current.srcAccessMask)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
 }        // namespace
 
 namespace core
@@ -94,6 +126,8 @@ Image::Image(Device const         &device,
 	subresource.mipLevel   = mip_levels;
 	subresource.arrayLayer = array_layers;
 
+	subresource_states.resize(mip_levels * array_layers);
+
 	VkImageCreateInfo image_info{VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO};
 	image_info.flags       = flags;
 	image_info.imageType   = type;
@@ -141,6 +175,8 @@ Image::Image(Device const &device, VkImage handle, const VkExtent3D &extent, VkF
 {
 	subresource.mipLevel   = 1;
 	subresource.arrayLayer = 1;
+
+	subresource_states.resize(1);
 }
 
 Image::Image(Image &&other) :
@@ -153,9 +189,11 @@ Image::Image(Image &&other) :
     usage{other.usage},
     tiling{other.tiling},
     subresource{other.subresource},
+    array_layer_count{other.array_layer_count},
     views(std::exchange(other.views, {})),
     mapped_data{other.mapped_data},
-    mapped{other.mapped}
+    mapped{other.mapped},
+    subresource_states{std::move(other.subresource_states)}
 {
 	other.memory      = VK_NULL_HANDLE;
 	other.mapped_data = nullptr;
@@ -251,5 +289,167 @@ std::unordered_set<ImageView *> &Image::get_views()
 	return views;
 }
 
+VkImageLayout Image::get_layout(uint32_t mip_level, uint32_t array_layer) const
+{
+	std::lock_guard<std::mutex> lock(subresource_states_mutex);
+
+	return subresource_states[get_state_index(mip_level, array_layer)].layout;
+}
+
+VkPipelineStageFlags Image::transition(const VkImageSubresourceRange &range, const ImageUsage &usage, std::vector<VkImageMemoryBarrier> &barriers) const
+{
+	assert(usage.layout != VK_IMAGE_LAYOUT_UNDEFINED && usage.layout != VK_IMAGE_LAYOUT_PREINITIALIZED && "Images cannot be transitioned to an undefined layout");
+	assert(usage.stage_mask != 0 && "The usage needs at least one stage");
+
+	uint32_t level_end = range.levelCount == VK_REMAINING_MIP_LEVELS ? subresource.mipLevel : range.baseMipLevel + range.levelCount;
+	uint32_t layer_end = range.layerCount == VK_REMAINING_ARRAY_LAYERS ? subresource.arrayLayer : range.baseArrayLayer + range.layerCount;
+
+	VkAccessFlags write_access = usage.access_mask & write_access_flags;
+	VkAccessFlags read_access  = usage.access_mask & ~write_access_flags;
+
+	std::lock_guard<std::mutex> lock(subresource_states_mutex);
+
+	VkPipelineStageFlags src_stage_mask = 0;
+
+	size_t previous_layer_begin = barriers.size();
+
+	for (uint32_t layer = range.baseArrayLayer; layer < layer_end; ++layer)
+	{
+		size_t layer_begin = barriers.size();
+
+		for (uint32_t level = range.baseMipLevel; level < level_end; ++level)
+		{
+			auto &state = subresource_states[get_state_index(level, layer)];
+
+			bool                 layout_change = state.layout != usage.layout;
+			bool                 needs_barrier = false;
+			VkPipelineStageFlags wait_stages   = state.write_stages;
+
+			if (layout_change || write_access)
+			{
+				// Transitions and writes must not overwrite what the previous reads still use
+				wait_stages |= state.read_stages;
+				needs_barrier = layout_change || wait_stages != 0;
+			}
+			else
+			{
+				// Reads only wait if the last write is not visible to them yet
+				needs_barrier = state.write_stages != 0 &&
+				                ((usage.stage_mask & ~state.visible_stages) != 0 || (read_access & ~state.visible_access) != 0);
+			}
+
+			if (needs_barrier)
+			{
+				src_stage_mask |= wait_stages != 0 ? wait_stages : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+
+				// Adjacent mip levels in the same state share a barrier
+				bool extended = false;
+				if (barriers.size() > layer_begin)
+				{
+					auto &previous = barriers.back();
+					if (previous.oldLayout == state.layout && previous.srcAccessMask == state.write_access &&
+					    previous.subresourceRange.baseMipLevel + previous.subresourceRange.levelCount == level)
+					{
+						previous.subresourceRange.levelCount++;
+						extended = true;
+					}
+				}
+
+				if (!extended)
+				{
+					VkImageMemoryBarrier barrier{VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
+					barrier.srcAccessMask       = state.write_access;
+					barrier.dstAccessMask       = usage.access_mask;
+					barrier.oldLayout           = state.layout;
+					barrier.newLayout           = usage.layout;
+					barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+					barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+					barrier.image               = handle;
+					barrier.subresourceRange    = {range.aspectMask, level, 1, layer, 1};
+					barriers.push_back(barrier);
+				}
+			}
+
+			if (write_access)
+			{
+				state.write_stages   = usage.stage_mask;
+				state.write_access   = write_access;
+				state.read_stages    = read_access ? usage.stage_mask : 0;
+				state.visible_stages = 0;
+				state.visible_access = 0;
+			}
+			else if (layout_change)
+			{
+				// The transition is the last write, and the barrier made it visible to the usage
+				state.write_stages   = usage.stage_mask;
+				state.write_access   = 0;
+				state.read_stages    = usage.stage_mask;
+				state.visible_stages = usage.stage_mask;
+				state.visible_access = read_access;
+			}
+			else
+			{
+				state.read_stages |= usage.stage_mask;
+				if (needs_barrier)
+				{
+					state.visible_stages |= usage.stage_mask;
+					state.visible_access |= read_access;
+				}
+			}
+
+			state.layout = usage.layout;
+		}
+
+		// Array layers in the same state share barriers too, as the faces of a cube map usually are
+		if (layer != range.baseArrayLayer && is_same_layer_barriers(barriers, previous_layer_begin, layer_begin))
+		{
+			for (size_t i = previous_layer_begin; i < layer_begin; ++i)
+			{
+				barriers[i].subresourceRange.layerCount++;
+			}
+			barriers.resize(layer_begin);
+		}
+		else
+		{
+			previous_layer_begin = layer_begin;
+		}
+	}
+
+	return src_stage_mask;
+}
+
+void Image::set_usage(const VkImageSubresourceRange &range, const ImageUsage &usage) const
+{
+	uint32_t level_end = range.levelCount == VK_REMAINING_MIP_LEVELS ? subresource.mipLevel : range.baseMipLevel + range.levelCount;
+	uint32_t layer_end = range.layerCount == VK_REMAINING_ARRAY_LAYERS ? subresource.arrayLayer : range.baseArrayLayer + range.layerCount;
+
+	VkAccessFlags write_access = usage.access_mask & write_access_flags;
+
+	std::lock_guard<std::mutex> lock(subresource_states_mutex);
+
+	for (uint32_t layer = range.baseArrayLayer; layer < layer_end; ++layer)
+	{
+		for (uint32_t level = range.baseMipLevel; level < level_end; ++level)
+		{
+			auto &state = subresource_states[get_state_index(level, layer)];
+
+			// Tracked as a barrier to the usage, followed by the accesses of the usage
+			state.layout         = usage.layout;
+			state.write_stages   = usage.stage_mask;
+			state.write_access   = write_access;
+			state.read_stages    = usage.stage_mask;
+			state.visible_stages = write_access ? 0 : usage.stage_mask;
+			state.visible_access = write_access ? 0 : usage.access_mask;
+		}
+	}
+}
+
+uint32_t Image::get_state_index(uint32_t mip_level, uint32_t array_layer) const
+{
+	assert(mip_level < subresource.mipLevel && array_layer < subresource.arrayLayer && "Subresource out of range");
+
+	return array_layer * subresource.mipLevel + mip_level;
+}
+
 }        // namespace core
 }        // namespace vkb
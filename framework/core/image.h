@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2021, Arm Limited and Contributors
+/* Copyright (c) 2019-2023, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -17,7 +17,9 @@
 
 #pragma once
 
+#include <mutex>
 #include <unordered_set>
+#include <vector>
 
 #include "common/helpers.h"
 #include "common/vk_common.h"
@@ -30,6 +32,29 @@ class Device;
 namespace core
 {
 class ImageView;
+
+/**
+ * @brief The synchronization state of one mip level of one array layer of an image,
+ *        as of the commands recorded so far
+ */
+struct ImageSubresourceState
+{
+	VkImageLayout layout{VK_IMAGE_LAYOUT_UNDEFINED};
+
+	/// Stages and accesses of the last write, the next barrier waits for them and makes them available
+	VkPipelineStageFlags write_stages{0};
+
+	VkAccessFlags write_access{0};
+
+	/// Stages which read the subresource since the last write, a write waits for them
+	VkPipelineStageFlags read_stages{0};
+
+	/// Stages and accesses the last write was made visible to, reading with them needs no barrier
+	VkPipelineStageFlags visible_stages{0};
+
+	VkAccessFlags visible_access{0};
+};
+
 class Image : public VulkanResource<VkImage, VK_OBJECT_TYPE_IMAGE, const Device>
 {
   public:
@@ -94,7 +119,37 @@ class Image : public VulkanResource<VkImage, VK_OBJECT_TYPE_IMAGE, const Device>
 
 	std::unordered_set<ImageView *> &get_views();
 
+	/**
+	 * @return The layout a subresource is in after the commands recorded so far
+	 */
+	VkImageLayout get_layout(uint32_t mip_level = 0, uint32_t array_layer = 0) const;
+
+	/**
+	 * @brief Computes the barriers making a subresource range ready for a new usage, and tracks that usage
+	 *
+	 * Subresources already in the layout of the usage, with their last write visible to it, need no barrier.
+	 * Adjacent subresources in the same state share a barrier.
+	 * @param range The subresource range, its aspects are tracked together
+	 * @param usage How the commands recorded after the barriers use the range
+	 * @param barriers The barriers needed, if any, are appended to it
+	 * @return The stages the barriers wait for, 0 if none is needed
+	 */
+	VkPipelineStageFlags transition(const VkImageSubresourceRange &range, const ImageUsage &usage, std::vector<VkImageMemoryBarrier> &barriers) const;
+
+	/**
+	 * @brief Tracks a usage of a subresource range synchronized outside of transition(), e.g. with an ImageMemoryBarrier
+	 *        or by the semaphore of a swapchain image
+	 * @param range The subresource range, its aspects are tracked together
+	 * @param usage The layout of the range, and the stages and accesses which last used it
+	 */
+	void set_usage(const VkImageSubresourceRange &range, const ImageUsage &usage) const;
+
   private:
+	/**
+	 * @return The index of a subresource in subresource_states
+	 */
+	uint32_t get_state_index(uint32_t mip_level, uint32_t array_layer) const;
+
 	VmaAllocation memory{VK_NULL_HANDLE};
 
 	VkImageType type{};
@@ -120,6 +175,13 @@ class Image : public VulkanResource<VkImage, VK_OBJECT_TYPE_IMAGE, const Device>
 
 	/// Whether it was mapped with vmaMapMemory
 	bool mapped{false};
+
+	/// One per mip level of each array layer, updated while commands are recorded rather than when they execute,
+	/// so the command buffers using the image must be submitted in the order they were recorded
+	mutable std::vector<ImageSubresourceState> subresource_states;
+
+	/// Command buffers recorded on several threads may transition the image, their order is then undefined
+	mutable std::mutex subresource_states_mutex;
 };
 }        // namespace core
 }        // namespace vkb
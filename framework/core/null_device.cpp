@@ -0,0 +1,1169 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "null_device.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+#include "common/helpers.h"
+
+namespace vkb
+{
+namespace null_device
+{
+namespace
+{
+// Entry points implemented by the functions below, with their implementation
+#define NULL_DEVICE_FUNCTIONS(X)                                                             \
+	X(vkGetInstanceProcAddr, get_instance_proc_addr)                                         \
+	X(vkGetDeviceProcAddr, get_device_proc_addr)                                             \
+	X(vkEnumerateInstanceVersion, enumerate_instance_version)                                \
+	X(vkEnumerateInstanceExtensionProperties, enumerate_instance_extension_properties)       \
+	X(vkEnumerateInstanceLayerProperties, enumerate_instance_layer_properties)               \
+	X(vkCreateInstance, create_instance)                                                     \
+	X(vkDestroyInstance, destroy_instance)                                                   \
+	X(vkEnumeratePhysicalDevices, enumerate_physical_devices)                                \
+	X(vkGetPhysicalDeviceFeatures, get_physical_device_features)                             \
+	X(vkGetPhysicalDeviceFeatures2, get_physical_device_features2)                           \
+	X(vkGetPhysicalDeviceFeatures2KHR, get_physical_device_features2)                        \
+	X(vkGetPhysicalDeviceProperties, get_physical_device_properties)                         \
+	X(vkGetPhysicalDeviceProperties2, get_physical_device_properties2)                       \
+	X(vkGetPhysicalDeviceProperties2KHR, get_physical_device_properties2)                    \
+	X(vkGetPhysicalDeviceMemoryProperties, get_physical_device_memory_properties)            \
+	X(vkGetPhysicalDeviceQueueFamilyProperties, get_physical_device_queue_family_properties) \
+	X(vkGetPhysicalDeviceFormatProperties, get_physical_device_format_properties)            \
+	X(vkGetPhysicalDeviceImageFormatProperties, get_physical_device_image_format_properties) \
+	X(vkEnumerateDeviceExtensionProperties, enumerate_device_extension_properties)           \
+	X(vkEnumerateDeviceLayerProperties, enumerate_device_layer_properties)                   \
+	X(vkCreateHeadlessSurfaceEXT, create_headless_surface)                                   \
+	X(vkDestroySurfaceKHR, destroy_surface)                                                  \
+	X(vkGetPhysicalDeviceSurfaceSupportKHR, get_physical_device_surface_support)             \
+	X(vkGetPhysicalDeviceSurfaceCapabilitiesKHR, get_physical_device_surface_capabilities)   \
+	X(vkGetPhysicalDeviceSurfaceFormatsKHR, get_physical_device_surface_formats)             \
+	X(vkGetPhysicalDeviceSurfacePresentModesKHR, get_physical_device_surface_present_modes)  \
+	X(vkCreateDevice, create_device)                                                         \
+	X(vkDestroyDevice, destroy_device)                                                       \
+	X(vkGetDeviceQueue, get_device_queue)                                                    \
+	X(vkDeviceWaitIdle, device_wait_idle)                                                    \
+	X(vkQueueSubmit, queue_submit)                                                           \
+	X(vkQueueWaitIdle, queue_wait_idle)                                                      \
+	X(vkQueuePresentKHR, queue_present)                                                      \
+	X(vkCreateSwapchainKHR, create_swapchain)                                                \
+	X(vkDestroySwapchainKHR, destroy_swapchain)                                              \
+	X(vkGetSwapchainImagesKHR, get_swapchain_images)                                         \
+	X(vkAcquireNextImageKHR, acquire_next_image)                                             \
+	X(vkAllocateMemory, allocate_memory)                                                     \
+	X(vkFreeMemory, free_memory)                                                             \
+	X(vkMapMemory, map_memory)                                                               \
+	X(vkUnmapMemory, unmap_memory)                                                           \
+	X(vkFlushMappedMemoryRanges, flush_mapped_memory_ranges)                                 \
+	X(vkInvalidateMappedMemoryRanges, invalidate_mapped_memory_ranges)                       \
+	X(vkCreateBuffer, create_buffer)                                                         \
+	X(vkDestroyBuffer, destroy_buffer)                                                       \
+	X(vkGetBufferMemoryRequirements, get_buffer_memory_requirements)                         \
+	X(vkGetBufferMemoryRequirements2, get_buffer_memory_requirements2)                       \
+	X(vkGetBufferMemoryRequirements2KHR, get_buffer_memory_requirements2)                    \
+	X(vkBindBufferMemory, bind_buffer_memory)                                                \
+	X(vkCreateImage, create_image)                                                           \
+	X(vkDestroyImage, destroy_image)                                                         \
+	X(vkGetImageMemoryRequirements, get_image_memory_requirements)                           \
+	X(vkGetImageMemoryRequirements2, get_image_memory_requirements2)                         \
+	X(vkGetImageMemoryRequirements2KHR, get_image_memory_requirements2)                      \
+	X(vkBindImageMemory, bind_image_memory)                                                  \
+	X(vkCreateImageView, create_image_view)                                                  \
+	X(vkDestroyImageView, destroy_image_view)                                                \
+	X(vkCreateBufferView, create_buffer_view)                                                \
+	X(vkDestroyBufferView, destroy_buffer_view)                                              \
+	X(vkCreateSampler, create_sampler)                                                       \
+	X(vkDestroySampler, destroy_sampler)                                                     \
+	X(vkCreateShaderModule, create_shader_module)                                            \
+	X(vkDestroyShaderModule, destroy_shader_module)                                          \
+	X(vkCreatePipelineCache, create_pipeline_cache)                                          \
+	X(vkDestroyPipelineCache, destroy_pipeline_cache)                                        \
+	X(vkGetPipelineCacheData, get_pipeline_cache_data)                                       \
+	X(vkCreatePipelineLayout, create_pipeline_layout)                                        \
+	X(vkDestroyPipelineLayout, destroy_pipeline_layout)                                      \
+	X(vkCreateGraphicsPipelines, create_graphics_pipelines)                                  \
+	X(vkCreateComputePipelines, create_compute_pipelines)                                    \
+	X(vkDestroyPipeline, destroy_pipeline)                                                   \
+	X(vkCreateDescriptorSetLayout, create_descriptor_set_layout)                             \
+	X(vkDestroyDescriptorSetLayout, destroy_descriptor_set_layout)                           \
+	X(vkCreateDescriptorPool, create_descriptor_pool)                                        \
+	X(vkDestroyDescriptorPool, destroy_descriptor_pool)                                      \
+	X(vkResetDescriptorPool, reset_descriptor_pool)                                          \
+	X(vkAllocateDescriptorSets, allocate_descriptor_sets)                                    \
+	X(vkFreeDescriptorSets, free_descriptor_sets)                                            \
+	X(vkUpdateDescriptorSets, update_descriptor_sets)                                        \
+	X(vkCreateRenderPass, create_render_pass)                                                \
+	X(vkDestroyRenderPass, destroy_render_pass)                                              \
+	X(vkGetRenderAreaGranularity, get_render_area_granularity)                               \
+	X(vkCreateFramebuffer, create_framebuffer)                                               \
+	X(vkDestroyFramebuffer, destroy_framebuffer)                                             \
+	X(vkCreateCommandPool, create_command_pool)                                              \
+	X(vkDestroyCommandPool, destroy_command_pool)                                            \
+	X(vkResetCommandPool, reset_command_pool)                                                \
+	X(vkAllocateCommandBuffers, allocate_command_buffers)                                    \
+	X(vkFreeCommandBuffers, free_command_buffers)                                            \
+	X(vkBeginCommandBuffer, begin_command_buffer)                                            \
+	X(vkEndCommandBuffer, end_command_buffer)                                                \
+	X(vkResetCommandBuffer, reset_command_buffer)                                            \
+	X(vkCreateFence, create_fence)                                                           \
+	X(vkDestroyFence, destroy_fence)                                                         \
+	X(vkResetFences, reset_fences)                                                           \
+	X(vkGetFenceStatus, get_fence_status)                                                    \
+	X(vkWaitForFences, wait_for_fences)                                                      \
+	X(vkCreateSemaphore, create_semaphore)                                                   \
+	X(vkDestroySemaphore, destroy_semaphore)                                                 \
+	X(vkCreateEvent, create_event)                                                           \
+	X(vkDestroyEvent, destroy_event)                                                         \
+	X(vkCreateQueryPool, create_query_pool)                                                  \
+	X(vkDestroyQueryPool, destroy_query_pool)                                                \
+	X(vkGetQueryPoolResults, get_query_pool_results)
+
+// Commands recorded into command buffers, which are only counted
+#define NULL_DEVICE_COMMANDS(X)    \
+	X(vkCmdBindPipeline)           \
+	X(vkCmdSetViewport)            \
+	X(vkCmdSetScissor)             \
+	X(vkCmdSetLineWidth)           \
+	X(vkCmdSetDepthBias)           \
+	X(vkCmdSetBlendConstants)      \
+	X(vkCmdSetDepthBounds)         \
+	X(vkCmdSetStencilCompareMask)  \
+	X(vkCmdSetStencilWriteMask)    \
+	X(vkCmdSetStencilReference)    \
+	X(vkCmdBindDescriptorSets)     \
+	X(vkCmdBindIndexBuffer)        \
+	X(vkCmdBindVertexBuffers)      \
+	X(vkCmdDraw)                   \
+	X(vkCmdDrawIndexed)            \
+	X(vkCmdDrawIndirect)           \
+	X(vkCmdDrawIndexedIndirect)    \
+	X(vkCmdDispatch)               \
+	X(vkCmdDispatchIndirect)       \
+	X(vkCmdCopyBuffer)             \
+	X(vkCmdCopyImage)              \
+	X(vkCmdBlitImage)              \
+	X(vkCmdCopyBufferToImage)      \
+	X(vkCmdCopyImageToBuffer)      \
+	X(vkCmdUpdateBuffer)           \
+	X(vkCmdFillBuffer)             \
+	X(vkCmdClearColorImage)        \
+	X(vkCmdClearDepthStencilImage) \
+	X(vkCmdClearAttachments)       \
+	X(vkCmdResolveImage)           \
+	X(vkCmdSetEvent)               \
+	X(vkCmdResetEvent)             \
+	X(vkCmdWaitEvents)             \
+	X(vkCmdPipelineBarrier)        \
+	X(vkCmdBeginQuery)             \
+	X(vkCmdEndQuery)               \
+	X(vkCmdResetQueryPool)         \
+	X(vkCmdWriteTimestamp)         \
+	X(vkCmdCopyQueryPoolResults)   \
+	X(vkCmdPushConstants)          \
+	X(vkCmdBeginRenderPass)        \
+	X(vkCmdNextSubpass)            \
+	X(vkCmdEndRenderPass)          \
+	X(vkCmdExecuteCommands)
+
+#define NULL_DEVICE_FUNCTION_ENTRY_POINT(name, function) name,
+#define NULL_DEVICE_COMMAND_ENTRY_POINT(name) name,
+
+// clang-format off
+enum class EntryPoint
+{
+	NULL_DEVICE_FUNCTIONS(NULL_DEVICE_FUNCTION_ENTRY_POINT)
+	NULL_DEVICE_COMMANDS(NULL_DEVICE_COMMAND_ENTRY_POINT)
+	Count
+};
+// clang-format on
+
+#undef NULL_DEVICE_FUNCTION_ENTRY_POINT
+#undef NULL_DEVICE_COMMAND_ENTRY_POINT
+
+#define NULL_DEVICE_FUNCTION_NAME(name, function) #name,
+#define NULL_DEVICE_COMMAND_NAME(name) #name,
+
+// clang-format off
+const std::array<const char *, static_cast<size_t>(EntryPoint::Count)> entry_point_names{
+	NULL_DEVICE_FUNCTIONS(NULL_DEVICE_FUNCTION_NAME)
+	NULL_DEVICE_COMMANDS(NULL_DEVICE_COMMAND_NAME)
+};
+// clang-format on
+
+#undef NULL_DEVICE_FUNCTION_NAME
+#undef NULL_DEVICE_COMMAND_NAME
+
+bool enabled{false};
+
+std::array<std::atomic<uint64_t>, static_cast<size_t>(EntryPoint::Count)> call_counts{};
+
+// Handles are never dereferenced, so a counter is enough to keep them unique
+std::atomic<uint64_t> next_handle{1};
+
+/**
+ * @brief State the null device needs to answer queries about the objects it created
+ */
+struct DeviceMemory
+{
+	VkDeviceSize size{0};
+
+	// Host memory is only allocated when the device memory is mapped
+	uint8_t *data{nullptr};
+};
+
+struct SwapchainImages
+{
+	std::vector<VkImage> images;
+
+	uint32_t next_image_index{0};
+};
+
+std::mutex object_mutex;
+
+std::unordered_map<uint64_t, VkDeviceSize> buffer_sizes;
+
+std::unordered_map<uint64_t, VkDeviceSize> image_sizes;
+
+std::unordered_map<uint64_t, DeviceMemory> device_memories;
+
+std::unordered_map<uint64_t, SwapchainImages> swapchains;
+
+constexpr VkDeviceSize memory_alignment = 256;
+
+// Large enough for a texel of any uncompressed format
+constexpr VkDeviceSize max_texel_size = 16;
+
+const std::vector<const char *> instance_extensions{VK_KHR_SURFACE_EXTENSION_NAME,
+                                                    VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME,
+                                                    VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME};
+
+const std::vector<const char *> device_extensions{VK_KHR_SWAPCHAIN_EXTENSION_NAME};
+
+const std::vector<VkFormat> surface_formats{VK_FORMAT_B8G8R8A8_SRGB,
+                                            VK_FORMAT_R8G8B8A8_SRGB,
+                                            VK_FORMAT_B8G8R8A8_UNORM,
+                                            VK_FORMAT_R8G8B8A8_UNORM};
+
+const std::vector<VkPresentModeKHR> present_modes{VK_PRESENT_MODE_FIFO_KHR,
+                                                  VK_PRESENT_MODE_MAILBOX_KHR,
+                                                  VK_PRESENT_MODE_IMMEDIATE_KHR};
+
+inline void count_call(EntryPoint entry_point)
+{
+	call_counts[static_cast<size_t>(entry_point)].fetch_add(1, std::memory_order_relaxed);
+}
+
+template <typename T>
+T new_handle()
+{
+	// Non-dispatchable handles are pointers or 64-bit integers depending on the platform
+	return (T) next_handle.fetch_add(1, std::memory_order_relaxed);
+}
+
+template <typename T>
+void new_handles(uint32_t count, T *handles)
+{
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		handles[i] = new_handle<T>();
+	}
+}
+
+template <typename T>
+uint64_t to_key(T handle)
+{
+	return (uint64_t) handle;
+}
+
+/**
+ * @brief Implements the two-call idiom of the enumeration entry points
+ */
+template <typename T, typename Source, typename Convert>
+VkResult enumerate(const std::vector<Source> &source, uint32_t *count, T *properties, Convert convert)
+{
+	if (properties == nullptr)
+	{
+		*count = to_u32(source.size());
+		return VK_SUCCESS;
+	}
+
+	uint32_t written = std::min(*count, to_u32(source.size()));
+
+	for (uint32_t i = 0; i < written; ++i)
+	{
+		properties[i] = convert(source[i]);
+	}
+
+	*count = written;
+
+	return written < source.size() ? VK_INCOMPLETE : VK_SUCCESS;
+}
+
+VkExtensionProperties to_extension_properties(const char *extension_name)
+{
+	VkExtensionProperties properties{};
+	std::strncpy(properties.extensionName, extension_name, VK_MAX_EXTENSION_NAME_SIZE - 1);
+	properties.specVersion = 1;
+	return properties;
+}
+
+VkDeviceSize align(VkDeviceSize size)
+{
+	return (size + memory_alignment - 1) / memory_alignment * memory_alignment;
+}
+
+VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL get_instance_proc_addr(VkInstance instance, const char *name);
+
+VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL get_device_proc_addr(VkDevice device, const char *name)
+{
+	return get_instance_proc_addr(VK_NULL_HANDLE, name);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL enumerate_instance_version(uint32_t *api_version)
+{
+	count_call(EntryPoint::vkEnumerateInstanceVersion);
+	*api_version = VK_API_VERSION_1_1;
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL enumerate_instance_extension_properties(const char *layer_name, uint32_t *count, VkExtensionProperties *properties)
+{
+	count_call(EntryPoint::vkEnumerateInstanceExtensionProperties);
+
+	if (layer_name != nullptr)
+	{
+		*count = 0;
+		return VK_ERROR_LAYER_NOT_PRESENT;
+	}
+
+	return enumerate(instance_extensions, count, properties, to_extension_properties);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL enumerate_instance_layer_properties(uint32_t *count, VkLayerProperties *properties)
+{
+	count_call(EntryPoint::vkEnumerateInstanceLayerProperties);
+	*count = 0;
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL create_instance(const VkInstanceCreateInfo *create_info, const VkAllocationCallbacks *allocator, VkInstance *instance)
+{
+	count_call(EntryPoint::vkCreateInstance);
+
+	if (create_info->enabledLayerCount > 0)
+	{
+		return VK_ERROR_LAYER_NOT_PRESENT;
+	}
+
+	*instance = new_handle<VkInstance>();
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL destroy_instance(VkInstance instance, const VkAllocationCallbacks *allocator)
+{
+	count_call(EntryPoint::vkDestroyInstance);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL enumerate_physical_devices(VkInstance instance, uint32_t *count, VkPhysicalDevice *physical_devices)
+{
+	count_call(EntryPoint::vkEnumeratePhysicalDevices);
+
+	static const VkPhysicalDevice physical_device = new_handle<VkPhysicalDevice>();
+
+	return enumerate(std::vector<VkPhysicalDevice>{physical_device}, count, physical_devices, [](VkPhysicalDevice handle) { return handle; });
+}
+
+VKAPI_ATTR void VKAPI_CALL get_physical_device_features(VkPhysicalDevice physical_device, VkPhysicalDeviceFeatures *features)
+{
+	count_call(EntryPoint::vkGetPhysicalDeviceFeatures);
+
+	// Every core feature is accepted, as nothing is executed
+	auto feature_bits = reinterpret_cast<VkBool32 *>(features);
+	std::fill(feature_bits, feature_bits + sizeof(VkPhysicalDeviceFeatures) / sizeof(VkBool32), VK_TRUE);
+}
+
+VKAPI_ATTR void VKAPI_CALL get_physical_device_features2(VkPhysicalDevice physical_device, VkPhysicalDeviceFeatures2 *features)
+{
+	count_call(EntryPoint::vkGetPhysicalDeviceFeatures2);
+
+	// Extension structures are left untouched, as no extension features are supported
+	get_physical_device_features(physical_device, &features->features);
+}
+
+VKAPI_ATTR void VKAPI_CALL get_physical_device_properties(VkPhysicalDevice physical_device, VkPhysicalDeviceProperties *properties)
+{
+	count_call(EntryPoint::vkGetPhysicalDeviceProperties);
+
+	*properties = {};
+
+	properties->apiVersion    = VK_API_VERSION_1_1;
+	properties->driverVersion = 1;
+	properties->deviceType    = VK_PHYSICAL_DEVICE_TYPE_OTHER;
+	std::strncpy(properties->deviceName, "Null device", VK_MAX_PHYSICAL_DEVICE_NAME_SIZE - 1);
+
+	auto &limits = properties->limits;
+
+	limits.maxImageDimension1D                   = 16384;
+	limits.maxImageDimension2D                   = 16384;
+	limits.maxImageDimension3D                   = 2048;
+	limits.maxImageDimensionCube                 = 16384;
+	limits.maxImageArrayLayers                   = 2048;
+	limits.maxTexelBufferElements                = 1u << 27;
+	limits.maxUniformBufferRange                 = 65536;
+	limits.maxStorageBufferRange                 = 1u << 30;
+	limits.maxPushConstantsSize                  = 256;
+	limits.maxMemoryAllocationCount              = 4096;
+	limits.maxSamplerAllocationCount             = 4000;
+	limits.bufferImageGranularity                = 1;
+	limits.maxBoundDescriptorSets                = 8;
+	limits.maxPerStageDescriptorSamplers         = 1024;
+	limits.maxPerStageDescriptorUniformBuffers   = 1024;
+	limits.maxPerStageDescriptorStorageBuffers   = 1024;
+	limits.maxPerStageDescriptorSampledImages    = 1024;
+	limits.maxPerStageDescriptorStorageImages    = 1024;
+	limits.maxPerStageDescriptorInputAttachments = 8;
+	limits.maxPerStageResources                  = 4096;
+	limits.maxDescriptorSetSamplers              = 4096;
+	limits.maxDescriptorSetUniformBuffers        = 4096;
+	limits.maxDescriptorSetUniformBuffersDynamic = 16;
+	limits.maxDescriptorSetStorageBuffers        = 4096;
+	limits.maxDescriptorSetStorageBuffersDynamic = 16;
+	limits.maxDescriptorSetSampledImages         = 4096;
+	limits.maxDescriptorSetStorageImages         = 4096;
+	limits.maxDescriptorSetInputAttachments      = 8;
+	limits.maxVertexInputAttributes              = 32;
+	limits.maxVertexInputBindings                = 32;
+	limits.maxVertexInputAttributeOffset         = 2047;
+	limits.maxVertexInputBindingStride           = 2048;
+	limits.maxVertexOutputComponents             = 128;
+	limits.maxTessellationGenerationLevel        = 64;
+	limits.maxTessellationPatchSize              = 32;
+	limits.maxFragmentInputComponents            = 128;
+	limits.maxFragmentOutputAttachments          = 8;
+	limits.maxComputeSharedMemorySize            = 32768;
+	limits.maxComputeWorkGroupCount[0]           = 65535;
+	limits.maxComputeWorkGroupCount[1]           = 65535;
+	limits.maxComputeWorkGroupCount[2]           = 65535;
+	limits.maxComputeWorkGroupInvocations        = 1024;
+	limits.maxComputeWorkGroupSize[0]            = 1024;
+	limits.maxComputeWorkGroupSize[1]            = 1024;
+	limits.maxComputeWorkGroupSize[2]            = 64;
+	limits.maxDrawIndexedIndexValue              = UINT32_MAX;
+	limits.maxDrawIndirectCount                  = UINT32_MAX;
+	limits.maxSamplerLodBias                     = 16.0f;
+	limits.maxSamplerAnisotropy                  = 16.0f;
+	limits.maxViewports                          = 16;
+	limits.maxViewportDimensions[0]              = 16384;
+	limits.maxViewportDimensions[1]              = 16384;
+	limits.viewportBoundsRange[0]                = -32768.0f;
+	limits.viewportBoundsRange[1]                = 32767.0f;
+	limits.minMemoryMapAlignment                 = 64;
+	limits.minTexelBufferOffsetAlignment         = 16;
+	limits.minUniformBufferOffsetAlignment       = memory_alignment;
+	limits.minStorageBufferOffsetAlignment       = memory_alignment;
+	limits.maxFramebufferWidth                   = 16384;
+	limits.maxFramebufferHeight                  = 16384;
+	limits.maxFramebufferLayers                  = 2048;
+	limits.framebufferColorSampleCounts          = VK_SAMPLE_COUNT_1_BIT | VK_SAMPLE_COUNT_2_BIT | VK_SAMPLE_COUNT_4_BIT | VK_SAMPLE_COUNT_8_BIT;
+	limits.framebufferDepthSampleCounts          = limits.framebufferColorSampleCounts;
+	limits.framebufferStencilSampleCounts        = limits.framebufferColorSampleCounts;
+	limits.framebufferNoAttachmentsSampleCounts  = limits.framebufferColorSampleCounts;
+	limits.maxColorAttachments                   = 8;
+	limits.sampledImageColorSampleCounts         = limits.framebufferColorSampleCounts;
+	limits.sampledImageIntegerSampleCounts       = limits.framebufferColorSampleCounts;
+	limits.sampledImageDepthSampleCounts         = limits.framebufferColorSampleCounts;
+	limits.sampledImageStencilSampleCounts       = limits.framebufferColorSampleCounts;
+	limits.storageImageSampleCounts              = limits.framebufferColorSampleCounts;
+	limits.maxSampleMaskWords                    = 1;
+	limits.timestampComputeAndGraphics           = VK_TRUE;
+	limits.timestampPeriod                       = 1.0f;
+	limits.maxClipDistances                      = 8;
+	limits.maxCullDistances                      = 8;
+	limits.maxCombinedClipAndCullDistances       = 8;
+	limits.pointSizeRange[0]                     = 1.0f;
+	limits.pointSizeRange[1]                     = 64.0f;
+	limits.lineWidthRange[0]                     = 1.0f;
+	limits.lineWidthRange[1]                     = 8.0f;
+	limits.optimalBufferCopyOffsetAlignment      = 1;
+	limits.optimalBufferCopyRowPitchAlignment    = 1;
+	limits.nonCoherentAtomSize                   = 64;
+}
+
+VKAPI_ATTR void VKAPI_CALL get_physical_device_properties2(VkPhysicalDevice physical_device, VkPhysicalDeviceProperties2 *properties)
+{
+	count_call(EntryPoint::vkGetPhysicalDeviceProperties2);
+
+	// Extension structures are left untouched, as no extension is supported
+	get_physical_device_properties(physical_device, &properties->properties);
+}
+
+VKAPI_ATTR void VKAPI_CALL get_physical_device_memory_properties(VkPhysicalDevice physical_device, VkPhysicalDeviceMemoryProperties *properties)
+{
+	count_call(EntryPoint::vkGetPhysicalDeviceMemoryProperties);
+
+	*properties = {};
+
+	// A single heap with host visible memory, like an integrated GPU
+	properties->memoryHeapCount              = 1;
+	properties->memoryHeaps[0].size          = 1ull << 32;
+	properties->memoryHeaps[0].flags         = VK_MEMORY_HEAP_DEVICE_LOCAL_BIT;
+	properties->memoryTypeCount              = 1;
+	properties->memoryTypes[0].heapIndex     = 0;
+	properties->memoryTypes[0].propertyFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+	                                           VK_MEMORY_PROPERTY_HOST_COHERENT_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+}
+
+VKAPI_ATTR void VKAPI_CALL get_physical_device_queue_family_properties(VkPhysicalDevice physical_device, uint32_t *count, VkQueueFamilyProperties *properties)
+{
+	count_call(EntryPoint::vkGetPhysicalDeviceQueueFamilyProperties);
+
+	VkQueueFamilyProperties queue_family{};
+	queue_family.queueFlags                  = VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT;
+	queue_family.queueCount                  = 1;
+	queue_family.timestampValidBits          = 64;
+	queue_family.minImageTransferGranularity = {1, 1, 1};
+
+	enumerate(std::vector<VkQueueFamilyProperties>{queue_family}, count, properties, [](const VkQueueFamilyProperties &family) { return family; });
+}
+
+VKAPI_ATTR void VKAPI_CALL get_physical_device_format_properties(VkPhysicalDevice physical_device, VkFormat format, VkFormatProperties *properties)
+{
+	count_call(EntryPoint::vkGetPhysicalDeviceFormatProperties);
+
+	// Every format supports every usage
+	properties->linearTilingFeatures  = ~0u;
+	properties->optimalTilingFeatures = ~0u;
+	properties->bufferFeatures        = ~0u;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL get_physical_device_image_format_properties(VkPhysicalDevice physical_device, VkFormat format, VkImageType type, VkImageTiling tiling, VkImageUsageFlags usage, VkImageCreateFlags flags, VkImageFormatProperties *properties)
+{
+	count_call(EntryPoint::vkGetPhysicalDeviceImageFormatProperties);
+
+	properties->maxExtent       = {16384, 16384, 2048};
+	properties->maxMipLevels    = 15;
+	properties->maxArrayLayers  = 2048;
+	properties->sampleCounts    = VK_SAMPLE_COUNT_1_BIT | VK_SAMPLE_COUNT_2_BIT | VK_SAMPLE_COUNT_4_BIT | VK_SAMPLE_COUNT_8_BIT;
+	properties->maxResourceSize = 1ull << 32;
+
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL enumerate_device_extension_properties(VkPhysicalDevice physical_device, const char *layer_name, uint32_t *count, VkExtensionProperties *properties)
+{
+	count_call(EntryPoint::vkEnumerateDeviceExtensionProperties);
+
+	if (layer_name != nullptr)
+	{
+		*count = 0;
+		return VK_ERROR_LAYER_NOT_PRESENT;
+	}
+
+	return enumerate(device_extensions, count, properties, to_extension_properties);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL enumerate_device_layer_properties(VkPhysicalDevice physical_device, uint32_t *count, VkLayerProperties *properties)
+{
+	count_call(EntryPoint::vkEnumerateDeviceLayerProperties);
+	*count = 0;
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL create_headless_surface(VkInstance instance, const VkHeadlessSurfaceCreateInfoEXT *create_info, const VkAllocationCallbacks *allocator, VkSurfaceKHR *surface)
+{
+	count_call(EntryPoint::vkCreateHeadlessSurfaceEXT);
+	*surface = new_handle<VkSurfaceKHR>();
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL destroy_surface(VkInstance instance, VkSurfaceKHR surface, const VkAllocationCallbacks *allocator)
+{
+	count_call(EntryPoint::vkDestroySurfaceKHR);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL get_physical_device_surface_support(VkPhysicalDevice physical_device, uint32_t queue_family_index, VkSurfaceKHR surface, VkBool32 *supported)
+{
+	count_call(EntryPoint::vkGetPhysicalDeviceSurfaceSupportKHR);
+	*supported = VK_TRUE;
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL get_physical_device_surface_capabilities(VkPhysicalDevice physical_device, VkSurfaceKHR surface, VkSurfaceCapabilitiesKHR *capabilities)
+{
+	count_call(EntryPoint::vkGetPhysicalDeviceSurfaceCapabilitiesKHR);
+
+	*capabilities = {};
+
+	// Like other headless surfaces, the extent is chosen by the swapchain
+	capabilities->minImageCount           = 2;
+	capabilities->maxImageCount           = 8;
+	capabilities->currentExtent           = {0xFFFFFFFF, 0xFFFFFFFF};
+	capabilities->minImageExtent          = {1, 1};
+	capabilities->maxImageExtent          = {16384, 16384};
+	capabilities->maxImageArrayLayers     = 1;
+	capabilities->supportedTransforms     = VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR;
+	capabilities->currentTransform        = VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR;
+	capabilities->supportedCompositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+	capabilities->supportedUsageFlags     = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT |
+	                                        VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT;
+
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL get_physical_device_surface_formats(VkPhysicalDevice physical_device, VkSurfaceKHR surface, uint32_t *count, VkSurfaceFormatKHR *formats)
+{
+	count_call(EntryPoint::vkGetPhysicalDeviceSurfaceFormatsKHR);
+
+	return enumerate(surface_formats, count, formats, [](VkFormat format) {
+		return VkSurfaceFormatKHR{format, VK_COLOR_SPACE_SRGB_NONLINEAR_KHR};
+	});
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL get_physical_device_surface_present_modes(VkPhysicalDevice physical_device, VkSurfaceKHR surface, uint32_t *count, VkPresentModeKHR *modes)
+{
+	count_call(EntryPoint::vkGetPhysicalDeviceSurfacePresentModesKHR);
+
+	return enumerate(present_modes, count, modes, [](VkPresentModeKHR mode) { return mode; });
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL create_device(VkPhysicalDevice physical_device, const VkDeviceCreateInfo *create_info, const VkAllocationCallbacks *allocator, VkDevice *device)
+{
+	count_call(EntryPoint::vkCreateDevice);
+
+	for (uint32_t i = 0; i < create_info->enabledExtensionCount; ++i)
+	{
+		auto extension_it = std::find_if(device_extensions.begin(), device_extensions.end(), [&](const char *extension_name) {
+			return std::strcmp(extension_name, create_info->ppEnabledExtensionNames[i]) == 0;
+		});
+
+		if (extension_it == device_extensions.end())
+		{
+			return VK_ERROR_EXTENSION_NOT_PRESENT;
+		}
+	}
+
+	*device = new_handle<VkDevice>();
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL destroy_device(VkDevice device, const VkAllocationCallbacks *allocator)
+{
+	count_call(EntryPoint::vkDestroyDevice);
+}
+
+VKAPI_ATTR void VKAPI_CALL get_device_queue(VkDevice device, uint32_t queue_family_index, uint32_t queue_index, VkQueue *queue)
+{
+	count_call(EntryPoint::vkGetDeviceQueue);
+
+	static const VkQueue null_queue = new_handle<VkQueue>();
+
+	*queue = null_queue;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL device_wait_idle(VkDevice device)
+{
+	count_call(EntryPoint::vkDeviceWaitIdle);
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL queue_submit(VkQueue queue, uint32_t submit_count, const VkSubmitInfo *submits, VkFence fence)
+{
+	count_call(EntryPoint::vkQueueSubmit);
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL queue_wait_idle(VkQueue queue)
+{
+	count_call(EntryPoint::vkQueueWaitIdle);
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL queue_present(VkQueue queue, const VkPresentInfoKHR *present_info)
+{
+	count_call(EntryPoint::vkQueuePresentKHR);
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL create_swapchain(VkDevice device, const VkSwapchainCreateInfoKHR *create_info, const VkAllocationCallbacks *allocator, VkSwapchainKHR *swapchain)
+{
+	count_call(EntryPoint::vkCreateSwapchainKHR);
+
+	*swapchain = new_handle<VkSwapchainKHR>();
+
+	SwapchainImages null_swapchain;
+	null_swapchain.images.resize(create_info->minImageCount);
+	new_handles(create_info->minImageCount, null_swapchain.images.data());
+
+	std::lock_guard<std::mutex> lock(object_mutex);
+	swapchains[to_key(*swapchain)] = std::move(null_swapchain);
+
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL destroy_swapchain(VkDevice device, VkSwapchainKHR swapchain, const VkAllocationCallbacks *allocator)
+{
+	count_call(EntryPoint::vkDestroySwapchainKHR);
+
+	std::lock_guard<std::mutex> lock(object_mutex);
+	swapchains.erase(to_key(swapchain));
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL get_swapchain_images(VkDevice device, VkSwapchainKHR swapchain, uint32_t *count, VkImage *images)
+{
+	count_call(EntryPoint::vkGetSwapchainImagesKHR);
+
+	std::lock_guard<std::mutex> lock(object_mutex);
+	return enumerate(swapchains.at(to_key(swapchain)).images, count, images, [](VkImage image) { return image; });
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL acquire_next_image(VkDevice device, VkSwapchainKHR swapchain, uint64_t timeout, VkSemaphore semaphore, VkFence fence, uint32_t *image_index)
+{
+	count_call(EntryPoint::vkAcquireNextImageKHR);
+
+	std::lock_guard<std::mutex> lock(object_mutex);
+
+	auto &null_swapchain = swapchains.at(to_key(swapchain));
+
+	*image_index                    = null_swapchain.next_image_index;
+	null_swapchain.next_image_index = (null_swapchain.next_image_index + 1) % to_u32(null_swapchain.images.size());
+
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL allocate_memory(VkDevice device, const VkMemoryAllocateInfo *allocate_info, const VkAllocationCallbacks *allocator, VkDeviceMemory *memory)
+{
+	count_call(EntryPoint::vkAllocateMemory);
+
+	*memory = new_handle<VkDeviceMemory>();
+
+	std::lock_guard<std::mutex> lock(object_mutex);
+	device_memories[to_key(*memory)].size = allocate_info->allocationSize;
+
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL free_memory(VkDevice device, VkDeviceMemory memory, const VkAllocationCallbacks *allocator)
+{
+	count_call(EntryPoint::vkFreeMemory);
+
+	std::lock_guard<std::mutex> lock(object_mutex);
+
+	auto memory_it = device_memories.find(to_key(memory));
+
+	if (memory_it != device_memories.end())
+	{
+		std::free(memory_it->second.data);
+		device_memories.erase(memory_it);
+	}
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL map_memory(VkDevice device, VkDeviceMemory memory, VkDeviceSize offset, VkDeviceSize size, VkMemoryMapFlags flags, void **data)
+{
+	count_call(EntryPoint::vkMapMemory);
+
+	std::lock_guard<std::mutex> lock(object_mutex);
+
+	auto &device_memory = device_memories.at(to_key(memory));
+
+	if (device_memory.data == nullptr)
+	{
+		// Zeroed pages are only committed when they are written
+		device_memory.data = static_cast<uint8_t *>(std::calloc(static_cast<size_t>(device_memory.size), 1));
+
+		if (device_memory.data == nullptr)
+		{
+			return VK_ERROR_MEMORY_MAP_FAILED;
+		}
+	}
+
+	*data = device_memory.data + offset;
+
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL unmap_memory(VkDevice device, VkDeviceMemory memory)
+{
+	count_call(EntryPoint::vkUnmapMemory);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL flush_mapped_memory_ranges(VkDevice device, uint32_t count, const VkMappedMemoryRange *ranges)
+{
+	count_call(EntryPoint::vkFlushMappedMemoryRanges);
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL invalidate_mapped_memory_ranges(VkDevice device, uint32_t count, const VkMappedMemoryRange *ranges)
+{
+	count_call(EntryPoint::vkInvalidateMappedMemoryRanges);
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL create_buffer(VkDevice device, const VkBufferCreateInfo *create_info, const VkAllocationCallbacks *allocator, VkBuffer *buffer)
+{
+	count_call(EntryPoint::vkCreateBuffer);
+
+	*buffer = new_handle<VkBuffer>();
+
+	std::lock_guard<std::mutex> lock(object_mutex);
+	buffer_sizes[to_key(*buffer)] = create_info->size;
+
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL destroy_buffer(VkDevice device, VkBuffer buffer, const VkAllocationCallbacks *allocator)
+{
+	count_call(EntryPoint::vkDestroyBuffer);
+
+	std::lock_guard<std::mutex> lock(object_mutex);
+	buffer_sizes.erase(to_key(buffer));
+}
+
+VKAPI_ATTR void VKAPI_CALL get_buffer_memory_requirements(VkDevice device, VkBuffer buffer, VkMemoryRequirements *requirements)
+{
+	count_call(EntryPoint::vkGetBufferMemoryRequirements);
+
+	std::lock_guard<std::mutex> lock(object_mutex);
+
+	requirements->size           = align(buffer_sizes.at(to_key(buffer)));
+	requirements->alignment      = memory_alignment;
+	requirements->memoryTypeBits = 1;
+}
+
+VKAPI_ATTR void VKAPI_CALL get_buffer_memory_requirements2(VkDevice device, const VkBufferMemoryRequirementsInfo2 *info, VkMemoryRequirements2 *requirements)
+{
+	count_call(EntryPoint::vkGetBufferMemoryRequirements2);
+	get_buffer_memory_requirements(device, info->buffer, &requirements->memoryRequirements);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL bind_buffer_memory(VkDevice device, VkBuffer buffer, VkDeviceMemory memory, VkDeviceSize offset)
+{
+	count_call(EntryPoint::vkBindBufferMemory);
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL create_image(VkDevice device, const VkImageCreateInfo *create_info, const VkAllocationCallbacks *allocator, VkImage *image)
+{
+	count_call(EntryPoint::vkCreateImage);
+
+	*image = new_handle<VkImage>();
+
+	// Mip levels add at most a third of the base level
+	VkDeviceSize size = VkDeviceSize{create_info->extent.width} * create_info->extent.height * create_info->extent.depth *
+	                    create_info->arrayLayers * create_info->samples * max_texel_size;
+
+	if (create_info->mipLevels > 1)
+	{
+		size += size / 3;
+	}
+
+	std::lock_guard<std::mutex> lock(object_mutex);
+	image_sizes[to_key(*image)] = size;
+
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL destroy_image(VkDevice device, VkImage image, const VkAllocationCallbacks *allocator)
+{
+	count_call(EntryPoint::vkDestroyImage);
+
+	std::lock_guard<std::mutex> lock(object_mutex);
+	image_sizes.erase(to_key(image));
+}
+
+VKAPI_ATTR void VKAPI_CALL get_image_memory_requirements(VkDevice device, VkImage image, VkMemoryRequirements *requirements)
+{
+	count_call(EntryPoint::vkGetImageMemoryRequirements);
+
+	std::lock_guard<std::mutex> lock(object_mutex);
+
+	requirements->size           = align(image_sizes.at(to_key(image)));
+	requirements->alignment      = memory_alignment;
+	requirements->memoryTypeBits = 1;
+}
+
+VKAPI_ATTR void VKAPI_CALL get_image_memory_requirements2(VkDevice device, const VkImageMemoryRequirementsInfo2 *info, VkMemoryRequirements2 *requirements)
+{
+	count_call(EntryPoint::vkGetImageMemoryRequirements2);
+	get_image_memory_requirements(device, info->image, &requirements->memoryRequirements);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL bind_image_memory(VkDevice device, VkImage image, VkDeviceMemory memory, VkDeviceSize offset)
+{
+	count_call(EntryPoint::vkBindImageMemory);
+	return VK_SUCCESS;
+}
+
+/**
+ * @brief Implements the entry points which create an object without state
+ */
+template <EntryPoint entry_point, typename CreateInfo, typename Handle>
+VKAPI_ATTR VkResult VKAPI_CALL create_object(VkDevice device, const CreateInfo *create_info, const VkAllocationCallbacks *allocator, Handle *handle)
+{
+	count_call(entry_point);
+	*handle = new_handle<Handle>();
+	return VK_SUCCESS;
+}
+
+/**
+ * @brief Implements the entry points which destroy an object without state
+ */
+template <EntryPoint entry_point, typename Handle>
+VKAPI_ATTR void VKAPI_CALL destroy_object(VkDevice device, Handle handle, const VkAllocationCallbacks *allocator)
+{
+	count_call(entry_point);
+}
+
+#define NULL_DEVICE_OBJECT(create_name, destroy_name, create_function, destroy_function, CreateInfo, Handle) \
+	constexpr auto create_function  = &create_object<EntryPoint::create_name, CreateInfo, Handle>;           \
+	constexpr auto destroy_function = &destroy_object<EntryPoint::destroy_name, Handle>;
+
+NULL_DEVICE_OBJECT(vkCreateImageView, vkDestroyImageView, create_image_view, destroy_image_view, VkImageViewCreateInfo, VkImageView)
+NULL_DEVICE_OBJECT(vkCreateBufferView, vkDestroyBufferView, create_buffer_view, destroy_buffer_view, VkBufferViewCreateInfo, VkBufferView)
+NULL_DEVICE_OBJECT(vkCreateSampler, vkDestroySampler, create_sampler, destroy_sampler, VkSamplerCreateInfo, VkSampler)
+NULL_DEVICE_OBJECT(vkCreateShaderModule, vkDestroyShaderModule, create_shader_module, destroy_shader_module, VkShaderModuleCreateInfo, VkShaderModule)
+NULL_DEVICE_OBJECT(vkCreatePipelineCache, vkDestroyPipelineCache, create_pipeline_cache, destroy_pipeline_cache, VkPipelineCacheCreateInfo, VkPipelineCache)
+NULL_DEVICE_OBJECT(vkCreatePipelineLayout, vkDestroyPipelineLayout, create_pipeline_layout, destroy_pipeline_layout, VkPipelineLayoutCreateInfo, VkPipelineLayout)
+NULL_DEVICE_OBJECT(vkCreateDescriptorSetLayout, vkDestroyDescriptorSetLayout, create_descriptor_set_layout, destroy_descriptor_set_layout, VkDescriptorSetLayoutCreateInfo, VkDescriptorSetLayout)
+NULL_DEVICE_OBJECT(vkCreateDescriptorPool, vkDestroyDescriptorPool, create_descriptor_pool, destroy_descriptor_pool, VkDescriptorPoolCreateInfo, VkDescriptorPool)
+NULL_DEVICE_OBJECT(vkCreateRenderPass, vkDestroyRenderPass, create_render_pass, destroy_render_pass, VkRenderPassCreateInfo, VkRenderPass)
+NULL_DEVICE_OBJECT(vkCreateFramebuffer, vkDestroyFramebuffer, create_framebuffer, destroy_framebuffer, VkFramebufferCreateInfo, VkFramebuffer)
+NULL_DEVICE_OBJECT(vkCreateCommandPool, vkDestroyCommandPool, create_command_pool, destroy_command_pool, VkCommandPoolCreateInfo, VkCommandPool)
+NULL_DEVICE_OBJECT(vkCreateFence, vkDestroyFence, create_fence, destroy_fence, VkFenceCreateInfo, VkFence)
+NULL_DEVICE_OBJECT(vkCreateSemaphore, vkDestroySemaphore, create_semaphore, destroy_semaphore, VkSemaphoreCreateInfo, VkSemaphore)
+NULL_DEVICE_OBJECT(vkCreateEvent, vkDestroyEvent, create_event, destroy_event, VkEventCreateInfo, VkEvent)
+NULL_DEVICE_OBJECT(vkCreateQueryPool, vkDestroyQueryPool, create_query_pool, destroy_query_pool, VkQueryPoolCreateInfo, VkQueryPool)
+
+#undef NULL_DEVICE_OBJECT
+
+VKAPI_ATTR VkResult VKAPI_CALL get_pipeline_cache_data(VkDevice device, VkPipelineCache pipeline_cache, size_t *size, void *data)
+{
+	count_call(EntryPoint::vkGetPipelineCacheData);
+
+	// There is nothing to cache
+	*size = 0;
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL create_graphics_pipelines(VkDevice device, VkPipelineCache pipeline_cache, uint32_t count, const VkGraphicsPipelineCreateInfo *create_infos, const VkAllocationCallbacks *allocator, VkPipeline *pipelines)
+{
+	count_call(EntryPoint::vkCreateGraphicsPipelines);
+	new_handles(count, pipelines);
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL create_compute_pipelines(VkDevice device, VkPipelineCache pipeline_cache, uint32_t count, const VkComputePipelineCreateInfo *create_infos, const VkAllocationCallbacks *allocator, VkPipeline *pipelines)
+{
+	count_call(EntryPoint::vkCreateComputePipelines);
+	new_handles(count, pipelines);
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL destroy_pipeline(VkDevice device, VkPipeline pipeline, const VkAllocationCallbacks *allocator)
+{
+	count_call(EntryPoint::vkDestroyPipeline);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL reset_descriptor_pool(VkDevice device, VkDescriptorPool descriptor_pool, VkDescriptorPoolResetFlags flags)
+{
+	count_call(EntryPoint::vkResetDescriptorPool);
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL allocate_descriptor_sets(VkDevice device, const VkDescriptorSetAllocateInfo *allocate_info, VkDescriptorSet *descriptor_sets)
+{
+	count_call(EntryPoint::vkAllocateDescriptorSets);
+	new_handles(allocate_info->descriptorSetCount, descriptor_sets);
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL free_descriptor_sets(VkDevice device, VkDescriptorPool descriptor_pool, uint32_t count, const VkDescriptorSet *descriptor_sets)
+{
+	count_call(EntryPoint::vkFreeDescriptorSets);
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL update_descriptor_sets(VkDevice device, uint32_t write_count, const VkWriteDescriptorSet *writes, uint32_t copy_count, const VkCopyDescriptorSet *copies)
+{
+	count_call(EntryPoint::vkUpdateDescriptorSets);
+}
+
+VKAPI_ATTR void VKAPI_CALL get_render_area_granularity(VkDevice device, VkRenderPass render_pass, VkExtent2D *granularity)
+{
+	count_call(EntryPoint::vkGetRenderAreaGranularity);
+	*granularity = {1, 1};
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL reset_command_pool(VkDevice device, VkCommandPool command_pool, VkCommandPoolResetFlags flags)
+{
+	count_call(EntryPoint::vkResetCommandPool);
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL allocate_command_buffers(VkDevice device, const VkCommandBufferAllocateInfo *allocate_info, VkCommandBuffer *command_buffers)
+{
+	count_call(EntryPoint::vkAllocateCommandBuffers);
+	new_handles(allocate_info->commandBufferCount, command_buffers);
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL free_command_buffers(VkDevice device, VkCommandPool command_pool, uint32_t count, const VkCommandBuffer *command_buffers)
+{
+	count_call(EntryPoint::vkFreeCommandBuffers);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL begin_command_buffer(VkCommandBuffer command_buffer, const VkCommandBufferBeginInfo *begin_info)
+{
+	count_call(EntryPoint::vkBeginCommandBuffer);
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL end_command_buffer(VkCommandBuffer command_buffer)
+{
+	count_call(EntryPoint::vkEndCommandBuffer);
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL reset_command_buffer(VkCommandBuffer command_buffer, VkCommandBufferResetFlags flags)
+{
+	count_call(EntryPoint::vkResetCommandBuffer);
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL reset_fences(VkDevice device, uint32_t count, const VkFence *fences)
+{
+	count_call(EntryPoint::vkResetFences);
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL get_fence_status(VkDevice device, VkFence fence)
+{
+	count_call(EntryPoint::vkGetFenceStatus);
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL wait_for_fences(VkDevice device, uint32_t count, const VkFence *fences, VkBool32 wait_all, uint64_t timeout)
+{
+	count_call(EntryPoint::vkWaitForFences);
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL get_query_pool_results(VkDevice device, VkQueryPool query_pool, uint32_t first_query, uint32_t query_count, size_t data_size, void *data, VkDeviceSize stride, VkQueryResultFlags flags)
+{
+	count_call(EntryPoint::vkGetQueryPoolResults);
+
+	// Nothing was executed, so every query reports zero
+	std::memset(data, 0, data_size);
+	return VK_SUCCESS;
+}
+
+/**
+ * @brief Implements a command by counting it
+ */
+template <typename Function, EntryPoint entry_point>
+struct Command;
+
+template <typename... Args, EntryPoint entry_point>
+struct Command<void(VKAPI_PTR *)(Args...), entry_point>
+{
+	static VKAPI_ATTR void VKAPI_CALL record(Args...)
+	{
+		count_call(entry_point);
+	}
+};
+
+const std::unordered_map<std::string, PFN_vkVoidFunction> &get_entry_points()
+{
+#define NULL_DEVICE_FUNCTION(name, function) \
+	{#name, reinterpret_cast<PFN_vkVoidFunction>(static_cast<PFN_##name>(function))},
+#define NULL_DEVICE_COMMAND(name) \
+	{#name, reinterpret_cast<PFN_vkVoidFunction>(&Command<PFN_##name, EntryPoint::name>::record)},
+
+	// clang-format off
+	static const std::unordered_map<std::string, PFN_vkVoidFunction> entry_points{
+		NULL_DEVICE_FUNCTIONS(NULL_DEVICE_FUNCTION)
+		NULL_DEVICE_COMMANDS(NULL_DEVICE_COMMAND)
+	};
+	// clang-format on
+
+#undef NULL_DEVICE_FUNCTION
+#undef NULL_DEVICE_COMMAND
+
+	return entry_points;
+}
+
+VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL get_instance_proc_addr(VkInstance instance, const char *name)
+{
+	auto &entry_points = get_entry_points();
+
+	auto entry_point_it = entry_points.find(name);
+
+	// Entry points of unsupported extensions aren't exposed, like with a driver
+	return entry_point_it != entry_points.end() ? entry_point_it->second : nullptr;
+}
+}        // namespace
+
+void enable()
+{
+	enabled = true;
+}
+
+bool is_enabled()
+{
+	return enabled;
+}
+
+VkResult initialize()
+{
+	volkInitializeCustom(get_instance_proc_addr);
+
+	return VK_SUCCESS;
+}
+
+std::vector<std::pair<std::string, uint64_t>> get_call_counts()
+{
+	std::vector<std::pair<std::string, uint64_t>> counts;
+
+	for (size_t i = 0; i < call_counts.size(); ++i)
+	{
+		uint64_t count = call_counts[i].load(std::memory_order_relaxed);
+
+		if (count > 0)
+		{
+			counts.emplace_back(entry_point_names[i], count);
+		}
+	}
+
+	return counts;
+}
+
+void reset_call_counts()
+{
+	for (auto &count : call_counts)
+	{
+		count.store(0, std::memory_order_relaxed);
+	}
+}
+}        // namespace null_device
+}        // namespace vkb
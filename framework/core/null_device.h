@@ -0,0 +1,61 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/vk_common.h"
+
+namespace vkb
+{
+/**
+ * @brief A Vulkan implementation that runs without a GPU
+ *
+ * When enabled, volk is initialized with the entry points of the null device instead of the
+ * Vulkan loader. The null device exposes a single physical device with a headless surface,
+ * accepts object creation and command recording, returns unique dummy handles and counts the
+ * calls made to each entry point. Nothing is executed, so frames only cost the CPU time of
+ * the framework, which makes it possible to benchmark the framework on machines without a GPU.
+ *
+ * Only the core entry points and the surface and swapchain extensions are implemented, the
+ * entry points of other extensions are not exposed.
+ */
+namespace null_device
+{
+/**
+ * @brief Makes the next Vulkan initialization use the null device
+ */
+void enable();
+
+bool is_enabled();
+
+/**
+ * @brief Initializes volk with the entry points of the null device
+ */
+VkResult initialize();
+
+/**
+ * @return The entry points called since the last reset, with their call count
+ */
+std::vector<std::pair<std::string, uint64_t>> get_call_counts();
+
+void reset_call_counts();
+}        // namespace null_device
+}        // namespace vkb
@@ -196,6 +196,10 @@ GraphicsPipeline::GraphicsPipeline(Device &        device,
 	input_assembly_state.topology               = pipeline_state.get_input_assembly_state().topology;
 	input_assembly_state.primitiveRestartEnable = pipeline_state.get_input_assembly_state().primitive_restart_enable;
 
+	VkPipelineTessellationStateCreateInfo tessellation_state{VK_STRUCTURE_TYPE_PIPELINE_TESSELLATION_STATE_CREATE_INFO};
+
+	tessellation_state.patchControlPoints = pipeline_state.get_tessellation_state().patch_control_points;
+
 	VkPipelineViewportStateCreateInfo viewport_state{VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO};
 
 	viewport_state.viewportCount = pipeline_state.get_viewport_state().viewport_count;
@@ -259,7 +263,7 @@ GraphicsPipeline::GraphicsPipeline(Device &        device,
 	color_blend_state.blendConstants[2] = 1.0f;
 	color_blend_state.blendConstants[3] = 1.0f;
 
-	std::array<VkDynamicState, 9> dynamic_states{
+	std::vector<VkDynamicState> dynamic_states{
 	    VK_DYNAMIC_STATE_VIEWPORT,
 	    VK_DYNAMIC_STATE_SCISSOR,
 	    VK_DYNAMIC_STATE_LINE_WIDTH,
@@ -271,6 +275,22 @@ GraphicsPipeline::GraphicsPipeline(Device &        device,
 	    VK_DYNAMIC_STATE_STENCIL_REFERENCE,
 	};
 
+	// States left out of the pipeline key are recorded by the command buffer
+	if (pipeline_state.get_extended_dynamic_state().extended_dynamic_state)
+	{
+		dynamic_states.push_back(VK_DYNAMIC_STATE_CULL_MODE_EXT);
+		dynamic_states.push_back(VK_DYNAMIC_STATE_FRONT_FACE_EXT);
+		dynamic_states.push_back(VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY_EXT);
+		dynamic_states.push_back(VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE_EXT);
+		dynamic_states.push_back(VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE_EXT);
+		dynamic_states.push_back(VK_DYNAMIC_STATE_DEPTH_COMPARE_OP_EXT);
+	}
+
+	if (pipeline_state.get_extended_dynamic_state().patch_control_points)
+	{
+		dynamic_states.push_back(VK_DYNAMIC_STATE_PATCH_CONTROL_POINTS_EXT);
+	}
+
 	VkPipelineDynamicStateCreateInfo dynamic_state{VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO};
 
 	dynamic_state.pDynamicStates    = dynamic_states.data();
@@ -278,6 +298,7 @@ GraphicsPipeline::GraphicsPipeline(Device &        device,
 
 	create_info.pVertexInputState   = &vertex_input_state;
 	create_info.pInputAssemblyState = &input_assembly_state;
+	create_info.pTessellationState  = input_assembly_state.topology == VK_PRIMITIVE_TOPOLOGY_PATCH_LIST ? &tessellation_state : nullptr;
 	create_info.pViewportState      = &viewport_state;
 	create_info.pRasterizationState = &rasterization_state;
 	create_info.pMultisampleState   = &multisample_state;
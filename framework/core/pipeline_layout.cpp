@@ -24,9 +24,40 @@
 
 namespace vkb
 {
-PipelineLayout::PipelineLayout(Device &device, const std::vector<ShaderModule *> &shader_modules) :
+namespace
+{
+inline bool can_push_descriptors(const std::vector<ShaderResource> &resource_set, uint32_t max_push_descriptors)
+{
+	uint32_t descriptor_count = 0;
+
+	for (auto &resource : resource_set)
+	{
+		// Skip shader resources without a binding point
+		if (resource.type == ShaderResourceType::Input ||
+		    resource.type == ShaderResourceType::Output ||
+		    resource.type == ShaderResourceType::PushConstant ||
+		    resource.type == ShaderResourceType::SpecializationConstant)
+		{
+			continue;
+		}
+
+		// Dynamic and update-after-bind descriptors cannot be pushed
+		if (resource.mode != ShaderResourceMode::Static || resource.array_size == 0)
+		{
+			return false;
+		}
+
+		descriptor_count += resource.array_size;
+	}
+
+	return descriptor_count > 0 && descriptor_count <= max_push_descriptors;
+}
+}        // namespace
+
+PipelineLayout::PipelineLayout(Device &device, const std::vector<ShaderModule *> &shader_modules, bool use_push_descriptors) :
     device{device},
-    shader_modules{shader_modules}
+    shader_modules{shader_modules},
+    use_push_descriptors{use_push_descriptors}
 {
 	// Collect and combine all the shader resources from each of the shader modules
 	// Collate them all into a map that is indexed by the name of the resource
@@ -78,10 +109,32 @@ PipelineLayout::PipelineLayout(Device &device, const std::vector<ShaderModule *>
 		}
 	}
 
-	// Create a descriptor set layout for each shader set in the shader modules
+	// Only one set of a pipeline layout can be pushed, so pick the lowest set index that is small enough,
+	// as the framework binds the resources that change with every draw at the first sets
+	uint32_t push_descriptor_set = ~0U;
+
+	if (use_push_descriptors)
+	{
+		for (auto &shader_set_it : shader_sets)
+		{
+			if (shader_set_it.first < push_descriptor_set && can_push_descriptors(shader_set_it.second, device.get_max_push_descriptors()))
+			{
+				push_descriptor_set = shader_set_it.first;
+			}
+		}
+	}
+
+	// Create a descriptor set layout for each shader set in the shader modules, in set order
+	std::vector<uint32_t> set_indices;
 	for (auto &shader_set_it : shader_sets)
 	{
-		descriptor_set_layouts.emplace_back(&device.get_resource_cache().request_descriptor_set_layout(shader_set_it.first, shader_modules, shader_set_it.second));
+		set_indices.push_back(shader_set_it.first);
+	}
+	std::sort(set_indices.begin(), set_indices.end());
+
+	for (auto set_index : set_indices)
+	{
+		descriptor_set_layouts.emplace_back(&device.get_resource_cache().request_descriptor_set_layout(set_index, shader_modules, shader_sets.at(set_index), set_index == push_descriptor_set));
 	}
 
 	// Collect all the descriptor set layout handles, maintaining set order
@@ -127,7 +180,8 @@ PipelineLayout::PipelineLayout(PipelineLayout &&other) :
     shader_modules{std::move(other.shader_modules)},
     shader_resources{std::move(other.shader_resources)},
     shader_sets{std::move(other.shader_sets)},
-    descriptor_set_layouts{std::move(other.descriptor_set_layouts)}
+    descriptor_set_layouts{std::move(other.descriptor_set_layouts)},
+    use_push_descriptors{other.use_push_descriptors}
 {
 	other.handle = VK_NULL_HANDLE;
 }
@@ -206,4 +260,9 @@ VkShaderStageFlags PipelineLayout::get_push_constant_range_stage(uint32_t size,
 	}
 	return stages;
 }
+
+bool PipelineLayout::uses_push_descriptors() const
+{
+	return use_push_descriptors;
+}
 }        // namespace vkb
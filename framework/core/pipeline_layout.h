@@ -31,7 +31,7 @@ class DescriptorSetLayout;
 class PipelineLayout
 {
   public:
-	PipelineLayout(Device &device, const std::vector<ShaderModule *> &shader_modules);
+	PipelineLayout(Device &device, const std::vector<ShaderModule *> &shader_modules, bool use_push_descriptors = false);
 
 	PipelineLayout(const PipelineLayout &) = delete;
 
@@ -57,6 +57,8 @@ class PipelineLayout
 
 	VkShaderStageFlags get_push_constant_range_stage(uint32_t size, uint32_t offset = 0) const;
 
+	bool uses_push_descriptors() const;
+
   private:
 	Device &device;
 
@@ -73,5 +75,8 @@ class PipelineLayout
 
 	// The different descriptor set layouts for this pipeline layout
 	std::vector<DescriptorSetLayout *> descriptor_set_layouts;
+
+	// Whether one of the descriptor set layouts may be recorded with push descriptors
+	bool use_push_descriptors{false};
 };
 }        // namespace vkb
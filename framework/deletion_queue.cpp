@@ -0,0 +1,99 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "deletion_queue.h"
+
+namespace vkb
+{
+DeletionQueue::~DeletionQueue()
+{
+	flush();
+}
+
+void DeletionQueue::push_callback(std::function<void()> &&callback)
+{
+	std::lock_guard<std::mutex> guard(mutex);
+	entries.push_back({frame_index, nullptr, std::move(callback)});
+}
+
+void DeletionQueue::push_object(std::shared_ptr<void> &&object)
+{
+	std::lock_guard<std::mutex> guard(mutex);
+	entries.push_back({frame_index, std::move(object), nullptr});
+}
+
+uint64_t DeletionQueue::end_frame()
+{
+	std::lock_guard<std::mutex> guard(mutex);
+	return frame_index++;
+}
+
+void DeletionQueue::collect(uint64_t completed_frame_index)
+{
+	std::deque<Entry> completed;
+
+	{
+		std::lock_guard<std::mutex> guard(mutex);
+
+		while (!entries.empty() && entries.front().frame_index <= completed_frame_index)
+		{
+			completed.push_back(std::move(entries.front()));
+			entries.pop_front();
+		}
+	}
+
+	// Destroyed outside of the lock, so that a destructor or callback may queue more objects
+	destroy(std::move(completed));
+}
+
+void DeletionQueue::flush()
+{
+	std::deque<Entry> all;
+
+	{
+		std::lock_guard<std::mutex> guard(mutex);
+		std::swap(all, entries);
+	}
+
+	destroy(std::move(all));
+}
+
+uint64_t DeletionQueue::get_frame_index() const
+{
+	std::lock_guard<std::mutex> guard(mutex);
+	return frame_index;
+}
+
+size_t DeletionQueue::get_pending_count() const
+{
+	std::lock_guard<std::mutex> guard(mutex);
+	return entries.size();
+}
+
+void DeletionQueue::destroy(std::deque<Entry> &&entries_to_destroy)
+{
+	// In the order they were queued
+	for (auto &entry : entries_to_destroy)
+	{
+		if (entry.callback)
+		{
+			entry.callback();
+		}
+		entry.object.reset();
+	}
+}
+}        // namespace vkb
@@ -0,0 +1,117 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+namespace vkb
+{
+/**
+ * @brief Destroys objects once the GPU work that may use them completed
+ *
+ * Objects and callbacks are queued with the index of the frame being recorded. Once the work of a
+ * frame was submitted, end_frame() starts the next index, and once the fences of the frame signaled,
+ * collect() destroys everything queued up to it. This replaces waiting for the device to idle before
+ * destroying buffers, images, views, pools or pipelines which may still be in use.
+ *
+ * Objects queued outside of frames, such as during loading, belong to the next frame submitted.
+ */
+class DeletionQueue
+{
+  public:
+	DeletionQueue() = default;
+
+	DeletionQueue(const DeletionQueue &) = delete;
+
+	DeletionQueue(DeletionQueue &&) = delete;
+
+	~DeletionQueue();
+
+	DeletionQueue &operator=(const DeletionQueue &) = delete;
+
+	DeletionQueue &operator=(DeletionQueue &&) = delete;
+
+	/**
+	 * @brief Takes ownership of an object, such as a core::Buffer or a std::unique_ptr<CommandPool>,
+	 *        and destroys it once the current frame completed
+	 */
+	template <typename T>
+	void push(T &&object)
+	{
+		push_object(std::make_shared<typename std::decay<T>::type>(std::forward<T>(object)));
+	}
+
+	/**
+	 * @brief Calls a function once the current frame completed, for example to destroy raw Vulkan handles
+	 */
+	void push_callback(std::function<void()> &&callback);
+
+	/**
+	 * @brief Ends the current frame, called once its work was submitted
+	 * @return The index of the frame, to pass to collect() once its fences signaled
+	 */
+	uint64_t end_frame();
+
+	/**
+	 * @brief Destroys the objects queued up to and including a frame
+	 * @param completed_frame_index A frame index returned by end_frame(), of which the work completed
+	 */
+	void collect(uint64_t completed_frame_index);
+
+	/**
+	 * @brief Destroys all the queued objects, the device must be idle
+	 */
+	void flush();
+
+	/**
+	 * @return The index of the frame the objects are currently queued for
+	 */
+	uint64_t get_frame_index() const;
+
+	/**
+	 * @return The number of objects and callbacks waiting for their frame to complete
+	 */
+	size_t get_pending_count() const;
+
+  private:
+	struct Entry
+	{
+		uint64_t frame_index;
+
+		std::shared_ptr<void> object;
+
+		std::function<void()> callback;
+	};
+
+	void push_object(std::shared_ptr<void> &&object);
+
+	void destroy(std::deque<Entry> &&entries_to_destroy);
+
+	mutable std::mutex mutex;
+
+	uint64_t frame_index{0};
+
+	/// Ordered by frame index
+	std::deque<Entry> entries;
+};
+}        // namespace vkb
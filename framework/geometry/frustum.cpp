@@ -1,4 +1,4 @@
-/* Copyright (c) 2019, Sascha Willems
+/* Copyright (c) 2019-2023, Sascha Willems
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -69,6 +69,21 @@ bool Frustum::check_sphere(glm::vec3 pos, float radius)
 	}
 	return true;
 }
+
+bool Frustum::check_box(const glm::vec3 &min, const glm::vec3 &max) const
+{
+	for (auto &plane : planes)
+	{
+		// The corner of the box furthest along the plane's normal
+		glm::vec3 corner(plane.x > 0.0f ? max.x : min.x, plane.y > 0.0f ? max.y : min.y, plane.z > 0.0f ? max.z : min.z);
+		if (glm::dot(glm::vec3(plane), corner) + plane.w < 0.0f)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
 const std::array<glm::vec4, 6> &Frustum::get_planes() const
 {
 	return planes;
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2022, Sascha Willems
+/* Copyright (c) 2019-2023, Sascha Willems
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -57,6 +57,14 @@ class Frustum
 	 */
 	bool check_sphere(glm::vec3 pos, float radius);
 
+	/**
+	 * @brief Checks if an axis aligned box is inside the Frustum, boxes near the corners
+	 *        of the Frustum can pass the test while being outside
+	 * @param min The minimum corner of the box
+	 * @param max The maximum corner of the box
+	 */
+	bool check_box(const glm::vec3 &min, const glm::vec3 &max) const;
+
 	const std::array<glm::vec4, 6> &get_planes() const;
 
   private:
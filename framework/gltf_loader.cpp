@@ -21,6 +21,7 @@
 
 #include <limits>
 #include <queue>
+#include <unordered_set>
 
 #include "common/error.h"
 
@@ -353,7 +354,7 @@ static inline bool texture_needs_srgb_colorspace(const std::string &name)
 std::unordered_map<std::string, bool> GLTFLoader::supported_extensions = {
     {KHR_LIGHTS_PUNCTUAL_EXTENSION, false}};
 
-GLTFLoader::GLTFLoader(Device const &device) :
+GLTFLoader::GLTFLoader(Device &device) :
     device{device}
 {
 }
@@ -400,7 +401,7 @@ std::unique_ptr<sg::Scene> GLTFLoader::read_scene_from_file(const std::string &f
 	return std::make_unique<sg::Scene>(load_scene(scene_index));
 }
 
-std::unique_ptr<sg::SubMesh> GLTFLoader::read_model_from_file(const std::string &file_name, uint32_t index)
+std::unique_ptr<sg::SubMesh> GLTFLoader::read_model_from_file(const std::string &file_name, uint32_t index, VkBufferUsageFlags buffer_usage)
 {
 	std::string err;
 	std::string warn;
@@ -439,7 +440,7 @@ std::unique_ptr<sg::SubMesh> GLTFLoader::read_model_from_file(const std::string
 		model_path.clear();
 	}
 
-	return std::move(load_model(index));
+	return std::move(load_model(index, buffer_usage));
 }
 
 sg::Scene GLTFLoader::load_scene(int scene_index)
@@ -563,10 +564,11 @@ sg::Scene GLTFLoader::load_scene(int scene_index)
 
 		queue.submit(command_buffer, device.request_fence());
 
+		// The fence of the batch guards both the command pool and the staging buffers,
+		// waiting for the whole device to idle is not needed
 		device.get_fence_pool().wait();
 		device.get_fence_pool().reset();
 		device.get_command_pool().reset_pool();
-		device.wait_idle();
 
 		// Remove the staging buffers for the batch we just processed
 		transient_buffers.clear();
@@ -607,6 +609,14 @@ sg::Scene GLTFLoader::load_scene(int scene_index)
 		scene.add_component(std::move(texture));
 	}
 
+	// Report the samplers shared through the resource cache
+	std::unordered_set<VkSampler> vk_samplers{default_sampler->get_vk_sampler().get_handle()};
+	for (auto sampler : samplers)
+	{
+		vk_samplers.insert(sampler->get_vk_sampler().get_handle());
+	}
+	LOGI("Scene samplers: {} created for {} glTF samplers and the default sampler", vk_samplers.size(), samplers.size() + 1);
+
 	scene.add_component(std::move(default_sampler));
 
 	// Load materials
@@ -1025,7 +1035,7 @@ sg::Scene GLTFLoader::load_scene(int scene_index)
 	return scene;
 }
 
-std::unique_ptr<sg::SubMesh> GLTFLoader::load_model(uint32_t index)
+std::unique_ptr<sg::SubMesh> GLTFLoader::load_model(uint32_t index, VkBufferUsageFlags buffer_usage)
 {
 	auto submesh = std::make_unique<sg::SubMesh>();
 
@@ -1110,7 +1120,7 @@ std::unique_ptr<sg::SubMesh> GLTFLoader::load_model(uint32_t index)
 
 	core::Buffer buffer{device,
 	                    vertex_data.size() * sizeof(Vertex),
-	                    VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+	                    VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | buffer_usage,
 	                    VMA_MEMORY_USAGE_GPU_ONLY};
 
 	command_buffer.copy_buffer(stage_buffer, buffer, vertex_data.size() * sizeof(Vertex));
@@ -1162,7 +1172,7 @@ std::unique_ptr<sg::SubMesh> GLTFLoader::load_model(uint32_t index)
 
 		submesh->index_buffer = std::make_unique<core::Buffer>(device,
 		                                                       index_data.size(),
-		                                                       VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+		                                                       VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT | buffer_usage,
 		                                                       VMA_MEMORY_USAGE_GPU_ONLY);
 
 		command_buffer.copy_buffer(stage_buffer, *submesh->index_buffer, index_data.size());
@@ -1374,10 +1384,8 @@ std::unique_ptr<sg::Sampler> GLTFLoader::parse_sampler(const tinygltf::Sampler &
 	sampler_info.borderColor  = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE;
 	sampler_info.maxLod       = std::numeric_limits<float>::max();
 
-	core::Sampler vk_sampler{device, sampler_info};
-	vk_sampler.set_debug_name(gltf_sampler.name);
-
-	return std::make_unique<sg::Sampler>(name, std::move(vk_sampler));
+	// glTF files often repeat the same sampler state, and it usually matches the default sampler
+	return std::make_unique<sg::Sampler>(name, device.get_resource_cache(), sampler_info);
 }
 
 std::unique_ptr<sg::Texture> GLTFLoader::parse_texture(const tinygltf::Texture &gltf_texture) const
@@ -1,5 +1,5 @@
-/* Copyright (c) 2018-2021, Arm Limited and Contributors
- * Copyright (c) 2019-2021, Sascha Willems
+/* Copyright (c) 2018-2023, Arm Limited and Contributors
+ * Copyright (c) 2019-2023, Sascha Willems
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -69,7 +69,7 @@ struct TypeCast
 class GLTFLoader
 {
   public:
-	GLTFLoader(Device const &device);
+	GLTFLoader(Device &device);
 
 	virtual ~GLTFLoader() = default;
 
@@ -78,8 +78,9 @@ class GLTFLoader
 	/**
 	 * @brief Loads the first model from a GLTF file for use in simpler samples
 	 *        makes use of the Vertex struct in vulkan_example_base.h
+	 * @param buffer_usage Usage flags added to the vertex and index buffers, e.g. to read them in compute shaders
 	 */
-	std::unique_ptr<sg::SubMesh> read_model_from_file(const std::string &file_name, uint32_t index);
+	std::unique_ptr<sg::SubMesh> read_model_from_file(const std::string &file_name, uint32_t index, VkBufferUsageFlags buffer_usage = 0);
 
   protected:
 	virtual std::unique_ptr<sg::Node> parse_node(const tinygltf::Node &gltf_node, size_t index) const;
@@ -122,7 +123,7 @@ class GLTFLoader
 	 */
 	tinygltf::Value *get_extension(tinygltf::ExtensionMap &tinygltf_extensions, const std::string &extension);
 
-	Device const &device;
+	Device &device;
 
 	tinygltf::Model model;
 
@@ -134,6 +135,6 @@ class GLTFLoader
   private:
 	sg::Scene load_scene(int scene_index = -1);
 
-	std::unique_ptr<sg::SubMesh> load_model(uint32_t index);
+	std::unique_ptr<sg::SubMesh> load_model(uint32_t index, VkBufferUsageFlags buffer_usage);
 };
 }        // namespace vkb
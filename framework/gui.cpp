@@ -18,6 +18,7 @@
 
 #include "gui.h"
 
+#include <cstring>
 #include <map>
 #include <numeric>
 
@@ -64,6 +65,58 @@ void upload_draw_data(ImDrawData *draw_data, const uint8_t *vertex_data, const u
 	}
 }
 
+/**
+ * @brief Hashes a block of memory eight bytes at a time, with the FNV-1a constants
+ */
+size_t hash_memory(const void *data, size_t size)
+{
+	const auto *bytes = static_cast<const uint8_t *>(data);
+	uint64_t    hash  = 14695981039346656037ull ^ size;
+	size_t      i     = 0;
+
+	for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+	{
+		uint64_t word;
+		std::memcpy(&word, bytes + i, sizeof(word));
+		hash = (hash ^ word) * 1099511628211ull;
+	}
+
+	for (; i < size; i++)
+	{
+		hash = (hash ^ bytes[i]) * 1099511628211ull;
+	}
+
+	return static_cast<size_t>(hash);
+}
+
+/**
+ * @brief Hashes the vertices and indices of the draw data, and separately the draw commands recorded from it
+ */
+void hash_draw_data(ImDrawData *draw_data, size_t &geometry_hash, size_t &commands_hash)
+{
+	geometry_hash = 0;
+	commands_hash = 0;
+
+	for (int n = 0; n < draw_data->CmdListsCount; n++)
+	{
+		const ImDrawList *cmd_list = draw_data->CmdLists[n];
+
+		hash_combine(geometry_hash, hash_memory(cmd_list->VtxBuffer.Data, cmd_list->VtxBuffer.Size * sizeof(ImDrawVert)));
+		hash_combine(geometry_hash, hash_memory(cmd_list->IdxBuffer.Data, cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx)));
+
+		hash_combine(commands_hash, cmd_list->VtxBuffer.Size);
+		for (int i = 0; i < cmd_list->CmdBuffer.Size; i++)
+		{
+			const ImDrawCmd &cmd = cmd_list->CmdBuffer[i];
+			hash_combine(commands_hash, cmd.ElemCount);
+			hash_combine(commands_hash, cmd.ClipRect.x);
+			hash_combine(commands_hash, cmd.ClipRect.y);
+			hash_combine(commands_hash, cmd.ClipRect.z);
+			hash_combine(commands_hash, cmd.ClipRect.w);
+		}
+	}
+}
+
 inline void reset_graph_max_value(StatGraphData &graph_data)
 {
 	// If it does not have a fixed max
@@ -370,6 +423,7 @@ void Gui::update(const float delta_time)
 	if (!visible)
 	{
 		ImGui::EndFrame();
+		end_cpu_timing();
 		return;
 	}
 
@@ -381,15 +435,70 @@ void Gui::update(const float delta_time)
 
 	// Render to generate draw buffers
 	ImGui::Render();
+
+	// Most frames draw the same gui as the previous one, which needs neither an upload nor new command buffers
+	ImDrawData *draw_data = ImGui::GetDrawData();
+	if (draw_data)
+	{
+		size_t new_geometry_hash = 0;
+		size_t new_commands_hash = 0;
+		hash_draw_data(draw_data, new_geometry_hash, new_commands_hash);
+
+		geometry_changed = new_geometry_hash != geometry_hash;
+		commands_changed = new_commands_hash != commands_hash;
+		geometry_hash    = new_geometry_hash;
+		commands_hash    = new_commands_hash;
+	}
+
+	end_cpu_timing();
+}
+
+void Gui::begin_cpu_frame()
+{
+	cpu_time       = frame_cpu_time;
+	frame_cpu_time = 0.0;
+
+	cpu_timer.start();
+}
+
+void Gui::end_cpu_timing()
+{
+	frame_cpu_time += cpu_timer.stop<Timer::Milliseconds>();
+}
+
+double Gui::get_cpu_time() const
+{
+	return cpu_time;
+}
+
+bool Gui::should_refresh_stats()
+{
+	if (!stats_timer.is_running())
+	{
+		stats_timer.start();
+		return true;
+	}
+
+	if (stats_timer.elapsed() < stats_view.update_interval)
+	{
+		return false;
+	}
+
+	stats_timer.lap();
+	return true;
 }
 
 bool Gui::update_buffers()
 {
+	cpu_timer.start();
+
 	ImDrawData *draw_data = ImGui::GetDrawData();
-	bool        updated   = false;
+	bool        updated   = commands_changed;
+	bool        upload    = geometry_changed;
 
 	if (!draw_data)
 	{
+		end_cpu_timing();
 		return false;
 	}
 
@@ -398,6 +507,7 @@ bool Gui::update_buffers()
 
 	if ((vertex_buffer_size == 0) || (index_buffer_size == 0))
 	{
+		end_cpu_timing();
 		return false;
 	}
 
@@ -405,6 +515,7 @@ bool Gui::update_buffers()
 	{
 		last_vertex_buffer_size = vertex_buffer_size;
 		updated                 = true;
+		upload                  = true;
 
 		vertex_buffer.reset();
 		vertex_buffer = std::make_unique<core::Buffer>(sample.get_render_context().get_device(), vertex_buffer_size,
@@ -417,6 +528,7 @@ bool Gui::update_buffers()
 	{
 		last_index_buffer_size = index_buffer_size;
 		updated                = true;
+		upload                 = true;
 
 		index_buffer.reset();
 		index_buffer = std::make_unique<core::Buffer>(sample.get_render_context().get_device(), index_buffer_size,
@@ -426,13 +538,22 @@ bool Gui::update_buffers()
 	}
 
 	// Upload data
-	upload_draw_data(draw_data, vertex_buffer->map(), index_buffer->map());
+	if (upload)
+	{
+		upload_draw_data(draw_data, vertex_buffer->map(), index_buffer->map());
+
+		vertex_buffer->flush();
+		index_buffer->flush();
+
+		vertex_buffer->unmap();
+		index_buffer->unmap();
+	}
 
-	vertex_buffer->flush();
-	index_buffer->flush();
+	// Only report changes once per update
+	geometry_changed = false;
+	commands_changed = false;
 
-	vertex_buffer->unmap();
-	index_buffer->unmap();
+	end_cpu_timing();
 
 	return updated;
 }
@@ -454,10 +575,16 @@ void Gui::update_buffers(CommandBuffer &command_buffer, RenderFrame &render_fram
 		return;
 	}
 
-	std::vector<uint8_t> vertex_data(vertex_buffer_size);
-	std::vector<uint8_t> index_data(index_buffer_size);
+	// The frame buffer pools are reset every frame, so only gathering the draw lists can be skipped
+	if (geometry_changed || (vertex_data.size() != vertex_buffer_size) || (index_data.size() != index_buffer_size))
+	{
+		vertex_data.resize(vertex_buffer_size);
+		index_data.resize(index_buffer_size);
+
+		upload_draw_data(draw_data, vertex_data.data(), index_data.data());
 
-	upload_draw_data(draw_data, vertex_data.data(), index_data.data());
+		geometry_changed = false;
+	}
 
 	auto vertex_allocation = sample.get_render_context().get_active_frame().allocate_buffer(VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, vertex_buffer_size);
 
@@ -491,6 +618,8 @@ void Gui::draw(CommandBuffer &command_buffer)
 		return;
 	}
 
+	cpu_timer.start();
+
 	ScopedDebugLabel debug_label{command_buffer, "GUI"};
 
 	// Vertex input state
@@ -598,6 +727,7 @@ void Gui::draw(CommandBuffer &command_buffer)
 
 	if (!draw_data || draw_data->CmdListsCount == 0)
 	{
+		end_cpu_timing();
 		return;
 	}
 
@@ -646,6 +776,8 @@ void Gui::draw(CommandBuffer &command_buffer)
 		}
 		vertex_offset += cmd_list->VtxBuffer.Size;
 	}
+
+	end_cpu_timing();
 }
 
 void Gui::draw(VkCommandBuffer command_buffer)
@@ -922,6 +1054,9 @@ void Gui::show_debug_window(DebugInfo &debug_info, const ImVec2 &position)
 
 void Gui::show_stats(const Stats &stats)
 {
+	// Graphs that change every frame would make the gui upload its geometry every frame
+	bool refresh = should_refresh_stats();
+
 	for (const auto &stat_index : stats.get_requested_stats())
 	{
 		// Find the graph data of this stat index
@@ -929,11 +1064,16 @@ void Gui::show_stats(const Stats &stats)
 
 		assert(pr != stats_view.graph_map.end() && "StatIndex not implemented in gui graph_map");
 
+		auto &graph_elements = graph_values[stat_index];
+		if (refresh || graph_elements.empty())
+		{
+			graph_elements = stats.get_data(stat_index);
+		}
+
 		// Draw graph
-		auto       &graph_data     = pr->second;
-		const auto &graph_elements = stats.get_data(stat_index);
-		float       graph_min      = 0.0f;
-		float      &graph_max      = graph_data.max_value;
+		auto  &graph_data = pr->second;
+		float  graph_min  = 0.0f;
+		float &graph_max  = graph_data.max_value;
 
 		if (!graph_data.has_fixed_max)
 		{
@@ -1000,6 +1140,8 @@ void Gui::show_simple_window(const std::string &name, uint32_t last_fps, std::fu
 {
 	ImGuiIO &io = ImGui::GetIO();
 
+	begin_cpu_frame();
+
 	ImGui::NewFrame();
 	ImGui::PushStyleVar(ImGuiStyleVar_WindowRounding, 0);
 	ImGui::SetNextWindowPos(ImVec2(10, 10));
@@ -1007,7 +1149,13 @@ void Gui::show_simple_window(const std::string &name, uint32_t last_fps, std::fu
 	ImGui::Begin("Vulkan Example", nullptr, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove);
 	ImGui::TextUnformatted(name.c_str());
 	ImGui::TextUnformatted(std::string(sample.get_render_context().get_device().get_gpu().get_properties().deviceName).c_str());
-	ImGui::Text("%.2f ms/frame (%.1d fps)", (1000.0f / last_fps), last_fps);
+	if (should_refresh_stats() || (shown_fps == 0))
+	{
+		shown_fps      = last_fps;
+		shown_cpu_time = cpu_time;
+	}
+	ImGui::Text("%.2f ms/frame (%.1d fps)", (1000.0f / shown_fps), shown_fps);
+	ImGui::Text("GUI: %.2f ms", shown_cpu_time);
 	ImGui::PushItemWidth(110.0f * dpi_factor);
 
 	body();
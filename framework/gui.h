@@ -1,5 +1,5 @@
-/* Copyright (c) 2018-2021, Arm Limited and Contributors
- * Copyright (c) 2019-2021, Sascha Willems
+/* Copyright (c) 2018-2023, Arm Limited and Contributors
+ * Copyright (c) 2019-2023, Sascha Willems
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -213,6 +213,9 @@ class Gui
 		float graph_height{50.0f};
 
 		float top_padding{1.1f};
+
+		/// Seconds between two refreshes of the graphs and frame time, 0 refreshes them every frame
+		float update_interval{0.1f};
 	};
 
 	/**
@@ -276,6 +279,11 @@ class Gui
 	 */
 	void update(const float delta_time);
 
+	/**
+	 * @brief Uploads the gui geometry to the buffers drawn by draw(VkCommandBuffer),
+	 *        unless it did not change since the last upload
+	 * @returns True if the command buffers drawing the gui need to be recorded again
+	 */
 	bool update_buffers();
 
 	/**
@@ -346,6 +354,12 @@ class Gui
 
 	bool is_debug_view_active() const;
 
+	/**
+	 * @return The CPU time spent in the gui during the last frame in milliseconds,
+	 *         from building the windows to recording the draw commands
+	 */
+	double get_cpu_time() const;
+
   private:
 	/**
 	 * @brief Block size of a buffer pool in kilobytes
@@ -358,6 +372,21 @@ class Gui
 	 */
 	void update_buffers(CommandBuffer &command_buffer, RenderFrame &render_frame);
 
+	/**
+	 * @brief Publishes the CPU time of the previous frame and starts timing a new one
+	 */
+	void begin_cpu_frame();
+
+	/**
+	 * @brief Adds the time since the gui timer was started to the CPU time of the frame
+	 */
+	void end_cpu_timing();
+
+	/**
+	 * @return True once per stats view update interval, when the graphs should take new data
+	 */
+	bool should_refresh_stats();
+
 	static const double press_time_ms;
 
 	static const float overlay_alpha;
@@ -378,6 +407,21 @@ class Gui
 
 	size_t last_index_buffer_size;
 
+	/// Hash of the vertices and indices of the last draw data
+	size_t geometry_hash{0};
+
+	/// Hash of the draw commands of the last draw data, which the command buffers are recorded from
+	size_t commands_hash{0};
+
+	bool geometry_changed{true};
+
+	bool commands_changed{true};
+
+	/// Geometry of the last draw data, copied to the frame buffer pools when a render context is used
+	std::vector<uint8_t> vertex_data;
+
+	std::vector<uint8_t> index_data;
+
 	///  Scale factor to apply due to a difference between the window and GL pixel sizes
 	float content_scale_factor{1.0f};
 
@@ -401,6 +445,23 @@ class Gui
 
 	DebugView debug_view;
 
+	/// Values shown by the graphs, refreshed at the stats view update interval
+	std::map<StatIndex, std::vector<float>> graph_values;
+
+	/// Frame rate and gui CPU time shown by the simple window, refreshed at the stats view update interval
+	uint32_t shown_fps{0};
+
+	double shown_cpu_time{0.0};
+
+	Timer stats_timer;
+
+	/// Measures the CPU time of the gui, which is spread over several calls per frame
+	Timer cpu_timer;
+
+	double frame_cpu_time{0.0};
+
+	double cpu_time{0.0};
+
 	VkDescriptorPool descriptor_pool{VK_NULL_HANDLE};
 
 	VkDescriptorSetLayout descriptor_set_layout{VK_NULL_HANDLE};
@@ -425,6 +486,7 @@ class Gui
 
 void Gui::new_frame()
 {
+	begin_cpu_frame();
 	ImGui::NewFrame();
 }
 }        // namespace vkb
@@ -19,16 +19,20 @@
 
 #include <cstring>
 
-#include "common/error.h"
-
-VKBP_DISABLE_WARNINGS()
-#include "common/glm_common.h"
-VKBP_ENABLE_WARNINGS()
-
+#include "geometry/frustum.h"
 #include "platform/filesystem.h"
 
 namespace vkb
 {
+namespace
+{
+bool intersects_sphere(const glm::vec3 &center, const float radius, const glm::vec3 &min, const glm::vec3 &max)
+{
+	glm::vec3 offset = glm::max(glm::max(min - center, center - max), glm::vec3(0.0f));
+	return glm::dot(offset, offset) <= radius * radius;
+}
+}        // namespace
+
 HeightMap::HeightMap(const std::string &file_name, const uint32_t patchsize)
 {
 	std::string file_path = fs::path::get(fs::path::Assets, file_name);
@@ -42,19 +46,24 @@ HeightMap::HeightMap(const std::string &file_name, const uint32_t patchsize)
 	ktx_size_t   ktx_size  = ktxTexture_GetImageSize(ktx_texture, 0);
 	ktx_uint8_t *ktx_image = ktxTexture_GetData(ktx_texture);
 
-	dim  = ktx_texture->baseWidth;
-	data = new uint16_t[dim * dim];
+	dim = ktx_texture->baseWidth;
+	data.resize(dim * dim);
 
-	memcpy(data, ktx_image, ktx_size);
+	memcpy(data.data(), ktx_image, std::min(static_cast<size_t>(ktx_size), data.size() * sizeof(uint16_t)));
 
 	this->scale = dim / patchsize;
 
 	ktxTexture_Destroy(ktx_texture);
+
+	build_pyramid();
 }
 
-HeightMap::~HeightMap()
+HeightMap::HeightMap(std::vector<uint16_t> &&data, const uint32_t dim, const uint32_t patchsize) :
+    data{std::move(data)}, dim{dim}, scale{dim / patchsize}
 {
-	delete[] data;
+	assert(dim >= 2 && this->data.size() == dim * dim);
+
+	build_pyramid();
 }
 
 float HeightMap::get_height(const uint32_t x, const uint32_t y)
@@ -63,6 +72,187 @@ float HeightMap::get_height(const uint32_t x, const uint32_t y)
 	rpos.x          = std::max(0, std::min(rpos.x, static_cast<int>(dim) - 1));
 	rpos.y          = std::max(0, std::min(rpos.y, static_cast<int>(dim) - 1));
 	rpos /= glm::ivec2(scale);
-	return *(data + (rpos.x + rpos.y * dim) * scale) / 65535.0f;
+	return data[(rpos.x + rpos.y * dim) * scale] / 65535.0f;
+}
+
+float HeightMap::sample(const glm::vec2 &uv) const
+{
+	// Texel centers are at (i + 0.5) / dim in texture coordinates
+	glm::vec2 position = glm::clamp(uv * static_cast<float>(dim) - 0.5f, glm::vec2(0.0f), glm::vec2(static_cast<float>(dim - 1)));
+
+	uint32_t x = std::min(static_cast<uint32_t>(position.x), dim - 2);
+	uint32_t y = std::min(static_cast<uint32_t>(position.y), dim - 2);
+
+	float fx = position.x - static_cast<float>(x);
+	float fy = position.y - static_cast<float>(y);
+
+	const uint16_t *upper_row = data.data() + y * dim + x;
+	const uint16_t *lower_row = upper_row + dim;
+
+	float upper = static_cast<float>(upper_row[0]) + (static_cast<float>(upper_row[1]) - static_cast<float>(upper_row[0])) * fx;
+	float lower = static_cast<float>(lower_row[0]) + (static_cast<float>(lower_row[1]) - static_cast<float>(lower_row[0])) * fx;
+
+	return (upper + (lower - upper) * fy) / 65535.0f;
+}
+
+uint32_t HeightMap::get_dimension() const
+{
+	return dim;
+}
+
+uint32_t HeightMap::get_level_count() const
+{
+	return static_cast<uint32_t>(levels.size());
+}
+
+glm::vec2 HeightMap::get_height_range(const uint32_t level, const uint32_t x, const uint32_t y) const
+{
+	const HeightRange &range = levels[level][y * level_sizes[level] + x];
+	return glm::vec2(range.min, range.max) / 65535.0f;
+}
+
+std::vector<HeightMap::Node> HeightMap::select_nodes(const glm::vec3 &camera_position, const LodSettings &settings, const Frustum *frustum) const
+{
+	const uint32_t root_level = get_level_count() - 1;
+
+	uint32_t leaf_level = 0;
+	while (leaf_level < root_level && (2u << leaf_level) <= settings.leaf_size)
+	{
+		leaf_level++;
+	}
+
+	std::vector<Node> nodes;
+	if (!select_node(root_level, 0, 0, root_level - leaf_level, camera_position, settings, frustum, nodes))
+	{
+		// The camera is beyond the range of the coarsest level, so the whole heightmap is drawn at that level
+		Node root = get_node(root_level, 0, 0, root_level - leaf_level, settings);
+		if (!frustum || frustum->check_box(root.min, root.max))
+		{
+			nodes.push_back(root);
+		}
+	}
+
+	return nodes;
+}
+
+void HeightMap::build_pyramid()
+{
+	levels.clear();
+	level_sizes.clear();
+
+	// Level 0 bounds the bilinear surface between each 2x2 texels
+	uint32_t size = dim - 1;
+
+	std::vector<HeightRange> cells(size * size);
+	for (uint32_t y = 0; y < size; ++y)
+	{
+		const uint16_t *upper_row = data.data() + y * dim;
+		const uint16_t *lower_row = upper_row + dim;
+
+		for (uint32_t x = 0; x < size; ++x)
+		{
+			HeightRange &range = cells[y * size + x];
+			range.min          = std::min(std::min(upper_row[x], upper_row[x + 1]), std::min(lower_row[x], lower_row[x + 1]));
+			range.max          = std::max(std::max(upper_row[x], upper_row[x + 1]), std::max(lower_row[x], lower_row[x + 1]));
+		}
+	}
+
+	levels.push_back(std::move(cells));
+	level_sizes.push_back(size);
+
+	// Each following level combines 2x2 cells of the previous one, cells on odd sized edges have fewer children
+	while (size > 1)
+	{
+		const uint32_t                  next_size = (size + 1) / 2;
+		const std::vector<HeightRange> &previous  = levels.back();
+
+		std::vector<HeightRange> next(next_size * next_size);
+		for (uint32_t y = 0; y < next_size; ++y)
+		{
+			for (uint32_t x = 0; x < next_size; ++x)
+			{
+				HeightRange range = previous[2 * y * size + 2 * x];
+				for (uint32_t child_y = 2 * y; child_y < std::min(2 * y + 2, size); ++child_y)
+				{
+					for (uint32_t child_x = 2 * x; child_x < std::min(2 * x + 2, size); ++child_x)
+					{
+						const HeightRange &child = previous[child_y * size + child_x];
+						range.min                = std::min(range.min, child.min);
+						range.max                = std::max(range.max, child.max);
+					}
+				}
+				next[y * next_size + x] = range;
+			}
+		}
+
+		levels.push_back(std::move(next));
+		level_sizes.push_back(next_size);
+		size = next_size;
+	}
+}
+
+HeightMap::Node HeightMap::get_node(const uint32_t level, const uint32_t x, const uint32_t y, const uint32_t lod, const LodSettings &settings) const
+{
+	const HeightRange &range = levels[level][y * level_sizes[level] + x];
+
+	Node node;
+	node.size   = 1u << level;
+	node.offset = glm::uvec2(x, y) * node.size;
+	node.lod    = lod;
+
+	// Nodes on the far edges can extend past the last texel
+	glm::vec3 first = settings.origin + settings.scale * glm::vec3(static_cast<float>(node.offset.x), range.min / 65535.0f, static_cast<float>(node.offset.y));
+	glm::vec3 last  = settings.origin + settings.scale * glm::vec3(static_cast<float>(std::min(node.offset.x + node.size, dim - 1)), range.max / 65535.0f, static_cast<float>(std::min(node.offset.y + node.size, dim - 1)));
+
+	// The scale can be negative, for example for a y axis pointing down
+	node.min = glm::min(first, last);
+	node.max = glm::max(first, last);
+
+	return node;
+}
+
+bool HeightMap::select_node(const uint32_t level, const uint32_t x, const uint32_t y, const uint32_t lod, const glm::vec3 &camera_position, const LodSettings &settings, const Frustum *frustum, std::vector<Node> &nodes) const
+{
+	Node node = get_node(level, x, y, lod, settings);
+
+	// Out of range nodes are left to the parent, which draws them at its own level of detail
+	const float range = settings.lod_distance * static_cast<float>(1u << lod);
+	if (!intersects_sphere(camera_position, range, node.min, node.max))
+	{
+		return false;
+	}
+
+	// Culled nodes count as handled, so that the parent doesn't draw them either
+	if (frustum && !frustum->check_box(node.min, node.max))
+	{
+		return true;
+	}
+
+	if (lod == 0 || !intersects_sphere(camera_position, 0.5f * range, node.min, node.max))
+	{
+		nodes.push_back(node);
+		return true;
+	}
+
+	for (uint32_t child = 0; child < 4; ++child)
+	{
+		const uint32_t child_x = 2 * x + (child & 1);
+		const uint32_t child_y = 2 * y + (child >> 1);
+		if (child_x >= level_sizes[level - 1] || child_y >= level_sizes[level - 1])
+		{
+			continue;
+		}
+
+		if (!select_node(level - 1, child_x, child_y, lod - 1, camera_position, settings, frustum, nodes))
+		{
+			Node child_node = get_node(level - 1, child_x, child_y, lod, settings);
+			if (!frustum || frustum->check_box(child_node.min, child_node.max))
+			{
+				nodes.push_back(child_node);
+			}
+		}
+	}
+
+	return true;
 }
 }        // namespace vkb
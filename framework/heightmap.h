@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2021, Sascha Willems
+/* Copyright (c) 2019-2023, Sascha Willems
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -19,15 +19,66 @@
 
 #include <ktx.h>
 #include <string>
+#include <vector>
+
+#include "common/error.h"
+
+VKBP_DISABLE_WARNINGS()
+#include "common/glm_common.h"
+VKBP_ENABLE_WARNINGS()
 
 namespace vkb
 {
+class Frustum;
+
 /**
  * @brief Class representing a heightmap loaded from a ktx texture
+ *
+ * Besides the texels, the heightmap keeps a pyramid with the minimum and maximum height of each
+ * block of texels, which bounds the terrain for culling and level of detail selection.
+ * Level 0 of the pyramid has a cell between each 2x2 texels, every following level halves the
+ * resolution until a single cell covers the whole heightmap. A cell of the pyramid is a node of
+ * the quadtree over the terrain.
  */
 class HeightMap
 {
   public:
+	/**
+	 * @brief Maps the heightmap to world space: a texel at (x, y) with height h lies at origin + scale * (x, h, y)
+	 */
+	struct LodSettings
+	{
+		glm::vec3 origin{0.0f};
+
+		/// World units per texel along x and z, and per unit of height along y
+		glm::vec3 scale{1.0f};
+
+		/// Size of the smallest nodes in texels, rounded down to a power of two
+		uint32_t leaf_size{32};
+
+		/// Distance from the camera up to which leaf nodes are used, each coarser level covers twice the distance
+		float lod_distance{64.0f};
+	};
+
+	/**
+	 * @brief A node of the quadtree selected for drawing
+	 */
+	struct Node
+	{
+		/// Position of the node's first texel
+		glm::uvec2 offset;
+
+		/// Size of the node in texels
+		uint32_t size;
+
+		/// Level of detail of the node, 0 for the range of the leaf nodes
+		uint32_t lod;
+
+		/// World space bounding box
+		glm::vec3 min;
+		glm::vec3 max;
+	};
+
 	/**
 	 * @brief Loads in a ktx texture as a heightmap
 	 * @param filename The ktx file to load
@@ -35,7 +86,15 @@ class HeightMap
 	 */
 	HeightMap(const std::string &filename, const uint32_t patchsize);
 
-	~HeightMap();
+	/**
+	 * @brief Creates a heightmap from 16 bit height values
+	 * @param data Square grid of dim * dim heights
+	 * @param dim The width and height of the grid, at least 2
+	 * @param patchsize The patch size
+	 */
+	HeightMap(std::vector<uint16_t> &&data, const uint32_t dim, const uint32_t patchsize);
+
+	~HeightMap() = default;
 
 	/**
 	 * @brief Retrieves a value from the heightmap at a specific coordinates
@@ -45,11 +104,66 @@ class HeightMap
 	 */
 	float get_height(const uint32_t x, const uint32_t y);
 
+	/**
+	 * @brief Samples the heightmap with bilinear filtering and clamping to the edge, like a linear sampler on the GPU
+	 * @param uv Normalized texture coordinates
+	 * @returns A height value between 0 and 1
+	 */
+	float sample(const glm::vec2 &uv) const;
+
+	uint32_t get_dimension() const;
+
+	/**
+	 * @returns The number of levels of the min/max pyramid, the last one has a single cell
+	 */
+	uint32_t get_level_count() const;
+
+	/**
+	 * @brief Retrieves the lowest and highest height of a cell of the min/max pyramid
+	 * @param level The level of the pyramid
+	 * @param x The x coordinate of the cell
+	 * @param y The y coordinate of the cell
+	 * @returns The minimum and maximum height between 0 and 1
+	 */
+	glm::vec2 get_height_range(const uint32_t level, const uint32_t x, const uint32_t y) const;
+
+	/**
+	 * @brief Selects the quadtree nodes to draw from a camera position, in the manner of CDLOD
+	 *
+	 * Nodes are refined while the camera is within the range of their children's level of detail,
+	 * so the selected nodes get smaller closer to the camera. A node of which only some children are in
+	 * range is replaced by the children, keeping the node's level of detail for the children out of range.
+	 * Drawing every node with the same number of vertices gives a resolution that falls off with distance.
+	 * @param camera_position Position of the camera in world space
+	 * @param settings Placement of the heightmap in world space and the ranges of the levels of detail
+	 * @param frustum Nodes outside of this frustum are skipped, if given
+	 * @returns The selected nodes, which don't overlap and cover the visible part of the heightmap
+	 */
+	std::vector<Node> select_nodes(const glm::vec3 &camera_position, const LodSettings &settings, const Frustum *frustum = nullptr) const;
+
   private:
-	uint16_t *data;
+	struct HeightRange
+	{
+		uint16_t min;
+		uint16_t max;
+	};
+
+	void build_pyramid();
+
+	Node get_node(const uint32_t level, const uint32_t x, const uint32_t y, const uint32_t lod, const LodSettings &settings) const;
+
+	bool select_node(const uint32_t level, const uint32_t x, const uint32_t y, const uint32_t lod, const glm::vec3 &camera_position, const LodSettings &settings, const Frustum *frustum, std::vector<Node> &nodes) const;
+
+	std::vector<uint16_t> data;
 
 	uint32_t dim;
 
 	uint32_t scale;
+
+	/// Cells of each level of the min/max pyramid
+	std::vector<std::vector<HeightRange>> levels;
+
+	/// Width and height of each level in cells
+	std::vector<uint32_t> level_sizes;
 };
 }        // namespace vkb
@@ -39,15 +39,29 @@ struct HPPResourceInfo
 	const vkb::core::HPPSampler   *sampler    = nullptr;
 };
 
+class HPPResourceBinding : private vkb::ResourceBinding
+{
+  public:
+	using vkb::ResourceBinding::get_element_count;
+
+  public:
+	const HPPResourceInfo &get_element(uint32_t array_element) const
+	{
+		return reinterpret_cast<HPPResourceInfo const &>(vkb::ResourceBinding::get_element(array_element));
+	}
+};
+
 class HPPResourceSet : private vkb::ResourceSet
 {
   public:
+	using vkb::ResourceSet::get_bound_bindings;
 	using vkb::ResourceSet::is_dirty;
+	using vkb::ResourceSet::max_bindings;
 
   public:
-	const BindingMap<HPPResourceInfo> &get_resource_bindings() const
+	const HPPResourceBinding &get_binding(uint32_t binding) const
 	{
-		return reinterpret_cast<BindingMap<HPPResourceInfo> const &>(vkb::ResourceSet::get_resource_bindings());
+		return reinterpret_cast<HPPResourceBinding const &>(vkb::ResourceSet::get_binding(binding));
 	}
 };
 
@@ -55,7 +69,9 @@ class HPPResourceBindingState : private vkb::ResourceBindingState
 {
   public:
 	using vkb::ResourceBindingState::clear_dirty;
+	using vkb::ResourceBindingState::get_bound_sets;
 	using vkb::ResourceBindingState::is_dirty;
+	using vkb::ResourceBindingState::max_sets;
 	using vkb::ResourceBindingState::reset;
 
   public:
@@ -85,9 +101,9 @@ class HPPResourceBindingState : private vkb::ResourceBindingState
 		vkb::ResourceBindingState::bind_input(reinterpret_cast<vkb::core::ImageView const &>(image_view), set, binding, array_element);
 	}
 
-	const std::unordered_map<uint32_t, vkb::HPPResourceSet> &get_resource_sets()
+	const vkb::HPPResourceSet &get_resource_set(uint32_t set) const
 	{
-		return reinterpret_cast<std::unordered_map<uint32_t, vkb::HPPResourceSet> const &>(vkb::ResourceBindingState::get_resource_sets());
+		return reinterpret_cast<vkb::HPPResourceSet const &>(vkb::ResourceBindingState::get_resource_set(set));
 	}
 };
 }        // namespace vkb
@@ -21,6 +21,8 @@
 #include <core/hpp_framebuffer.h>
 #include <core/hpp_pipeline_layout.h>
 #include <core/hpp_render_pass.h>
+#include <core/image_view.h>
+#include <core/sampler.h>
 #include <hpp_resource_record.h>
 #include <hpp_resource_replay.h>
 #include <vulkan/vulkan.hpp>
@@ -54,6 +56,13 @@ struct HPPResourceCacheState
 	std::unordered_map<std::size_t, vkb::core::HPPComputePipeline>     compute_pipelines;
 	std::unordered_map<std::size_t, vkb::core::HPPDescriptorSet>       descriptor_sets;
 	std::unordered_map<std::size_t, vkb::core::HPPFramebuffer>         framebuffers;
+
+	// Not used through the vulkan.hpp interface, but keeps the layout of vkb::ResourceCacheState,
+	// as the vkb::GLTFLoader requests its samplers through a vkb::Device cast from a vkb::core::HPPDevice
+	std::unordered_map<std::size_t, vkb::core::Sampler>   samplers;
+	std::unordered_map<std::size_t, vkb::core::ImageView> image_views;
+	std::unordered_map<VkSampler, uint32_t>               sampler_references;
+	std::unordered_map<VkImageView, uint32_t>             image_view_references;
 };
 
 /**
@@ -114,5 +123,7 @@ class HPPResourceCache
 	std::mutex             render_pass_mutex           = {};
 	std::mutex             compute_pipeline_mutex      = {};
 	std::mutex             framebuffer_mutex           = {};
+	std::mutex             sampler_mutex               = {};
+	std::mutex             image_view_mutex            = {};
 };
 }        // namespace vkb
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2021, Arm Limited and Contributors
+/* Copyright (c) 2019-2023, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -52,6 +52,16 @@ void Application::input_event(const InputEvent &input_event)
 {
 }
 
+bool Application::get_camera_pose(CameraPose & /*pose*/)
+{
+	return false;
+}
+
+bool Application::set_camera_pose(const CameraPose & /*pose*/)
+{
+	return false;
+}
+
 void Application::update(float delta_time)
 {
 	fps        = 1.0f / delta_time;
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2021, Arm Limited and Contributors
+/* Copyright (c) 2019-2023, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -28,6 +28,7 @@ namespace vkb
 {
 class Window;
 class Platform;
+struct CameraPose;
 
 class Application
 {
@@ -66,6 +67,20 @@ class Application
 	 */
 	virtual void input_event(const InputEvent &input_event);
 
+	/**
+	 * @brief Gets the pose of the camera the application renders from, used to record camera paths
+	 * @param pose The pose to fill in
+	 * @return False if the application has no camera
+	 */
+	virtual bool get_camera_pose(CameraPose &pose);
+
+	/**
+	 * @brief Moves the camera the application renders from, used to replay camera paths
+	 * @param pose The pose of the camera
+	 * @return False if the application has no camera
+	 */
+	virtual bool set_camera_pose(const CameraPose &pose);
+
 	const std::string &get_name() const;
 
 	void set_name(const std::string &name);
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019, Arm Limited and Contributors
+/* Copyright (c) 2019-2023, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -97,6 +97,19 @@ void Configuration::reset()
 	current_configuration = configs.begin();
 }
 
+bool Configuration::select(uint32_t config_index)
+{
+	auto it = configs.find(config_index);
+	if (it == configs.end())
+	{
+		return false;
+	}
+
+	current_configuration = it;
+
+	return true;
+}
+
 void Configuration::insert_setting(uint32_t config_index, std::unique_ptr<Setting> setting)
 {
 	settings.push_back(std::move(setting));
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019, Arm Limited and Contributors
+/* Copyright (c) 2019-2023, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -111,6 +111,13 @@ class Configuration
 	 */
 	void reset();
 
+	/**
+	 * @brief Makes a configuration the current one, without applying it
+	 * @param config_index The index the configuration was inserted with
+	 * @return False if there is no configuration with this index
+	 */
+	bool select(uint32_t config_index);
+
 	/**
 	 * @brief Inserts a setting into the current configuration
 	 * @param config_index The configuration to insert the setting into
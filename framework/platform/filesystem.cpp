@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2020, Arm Limited and Contributors
+/* Copyright (c) 2019-2023, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -37,7 +37,8 @@ const std::unordered_map<Type, std::string> relative_paths = {{Type::Assets, "as
                                                               {Type::Storage, "output/"},
                                                               {Type::Screenshots, "output/images/"},
                                                               {Type::Logs, "output/logs/"},
-                                                              {Type::Graphs, "output/graphs/"}};
+                                                              {Type::Graphs, "output/graphs/"},
+                                                              {Type::CameraPaths, "output/camera_paths/"}};
 
 const std::string get(const Type type, const std::string &file)
 {
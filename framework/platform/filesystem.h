@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2020, Arm Limited and Contributors
+/* Copyright (c) 2019-2023, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -42,6 +42,7 @@ enum Type
 	Screenshots,
 	Logs,
 	Graphs,
+	CameraPaths,
 	/* NewFolder */
 	TotalRelativePathTypes,
 
@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2022, Arm Limited and Contributors
+/* Copyright (c) 2018-2023, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -17,6 +17,8 @@
 
 #include "headless_window.h"
 
+#include "core/instance.h"
+
 namespace vkb
 {
 HeadlessWindow::HeadlessWindow(const Window::Properties &properties) :
@@ -26,12 +28,32 @@ HeadlessWindow::HeadlessWindow(const Window::Properties &properties) :
 
 VkSurfaceKHR HeadlessWindow::create_surface(Instance &instance)
 {
-	return VK_NULL_HANDLE;
+	// Headless apps render offscreen unless a swapchain was requested
+	if (!properties.headless_surface || !instance.is_enabled(VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME))
+	{
+		return VK_NULL_HANDLE;
+	}
+
+	return create_surface(instance.get_handle(), VK_NULL_HANDLE);
 }
 
-VkSurfaceKHR HeadlessWindow::create_surface(VkInstance, VkPhysicalDevice)
+VkSurfaceKHR HeadlessWindow::create_surface(VkInstance instance, VkPhysicalDevice)
 {
-	return VK_NULL_HANDLE;
+	if (!properties.headless_surface || instance == VK_NULL_HANDLE || vkCreateHeadlessSurfaceEXT == nullptr)
+	{
+		return VK_NULL_HANDLE;
+	}
+
+	VkHeadlessSurfaceCreateInfoEXT create_info{VK_STRUCTURE_TYPE_HEADLESS_SURFACE_CREATE_INFO_EXT};
+
+	VkSurfaceKHR surface{VK_NULL_HANDLE};
+
+	if (vkCreateHeadlessSurfaceEXT(instance, &create_info, nullptr, &surface) != VK_SUCCESS)
+	{
+		return VK_NULL_HANDLE;
+	}
+
+	return surface;
 }
 
 bool HeadlessWindow::should_close()
@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2022, Arm Limited and Contributors
+/* Copyright (c) 2018-2023, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -32,14 +32,14 @@ class HeadlessWindow : public Window
 	virtual ~HeadlessWindow() = default;
 
 	/**
-	 * @brief A direct window doesn't have a surface
-	 * @returns VK_NULL_HANDLE
+	 * @brief Creates a headless surface if it was requested and the instance enabled VK_EXT_headless_surface
+	 * @returns VK_NULL_HANDLE if the app renders offscreen
 	 */
 	VkSurfaceKHR create_surface(Instance &instance) override;
 
 	/**
-	 * @brief A direct window doesn't have a surface
-	 * @returns nullptr
+	 * @brief Creates a headless surface if it was requested and VK_EXT_headless_surface is loaded
+	 * @returns VK_NULL_HANDLE if the app renders offscreen
 	 */
 	VkSurfaceKHR create_surface(VkInstance instance, VkPhysicalDevice physical_device) override;
 
@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2022, Arm Limited and Contributors
+/* Copyright (c) 2018-2023, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -64,15 +64,17 @@ class Window
 		Optional<bool>        resizable;
 		Optional<Vsync>       vsync;
 		OptionalExtent        extent;
+		Optional<bool>        headless_surface;
 	};
 
 	struct Properties
 	{
-		std::string title     = "";
-		Mode        mode      = Mode::Default;
-		bool        resizable = true;
-		Vsync       vsync     = Vsync::Default;
-		Extent      extent    = {1280, 720};
+		std::string title            = "";
+		Mode        mode             = Mode::Default;
+		bool        resizable        = true;
+		Vsync       vsync            = Vsync::Default;
+		Extent      extent           = {1280, 720};
+		bool        headless_surface = false;        ///< Whether a headless window presents to a VK_EXT_headless_surface swapchain instead of rendering offscreen
 	};
 
 	/**
@@ -0,0 +1,759 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "command_list.h"
+
+#include <future>
+#include <limits>
+#include <new>
+
+#include <ctpl_stl.h>
+
+#include "core/command_buffer.h"
+
+namespace vkb
+{
+namespace
+{
+/// Alignment of the commands in the blocks, enough for the pointers and device sizes they hold
+constexpr size_t command_alignment = alignof(VkDeviceSize) > alignof(void *) ? alignof(VkDeviceSize) : alignof(void *);
+
+enum class CommandType : uint32_t
+{
+	BindPipelineLayout,
+	SetVertexInputState,
+	SetInputAssemblyState,
+	SetRasterizationState,
+	SetMultisampleState,
+	SetDepthStencilState,
+	SetColorBlendState,
+	SetViewport,
+	SetScissor,
+	PushConstants,
+	BindBuffer,
+	BindImage,
+	BindVertexBuffers,
+	BindIndexBuffer,
+	Draw,
+	DrawIndexed,
+	ImageMemoryBarrier,
+	BufferMemoryBarrier,
+};
+
+/**
+ * @brief Header at the start of every command, the payload of a command directly follows it
+ */
+struct CommandHeader
+{
+	CommandType type;
+
+	/// Size of the command including its header and payload, used to find the next command
+	uint32_t size;
+};
+
+struct BindPipelineLayoutCommand
+{
+	static constexpr CommandType type = CommandType::BindPipelineLayout;
+
+	CommandHeader header;
+
+	PipelineLayout *pipeline_layout;
+};
+
+/// Command for the states holding vectors, which are stored outside the blocks
+template <CommandType Type>
+struct SetStateIndexCommand
+{
+	static constexpr CommandType type = Type;
+
+	CommandHeader header;
+
+	size_t index;
+};
+
+template <CommandType Type, class State>
+struct SetStateCommand
+{
+	static constexpr CommandType type = Type;
+
+	CommandHeader header;
+
+	State state_info;
+};
+
+/// Command followed by an array of count elements of the given type
+template <CommandType Type, class Element>
+struct SetArrayCommand
+{
+	static constexpr CommandType type = Type;
+
+	CommandHeader header;
+
+	uint32_t first;
+
+	uint32_t count;
+
+	const Element *get_elements() const
+	{
+		return reinterpret_cast<const Element *>(this + 1);
+	}
+};
+
+struct PushConstantsCommand
+{
+	static constexpr CommandType type = CommandType::PushConstants;
+
+	CommandHeader header;
+
+	uint32_t size;
+
+	const uint8_t *get_data() const
+	{
+		return reinterpret_cast<const uint8_t *>(this + 1);
+	}
+};
+
+struct BindBufferCommand
+{
+	static constexpr CommandType type = CommandType::BindBuffer;
+
+	CommandHeader header;
+
+	const core::Buffer *buffer;
+
+	VkDeviceSize offset;
+
+	VkDeviceSize range;
+
+	uint32_t set;
+
+	uint32_t binding;
+
+	uint32_t array_element;
+};
+
+struct BindImageCommand
+{
+	static constexpr CommandType type = CommandType::BindImage;
+
+	CommandHeader header;
+
+	const core::ImageView *image_view;
+
+	/// Null for images bound without a sampler
+	const core::Sampler *sampler;
+
+	uint32_t set;
+
+	uint32_t binding;
+
+	uint32_t array_element;
+};
+
+/// Command followed by count offsets, then count buffer pointers, so that the offsets stay aligned
+struct BindVertexBuffersCommand
+{
+	static constexpr CommandType type = CommandType::BindVertexBuffers;
+
+	CommandHeader header;
+
+	uint32_t first_binding;
+
+	uint32_t count;
+
+	const VkDeviceSize *get_offsets() const
+	{
+		return reinterpret_cast<const VkDeviceSize *>(this + 1);
+	}
+
+	const core::Buffer *const *get_buffers() const
+	{
+		return reinterpret_cast<const core::Buffer *const *>(get_offsets() + count);
+	}
+};
+
+struct BindIndexBufferCommand
+{
+	static constexpr CommandType type = CommandType::BindIndexBuffer;
+
+	CommandHeader header;
+
+	const core::Buffer *buffer;
+
+	VkDeviceSize offset;
+
+	VkIndexType index_type;
+};
+
+struct DrawCommand
+{
+	static constexpr CommandType type = CommandType::Draw;
+
+	CommandHeader header;
+
+	uint32_t vertex_count;
+
+	uint32_t instance_count;
+
+	uint32_t first_vertex;
+
+	uint32_t first_instance;
+};
+
+struct DrawIndexedCommand
+{
+	static constexpr CommandType type = CommandType::DrawIndexed;
+
+	CommandHeader header;
+
+	uint32_t index_count;
+
+	uint32_t instance_count;
+
+	uint32_t first_index;
+
+	int32_t vertex_offset;
+
+	uint32_t first_instance;
+};
+
+struct ImageMemoryBarrierCommand
+{
+	static constexpr CommandType type = CommandType::ImageMemoryBarrier;
+
+	CommandHeader header;
+
+	const core::ImageView *image_view;
+
+	ImageMemoryBarrier memory_barrier;
+};
+
+struct BufferMemoryBarrierCommand
+{
+	static constexpr CommandType type = CommandType::BufferMemoryBarrier;
+
+	CommandHeader header;
+
+	const core::Buffer *buffer;
+
+	VkDeviceSize offset;
+
+	VkDeviceSize size;
+
+	BufferMemoryBarrier memory_barrier;
+};
+
+using SetVertexInputStateCommand   = SetStateIndexCommand<CommandType::SetVertexInputState>;
+using SetColorBlendStateCommand    = SetStateIndexCommand<CommandType::SetColorBlendState>;
+using SetInputAssemblyStateCommand = SetStateCommand<CommandType::SetInputAssemblyState, InputAssemblyState>;
+using SetRasterizationStateCommand = SetStateCommand<CommandType::SetRasterizationState, RasterizationState>;
+using SetMultisampleStateCommand   = SetStateCommand<CommandType::SetMultisampleState, MultisampleState>;
+using SetDepthStencilStateCommand  = SetStateCommand<CommandType::SetDepthStencilState, DepthStencilState>;
+using SetViewportCommand           = SetArrayCommand<CommandType::SetViewport, VkViewport>;
+using SetScissorCommand            = SetArrayCommand<CommandType::SetScissor, VkRect2D>;
+
+inline size_t align_command_size(size_t size)
+{
+	return (size + command_alignment - 1) & ~(command_alignment - 1);
+}
+
+inline bool is_action(CommandType type)
+{
+	switch (type)
+	{
+		case CommandType::Draw:
+		case CommandType::DrawIndexed:
+		case CommandType::ImageMemoryBarrier:
+		case CommandType::BufferMemoryBarrier:
+			return true;
+		default:
+			return false;
+	}
+}
+
+template <class T>
+inline const T &as(const CommandHeader &header)
+{
+	return *reinterpret_cast<const T *>(&header);
+}
+}        // namespace
+
+CommandList::CommandList(size_t block_size) :
+    block_size{align_command_size(block_size)}
+{
+}
+
+void CommandList::reset()
+{
+	for (auto &block : blocks)
+	{
+		block.size = 0;
+	}
+
+	active_block  = 0;
+	command_count = 0;
+	action_count  = 0;
+
+	vertex_input_states.clear();
+	color_blend_states.clear();
+}
+
+bool CommandList::empty() const
+{
+	return command_count == 0;
+}
+
+uint32_t CommandList::get_command_count() const
+{
+	return command_count;
+}
+
+uint32_t CommandList::get_action_count() const
+{
+	return action_count;
+}
+
+size_t CommandList::get_size() const
+{
+	size_t size = 0;
+
+	for (auto &block : blocks)
+	{
+		size += block.size;
+	}
+
+	return size;
+}
+
+uint8_t *CommandList::allocate(size_t size)
+{
+	// Move to the next block with enough space left, commands never straddle two blocks
+	while (active_block < blocks.size() && blocks[active_block].capacity - blocks[active_block].size < size)
+	{
+		++active_block;
+	}
+
+	if (active_block == blocks.size())
+	{
+		// Commands larger than a block, such as big push constant ranges, get a block of their own
+		Block block;
+		block.capacity = std::max(block_size, size);
+		block.data     = std::make_unique<uint8_t[]>(block.capacity);
+
+		blocks.push_back(std::move(block));
+	}
+
+	auto &block = blocks[active_block];
+
+	uint8_t *data = block.data.get() + block.size;
+	block.size += size;
+
+	return data;
+}
+
+template <class T>
+T &CommandList::record(size_t payload_size)
+{
+	static_assert(std::is_trivially_destructible<T>::value, "Commands are never destroyed");
+
+	size_t size = align_command_size(sizeof(T) + payload_size);
+
+	if (size > std::numeric_limits<uint32_t>::max())
+	{
+		throw std::runtime_error("Command is too large to be recorded");
+	}
+
+	auto command = new (allocate(size)) T{};
+
+	command->header.type = T::type;
+	command->header.size = to_u32(size);
+
+	++command_count;
+
+	if (is_action(T::type))
+	{
+		++action_count;
+	}
+
+	return *command;
+}
+
+void CommandList::bind_pipeline_layout(PipelineLayout &pipeline_layout)
+{
+	record<BindPipelineLayoutCommand>().pipeline_layout = &pipeline_layout;
+}
+
+void CommandList::set_vertex_input_state(const VertexInputState &state_info)
+{
+	record<SetVertexInputStateCommand>().index = vertex_input_states.size();
+
+	vertex_input_states.push_back(state_info);
+}
+
+void CommandList::set_input_assembly_state(const InputAssemblyState &state_info)
+{
+	record<SetInputAssemblyStateCommand>().state_info = state_info;
+}
+
+void CommandList::set_rasterization_state(const RasterizationState &state_info)
+{
+	record<SetRasterizationStateCommand>().state_info = state_info;
+}
+
+void CommandList::set_multisample_state(const MultisampleState &state_info)
+{
+	record<SetMultisampleStateCommand>().state_info = state_info;
+}
+
+void CommandList::set_depth_stencil_state(const DepthStencilState &state_info)
+{
+	record<SetDepthStencilStateCommand>().state_info = state_info;
+}
+
+void CommandList::set_color_blend_state(const ColorBlendState &state_info)
+{
+	record<SetColorBlendStateCommand>().index = color_blend_states.size();
+
+	color_blend_states.push_back(state_info);
+}
+
+void CommandList::set_viewport(uint32_t first_viewport, const std::vector<VkViewport> &viewports)
+{
+	auto &command = record<SetViewportCommand>(viewports.size() * sizeof(VkViewport));
+	command.first = first_viewport;
+	command.count = to_u32(viewports.size());
+
+	std::copy(viewports.begin(), viewports.end(), reinterpret_cast<VkViewport *>(&command + 1));
+}
+
+void CommandList::set_scissor(uint32_t first_scissor, const std::vector<VkRect2D> &scissors)
+{
+	auto &command = record<SetScissorCommand>(scissors.size() * sizeof(VkRect2D));
+	command.first = first_scissor;
+	command.count = to_u32(scissors.size());
+
+	std::copy(scissors.begin(), scissors.end(), reinterpret_cast<VkRect2D *>(&command + 1));
+}
+
+void CommandList::push_constants(const std::vector<uint8_t> &values)
+{
+	push_constants(values.data(), values.size());
+}
+
+void CommandList::push_constants(const uint8_t *data, size_t size)
+{
+	auto &command = record<PushConstantsCommand>(size);
+	command.size  = to_u32(size);
+
+	std::copy(data, data + size, reinterpret_cast<uint8_t *>(&command + 1));
+}
+
+void CommandList::bind_buffer(const core::Buffer &buffer, VkDeviceSize offset, VkDeviceSize range, uint32_t set, uint32_t binding, uint32_t array_element)
+{
+	auto &command         = record<BindBufferCommand>();
+	command.buffer        = &buffer;
+	command.offset        = offset;
+	command.range         = range;
+	command.set           = set;
+	command.binding       = binding;
+	command.array_element = array_element;
+}
+
+void CommandList::bind_image(const core::ImageView &image_view, const core::Sampler &sampler, uint32_t set, uint32_t binding, uint32_t array_element)
+{
+	auto &command         = record<BindImageCommand>();
+	command.image_view    = &image_view;
+	command.sampler       = &sampler;
+	command.set           = set;
+	command.binding       = binding;
+	command.array_element = array_element;
+}
+
+void CommandList::bind_image(const core::ImageView &image_view, uint32_t set, uint32_t binding, uint32_t array_element)
+{
+	auto &command         = record<BindImageCommand>();
+	command.image_view    = &image_view;
+	command.sampler       = nullptr;
+	command.set           = set;
+	command.binding       = binding;
+	command.array_element = array_element;
+}
+
+void CommandList::bind_vertex_buffers(uint32_t first_binding, const std::vector<std::reference_wrapper<const vkb::core::Buffer>> &buffers, const std::vector<VkDeviceSize> &offsets)
+{
+	assert(buffers.size() == offsets.size() && "Every vertex buffer needs an offset");
+
+	auto &command = record<BindVertexBuffersCommand>(buffers.size() * (sizeof(core::Buffer *) + sizeof(VkDeviceSize)));
+	command.first_binding = first_binding;
+	command.count         = to_u32(buffers.size());
+
+	auto offset_data = reinterpret_cast<VkDeviceSize *>(&command + 1);
+	std::copy(offsets.begin(), offsets.end(), offset_data);
+
+	std::transform(buffers.begin(), buffers.end(), reinterpret_cast<const core::Buffer **>(offset_data + offsets.size()),
+	               [](const core::Buffer &buffer) { return &buffer; });
+}
+
+void CommandList::bind_index_buffer(const core::Buffer &buffer, VkDeviceSize offset, VkIndexType index_type)
+{
+	auto &command      = record<BindIndexBufferCommand>();
+	command.buffer     = &buffer;
+	command.offset     = offset;
+	command.index_type = index_type;
+}
+
+void CommandList::draw(uint32_t vertex_count, uint32_t instance_count, uint32_t first_vertex, uint32_t first_instance)
+{
+	auto &command          = record<DrawCommand>();
+	command.vertex_count   = vertex_count;
+	command.instance_count = instance_count;
+	command.first_vertex   = first_vertex;
+	command.first_instance = first_instance;
+}
+
+void CommandList::draw_indexed(uint32_t index_count, uint32_t instance_count, uint32_t first_index, int32_t vertex_offset, uint32_t first_instance)
+{
+	auto &command          = record<DrawIndexedCommand>();
+	command.index_count    = index_count;
+	command.instance_count = instance_count;
+	command.first_index    = first_index;
+	command.vertex_offset  = vertex_offset;
+	command.first_instance = first_instance;
+}
+
+void CommandList::image_memory_barrier(const core::ImageView &image_view, const ImageMemoryBarrier &memory_barrier)
+{
+	auto &command          = record<ImageMemoryBarrierCommand>();
+	command.image_view     = &image_view;
+	command.memory_barrier = memory_barrier;
+}
+
+void CommandList::buffer_memory_barrier(const core::Buffer &buffer, VkDeviceSize offset, VkDeviceSize size, const BufferMemoryBarrier &memory_barrier)
+{
+	auto &command          = record<BufferMemoryBarrierCommand>();
+	command.buffer         = &buffer;
+	command.offset         = offset;
+	command.size           = size;
+	command.memory_barrier = memory_barrier;
+}
+
+void CommandList::execute(CommandBuffer &command_buffer) const
+{
+	execute(command_buffer, 0, action_count);
+}
+
+void CommandList::execute(CommandBuffer &command_buffer, uint32_t first_action, uint32_t count) const
+{
+	assert(command_buffer.is_recording() && "Command buffer must be recording to execute a command list");
+
+	uint32_t end_action   = first_action + std::min(count, action_count - std::min(first_action, action_count));
+	uint32_t action_index = 0;
+
+	// Push constants recorded before the range which no skipped draw has consumed yet
+	std::vector<const PushConstantsCommand *> pending_push_constants;
+
+	// An empty range still translates the state of a list without actions
+	if (first_action >= end_action && action_count > 0)
+	{
+		return;
+	}
+
+	for (auto &block : blocks)
+	{
+		size_t offset = 0;
+
+		while (offset < block.size)
+		{
+			auto &header = *reinterpret_cast<const CommandHeader *>(block.data.get() + offset);
+			offset += header.size;
+
+			if (is_action(header.type))
+			{
+				// Only the state recorded before the range matters to its actions
+				if (action_index++ < first_action)
+				{
+					// A draw consumes the push constants recorded before it, a barrier leaves them to the next draw
+					if (header.type == CommandType::Draw || header.type == CommandType::DrawIndexed)
+					{
+						pending_push_constants.clear();
+					}
+
+					// The constants left after the last skipped action are those of the first action of the range
+					if (action_index == first_action)
+					{
+						for (auto command : pending_push_constants)
+						{
+							command_buffer.push_constants({command->get_data(), command->get_data() + command->size});
+						}
+					}
+
+					continue;
+				}
+			}
+			else if (header.type == CommandType::PushConstants && action_index < first_action)
+			{
+				// Push constants accumulate in the command buffer until a draw flushes them,
+				// so replaying those of the skipped draws would exceed the push constant limit
+				pending_push_constants.push_back(&as<PushConstantsCommand>(header));
+				continue;
+			}
+
+			switch (header.type)
+			{
+				case CommandType::BindPipelineLayout:
+					command_buffer.bind_pipeline_layout(*as<BindPipelineLayoutCommand>(header).pipeline_layout);
+					break;
+				case CommandType::SetVertexInputState:
+					command_buffer.set_vertex_input_state(vertex_input_states[as<SetVertexInputStateCommand>(header).index]);
+					break;
+				case CommandType::SetInputAssemblyState:
+					command_buffer.set_input_assembly_state(as<SetInputAssemblyStateCommand>(header).state_info);
+					break;
+				case CommandType::SetRasterizationState:
+					command_buffer.set_rasterization_state(as<SetRasterizationStateCommand>(header).state_info);
+					break;
+				case CommandType::SetMultisampleState:
+					command_buffer.set_multisample_state(as<SetMultisampleStateCommand>(header).state_info);
+					break;
+				case CommandType::SetDepthStencilState:
+					command_buffer.set_depth_stencil_state(as<SetDepthStencilStateCommand>(header).state_info);
+					break;
+				case CommandType::SetColorBlendState:
+					command_buffer.set_color_blend_state(color_blend_states[as<SetColorBlendStateCommand>(header).index]);
+					break;
+				case CommandType::SetViewport:
+				{
+					auto &command = as<SetViewportCommand>(header);
+					command_buffer.set_viewport(command.first, {command.get_elements(), command.get_elements() + command.count});
+					break;
+				}
+				case CommandType::SetScissor:
+				{
+					auto &command = as<SetScissorCommand>(header);
+					command_buffer.set_scissor(command.first, {command.get_elements(), command.get_elements() + command.count});
+					break;
+				}
+				case CommandType::PushConstants:
+				{
+					auto &command = as<PushConstantsCommand>(header);
+					command_buffer.push_constants({command.get_data(), command.get_data() + command.size});
+					break;
+				}
+				case CommandType::BindBuffer:
+				{
+					auto &command = as<BindBufferCommand>(header);
+					command_buffer.bind_buffer(*command.buffer, command.offset, command.range, command.set, command.binding, command.array_element);
+					break;
+				}
+				case CommandType::BindImage:
+				{
+					auto &command = as<BindImageCommand>(header);
+					if (command.sampler)
+					{
+						command_buffer.bind_image(*command.image_view, *command.sampler, command.set, command.binding, command.array_element);
+					}
+					else
+					{
+						command_buffer.bind_image(*command.image_view, command.set, command.binding, command.array_element);
+					}
+					break;
+				}
+				case CommandType::BindVertexBuffers:
+				{
+					auto &command = as<BindVertexBuffersCommand>(header);
+
+					std::vector<std::reference_wrapper<const core::Buffer>> buffers;
+					buffers.reserve(command.count);
+					for (uint32_t i = 0; i < command.count; ++i)
+					{
+						buffers.emplace_back(*command.get_buffers()[i]);
+					}
+
+					command_buffer.bind_vertex_buffers(command.first_binding, buffers, {command.get_offsets(), command.get_offsets() + command.count});
+					break;
+				}
+				case CommandType::BindIndexBuffer:
+				{
+					auto &command = as<BindIndexBufferCommand>(header);
+					command_buffer.bind_index_buffer(*command.buffer, command.offset, command.index_type);
+					break;
+				}
+				case CommandType::Draw:
+				{
+					auto &command = as<DrawCommand>(header);
+					command_buffer.draw(command.vertex_count, command.instance_count, command.first_vertex, command.first_instance);
+					break;
+				}
+				case CommandType::DrawIndexed:
+				{
+					auto &command = as<DrawIndexedCommand>(header);
+					command_buffer.draw_indexed(command.index_count, command.instance_count, command.first_index, command.vertex_offset, command.first_instance);
+					break;
+				}
+				case CommandType::ImageMemoryBarrier:
+				{
+					auto &command = as<ImageMemoryBarrierCommand>(header);
+					command_buffer.image_memory_barrier(*command.image_view, command.memory_barrier);
+					break;
+				}
+				case CommandType::BufferMemoryBarrier:
+				{
+					auto &command = as<BufferMemoryBarrierCommand>(header);
+					command_buffer.buffer_memory_barrier(*command.buffer, command.offset, command.size, command.memory_barrier);
+					break;
+				}
+			}
+
+			// The state recorded after the last action of a partial range is not needed
+			if (action_index == end_action && end_action < action_count)
+			{
+				return;
+			}
+		}
+	}
+}
+
+void CommandList::execute(const std::vector<CommandBuffer *> &command_buffers, ctpl::thread_pool &thread_pool) const
+{
+	if (command_buffers.empty())
+	{
+		return;
+	}
+
+	uint32_t actions_per_command_buffer = (action_count + to_u32(command_buffers.size()) - 1) / to_u32(command_buffers.size());
+
+	std::vector<std::future<void>> futures;
+	futures.reserve(command_buffers.size());
+
+	for (size_t i = 0; i < command_buffers.size(); ++i)
+	{
+		auto command_buffer = command_buffers[i];
+		auto first_action   = to_u32(i) * actions_per_command_buffer;
+
+		futures.push_back(thread_pool.push(
+		    [this, command_buffer, first_action, actions_per_command_buffer](size_t) {
+			    execute(*command_buffer, first_action, actions_per_command_buffer);
+		    }));
+	}
+
+	// Rethrows the errors of the threads, if any
+	for (auto &future : futures)
+	{
+		future.get();
+	}
+}
+}        // namespace vkb
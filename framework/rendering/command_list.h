@@ -0,0 +1,210 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <deque>
+#include <memory>
+
+#include "common/helpers.h"
+#include "common/vk_common.h"
+#include "rendering/pipeline_state.h"
+
+namespace ctpl
+{
+class thread_pool;
+}        // namespace ctpl
+
+namespace vkb
+{
+namespace core
+{
+class Buffer;
+class ImageView;
+class Sampler;
+}        // namespace core
+
+class CommandBuffer;
+class PipelineLayout;
+
+/**
+ * @brief A list of commands recorded on the CPU, without a Vulkan command buffer
+ *
+ * The list mirrors the binding and drawing functions of CommandBuffer. Commands are packed into
+ * fixed size blocks of memory, which are kept and reused when the list is reset, so recording
+ * does not allocate once the list has reached its working size.
+ *
+ * Since no Vulkan object is involved while recording, a list can be built on any thread before a
+ * command buffer is available, and a list holding static geometry can be recorded once and
+ * executed every frame. Executing a list translates it into calls to a CommandBuffer, which
+ * performs the usual state tracking, pipeline and descriptor set requests.
+ *
+ * The resources referenced by the commands are not owned by the list and must outlive it.
+ */
+class CommandList
+{
+  public:
+	/// Default size in bytes of the blocks commands are packed into
+	static constexpr size_t default_block_size = 64 * 1024;
+
+	explicit CommandList(size_t block_size = default_block_size);
+
+	CommandList(const CommandList &) = delete;
+
+	CommandList(CommandList &&) = default;
+
+	~CommandList() = default;
+
+	CommandList &operator=(const CommandList &) = delete;
+
+	CommandList &operator=(CommandList &&) = default;
+
+	/**
+	 * @brief Removes all the commands, keeping the memory of the list for the next recording
+	 */
+	void reset();
+
+	bool empty() const;
+
+	/**
+	 * @return The number of commands recorded
+	 */
+	uint32_t get_command_count() const;
+
+	/**
+	 * @return The number of draws and barriers recorded, the commands that execute ranges are expressed in
+	 */
+	uint32_t get_action_count() const;
+
+	/**
+	 * @return The number of bytes used by the commands
+	 */
+	size_t get_size() const;
+
+	void bind_pipeline_layout(PipelineLayout &pipeline_layout);
+
+	void set_vertex_input_state(const VertexInputState &state_info);
+
+	void set_input_assembly_state(const InputAssemblyState &state_info);
+
+	void set_rasterization_state(const RasterizationState &state_info);
+
+	void set_multisample_state(const MultisampleState &state_info);
+
+	void set_depth_stencil_state(const DepthStencilState &state_info);
+
+	void set_color_blend_state(const ColorBlendState &state_info);
+
+	void set_viewport(uint32_t first_viewport, const std::vector<VkViewport> &viewports);
+
+	void set_scissor(uint32_t first_scissor, const std::vector<VkRect2D> &scissors);
+
+	void push_constants(const std::vector<uint8_t> &values);
+
+	template <typename T>
+	void push_constants(const T &value)
+	{
+		push_constants(reinterpret_cast<const uint8_t *>(&value), sizeof(T));
+	}
+
+	void bind_buffer(const core::Buffer &buffer, VkDeviceSize offset, VkDeviceSize range, uint32_t set, uint32_t binding, uint32_t array_element);
+
+	void bind_image(const core::ImageView &image_view, const core::Sampler &sampler, uint32_t set, uint32_t binding, uint32_t array_element);
+
+	void bind_image(const core::ImageView &image_view, uint32_t set, uint32_t binding, uint32_t array_element);
+
+	void bind_vertex_buffers(uint32_t first_binding, const std::vector<std::reference_wrapper<const vkb::core::Buffer>> &buffers, const std::vector<VkDeviceSize> &offsets);
+
+	void bind_index_buffer(const core::Buffer &buffer, VkDeviceSize offset, VkIndexType index_type);
+
+	void draw(uint32_t vertex_count, uint32_t instance_count, uint32_t first_vertex, uint32_t first_instance);
+
+	void draw_indexed(uint32_t index_count, uint32_t instance_count, uint32_t first_index, int32_t vertex_offset, uint32_t first_instance);
+
+	void image_memory_barrier(const core::ImageView &image_view, const ImageMemoryBarrier &memory_barrier);
+
+	void buffer_memory_barrier(const core::Buffer &buffer, VkDeviceSize offset, VkDeviceSize size, const BufferMemoryBarrier &memory_barrier);
+
+	/**
+	 * @brief Translates all the commands of the list into a command buffer
+	 * @param command_buffer A command buffer in the recording state
+	 */
+	void execute(CommandBuffer &command_buffer) const;
+
+	/**
+	 * @brief Translates a range of the actions of the list into a command buffer
+	 *
+	 * The state commands recorded before the last action of the range are all translated, so that
+	 * the actions of the range are recorded with the same state as when executing the whole list.
+	 * Actions outside the range are skipped, as are the push constants a skipped draw consumes.
+	 * @param command_buffer A command buffer in the recording state
+	 * @param first_action The index of the first draw or barrier to record
+	 * @param action_count The number of draws and barriers to record
+	 */
+	void execute(CommandBuffer &command_buffer, uint32_t first_action, uint32_t action_count) const;
+
+	/**
+	 * @brief Translates the list into several command buffers in parallel, splitting its actions
+	 *        evenly between them, and waits for the translation to complete
+	 *
+	 * Each command buffer must be in the recording state and allocated from a command pool of a
+	 * different thread index, as they are recorded concurrently. Executing the command buffers in
+	 * order is equivalent to executing the list into a single command buffer.
+	 * @param command_buffers The command buffers to record into
+	 * @param thread_pool The threads which record the command buffers
+	 */
+	void execute(const std::vector<CommandBuffer *> &command_buffers, ctpl::thread_pool &thread_pool) const;
+
+  private:
+	struct Block
+	{
+		std::unique_ptr<uint8_t[]> data;
+
+		size_t capacity{0};
+
+		size_t size{0};
+	};
+
+	/**
+	 * @brief Reserves space for a command at the end of the list
+	 * @param size The size of the command in bytes
+	 * @return A pointer to the memory of the command
+	 */
+	uint8_t *allocate(size_t size);
+
+	void push_constants(const uint8_t *data, size_t size);
+
+	template <class T>
+	T &record(size_t payload_size = 0);
+
+	size_t block_size;
+
+	std::vector<Block> blocks;
+
+	/// Index of the block commands are currently appended to
+	size_t active_block{0};
+
+	uint32_t command_count{0};
+
+	uint32_t action_count{0};
+
+	/// States holding vectors, which are stored out of the blocks and referenced by index
+	std::deque<VertexInputState> vertex_input_states;
+
+	std::deque<ColorBlendState> color_blend_states;
+};
+}        // namespace vkb
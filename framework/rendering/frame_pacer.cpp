@@ -0,0 +1,179 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "frame_pacer.h"
+
+#include <algorithm>
+
+namespace vkb
+{
+namespace
+{
+float to_seconds(FramePacer::Clock::duration duration)
+{
+	return std::chrono::duration<float>(duration).count();
+}
+}        // namespace
+
+void FramePacer::set_latency_mode(bool enable)
+{
+	latency_mode = enable;
+}
+
+bool FramePacer::is_latency_mode_enabled() const
+{
+	return latency_mode;
+}
+
+const FramePacer::Timings &FramePacer::get_timings() const
+{
+	return timings;
+}
+
+bool FramePacer::is_frame_started() const
+{
+	return frame_started;
+}
+
+FramePacer::Clock::duration FramePacer::get_start_delay() const
+{
+	if (!latency_mode || !frame_submitted || gpu_time <= 0.0f)
+	{
+		return Clock::duration::zero();
+	}
+
+	// The GPU starts the previous frame once it was submitted or once it finished the frame before
+	auto gpu_start = std::max(submit_time, previous_completion_time);
+
+	// Start the CPU work early enough for its submission to reach the GPU as it finishes the previous frame,
+	// so that the GPU stays busy while the frame does not wait in the queue
+	auto predicted_start = gpu_start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(gpu_time - cpu_time - start_margin));
+
+	auto delay = predicted_start - Clock::now();
+
+	return std::min(std::max(delay, Clock::duration::zero()),
+	                std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(gpu_time)));
+}
+
+void FramePacer::start_frame(float delay)
+{
+	// The timings of the previous frame are complete, including its present
+	timings = current;
+
+	current                 = {};
+	current.present_latency = timings.present_latency;
+	current.pacing_delay    = delay;
+
+	frame_start_time        = Clock::now();
+	frame_started           = true;
+	previous_frame_complete = !latency_mode || !frame_submitted;
+}
+
+bool FramePacer::is_previous_frame_complete() const
+{
+	return previous_frame_complete;
+}
+
+void FramePacer::on_previous_frame_complete(float wait)
+{
+	auto now = Clock::now();
+
+	current.fence_wait += wait;
+	previous_frame_wait = wait;
+
+	// The GPU time is the time from the start of the previous frame on the GPU to its completion, which is
+	// only known when the CPU waited for it. Otherwise it completed earlier, which bounds the estimate
+	float sample = to_seconds(now - std::max(submit_time, previous_completion_time));
+	if (wait > blocking_wait_threshold || gpu_time <= 0.0f)
+	{
+		gpu_time += (sample - gpu_time) * (gpu_time > 0.0f ? smoothing : 1.0f);
+	}
+	else
+	{
+		gpu_time = std::min(gpu_time, sample);
+	}
+
+	previous_completion_time = now;
+	previous_frame_complete  = true;
+}
+
+void FramePacer::add_fence_wait(float time)
+{
+	current.fence_wait += time;
+}
+
+void FramePacer::add_acquire(float time)
+{
+	current.acquire += time;
+}
+
+void FramePacer::add_submit(float time)
+{
+	current.submit += time;
+}
+
+void FramePacer::add_present(float time)
+{
+	current.present += time;
+}
+
+void FramePacer::end_frame()
+{
+	submit_time = Clock::now();
+
+	// Without the wait for the previous frame, which the delay of the next frame replaces
+	float sample = to_seconds(submit_time - frame_start_time) - previous_frame_wait;
+	cpu_time += (sample - cpu_time) * (frame_submitted ? smoothing : 1.0f);
+
+	previous_frame_wait = 0.0f;
+
+	frame_started   = false;
+	frame_submitted = true;
+}
+
+uint64_t FramePacer::next_present_id()
+{
+	return ++last_present_id;
+}
+
+void FramePacer::on_presented(uint64_t present_id)
+{
+	pending_presents.emplace_back(present_id, Clock::now());
+}
+
+uint64_t FramePacer::get_pending_present_id() const
+{
+	return pending_presents.empty() ? 0 : pending_presents.front().first;
+}
+
+void FramePacer::on_displayed(uint64_t present_id)
+{
+	auto now = Clock::now();
+
+	// Images are displayed in order, so the older ones were displayed as well
+	while (!pending_presents.empty() && pending_presents.front().first <= present_id)
+	{
+		current.present_latency = to_seconds(now - pending_presents.front().second);
+		pending_presents.pop_front();
+	}
+}
+
+void FramePacer::clear_pending_presents()
+{
+	pending_presents.clear();
+}
+}        // namespace vkb
@@ -0,0 +1,192 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <utility>
+
+namespace vkb
+{
+/**
+ * @brief Times the steps of a frame which may block the CPU, and optionally delays the start of frames
+ *        to reduce the latency between the CPU work of a frame and its display
+ *
+ * The render context waits for the fences of a frame, acquires, submits and presents, and the pacer
+ * records how long each of these steps took. Without latency mode, frames start as soon as possible,
+ * and the CPU may run several frames ahead of the GPU, which adds to the latency of each of them.
+ *
+ * In latency mode the CPU waits for the previous frame before submitting the next one, so that
+ * frames do not queue on the GPU, and delays the start of the next frame by the time it would have
+ * waited, predicted from the measured GPU time and CPU time of frames. The CPU work then finishes as
+ * the GPU finishes the previous frame, reading input as late as possible without leaving the GPU idle.
+ */
+class FramePacer
+{
+  public:
+	using Clock = std::chrono::steady_clock;
+
+	/**
+	 * @brief Time in seconds the CPU spent in each step of the last frame
+	 */
+	struct Timings
+	{
+		/// Waiting for the fences of frames, long when the GPU is the bottleneck
+		float fence_wait{0.0f};
+
+		/// Acquiring the next swapchain image, long when presentation is the bottleneck
+		float acquire{0.0f};
+
+		/// Submitting command buffers to the queue
+		float submit{0.0f};
+
+		/// Presenting the swapchain image
+		float present{0.0f};
+
+		/// From presenting an image until it was displayed, for the last image known to be displayed,
+		/// 0 without VK_KHR_present_wait. Displays are checked when frames start, which rounds it up
+		float present_latency{0.0f};
+
+		/// Delay added to the start of the frame by the latency mode
+		float pacing_delay{0.0f};
+	};
+
+	/**
+	 * @brief Enables or disables delaying the start of frames to reduce latency
+	 */
+	void set_latency_mode(bool enable);
+
+	bool is_latency_mode_enabled() const;
+
+	/**
+	 * @return The timings of the last complete frame
+	 */
+	const Timings &get_timings() const;
+
+	/**
+	 * @return Whether the frame was started since the previous one was submitted
+	 */
+	bool is_frame_started() const;
+
+	/**
+	 * @return How long to delay the start of the next frame, 0 unless the latency mode is enabled
+	 *         and the previous frame is predicted to keep the GPU busy for longer than the CPU work of the next one
+	 */
+	Clock::duration get_start_delay() const;
+
+	/**
+	 * @brief Called before the CPU work of a frame
+	 * @param delay Time in seconds the start of the frame was delayed by get_start_delay()
+	 */
+	void start_frame(float delay);
+
+	/**
+	 * @return False in latency mode until the previous frame was waited for, which has to happen before
+	 *         the first submission of the frame so that its work does not queue behind the previous one
+	 */
+	bool is_previous_frame_complete() const;
+
+	/**
+	 * @brief Called once the previous frame completed in latency mode, measures its GPU time
+	 * @param wait Time in seconds spent waiting for the previous frame to complete
+	 */
+	void on_previous_frame_complete(float wait);
+
+	void add_fence_wait(float time);
+
+	void add_acquire(float time);
+
+	void add_submit(float time);
+
+	void add_present(float time);
+
+	/**
+	 * @brief Called once all the work of the frame was submitted, which ends its CPU work
+	 */
+	void end_frame();
+
+	/**
+	 * @return The identifier to present the next image with, for VK_KHR_present_id
+	 */
+	uint64_t next_present_id();
+
+	/**
+	 * @brief Called once an image was presented with an identifier, to measure when it is displayed
+	 */
+	void on_presented(uint64_t present_id);
+
+	/**
+	 * @return The identifier of the oldest presented image not known to be displayed yet, 0 for none
+	 */
+	uint64_t get_pending_present_id() const;
+
+	/**
+	 * @brief Called once an image was displayed, records its latency
+	 */
+	void on_displayed(uint64_t present_id);
+
+	/**
+	 * @brief Forgets the presented images which are not displayed yet, for example as the swapchain was recreated
+	 */
+	void clear_pending_presents();
+
+  private:
+	/// Waits shorter than this are considered not to block, in seconds
+	static constexpr float blocking_wait_threshold = 0.0001f;
+
+	/// Margin in seconds by which the next frame starts early, to not leave the GPU idle when the prediction is late
+	static constexpr float start_margin = 0.001f;
+
+	/// Weight of a new sample in the moving averages of the GPU and CPU times
+	static constexpr float smoothing = 0.1f;
+
+	bool latency_mode{false};
+
+	/// Timings of the last complete frame
+	Timings timings;
+
+	/// Timings of the frame in progress
+	Timings current;
+
+	bool frame_started{false};
+
+	bool frame_submitted{false};
+
+	bool previous_frame_complete{true};
+
+	/// Time in seconds the current frame waited for the previous one
+	float previous_frame_wait{0.0f};
+
+	Clock::time_point frame_start_time;
+
+	Clock::time_point submit_time;
+
+	Clock::time_point previous_completion_time;
+
+	/// Moving averages in seconds of the GPU time of a frame and of the CPU time from its start to its last submission
+	float gpu_time{0.0f};
+
+	float cpu_time{0.0f};
+
+	uint64_t last_present_id{0};
+
+	/// Presented images waiting to be displayed, with their present time
+	std::deque<std::pair<uint64_t, Clock::time_point>> pending_presents;
+};
+}        // namespace vkb
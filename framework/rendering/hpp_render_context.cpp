@@ -431,6 +431,8 @@ void HPPRenderContext::end_frame(vk::Semaphore semaphore)
 		}
 	}
 
+	get_active_frame().mark_submitted();
+
 	// Frame is not active anymore
 	if (acquired_semaphore)
 	{
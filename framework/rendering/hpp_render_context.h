@@ -18,8 +18,10 @@
 #pragma once
 
 #include <core/hpp_device.h>
+#include <core/hpp_query_pool.h>
 #include <core/hpp_swapchain.h>
 #include <platform/hpp_window.h>
+#include <rendering/frame_pacer.h>
 #include <rendering/hpp_render_frame.h>
 
 namespace vkb
@@ -254,6 +256,26 @@ class HPPRenderContext
 	vk::SurfaceTransformFlagBitsKHR pre_transform{vk::SurfaceTransformFlagBitsKHR::eIdentity};
 
 	size_t thread_count{1};
+
+	/// Mirrors vkb::RenderContext, the frames are not paced or timed
+	vkb::FramePacer frame_pacer;
+
+	/// Mirrors vkb::RenderContext, no async compute work is submitted
+	const vkb::core::HPPQueue *async_compute_queue{nullptr};
+
+	vk::Semaphore async_compute_wait_semaphore;
+
+	vk::PipelineStageFlags async_compute_wait_stage{vk::PipelineStageFlagBits::eAllCommands};
+
+	vk::Semaphore graphics_wait_semaphore;
+
+	vk::PipelineStageFlags graphics_wait_stage{vk::PipelineStageFlagBits::eAllCommands};
+
+	std::unique_ptr<vkb::core::HPPQueryPool> async_compute_query_pool;
+
+	std::vector<bool> async_compute_timed;
+
+	float async_compute_time{0.0f};
 };
 
 }        // namespace rendering
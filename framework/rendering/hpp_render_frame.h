@@ -35,6 +35,7 @@ namespace rendering
 class HPPRenderFrame : private vkb::RenderFrame
 {
   public:
+	using vkb::RenderFrame::mark_submitted;
 	using vkb::RenderFrame::reset;
 
 	HPPRenderFrame(vkb::core::HPPDevice &device, std::unique_ptr<HPPRenderTarget> &&render_target, size_t thread_count = 1) :
@@ -72,6 +72,16 @@ bool operator!=(const vkb::DepthStencilState &lhs, const vkb::DepthStencilState
 	       lhs.back != rhs.back || lhs.front != rhs.front;
 }
 
+bool operator!=(const vkb::TessellationState &lhs, const vkb::TessellationState &rhs)
+{
+	return lhs.patch_control_points != rhs.patch_control_points;
+}
+
+bool operator!=(const vkb::ExtendedDynamicState &lhs, const vkb::ExtendedDynamicState &rhs)
+{
+	return std::tie(lhs.extended_dynamic_state, lhs.patch_control_points) != std::tie(rhs.extended_dynamic_state, rhs.patch_control_points);
+}
+
 bool operator!=(const vkb::ColorBlendState &lhs, const vkb::ColorBlendState &rhs)
 {
 	return std::tie(lhs.logic_op, lhs.logic_op_enable) != std::tie(rhs.logic_op, rhs.logic_op_enable) ||
@@ -84,6 +94,24 @@ bool operator!=(const vkb::ColorBlendState &lhs, const vkb::ColorBlendState &rhs
 
 namespace vkb
 {
+VkPrimitiveTopology get_topology_class(VkPrimitiveTopology topology)
+{
+	switch (topology)
+	{
+		case VK_PRIMITIVE_TOPOLOGY_POINT_LIST:
+			return VK_PRIMITIVE_TOPOLOGY_POINT_LIST;
+		case VK_PRIMITIVE_TOPOLOGY_LINE_LIST:
+		case VK_PRIMITIVE_TOPOLOGY_LINE_STRIP:
+		case VK_PRIMITIVE_TOPOLOGY_LINE_LIST_WITH_ADJACENCY:
+		case VK_PRIMITIVE_TOPOLOGY_LINE_STRIP_WITH_ADJACENCY:
+			return VK_PRIMITIVE_TOPOLOGY_LINE_LIST;
+		case VK_PRIMITIVE_TOPOLOGY_PATCH_LIST:
+			return VK_PRIMITIVE_TOPOLOGY_PATCH_LIST;
+		default:
+			return VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+	}
+}
+
 void SpecializationConstantState::reset()
 {
 	if (dirty)
@@ -150,6 +178,8 @@ void PipelineState::reset()
 
 	color_blend_state = {};
 
+	tessellation_state = {};
+
 	subpass_index = {0U};
 }
 
@@ -215,9 +245,15 @@ void PipelineState::set_input_assembly_state(const InputAssemblyState &new_input
 {
 	if (input_assembly_state != new_input_assembly_state)
 	{
-		input_assembly_state = new_input_assembly_state;
+		// A dynamic topology only needs a new pipeline when its topology class changes
+		if (!extended_dynamic_state.extended_dynamic_state ||
+		    input_assembly_state.primitive_restart_enable != new_input_assembly_state.primitive_restart_enable ||
+		    get_topology_class(input_assembly_state.topology) != get_topology_class(new_input_assembly_state.topology))
+		{
+			dirty = true;
+		}
 
-		dirty = true;
+		input_assembly_state = new_input_assembly_state;
 	}
 }
 
@@ -225,9 +261,15 @@ void PipelineState::set_rasterization_state(const RasterizationState &new_raster
 {
 	if (rasterization_state != new_rasterization_state)
 	{
-		rasterization_state = new_rasterization_state;
+		// Cull mode and front face are recorded by the command buffer when dynamic
+		if (!extended_dynamic_state.extended_dynamic_state ||
+		    std::tie(rasterization_state.depth_bias_enable, rasterization_state.depth_clamp_enable, rasterization_state.polygon_mode, rasterization_state.rasterizer_discard_enable) !=
+		        std::tie(new_rasterization_state.depth_bias_enable, new_rasterization_state.depth_clamp_enable, new_rasterization_state.polygon_mode, new_rasterization_state.rasterizer_discard_enable))
+		{
+			dirty = true;
+		}
 
-		dirty = true;
+		rasterization_state = new_rasterization_state;
 	}
 }
 
@@ -255,9 +297,16 @@ void PipelineState::set_depth_stencil_state(const DepthStencilState &new_depth_s
 {
 	if (depth_stencil_state != new_depth_stencil_state)
 	{
-		depth_stencil_state = new_depth_stencil_state;
+		// Depth test, depth write and depth compare op are recorded by the command buffer when dynamic
+		if (!extended_dynamic_state.extended_dynamic_state ||
+		    std::tie(depth_stencil_state.depth_bounds_test_enable, depth_stencil_state.stencil_test_enable) !=
+		        std::tie(new_depth_stencil_state.depth_bounds_test_enable, new_depth_stencil_state.stencil_test_enable) ||
+		    depth_stencil_state.back != new_depth_stencil_state.back || depth_stencil_state.front != new_depth_stencil_state.front)
+		{
+			dirty = true;
+		}
 
-		dirty = true;
+		depth_stencil_state = new_depth_stencil_state;
 	}
 }
 
@@ -271,6 +320,30 @@ void PipelineState::set_color_blend_state(const ColorBlendState &new_color_blend
 	}
 }
 
+void PipelineState::set_tessellation_state(const TessellationState &new_tessellation_state)
+{
+	if (tessellation_state != new_tessellation_state)
+	{
+		// Patch control points are recorded by the command buffer when dynamic
+		if (!extended_dynamic_state.patch_control_points)
+		{
+			dirty = true;
+		}
+
+		tessellation_state = new_tessellation_state;
+	}
+}
+
+void PipelineState::set_extended_dynamic_state(const ExtendedDynamicState &new_extended_dynamic_state)
+{
+	if (extended_dynamic_state != new_extended_dynamic_state)
+	{
+		extended_dynamic_state = new_extended_dynamic_state;
+
+		dirty = true;
+	}
+}
+
 void PipelineState::set_subpass_index(uint32_t new_subpass_index)
 {
 	if (subpass_index != new_subpass_index)
@@ -332,6 +405,16 @@ const ColorBlendState &PipelineState::get_color_blend_state() const
 	return color_blend_state;
 }
 
+const TessellationState &PipelineState::get_tessellation_state() const
+{
+	return tessellation_state;
+}
+
+const ExtendedDynamicState &PipelineState::get_extended_dynamic_state() const
+{
+	return extended_dynamic_state;
+}
+
 uint32_t PipelineState::get_subpass_index() const
 {
 	return subpass_index;
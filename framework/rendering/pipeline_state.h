@@ -105,6 +105,30 @@ struct DepthStencilState
 	StencilOpState back{};
 };
 
+struct TessellationState
+{
+	uint32_t patch_control_points{0};
+};
+
+/**
+ * @brief Selects the pipeline state that is left out of the pipeline key and recorded
+ *        with vkCmdSet* commands instead, so that changing it does not require a new pipeline
+ */
+struct ExtendedDynamicState
+{
+	/// Cull mode, front face, primitive topology and depth test/write/compare (VK_EXT_extended_dynamic_state)
+	VkBool32 extended_dynamic_state{VK_FALSE};
+
+	/// Patch control points (VK_EXT_extended_dynamic_state2)
+	VkBool32 patch_control_points{VK_FALSE};
+};
+
+/**
+ * @brief Returns the topology class of a primitive topology. With dynamic primitive topology
+ *        a pipeline can be used with any topology of the same class.
+ */
+VkPrimitiveTopology get_topology_class(VkPrimitiveTopology topology);
+
 struct ColorBlendAttachmentState
 {
 	VkBool32 blend_enable{VK_FALSE};
@@ -195,6 +219,14 @@ class PipelineState
 
 	void set_color_blend_state(const ColorBlendState &color_blend_state);
 
+	void set_tessellation_state(const TessellationState &tessellation_state);
+
+	/**
+	 * @brief Selects which state is dynamic. It is a property of the device rather than of a draw,
+	 *        so it is kept across calls to reset.
+	 */
+	void set_extended_dynamic_state(const ExtendedDynamicState &extended_dynamic_state);
+
 	void set_subpass_index(uint32_t subpass_index);
 
 	const PipelineLayout &get_pipeline_layout() const;
@@ -217,6 +249,10 @@ class PipelineState
 
 	const ColorBlendState &get_color_blend_state() const;
 
+	const TessellationState &get_tessellation_state() const;
+
+	const ExtendedDynamicState &get_extended_dynamic_state() const;
+
 	uint32_t get_subpass_index() const;
 
 	bool is_dirty() const;
@@ -246,6 +282,10 @@ class PipelineState
 
 	ColorBlendState color_blend_state{};
 
+	TessellationState tessellation_state{};
+
+	ExtendedDynamicState extended_dynamic_state{};
+
 	uint32_t subpass_index{0U};
 };
 }        // namespace vkb
@@ -46,7 +46,10 @@ PostProcessingComputePass::PostProcessingComputePass(PostProcessingPipeline *par
 		sampler_info.maxAnisotropy    = 0.0f;
 		sampler_info.borderColor      = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE;
 
-		this->default_sampler = std::make_shared<vkb::core::Sampler>(get_render_context().get_device(), sampler_info);
+		// Shared with the other passes using the same state, the deleter returns it to the cache
+		auto &resource_cache  = get_render_context().get_device().get_resource_cache();
+		this->default_sampler = std::shared_ptr<core::Sampler>(&resource_cache.request_sampler(sampler_info),
+		                                                       [&resource_cache](core::Sampler *sampler) { resource_cache.release_sampler(*sampler); });
 	}
 }
 
@@ -87,19 +90,15 @@ PostProcessingComputePass &PostProcessingComputePass::bind_storage_image(const s
 	return *this;
 }
 
-void PostProcessingComputePass::transition_images(CommandBuffer &command_buffer, RenderTarget &default_render_target)
+std::vector<PostProcessingComputePass::AttachmentUse> PostProcessingComputePass::get_attachment_uses(RenderTarget &default_render_target) const
 {
-	BarrierInfo fallback_barrier_src{};
-	fallback_barrier_src.pipeline_stage     = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-	fallback_barrier_src.image_read_access  = 0;        // For UNDEFINED -> STORAGE in first CP
-	fallback_barrier_src.image_write_access = 0;
-	const auto prev_pass_barrier_info       = get_predecessor_src_barrier_info(fallback_barrier_src);
-
 	// Get compute shader from cache
-	auto &resource_cache  = command_buffer.get_device().get_resource_cache();
+	auto &resource_cache  = get_render_context().get_device().get_resource_cache();
 	auto &shader_module   = resource_cache.request_shader_module(VK_SHADER_STAGE_COMPUTE_BIT, cs_source, cs_variant);
 	auto &pipeline_layout = resource_cache.request_pipeline_layout({&shader_module});
 
+	std::vector<AttachmentUse> uses;
+
 	for (const auto &sampled : sampled_images)
 	{
 		if (const uint32_t *attachment = sampled.second.get_target_attachment())
@@ -110,28 +109,11 @@ void PostProcessingComputePass::transition_images(CommandBuffer &command_buffer,
 				sampled_rt = &default_render_target;
 			}
 
-			if (sampled_rt->get_layout(*attachment) == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
-			{
-				// No-op
-				continue;
-			}
-
-			vkb::ImageMemoryBarrier barrier;
-			barrier.old_layout      = sampled_rt->get_layout(*attachment);
-			barrier.new_layout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-			barrier.src_access_mask = prev_pass_barrier_info.image_write_access;
-			barrier.dst_access_mask = VK_ACCESS_SHADER_READ_BIT;
-			barrier.src_stage_mask  = prev_pass_barrier_info.pipeline_stage;
-			barrier.dst_stage_mask  = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-
 			assert(*attachment < sampled_rt->get_views().size());
-			command_buffer.image_memory_barrier(sampled_rt->get_views()[*attachment], barrier);
-			sampled_rt->set_layout(*attachment, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+			uses.push_back({sampled_rt, *attachment, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_ACCESS_SHADER_READ_BIT});
 		}
 	}
 
-	const auto &bindings = pipeline_layout.get_descriptor_set_layout(0);
-
 	for (const auto &storage : storage_images)
 	{
 		if (const uint32_t *attachment = storage.second.get_target_attachment())
@@ -142,8 +124,8 @@ void PostProcessingComputePass::transition_images(CommandBuffer &command_buffer,
 				storage_rt = &default_render_target;
 			}
 
-			// A storage image is either readonly or writeonly;
-			// use shader reflection to figure out which case, then transition
+			// Storage images are always in the general layout, as their descriptors are written;
+			// use shader reflection to figure out whether they are read, written or both
 			// NOTE: Could add a <name -> readonly?> cache to make this faster?
 			auto resource = std::find_if(pipeline_layout.get_resources().begin(), pipeline_layout.get_resources().end(),
 			                             [&storage](const auto &res) {
@@ -156,37 +138,61 @@ void PostProcessingComputePass::transition_images(CommandBuffer &command_buffer,
 			}
 
 			const bool readable = !(resource->qualifiers & ShaderResourceQualifiers::NonReadable);
-			const bool writable = !(resource->qualifiers & ShaderResourceQualifiers::NonReadable);
-
-			vkb::ImageMemoryBarrier barrier;
-			barrier.old_layout = storage_rt->get_layout(*attachment);
-			barrier.new_layout = (readable && !writable) ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_GENERAL;
-
-			if (storage_rt->get_layout(*attachment) == barrier.new_layout)
-			{
-				// No-op
-				continue;
-			}
-
-			barrier.src_stage_mask = prev_pass_barrier_info.pipeline_stage;
-			barrier.dst_stage_mask = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+			const bool writable = !(resource->qualifiers & ShaderResourceQualifiers::NonWritable);
 
-			barrier.src_access_mask = prev_pass_barrier_info.image_write_access;
-			barrier.dst_access_mask = 0;
+			AttachmentUse use{storage_rt, *attachment, VK_IMAGE_LAYOUT_GENERAL, 0};
 			if (readable)
 			{
-				barrier.dst_access_mask |= VK_ACCESS_SHADER_READ_BIT;
+				use.access |= VK_ACCESS_SHADER_READ_BIT;
 			}
 			if (writable)
 			{
-				barrier.dst_access_mask |= VK_ACCESS_SHADER_WRITE_BIT;
+				use.access |= VK_ACCESS_SHADER_WRITE_BIT;
 			}
 
 			assert(*attachment < storage_rt->get_views().size());
-			command_buffer.image_memory_barrier(storage_rt->get_views()[*attachment], barrier);
-			storage_rt->set_layout(*attachment, barrier.new_layout);
+			uses.push_back(use);
 		}
 	}
+
+	return uses;
+}
+
+void PostProcessingComputePass::transition_images(CommandBuffer &command_buffer, RenderTarget &default_render_target)
+{
+	BarrierInfo fallback_barrier_src{};
+	fallback_barrier_src.pipeline_stage     = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+	fallback_barrier_src.image_read_access  = 0;        // For UNDEFINED -> STORAGE in first CP
+	fallback_barrier_src.image_write_access = 0;
+	auto prev_pass_barrier_info             = get_predecessor_src_barrier_info(fallback_barrier_src);
+
+	if (async_compute)
+	{
+		// The images were handed over to the compute queue at the compute shader stage,
+		// which the graphics stages of the predecessor are not supported on
+		prev_pass_barrier_info.pipeline_stage     = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+		prev_pass_barrier_info.image_write_access = VK_ACCESS_SHADER_WRITE_BIT;
+	}
+
+	for (const auto &use : get_attachment_uses(default_render_target))
+	{
+		if (use.render_target->get_layout(use.attachment) == use.layout)
+		{
+			// No-op
+			continue;
+		}
+
+		vkb::ImageMemoryBarrier barrier;
+		barrier.old_layout      = use.render_target->get_layout(use.attachment);
+		barrier.new_layout      = use.layout;
+		barrier.src_access_mask = prev_pass_barrier_info.image_write_access;
+		barrier.dst_access_mask = use.access;
+		barrier.src_stage_mask  = prev_pass_barrier_info.pipeline_stage;
+		barrier.dst_stage_mask  = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+
+		command_buffer.image_memory_barrier(use.render_target->get_views()[use.attachment], barrier);
+		use.render_target->set_layout(use.attachment, use.layout);
+	}
 }
 
 void PostProcessingComputePass::draw(CommandBuffer &command_buffer, RenderTarget &default_render_target)
@@ -1,4 +1,4 @@
-/* Copyright (c) 2020, Arm Limited and Contributors
+/* Copyright (c) 2020-2023, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -34,6 +34,8 @@ using SampledImageMap = std::unordered_map<std::string, core::SampledImage>;
 */
 class PostProcessingComputePass : public PostProcessingPass<PostProcessingComputePass>
 {
+	friend class PostProcessingPipeline;
+
   public:
 	PostProcessingComputePass(PostProcessingPipeline *parent, const ShaderSource &cs_source, const ShaderVariant &cs_variant = {},
 	                          std::shared_ptr<core::Sampler> &&default_sampler = {});
@@ -64,6 +66,24 @@ class PostProcessingComputePass : public PostProcessingPass<PostProcessingComput
 		return n_workgroups;
 	}
 
+	/**
+	 * @brief Runs the pass on the async compute queue of the render context, overlapping the graphics work
+	 *        that follows it, for example the next frame.
+	 * @remarks Consecutive async passes are submitted together. The render target attachments they use are
+	 *          handed over between the queues by the parent vkb::PostProcessingPipeline; other images must
+	 *          be created with VK_SHARING_MODE_CONCURRENT if the compute queue is of another queue family.
+	 */
+	inline PostProcessingComputePass &set_async_compute(bool enable)
+	{
+		async_compute = enable;
+		return *this;
+	}
+
+	inline bool is_async_compute() const
+	{
+		return async_compute;
+	}
+
 	/**
 	* @brief Maps the names of samplers in the shader to vkb::core::SampledImage.
 	*        These are given as samplers to the subpass, at set 0; they are bound automatically according to their name.
@@ -146,6 +166,21 @@ class PostProcessingComputePass : public PostProcessingPass<PostProcessingComput
 	}
 
   private:
+	/**
+	 * @brief A render target attachment bound to the pass
+	 */
+	struct AttachmentUse
+	{
+		RenderTarget *render_target;
+
+		uint32_t attachment;
+
+		/// The layout the pass accesses the attachment in
+		VkImageLayout layout;
+
+		VkAccessFlags access;
+	};
+
 	ShaderSource         cs_source;
 	ShaderVariant        cs_variant;
 	glm::tvec3<uint32_t> n_workgroups{1, 1, 1};
@@ -158,6 +193,13 @@ class PostProcessingComputePass : public PostProcessingPass<PostProcessingComput
 	std::unique_ptr<BufferAllocation> uniform_alloc{};
 	std::vector<uint8_t>              push_constants_data{};
 
+	bool async_compute{false};
+
+	/**
+	 * @brief Returns the render target attachments bound as sampled images and storage images
+	 */
+	std::vector<AttachmentUse> get_attachment_uses(RenderTarget &default_render_target) const;
+
 	/**
 	 * @brief Transitions sampled_images (to SHADER_READ_ONLY_OPTIMAL)
 	 *        and storage_images (to GENERAL) as appropriate.
@@ -1,4 +1,4 @@
-/* Copyright (c) 2020-2022, Arm Limited and Contributors
+/* Copyright (c) 2020-2023, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -73,6 +73,9 @@ class PostProcessingPassBase
 	PostProcessingPipeline *parent{nullptr};
 	bool                    prepared{false};
 
+	// Set by the parent when this pass is drawn as part of the render pass of a preceding pass
+	bool fused{false};
+
 	std::string debug_name{};
 
 	RenderTarget                  *render_target{nullptr};
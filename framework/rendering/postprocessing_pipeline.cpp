@@ -1,4 +1,4 @@
-/* Copyright (c) 2020-2021, Arm Limited and Contributors
+/* Copyright (c) 2020-2023, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -17,7 +17,10 @@
 
 #include "postprocessing_pipeline.h"
 
+#include "common/logging.h"
 #include "common/utils.h"
+#include "postprocessing_computepass.h"
+#include "postprocessing_renderpass.h"
 
 namespace vkb
 {
@@ -26,44 +29,321 @@ PostProcessingPipeline::PostProcessingPipeline(RenderContext &render_context, Sh
     triangle_vs{std::move(triangle_vs)}
 {}
 
-void PostProcessingPipeline::draw(CommandBuffer &command_buffer, RenderTarget &default_render_target)
+namespace
 {
+bool is_async_compute_pass(const PostProcessingPassBase &pass)
+{
+	auto *compute_pass = dynamic_cast<const PostProcessingComputePass *>(&pass);
+	return compute_pass && compute_pass->is_async_compute();
+}
+}        // namespace
+
+CommandBuffer &PostProcessingPipeline::draw(CommandBuffer &command_buffer, RenderTarget &default_render_target)
+{
+	update_fusion();
+
+	CommandBuffer *current_command_buffer = &command_buffer;
+	bool           async_compute          = false;
+
 	for (current_pass_index = 0; current_pass_index < passes.size(); current_pass_index++)
 	{
 		auto &pass = *passes[current_pass_index];
 
+		if (pass.fused)
+		{
+			// Drawn as part of the render pass of a preceding pass
+			continue;
+		}
+
+		if (is_async_compute_pass(pass) != async_compute)
+		{
+			async_compute          = !async_compute;
+			current_command_buffer = async_compute ? &begin_async_compute(*current_command_buffer, default_render_target) :
+			                                         &end_async_compute(*current_command_buffer, default_render_target);
+		}
+
 		if (pass.debug_name.empty())
 		{
 			pass.debug_name = fmt::format("PPP pass #{}", current_pass_index);
 		}
-		ScopedDebugLabel marker{command_buffer, pass.debug_name.c_str()};
+		ScopedDebugLabel marker{*current_command_buffer, pass.debug_name.c_str()};
 
 		if (!pass.prepared)
 		{
-			ScopedDebugLabel marker{command_buffer, "Prepare"};
+			ScopedDebugLabel marker{*current_command_buffer, "Prepare"};
 
-			pass.prepare(command_buffer, default_render_target);
+			pass.prepare(*current_command_buffer, default_render_target);
 			pass.prepared = true;
 		}
 
 		if (pass.pre_draw)
 		{
-			ScopedDebugLabel marker{command_buffer, "Pre-draw"};
+			ScopedDebugLabel marker{*current_command_buffer, "Pre-draw"};
 
 			pass.pre_draw();
 		}
 
-		pass.draw(command_buffer, default_render_target);
+		pass.draw(*current_command_buffer, default_render_target);
 
 		if (pass.post_draw)
 		{
-			ScopedDebugLabel marker{command_buffer, "Post-draw"};
+			ScopedDebugLabel marker{*current_command_buffer, "Post-draw"};
 
 			pass.post_draw();
 		}
 	}
 
+	if (async_compute)
+	{
+		// The pipeline ends with async compute passes, the graphics work of the frame waits for them
+		current_command_buffer = &end_async_compute(*current_command_buffer, default_render_target);
+	}
+
 	current_pass_index = 0;
+
+	log_bandwidth_estimate(default_render_target);
+
+	return *current_command_buffer;
+}
+
+CommandBuffer &PostProcessingPipeline::begin_async_compute(CommandBuffer &command_buffer, RenderTarget &default_render_target)
+{
+	// The writes of the predecessor, or of the work recorded before the pipeline
+	PostProcessingPassBase::BarrierInfo fallback_barrier_src{};
+	fallback_barrier_src.pipeline_stage     = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+	fallback_barrier_src.image_write_access = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+	const auto prev_pass_barrier_info       = passes[current_pass_index]->get_predecessor_src_barrier_info(fallback_barrier_src);
+
+	auto transfers = get_async_compute_attachments(current_pass_index, default_render_target);
+	for (auto &transfer : transfers)
+	{
+		transfer.src_stage_mask  = prev_pass_barrier_info.pipeline_stage;
+		transfer.src_access_mask = prev_pass_barrier_info.image_write_access;
+		transfer.dst_stage_mask  = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+		transfer.dst_access_mask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+	}
+
+	return render_context->begin_async_compute(command_buffer, transfers);
+}
+
+CommandBuffer &PostProcessingPipeline::end_async_compute(CommandBuffer &command_buffer, RenderTarget &default_render_target)
+{
+	size_t first_pass = current_pass_index;
+	while (first_pass > 0 && is_async_compute_pass(*passes[first_pass - 1]))
+	{
+		first_pass--;
+	}
+
+	// The next pass reads the outputs of the async passes, the work after the pipeline may read them anywhere
+	VkPipelineStageFlags dst_stage_mask  = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+	VkAccessFlags        dst_access_mask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+	if (current_pass_index < passes.size())
+	{
+		dst_stage_mask  = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | passes[current_pass_index]->get_dst_barrier_info().pipeline_stage;
+		dst_access_mask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+	}
+
+	auto transfers = get_async_compute_attachments(first_pass, default_render_target);
+	for (auto &transfer : transfers)
+	{
+		transfer.src_stage_mask  = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+		transfer.src_access_mask = VK_ACCESS_SHADER_WRITE_BIT;
+		transfer.dst_stage_mask  = dst_stage_mask;
+		transfer.dst_access_mask = dst_access_mask;
+	}
+
+	return render_context->end_async_compute(command_buffer, transfers);
+}
+
+std::vector<QueueTransfer> PostProcessingPipeline::get_async_compute_attachments(size_t first_pass, RenderTarget &default_render_target) const
+{
+	std::vector<QueueTransfer> transfers;
+
+	for (size_t i = first_pass; i < passes.size() && is_async_compute_pass(*passes[i]); i++)
+	{
+		auto &compute_pass = dynamic_cast<const PostProcessingComputePass &>(*passes[i]);
+
+		for (const auto &use : compute_pass.get_attachment_uses(default_render_target))
+		{
+			const auto   *image_view = &use.render_target->get_views()[use.attachment];
+			VkImageLayout layout     = use.render_target->get_layout(use.attachment);
+
+			// Undefined images have no contents to hand over, the passes transition them
+			bool skip = layout == VK_IMAGE_LAYOUT_UNDEFINED ||
+			            std::any_of(transfers.begin(), transfers.end(), [image_view](const QueueTransfer &transfer) { return transfer.image_view == image_view; });
+			if (!skip)
+			{
+				// The layout is kept, each pass transitions the attachments it uses on the compute queue
+				QueueTransfer transfer;
+				transfer.image_view = image_view;
+				transfer.old_layout = layout;
+				transfer.new_layout = layout;
+				transfers.push_back(transfer);
+			}
+		}
+	}
+
+	return transfers;
+}
+
+void PostProcessingPipeline::update_fusion()
+{
+	PostProcessingRenderPass *host_pass = nullptr;
+
+	for (size_t i = 0; i < passes.size(); i++)
+	{
+		auto &pass        = *passes[i];
+		auto *render_pass = dynamic_cast<PostProcessingRenderPass *>(&pass);
+
+		pass.fused = false;
+
+		if (render_pass)
+		{
+			render_pass->fused_passes.clear();
+
+			if (pass_fusion && host_pass && host_pass->try_fuse(*render_pass))
+			{
+				pass.fused = true;
+				continue;
+			}
+		}
+
+		// Compute passes end the chain of render passes
+		host_pass       = render_pass;
+		last_pass_index = i;
+	}
+}
+
+std::vector<std::pair<RenderTarget *, uint32_t>> PostProcessingPipeline::get_transient_attachments(RenderTarget &default_render_target)
+{
+	// The attachments used by each render pass, including the steps of the passes fused into it
+	std::vector<std::pair<PostProcessingRenderPass *, PostProcessingRenderPass::AttachmentUsage>> render_pass_usages;
+
+	for (auto &pass : passes)
+	{
+		auto *render_pass = dynamic_cast<PostProcessingRenderPass *>(pass.get());
+
+		if (render_pass && !pass->fused)
+		{
+			render_pass_usages.emplace_back(render_pass, PostProcessingRenderPass::collect_attachment_usage(render_pass->get_steps(true)));
+		}
+	}
+
+	auto resolve = [&default_render_target](RenderTarget *render_target) {
+		return render_target ? render_target : &default_render_target;
+	};
+
+	// Whether a pass other than the given render pass uses the attachment
+	auto used_elsewhere = [&](const PostProcessingRenderPass *render_pass, RenderTarget *render_target, uint32_t attachment) {
+		for (auto &other : render_pass_usages)
+		{
+			const auto &usage = other.second;
+
+			if (other.first != render_pass && resolve(other.first->get_render_target()) == render_target &&
+			    (usage.input_attachments.count(attachment) > 0 || usage.internal_input_attachments.count(attachment) > 0 || usage.output_attachments.count(attachment) > 0))
+			{
+				return true;
+			}
+
+			for (const auto &sampled : usage.sampled_attachments)
+			{
+				if (resolve(sampled.first ? sampled.first : other.first->get_render_target()) == render_target && (sampled.second & ATTACHMENT_BITMASK) == attachment)
+				{
+					return true;
+				}
+			}
+		}
+
+		for (auto &pass : passes)
+		{
+			if (auto *compute_pass = dynamic_cast<PostProcessingComputePass *>(pass.get()))
+			{
+				for (const auto &use : compute_pass->get_attachment_uses(default_render_target))
+				{
+					if (use.render_target == render_target && use.attachment == attachment)
+					{
+						return true;
+					}
+				}
+			}
+		}
+
+		return false;
+	};
+
+	std::vector<std::pair<RenderTarget *, uint32_t>> transient_attachments;
+
+	for (auto &render_pass_usage : render_pass_usages)
+	{
+		auto       *render_pass = render_pass_usage.first;
+		const auto &usage       = render_pass_usage.second;
+
+		if (render_pass->fused_passes.empty())
+		{
+			continue;
+		}
+
+		auto        steps         = render_pass->get_steps(true);
+		const auto &final_outputs = steps.back()->get_output_attachments();
+
+		// Written and then read in the render pass, and not holding its final output
+		for (uint32_t attachment : usage.internal_input_attachments)
+		{
+			if (usage.input_attachments.count(attachment) == 0 &&
+			    std::find(final_outputs.begin(), final_outputs.end(), attachment) == final_outputs.end() &&
+			    !used_elsewhere(render_pass, resolve(render_pass->get_render_target()), attachment))
+			{
+				transient_attachments.emplace_back(render_pass->get_render_target(), attachment);
+			}
+		}
+	}
+
+	return transient_attachments;
+}
+
+void PostProcessingPipeline::log_bandwidth_estimate(RenderTarget &default_render_target)
+{
+	VkDeviceSize traffic           = 0;
+	size_t       render_pass_count = 0;
+
+	for (auto &pass : passes)
+	{
+		auto *render_pass = dynamic_cast<PostProcessingRenderPass *>(pass.get());
+
+		if (render_pass && !pass->fused)
+		{
+			traffic += render_pass->attachment_traffic;
+			render_pass_count++;
+		}
+	}
+
+	if (traffic == logged_traffic && render_pass_count == logged_render_pass_count)
+	{
+		return;
+	}
+
+	logged_traffic           = traffic;
+	logged_render_pass_count = render_pass_count;
+
+	// Estimate the same passes each run as their own render pass, for comparison
+	VkDeviceSize unfused_traffic = 0;
+
+	for (auto &pass : passes)
+	{
+		if (auto *render_pass = dynamic_cast<PostProcessingRenderPass *>(pass.get()))
+		{
+			unfused_traffic += render_pass->estimate_attachment_traffic(default_render_target, false);
+		}
+	}
+
+	LOGI("Post-processing: {} passes in {} render passes, estimated attachment traffic {:.2f} MiB per frame ({:.2f} MiB without fusion)",
+	     passes.size(), render_pass_count, traffic / (1024.0 * 1024.0), unfused_traffic / (1024.0 * 1024.0));
+
+	for (const auto &attachment : get_transient_attachments(default_render_target))
+	{
+		LOGI("Post-processing: attachment {} of {} render target never leaves its fused render pass and can be transient",
+		     attachment.second, attachment.first ? "a pass" : "the default");
+	}
 }
 
 }        // namespace vkb
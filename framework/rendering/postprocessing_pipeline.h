@@ -1,4 +1,4 @@
-/* Copyright (c) 2020, Arm Limited and Contributors
+/* Copyright (c) 2020-2023, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -48,8 +48,10 @@ class PostProcessingPipeline
 	 * @brief Runs all renderpasses in this pipeline, recording commands into the given command buffer.
 	 * @remarks vkb::PostProcessingRenderpass that do not explicitly have a vkb::RenderTarget set will render
 	 *          to default_render_target.
+	 * @remarks Async compute passes submit the commands recorded so far, see vkb::RenderContext::begin_async_compute().
+	 * @returns The command buffer to record the rest of the frame into, a new one if async compute passes were submitted
 	 */
-	void draw(CommandBuffer &command_buffer, RenderTarget &default_render_target);
+	CommandBuffer &draw(CommandBuffer &command_buffer, RenderTarget &default_render_target);
 
 	/**
 	 * @brief Gets all of the passes in the pipeline.
@@ -95,11 +97,76 @@ class PostProcessingPipeline
 		return current_pass_index;
 	}
 
+	/**
+	 * @brief Returns the index of the last pass that is not drawn as part of a preceding pass.
+	 */
+	inline size_t get_last_pass_index() const
+	{
+		return last_pass_index;
+	}
+
+	/**
+	 * @brief Enables or disables merging consecutive vkb::PostProcessingRenderPass into a single render pass.
+	 * @remarks A pass is merged into the render pass of its predecessor when it draws to the same render target,
+	 *          reads its predecessor's outputs only as input attachments (i.e. at the same pixel), does not sample
+	 *          the shared render target, and neither a post-draw hook nor a pre-draw hook separates them.
+	 *          Fusion is enabled by default.
+	 */
+	inline void set_pass_fusion(bool enable)
+	{
+		pass_fusion = enable;
+	}
+
+	inline bool get_pass_fusion() const
+	{
+		return pass_fusion;
+	}
+
+	/**
+	 * @brief Returns the attachments which are written and read as input attachments within a single fused render pass,
+	 *        and used by no other pass, as pairs of render target (nullptr for the default render target) and attachment index.
+	 * @remarks Their contents never leave the render pass, so the caller can create them with VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT
+	 *          in lazily allocated memory, which also skips storing them, as long as it does not read them after the pipeline.
+	 *          The result follows the fusion decided by the last draw.
+	 */
+	std::vector<std::pair<RenderTarget *, uint32_t>> get_transient_attachments(RenderTarget &default_render_target);
+
   private:
+	/**
+	 * @brief Decides which passes are drawn as part of the render pass of a preceding pass.
+	 */
+	void update_fusion();
+
+	/**
+	 * @brief Hands the attachments of the async compute passes starting at the current pass over to the compute queue
+	 * @returns The command buffer of the compute queue
+	 */
+	CommandBuffer &begin_async_compute(CommandBuffer &command_buffer, RenderTarget &default_render_target);
+
+	/**
+	 * @brief Hands the attachments of the async compute passes ending before the current pass back to the graphics queue
+	 * @returns The command buffer of the graphics queue
+	 */
+	CommandBuffer &end_async_compute(CommandBuffer &command_buffer, RenderTarget &default_render_target);
+
+	/**
+	 * @brief Returns the attachments used by the async compute passes from first_pass to the end of their run
+	 */
+	std::vector<QueueTransfer> get_async_compute_attachments(size_t first_pass, RenderTarget &default_render_target) const;
+
+	/**
+	 * @brief Logs the estimated attachment traffic when the render passes of the pipeline changed.
+	 */
+	void log_bandwidth_estimate(RenderTarget &default_render_target);
+
 	RenderContext *                                      render_context{nullptr};
 	ShaderSource                                         triangle_vs;
 	std::vector<std::unique_ptr<PostProcessingPassBase>> passes{};
 	size_t                                               current_pass_index{0};
+	size_t                                               last_pass_index{0};
+	bool                                                 pass_fusion{true};
+	VkDeviceSize                                         logged_traffic{0};
+	size_t                                               logged_render_pass_count{0};
 };
 
 }        // namespace vkb
\ No newline at end of file
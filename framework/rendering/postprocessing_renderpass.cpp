@@ -21,9 +21,6 @@
 
 namespace vkb
 {
-constexpr uint32_t DEPTH_RESOLVE_BITMASK = 0x80000000;
-constexpr uint32_t ATTACHMENT_BITMASK    = 0x7FFFFFFF;
-
 PostProcessingSubpass::PostProcessingSubpass(PostProcessingRenderPass *parent, RenderContext &render_context, ShaderSource &&triangle_vs,
                                              ShaderSource &&fs, ShaderVariant &&fs_variant) :
     Subpass(render_context, std::move(triangle_vs), std::move(fs)),
@@ -215,38 +212,30 @@ PostProcessingRenderPass::PostProcessingRenderPass(PostProcessingPipeline *paren
 		sampler_info.maxAnisotropy    = 0.0f;
 		sampler_info.borderColor      = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE;
 
-		this->default_sampler = std::make_unique<vkb::core::Sampler>(get_render_context().get_device(), sampler_info);
+		// Shared with the other passes using the same state, the deleter returns it to the cache
+		auto &resource_cache  = get_render_context().get_device().get_resource_cache();
+		this->default_sampler = std::shared_ptr<core::Sampler>(&resource_cache.request_sampler(sampler_info),
+		                                                       [&resource_cache](core::Sampler *sampler) { resource_cache.release_sampler(*sampler); });
 	}
 }
 
-void PostProcessingRenderPass::update_load_stores(
-    const AttachmentSet        &input_attachments,
-    const SampledAttachmentSet &sampled_attachments,
-    const AttachmentSet        &output_attachments,
-    const RenderTarget         &fallback_render_target)
+std::vector<LoadStoreInfo> PostProcessingRenderPass::select_load_stores(const AttachmentUsage &usage, const RenderTarget &render_target)
 {
-	if (!load_stores_dirty)
-	{
-		return;
-	}
-
-	const auto &render_target = this->render_target ? *this->render_target : fallback_render_target;
-
-	// Update load/stores accordingly
-	load_stores.clear();
+	std::vector<LoadStoreInfo> load_stores;
 
 	for (uint32_t j = 0; j < static_cast<uint32_t>(render_target.get_attachments().size()); j++)
 	{
-		const bool is_input   = input_attachments.find(j) != input_attachments.end();
-		const bool is_sampled = std::find_if(sampled_attachments.begin(), sampled_attachments.end(),
-		                                     [&render_target, j](auto &pair) {
-			                                     // NOTE: if RT not set, default is the currently-active one
-			                                     auto *sampled_rt = pair.first ? pair.first : &render_target;
-			                                     // unpack attachment
-			                                     uint32_t attachment = pair.second & ATTACHMENT_BITMASK;
-			                                     return attachment == j && sampled_rt == &render_target;
-		                                     }) != sampled_attachments.end();
-		const bool is_output  = output_attachments.find(j) != output_attachments.end();
+		const bool is_input     = usage.input_attachments.find(j) != usage.input_attachments.end();
+		const bool is_sampled   = std::find_if(usage.sampled_attachments.begin(), usage.sampled_attachments.end(),
+		                                       [&render_target, j](auto &pair) {
+			                                       // NOTE: if RT not set, default is the currently-active one
+			                                       auto *sampled_rt = pair.first ? pair.first : &render_target;
+			                                       // unpack attachment
+			                                       uint32_t attachment = pair.second & ATTACHMENT_BITMASK;
+			                                       return attachment == j && sampled_rt == &render_target;
+		                                       }) != usage.sampled_attachments.end();
+		const bool is_output    = usage.output_attachments.find(j) != usage.output_attachments.end();
+		const bool is_transient = render_target.get_attachments()[j].usage & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
 
 		VkAttachmentLoadOp load;
 		if (is_input || is_sampled)
@@ -262,8 +251,9 @@ void PostProcessingRenderPass::update_load_stores(
 			load = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
 		}
 
+		// Transient attachments only live in the render pass, e.g. an intermediate of fused passes
 		VkAttachmentStoreOp store;
-		if (is_output)
+		if (is_output && !is_transient)
 		{
 			store = VK_ATTACHMENT_STORE_OP_STORE;
 		}
@@ -275,6 +265,58 @@ void PostProcessingRenderPass::update_load_stores(
 		load_stores.push_back({load, store});
 	}
 
+	return load_stores;
+}
+
+static VkDeviceSize get_attachment_size(const RenderTarget &render_target, uint32_t attachment)
+{
+	const auto &description = render_target.get_attachments()[attachment];
+	const auto &extent      = render_target.get_extent();
+
+	return static_cast<VkDeviceSize>(extent.width) * extent.height * description.samples * std::max<int32_t>(get_bits_per_pixel(description.format), 0) / 8;
+}
+
+VkDeviceSize PostProcessingRenderPass::estimate_traffic(const AttachmentUsage &usage, const std::vector<LoadStoreInfo> &load_stores, const RenderTarget &render_target)
+{
+	VkDeviceSize traffic = 0;
+
+	for (uint32_t j = 0; j < static_cast<uint32_t>(load_stores.size()); j++)
+	{
+		if (load_stores[j].load_op == VK_ATTACHMENT_LOAD_OP_LOAD)
+		{
+			traffic += get_attachment_size(render_target, j);
+		}
+
+		if (load_stores[j].store_op == VK_ATTACHMENT_STORE_OP_STORE)
+		{
+			traffic += get_attachment_size(render_target, j);
+		}
+	}
+
+	// Sampled attachments are read at least once
+	for (const auto &sampled : usage.sampled_attachments)
+	{
+		const auto *sampled_rt = sampled.first ? sampled.first : &render_target;
+
+		traffic += get_attachment_size(*sampled_rt, sampled.second & ATTACHMENT_BITMASK);
+	}
+
+	return traffic;
+}
+
+void PostProcessingRenderPass::update_load_stores(const AttachmentUsage &usage, const RenderTarget &fallback_render_target)
+{
+	if (!load_stores_dirty)
+	{
+		return;
+	}
+
+	const auto &render_target = this->render_target ? *this->render_target : fallback_render_target;
+
+	// Update load/stores accordingly
+	load_stores        = select_load_stores(usage, render_target);
+	attachment_traffic = estimate_traffic(usage, load_stores, render_target);
+
 	pipeline.set_load_store(load_stores);
 	load_stores_dirty = false;
 }
@@ -445,22 +487,48 @@ void PostProcessingRenderPass::transition_attachments(
 	//       so we don't want to transition them to UNDEFINED layout here
 }
 
-void PostProcessingRenderPass::prepare_draw(CommandBuffer &command_buffer, RenderTarget &fallback_render_target)
+std::vector<PostProcessingSubpass *> PostProcessingRenderPass::get_steps(bool include_fused)
 {
-	// Collect all input, output, and sampled-from attachments from all subpasses (steps)
-	AttachmentSet        input_attachments, output_attachments;
-	SampledAttachmentSet sampled_attachments;
+	std::vector<PostProcessingSubpass *> steps;
 
 	for (auto &step_ptr : pipeline.get_subpasses())
 	{
-		auto &step = *dynamic_cast<PostProcessingSubpass *>(step_ptr.get());
+		steps.push_back(dynamic_cast<PostProcessingSubpass *>(step_ptr.get()));
+	}
 
-		for (auto &it : step.get_input_attachments())
+	if (include_fused)
+	{
+		for (auto *fused_pass : fused_passes)
 		{
-			input_attachments.insert(it.second);
+			auto fused_steps = fused_pass->get_steps(false);
+			steps.insert(steps.end(), fused_steps.begin(), fused_steps.end());
 		}
+	}
 
-		for (auto &it : step.get_sampled_images())
+	return steps;
+}
+
+PostProcessingRenderPass::AttachmentUsage PostProcessingRenderPass::collect_attachment_usage(const std::vector<PostProcessingSubpass *> &steps)
+{
+	// Collect all input, output, and sampled-from attachments from all subpasses (steps)
+	AttachmentUsage usage;
+
+	for (auto *step : steps)
+	{
+		for (auto &it : step->get_input_attachments())
+		{
+			// Inputs written by a previous step stay in the render pass
+			if (usage.output_attachments.find(it.second) != usage.output_attachments.end())
+			{
+				usage.internal_input_attachments.insert(it.second);
+			}
+			else
+			{
+				usage.input_attachments.insert(it.second);
+			}
+		}
+
+		for (auto &it : step->get_sampled_images())
 		{
 			if (const uint32_t *sampled_attachment = it.second.get_target_attachment())
 			{
@@ -473,26 +541,80 @@ void PostProcessingRenderPass::prepare_draw(CommandBuffer &command_buffer, Rende
 					packed_sampled_attachment |= DEPTH_RESOLVE_BITMASK;
 				}
 
-				sampled_attachments.insert({image_rt, packed_sampled_attachment});
+				usage.sampled_attachments.insert({image_rt, packed_sampled_attachment});
 			}
 		}
 
-		for (uint32_t it : step.get_output_attachments())
+		for (uint32_t it : step->get_output_attachments())
 		{
-			output_attachments.insert(it);
+			usage.output_attachments.insert(it);
 		}
 	}
 
-	transition_attachments(input_attachments, sampled_attachments, output_attachments,
-	                       command_buffer, fallback_render_target);
-	update_load_stores(input_attachments, sampled_attachments, output_attachments,
-	                   fallback_render_target);
+	return usage;
 }
 
-void PostProcessingRenderPass::draw(CommandBuffer &command_buffer, RenderTarget &default_render_target)
+bool PostProcessingRenderPass::try_fuse(PostProcessingRenderPass &next)
 {
-	prepare_draw(command_buffer, default_render_target);
+	// Hooks run between render passes, and subpasses of a render pass share its framebuffer
+	if (post_draw || next.pre_draw || next.post_draw || next.render_target != render_target || next.pipeline.get_subpasses().empty())
+	{
+		return false;
+	}
+
+	auto usage      = collect_attachment_usage(get_steps(true));
+	auto next_usage = collect_attachment_usage(next.get_steps(false));
 
+	// Sampling reads any pixel, so the outputs of the render pass may only be read as input attachments
+	for (const auto &sampled : next_usage.sampled_attachments)
+	{
+		if (sampled.first == nullptr || sampled.first == render_target)
+		{
+			return false;
+		}
+	}
+
+	// An attachment sampled in the render pass can not be written in it
+	for (const auto &sampled : usage.sampled_attachments)
+	{
+		if ((sampled.first == nullptr || sampled.first == render_target) &&
+		    next_usage.output_attachments.find(sampled.second & ATTACHMENT_BITMASK) != next_usage.output_attachments.end())
+		{
+			return false;
+		}
+	}
+
+	fused_passes.push_back(&next);
+
+	return true;
+}
+
+VkDeviceSize PostProcessingRenderPass::estimate_attachment_traffic(RenderTarget &default_render_target, bool include_fused)
+{
+	const auto &target = render_target ? *render_target : default_render_target;
+	auto        usage  = collect_attachment_usage(get_steps(include_fused));
+
+	return estimate_traffic(usage, select_load_stores(usage, target), target);
+}
+
+void PostProcessingRenderPass::prepare_draw(CommandBuffer &command_buffer, RenderTarget &fallback_render_target, const std::vector<PostProcessingSubpass *> &steps)
+{
+	auto usage = collect_attachment_usage(steps);
+
+	// Inputs written earlier in the render pass are transitioned by the render pass itself
+	transition_attachments(usage.input_attachments, usage.sampled_attachments, usage.output_attachments,
+	                       command_buffer, fallback_render_target);
+	update_load_stores(usage, fallback_render_target);
+
+	// Fusion is decided again on every draw, so load/stores chosen for a fused render pass are not kept
+	if (!fused_passes.empty())
+	{
+		load_stores_dirty = true;
+	}
+}
+
+void PostProcessingRenderPass::update_uniform_buffer()
+{
 	if (!uniform_data.empty())
 	{
 		// Allocate a buffer (using the buffer pool from the active frame to store uniform values) and bind it
@@ -500,10 +622,111 @@ void PostProcessingRenderPass::draw(CommandBuffer &command_buffer, RenderTarget
 		uniform_buffer_alloc = std::make_shared<BufferAllocation>(render_frame.allocate_buffer(VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, uniform_data.size()));
 		uniform_buffer_alloc->update(uniform_data);
 	}
+}
+
+void PostProcessingRenderPass::draw_fused(CommandBuffer &command_buffer, const std::vector<PostProcessingSubpass *> &steps)
+{
+	auto &render_target = *draw_render_target;
+
+	std::vector<Subpass *> subpasses(steps.begin(), steps.end());
+
+	// Pad clear values if they're less than render target attachments
+	auto clear_values = pipeline.get_clear_value();
+	while (clear_values.size() < render_target.get_attachments().size())
+	{
+		clear_values.push_back({0.0f, 0.0f, 0.0f, 1.0f});
+	}
+
+	for (size_t i = 0; i < steps.size(); ++i)
+	{
+		auto &step = *steps[i];
+
+		step.update_render_target_attachments(render_target);
+
+		if (i == 0)
+		{
+			command_buffer.begin_render_pass(render_target, load_stores, clear_values, subpasses);
+		}
+		else
+		{
+			command_buffer.next_subpass();
+		}
+
+		if (step.get_debug_name().empty())
+		{
+			step.set_debug_name(fmt::format("PPP fused subpass #{}", i));
+		}
+
+		ScopedDebugLabel subpass_debug_label{command_buffer, step.get_debug_name().c_str()};
+
+		step.draw(command_buffer);
+	}
+}
+
+void PostProcessingRenderPass::update_final_layouts(const std::vector<PostProcessingSubpass *> &steps, RenderTarget &render_target)
+{
+	// The render pass leaves attachments in the layout of the last subpass using them, or in the attachment layout
+	const auto &last_step = *steps.back();
+	const auto &outputs   = last_step.get_output_attachments();
+
+	for (auto *step : steps)
+	{
+		for (auto &it : step->get_input_attachments())
+		{
+			const uint32_t attachment = it.second;
+			const bool     is_depth   = is_depth_stencil_format(render_target.get_attachments()[attachment].format);
+
+			if (std::find(outputs.begin(), outputs.end(), attachment) != outputs.end())
+			{
+				continue;
+			}
+
+			const auto &last_inputs    = last_step.get_input_attachments();
+			const bool  read_last_step = std::find_if(last_inputs.begin(), last_inputs.end(), [attachment](auto &input) { return input.second == attachment; }) != last_inputs.end();
+
+			VkImageLayout final_layout;
+			if (read_last_step)
+			{
+				final_layout = is_depth ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+			}
+			else
+			{
+				final_layout = is_depth ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL : VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+			}
+
+			render_target.set_layout(attachment, final_layout);
+
+			// The image tracks the layout too, as written by the subpasses which may have output to it
+			ImageUsage usage;
+			usage.layout      = final_layout;
+			usage.stage_mask  = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT |
+			                    (is_depth ? VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT : VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+			usage.access_mask = VK_ACCESS_INPUT_ATTACHMENT_READ_BIT |
+			                    (is_depth ? VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT : VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
+
+			const auto &view = render_target.get_views()[attachment];
+			view.get_image().set_usage(view.get_subresource_range(), usage);
+		}
+	}
+}
+
+void PostProcessingRenderPass::draw(CommandBuffer &command_buffer, RenderTarget &default_render_target)
+{
+	auto steps = get_steps(true);
+
+	prepare_draw(command_buffer, default_render_target, steps);
 
 	// Update render target for this draw
 	draw_render_target = render_target ? render_target : &default_render_target;
 
+	update_uniform_buffer();
+
+	for (auto *fused_pass : fused_passes)
+	{
+		fused_pass->draw_render_target = draw_render_target;
+		fused_pass->update_uniform_buffer();
+	}
+
 	// Set appropriate viewport & scissor for this RT
 	{
 		auto &extent = draw_render_target->get_extent();
@@ -521,13 +744,22 @@ void PostProcessingRenderPass::draw(CommandBuffer &command_buffer, RenderTarget
 	}
 
 	// Finally draw all subpasses
-	pipeline.draw(command_buffer, *draw_render_target);
+	if (fused_passes.empty())
+	{
+		pipeline.draw(command_buffer, *draw_render_target);
+	}
+	else
+	{
+		draw_fused(command_buffer, steps);
+	}
+
+	update_final_layouts(steps, *draw_render_target);
 
-	if (parent->get_current_pass_index() < (parent->get_passes().size() - 1))
+	if (parent->get_current_pass_index() < parent->get_last_pass_index())
 	{
 		// Leave the last renderpass open for user modification (e.g., drawing GUI)
 		command_buffer.end_render_pass();
 	}
 }
 
-}        // namespace vkb
\ No newline at end of file
+}        // namespace vkb
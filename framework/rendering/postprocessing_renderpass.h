@@ -63,6 +63,10 @@ using AttachmentList = std::vector<uint32_t>;
  */
 using AttachmentSet = std::unordered_set<uint32_t>;
 
+// Sampled attachments are packed with a flag telling whether the depth resolve is sampled
+constexpr uint32_t DEPTH_RESOLVE_BITMASK = 0x80000000;
+constexpr uint32_t ATTACHMENT_BITMASK    = 0x7FFFFFFF;
+
 class PostProcessingRenderPass;
 
 /**
@@ -220,6 +224,7 @@ class PostProcessingRenderPass : public PostProcessingPass<PostProcessingRenderP
 {
   public:
 	friend class PostProcessingSubpass;
+	friend class PostProcessingPipeline;
 
 	PostProcessingRenderPass(PostProcessingPipeline *parent, std::unique_ptr<core::Sampler> &&default_sampler = nullptr);
 
@@ -284,6 +289,50 @@ class PostProcessingRenderPass : public PostProcessingPass<PostProcessingRenderP
 	// An attachment sampled from a rendertarget
 	using SampledAttachmentSet = std::unordered_set<std::pair<RenderTarget *, uint32_t>, PairHasher>;
 
+	/**
+	 * @brief The attachments used by the steps of a render pass.
+	 */
+	struct AttachmentUsage
+	{
+		AttachmentSet        input_attachments{};                 // Read as input attachments before being written in the render pass
+		AttachmentSet        internal_input_attachments{};        // Read as input attachments after being written in the render pass
+		AttachmentSet        output_attachments{};
+		SampledAttachmentSet sampled_attachments{};
+	};
+
+	/**
+	 * @brief Returns the steps of this pass, followed by the steps of the passes fused into it if include_fused is set.
+	 */
+	std::vector<PostProcessingSubpass *> get_steps(bool include_fused);
+
+	/**
+	 * @brief Collects the attachments used by the given steps, run in order as subpasses of one render pass.
+	 */
+	static AttachmentUsage collect_attachment_usage(const std::vector<PostProcessingSubpass *> &steps);
+
+	/**
+	 * @brief Select appropriate load/store operations for each buffer of render_target.
+	 * @remarks Attachments written before being read in the render pass are not loaded,
+	 *          transient attachments are never stored.
+	 */
+	static std::vector<LoadStoreInfo> select_load_stores(const AttachmentUsage &usage, const RenderTarget &render_target);
+
+	/**
+	 * @brief Estimates the bytes loaded, stored and sampled by a render pass.
+	 */
+	static VkDeviceSize estimate_traffic(const AttachmentUsage &usage, const std::vector<LoadStoreInfo> &load_stores, const RenderTarget &render_target);
+
+	/**
+	 * @brief Draws the next pass as further subpasses of the render pass of this pass, if they can be merged.
+	 * @returns Whether next was fused into this pass.
+	 */
+	bool try_fuse(PostProcessingRenderPass &next);
+
+	/**
+	 * @brief Estimates the bytes loaded, stored and sampled per draw by the render pass of this pass.
+	 */
+	VkDeviceSize estimate_attachment_traffic(RenderTarget &default_render_target, bool include_fused);
+
 	/**
 	 * @brief Transition input, sampled and output attachments as appropriate.
 	 * @remarks If a RenderTarget is not explicitly set for this pass, fallback_render_target is used.
@@ -297,29 +346,47 @@ class PostProcessingRenderPass : public PostProcessingPass<PostProcessingRenderP
 	/**
 	 * @brief Select appropriate load/store operations for each buffer of render_target,
 	 *        according to the subpass inputs/sampled inputs/subpass outputs of all steps
-	 *        in the pipeline.
+	 *        in the render pass.
 	 * @remarks If a RenderTarget is not explicitly set for this pass, fallback_render_target is used.
 	 */
-	void update_load_stores(const AttachmentSet        &input_attachments,
-	                        const SampledAttachmentSet &sampled_attachments,
-	                        const AttachmentSet        &output_attachments,
-	                        const RenderTarget         &fallback_render_target);
+	void update_load_stores(const AttachmentUsage &usage, const RenderTarget &fallback_render_target);
+
+	/**
+	 * @brief Transition images and prepare load/stores before draw()ing the given steps.
+	 */
+	void prepare_draw(CommandBuffer &command_buffer, RenderTarget &fallback_render_target, const std::vector<PostProcessingSubpass *> &steps);
 
 	/**
-	 * @brief Transition images and prepare load/stores before draw()ing.
+	 * @brief Allocates and fills the uniform buffer of this pass, if it has uniform data.
 	 */
-	void prepare_draw(CommandBuffer &command_buffer, RenderTarget &fallback_render_target);
+	void update_uniform_buffer();
+
+	/**
+	 * @brief Draws the steps of this pass and of the passes fused into it as subpasses of one render pass.
+	 */
+	void draw_fused(CommandBuffer &command_buffer, const std::vector<PostProcessingSubpass *> &steps);
+
+	/**
+	 * @brief Tracks the layouts the render pass of the given steps leaves its input attachments in.
+	 */
+	void update_final_layouts(const std::vector<PostProcessingSubpass *> &steps, RenderTarget &render_target);
 
 	BarrierInfo get_src_barrier_info() const override;
 	BarrierInfo get_dst_barrier_info() const override;
 
 	RenderPipeline                    pipeline{};
-	std::unique_ptr<core::Sampler>    default_sampler{};
+	std::shared_ptr<core::Sampler>    default_sampler{};
 	RenderTarget                     *draw_render_target{nullptr};
 	std::vector<LoadStoreInfo>        load_stores{};
 	bool                              load_stores_dirty{true};
 	std::vector<uint8_t>              uniform_data{};
 	std::shared_ptr<BufferAllocation> uniform_buffer_alloc{};
+
+	// Passes drawn as further subpasses of the render pass of this pass, set by the parent on each draw
+	std::vector<PostProcessingRenderPass *> fused_passes{};
+
+	// Estimated bytes loaded, stored and sampled per draw by the render pass of this pass
+	VkDeviceSize attachment_traffic{0};
 };
 
 }        // namespace vkb
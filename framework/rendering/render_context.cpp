@@ -17,7 +17,11 @@
 
 #include "render_context.h"
 
+#include <array>
+#include <thread>
+
 #include "platform/window.h"
+#include "timer.h"
 
 namespace vkb
 {
@@ -142,9 +146,10 @@ void RenderContext::update_swapchain(const VkExtent2D &extent)
 		return;
 	}
 
-	device.get_resource_cache().clear_framebuffers();
-
-	swapchain = std::make_unique<Swapchain>(*swapchain, extent);
+	// The old swapchain is retired by the new one, and destroyed once the frames in flight no longer use its images
+	auto old_swapchain = std::move(swapchain);
+	swapchain          = std::make_unique<Swapchain>(*old_swapchain, extent);
+	defer_destruction(std::move(old_swapchain));
 
 	recreate();
 }
@@ -157,11 +162,10 @@ void RenderContext::update_swapchain(const uint32_t image_count)
 		return;
 	}
 
-	device.get_resource_cache().clear_framebuffers();
-
-	device.wait_idle();
-
-	swapchain = std::make_unique<Swapchain>(*swapchain, image_count);
+	// The old swapchain is retired by the new one, and destroyed once the frames in flight no longer use its images
+	auto old_swapchain = std::move(swapchain);
+	swapchain          = std::make_unique<Swapchain>(*old_swapchain, image_count);
+	defer_destruction(std::move(old_swapchain));
 
 	recreate();
 }
@@ -174,9 +178,10 @@ void RenderContext::update_swapchain(const std::set<VkImageUsageFlagBits> &image
 		return;
 	}
 
-	device.get_resource_cache().clear_framebuffers();
-
-	swapchain = std::make_unique<Swapchain>(*swapchain, image_usage_flags);
+	// The old swapchain is retired by the new one, and destroyed once the frames in flight no longer use its images
+	auto old_swapchain = std::move(swapchain);
+	swapchain          = std::make_unique<Swapchain>(*old_swapchain, image_usage_flags);
+	defer_destruction(std::move(old_swapchain));
 
 	recreate();
 }
@@ -189,8 +194,6 @@ void RenderContext::update_swapchain(const VkExtent2D &extent, const VkSurfaceTr
 		return;
 	}
 
-	device.get_resource_cache().clear_framebuffers();
-
 	auto width  = extent.width;
 	auto height = extent.height;
 	if (transform == VK_SURFACE_TRANSFORM_ROTATE_90_BIT_KHR || transform == VK_SURFACE_TRANSFORM_ROTATE_270_BIT_KHR)
@@ -199,7 +202,10 @@ void RenderContext::update_swapchain(const VkExtent2D &extent, const VkSurfaceTr
 		std::swap(width, height);
 	}
 
-	swapchain = std::make_unique<Swapchain>(*swapchain, VkExtent2D{width, height}, transform);
+	// The old swapchain is retired by the new one, and destroyed once the frames in flight no longer use its images
+	auto old_swapchain = std::move(swapchain);
+	swapchain          = std::make_unique<Swapchain>(*old_swapchain, VkExtent2D{width, height}, transform);
+	defer_destruction(std::move(old_swapchain));
 
 	// Save the preTransform attribute for future rotations
 	pre_transform = transform;
@@ -211,6 +217,9 @@ void RenderContext::recreate()
 {
 	LOGI("Recreated swapchain");
 
+	// The images presented to the old swapchain can no longer be waited for
+	frame_pacer.clear_pending_presents();
+
 	VkExtent2D swapchain_extent = swapchain->get_extent();
 	VkExtent3D extent{swapchain_extent.width, swapchain_extent.height, 1};
 
@@ -238,7 +247,7 @@ void RenderContext::recreate()
 		++frame_it;
 	}
 
-	device.get_resource_cache().clear_framebuffers();
+	retire_framebuffers();
 }
 
 bool RenderContext::handle_surface_changes(bool force_update)
@@ -266,9 +275,7 @@ bool RenderContext::handle_surface_changes(bool force_update)
 	    surface_properties.currentExtent.height != surface_extent.height ||
 	    force_update)
 	{
-		// Recreate swapchain
-		device.wait_idle();
-
+		// Recreate swapchain, the frames in flight keep the old one alive until they complete
 		update_swapchain(surface_properties.currentExtent, pre_transform);
 
 		surface_extent = surface_properties.currentExtent;
@@ -306,23 +313,43 @@ void RenderContext::submit(const std::vector<CommandBuffer *> &command_buffers)
 {
 	assert(frame_active && "RenderContext is inactive, cannot submit command buffer. Please call begin()");
 
-	VkSemaphore render_semaphore = VK_NULL_HANDLE;
+	std::vector<VkSemaphore>          wait_semaphores;
+	std::vector<VkPipelineStageFlags> wait_stages;
 
-	if (swapchain)
+	if (swapchain && acquired_semaphore)
 	{
-		assert(acquired_semaphore && "We do not have acquired_semaphore, it was probably consumed?\n");
-		render_semaphore = submit(queue, command_buffers, acquired_semaphore, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+		wait_semaphores.push_back(acquired_semaphore);
+		wait_stages.push_back(VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
 	}
-	else
+
+	if (graphics_wait_semaphore)
 	{
-		submit(queue, command_buffers);
+		wait_semaphores.push_back(graphics_wait_semaphore);
+		wait_stages.push_back(graphics_wait_stage);
+		graphics_wait_semaphore = VK_NULL_HANDLE;
 	}
 
+	VkSemaphore render_semaphore = VK_NULL_HANDLE;
+
+	if (swapchain)
+	{
+		// The acquired semaphore was waited for by an earlier submission of the frame if there was async compute work
+		assert(!wait_semaphores.empty() && "We do not have acquired_semaphore, it was probably consumed?\n");
+		render_semaphore = get_active_frame().request_semaphore();
+	}
+
+	submit_batch(queue, command_buffers, wait_semaphores, wait_stages, render_semaphore);
+
 	end_frame(render_semaphore);
 }
 
 void RenderContext::begin_frame()
 {
+	if (!frame_pacer.is_frame_started())
+	{
+		pace_frame();
+	}
+
 	// Only handle surface changes if a swapchain exists
 	if (swapchain)
 	{
@@ -338,8 +365,14 @@ void RenderContext::begin_frame()
 	// so we need to hold ownership.
 	acquired_semaphore = prev_frame.request_semaphore_with_ownership();
 
+	Timer timer;
+
 	if (swapchain)
 	{
+		update_present_latency();
+
+		timer.start();
+
 		auto result = swapchain->acquire_next_image(active_frame_index, acquired_semaphore, VK_NULL_HANDLE);
 
 		if (result == VK_SUBOPTIMAL_KHR || result == VK_ERROR_OUT_OF_DATE_KHR)
@@ -352,53 +385,114 @@ void RenderContext::begin_frame()
 			}
 		}
 
+		frame_pacer.add_acquire(static_cast<float>(timer.stop()));
+
 		if (result != VK_SUCCESS)
 		{
 			prev_frame.reset();
 			return;
 		}
+
+		// The contents of the acquired image are undefined, the commands using it wait for the acquired semaphore
+		auto &swapchain_view = frames[active_frame_index]->get_render_target().get_views()[0];
+		swapchain_view.get_image().set_usage(swapchain_view.get_subresource_range(), {VK_IMAGE_LAYOUT_UNDEFINED, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, 0});
 	}
 
 	// Now the frame is active again
 	frame_active = true;
 
 	// Wait on all resource to be freed from the previous render to this frame
+	timer.start();
 	wait_frame();
+	frame_pacer.add_fence_wait(static_cast<float>(timer.stop()));
+
+	update_async_compute_time();
 }
 
-VkSemaphore RenderContext::submit(const Queue &queue, const std::vector<CommandBuffer *> &command_buffers, VkSemaphore wait_semaphore, VkPipelineStageFlags wait_pipeline_stage)
+void RenderContext::pace_frame()
 {
-	std::vector<VkCommandBuffer> cmd_buf_handles(command_buffers.size(), VK_NULL_HANDLE);
-	std::transform(command_buffers.begin(), command_buffers.end(), cmd_buf_handles.begin(), [](const CommandBuffer *cmd_buf) { return cmd_buf->get_handle(); });
+	auto delay = frame_pacer.get_start_delay();
 
-	RenderFrame &frame = get_active_frame();
+	if (delay > FramePacer::Clock::duration::zero())
+	{
+		std::this_thread::sleep_for(delay);
+	}
 
-	VkSemaphore signal_semaphore = frame.request_semaphore();
+	frame_pacer.start_frame(std::chrono::duration<float>(delay).count());
+}
 
-	VkSubmitInfo submit_info{VK_STRUCTURE_TYPE_SUBMIT_INFO};
+void RenderContext::wait_previous_frames()
+{
+	Timer timer;
+	timer.start();
 
-	submit_info.commandBufferCount = to_u32(cmd_buf_handles.size());
-	submit_info.pCommandBuffers    = cmd_buf_handles.data();
+	// Submissions complete in order, so this waits for the last frame submitted
+	for (size_t i = 0; i < frames.size(); ++i)
+	{
+		if (i != active_frame_index)
+		{
+			VK_CHECK(frames[i]->get_fence_pool().wait());
+		}
+	}
 
-	if (wait_semaphore != VK_NULL_HANDLE)
+	frame_pacer.on_previous_frame_complete(static_cast<float>(timer.stop()));
+}
+
+void RenderContext::update_present_latency()
+{
+	if (!device.is_enabled(VK_KHR_PRESENT_WAIT_EXTENSION_NAME))
 	{
-		submit_info.waitSemaphoreCount = 1;
-		submit_info.pWaitSemaphores    = &wait_semaphore;
-		submit_info.pWaitDstStageMask  = &wait_pipeline_stage;
+		return;
 	}
 
-	submit_info.signalSemaphoreCount = 1;
-	submit_info.pSignalSemaphores    = &signal_semaphore;
+	// Only checks whether the images were displayed, without waiting
+	for (auto present_id = frame_pacer.get_pending_present_id(); present_id != 0; present_id = frame_pacer.get_pending_present_id())
+	{
+		VkResult result = vkWaitForPresentKHR(device.get_handle(), swapchain->get_handle(), present_id, 0);
 
-	VkFence fence = frame.request_fence();
+		if (result == VK_SUCCESS)
+		{
+			frame_pacer.on_displayed(present_id);
+		}
+		else
+		{
+			if (result != VK_TIMEOUT)
+			{
+				frame_pacer.clear_pending_presents();
+			}
+			break;
+		}
+	}
+}
 
-	queue.submit({submit_info}, fence);
+VkSemaphore RenderContext::submit(const Queue &queue, const std::vector<CommandBuffer *> &command_buffers, VkSemaphore wait_semaphore, VkPipelineStageFlags wait_pipeline_stage)
+{
+	std::vector<VkSemaphore>          wait_semaphores;
+	std::vector<VkPipelineStageFlags> wait_stages;
+
+	if (wait_semaphore != VK_NULL_HANDLE)
+	{
+		wait_semaphores.push_back(wait_semaphore);
+		wait_stages.push_back(wait_pipeline_stage);
+	}
+
+	VkSemaphore signal_semaphore = get_active_frame().request_semaphore();
+
+	submit_batch(queue, command_buffers, wait_semaphores, wait_stages, signal_semaphore);
 
 	return signal_semaphore;
 }
 
 void RenderContext::submit(const Queue &queue, const std::vector<CommandBuffer *> &command_buffers)
 {
+	submit_batch(queue, command_buffers, {}, {}, VK_NULL_HANDLE);
+}
+
+void RenderContext::submit_batch(const Queue &queue, const std::vector<CommandBuffer *> &command_buffers,
+                                 const std::vector<VkSemaphore> &wait_semaphores, const std::vector<VkPipelineStageFlags> &wait_stages, VkSemaphore signal_semaphore)
+{
+	assert(wait_semaphores.size() == wait_stages.size());
+
 	std::vector<VkCommandBuffer> cmd_buf_handles(command_buffers.size(), VK_NULL_HANDLE);
 	std::transform(command_buffers.begin(), command_buffers.end(), cmd_buf_handles.begin(), [](const CommandBuffer *cmd_buf) { return cmd_buf->get_handle(); });
 
@@ -409,9 +503,282 @@ void RenderContext::submit(const Queue &queue, const std::vector<CommandBuffer *
 	submit_info.commandBufferCount = to_u32(cmd_buf_handles.size());
 	submit_info.pCommandBuffers    = cmd_buf_handles.data();
 
+	submit_info.waitSemaphoreCount = to_u32(wait_semaphores.size());
+	submit_info.pWaitSemaphores    = wait_semaphores.data();
+	submit_info.pWaitDstStageMask  = wait_stages.data();
+
+	if (signal_semaphore != VK_NULL_HANDLE)
+	{
+		submit_info.signalSemaphoreCount = 1;
+		submit_info.pSignalSemaphores    = &signal_semaphore;
+	}
+
 	VkFence fence = frame.request_fence();
 
+	if (!frame_pacer.is_previous_frame_complete())
+	{
+		wait_previous_frames();
+	}
+
+	Timer timer;
+	timer.start();
+
 	queue.submit({submit_info}, fence);
+
+	frame_pacer.add_submit(static_cast<float>(timer.stop()));
+}
+
+const Queue &RenderContext::get_async_compute_queue()
+{
+	if (!async_compute_queue)
+	{
+		uint32_t compute_family = device.get_queue_family_index(VK_QUEUE_COMPUTE_BIT);
+
+		if (compute_family != queue.get_family_index())
+		{
+			async_compute_queue = &device.get_queue(compute_family, 0);
+		}
+		else if (device.get_num_queues_for_queue_family(compute_family) > 1)
+		{
+			async_compute_queue = &device.get_queue(compute_family, queue.get_index() == 0 ? 1 : 0);
+		}
+		else
+		{
+			async_compute_queue = &queue;
+		}
+
+		LOGI("Async compute queue: family {}, index {}{}", async_compute_queue->get_family_index(), async_compute_queue->get_index(),
+		     async_compute_queue == &queue ? " (the graphics queue, the work is recorded inline)" : "");
+	}
+
+	return *async_compute_queue;
+}
+
+namespace
+{
+ImageMemoryBarrier to_image_memory_barrier(const QueueTransfer &transfer)
+{
+	ImageMemoryBarrier barrier;
+	barrier.old_layout      = transfer.old_layout;
+	barrier.new_layout      = transfer.new_layout;
+	barrier.src_stage_mask  = transfer.src_stage_mask;
+	barrier.src_access_mask = transfer.src_access_mask;
+	barrier.dst_stage_mask  = transfer.dst_stage_mask;
+	barrier.dst_access_mask = transfer.dst_access_mask;
+	return barrier;
+}
+
+VkPipelineStageFlags get_dst_stage_mask(const std::vector<QueueTransfer> &transfers)
+{
+	VkPipelineStageFlags stage_mask = 0;
+	for (auto &transfer : transfers)
+	{
+		stage_mask |= transfer.dst_stage_mask;
+	}
+
+	// Without images to hand over, the work still waits for the previous submission
+	return stage_mask ? stage_mask : VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+}
+}        // namespace
+
+void RenderContext::record_queue_transfers(CommandBuffer &command_buffer, const std::vector<QueueTransfer> &transfers, bool release,
+                                           uint32_t src_queue_family, uint32_t dst_queue_family, VkPipelineStageFlags wait_stage)
+{
+	for (auto &transfer : transfers)
+	{
+		// The contents of an undefined image are not kept, so it does not need an ownership transfer
+		bool transfer_ownership = src_queue_family != dst_queue_family && transfer.old_layout != VK_IMAGE_LAYOUT_UNDEFINED;
+
+		if (!transfer_ownership && (release || transfer.old_layout == transfer.new_layout))
+		{
+			// Ordered and made visible by the semaphore, the receiving queue changes the layout if needed
+			continue;
+		}
+
+		auto barrier = to_image_memory_barrier(transfer);
+
+		if (transfer_ownership)
+		{
+			barrier.old_queue_family = src_queue_family;
+			barrier.new_queue_family = dst_queue_family;
+		}
+
+		if (release)
+		{
+			barrier.dst_stage_mask  = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+			barrier.dst_access_mask = 0;
+		}
+		else
+		{
+			// Chained to the semaphore wait, which made the writes of the other queue visible
+			barrier.src_stage_mask  = wait_stage;
+			barrier.src_access_mask = 0;
+		}
+
+		command_buffer.image_memory_barrier(*transfer.image_view, barrier);
+	}
+}
+
+CommandBuffer &RenderContext::begin_async_compute(CommandBuffer &command_buffer, const std::vector<QueueTransfer> &transfers)
+{
+	assert(frame_active && "RenderContext is inactive, cannot begin async compute. Please call begin()");
+
+	auto &compute_queue = get_async_compute_queue();
+
+	if (&compute_queue == &queue)
+	{
+		for (auto &transfer : transfers)
+		{
+			command_buffer.image_memory_barrier(*transfer.image_view, to_image_memory_barrier(transfer));
+		}
+		return command_buffer;
+	}
+
+	uint32_t graphics_family = queue.get_family_index();
+	uint32_t compute_family  = compute_queue.get_family_index();
+
+	record_queue_transfers(command_buffer, transfers, true, graphics_family, compute_family, 0);
+	command_buffer.end();
+
+	std::vector<VkSemaphore>          wait_semaphores;
+	std::vector<VkPipelineStageFlags> wait_stages;
+
+	if (swapchain && acquired_semaphore)
+	{
+		wait_semaphores.push_back(acquired_semaphore);
+		wait_stages.push_back(VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+	}
+
+	if (graphics_wait_semaphore)
+	{
+		wait_semaphores.push_back(graphics_wait_semaphore);
+		wait_stages.push_back(graphics_wait_stage);
+		graphics_wait_semaphore = VK_NULL_HANDLE;
+	}
+
+	async_compute_wait_semaphore = get_active_frame().request_semaphore();
+	async_compute_wait_stage     = get_dst_stage_mask(transfers);
+
+	submit_batch(queue, {&command_buffer}, wait_semaphores, wait_stages, async_compute_wait_semaphore);
+
+	if (swapchain && acquired_semaphore)
+	{
+		// Waited for, the following submissions of the frame are ordered after this one
+		release_owned_semaphore(acquired_semaphore);
+		acquired_semaphore = VK_NULL_HANDLE;
+	}
+
+	auto &compute_command_buffer = get_active_frame().request_command_buffer(compute_queue, command_buffer.get_reset_mode());
+	compute_command_buffer.begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+
+	// Times the async compute work of the frame, from the start of its first submission to the end of its last one
+	if (compute_queue.get_properties().timestampValidBits > 0)
+	{
+		if (async_compute_timed.size() != frames.size())
+		{
+			if (async_compute_query_pool)
+			{
+				defer_destruction(std::shared_ptr<QueryPool>(std::move(async_compute_query_pool)));
+			}
+
+			VkQueryPoolCreateInfo query_pool_info{VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO};
+			query_pool_info.queryType  = VK_QUERY_TYPE_TIMESTAMP;
+			query_pool_info.queryCount = to_u32(frames.size() * 2);
+
+			async_compute_query_pool = std::make_unique<QueryPool>(device, query_pool_info);
+			async_compute_timed.assign(frames.size(), false);
+		}
+	}
+
+	record_queue_transfers(compute_command_buffer, transfers, false, graphics_family, compute_family, async_compute_wait_stage);
+
+	if (active_frame_index < async_compute_timed.size() && !async_compute_timed[active_frame_index])
+	{
+		// Written after the semaphore wait, so that the time does not include waiting for the graphics work
+		compute_command_buffer.reset_query_pool(*async_compute_query_pool, active_frame_index * 2, 1);
+		compute_command_buffer.write_timestamp(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, *async_compute_query_pool, active_frame_index * 2);
+		async_compute_timed[active_frame_index] = true;
+	}
+
+	return compute_command_buffer;
+}
+
+CommandBuffer &RenderContext::end_async_compute(CommandBuffer &command_buffer, const std::vector<QueueTransfer> &transfers)
+{
+	assert(frame_active && "RenderContext is inactive, cannot end async compute. Please call begin()");
+
+	auto &compute_queue = get_async_compute_queue();
+
+	if (&compute_queue == &queue)
+	{
+		for (auto &transfer : transfers)
+		{
+			command_buffer.image_memory_barrier(*transfer.image_view, to_image_memory_barrier(transfer));
+		}
+		return command_buffer;
+	}
+
+	assert(async_compute_wait_semaphore && "Async compute was not begun, please call begin_async_compute");
+
+	uint32_t graphics_family = queue.get_family_index();
+	uint32_t compute_family  = compute_queue.get_family_index();
+
+	record_queue_transfers(command_buffer, transfers, true, compute_family, graphics_family, 0);
+
+	if (active_frame_index < async_compute_timed.size() && async_compute_timed[active_frame_index])
+	{
+		// Written again by each async compute submission of the frame, so that it times the last one
+		command_buffer.reset_query_pool(*async_compute_query_pool, active_frame_index * 2 + 1, 1);
+		command_buffer.write_timestamp(VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, *async_compute_query_pool, active_frame_index * 2 + 1);
+	}
+
+	command_buffer.end();
+
+	graphics_wait_semaphore = get_active_frame().request_semaphore();
+	graphics_wait_stage     = get_dst_stage_mask(transfers);
+
+	submit_batch(compute_queue, {&command_buffer}, {async_compute_wait_semaphore}, {async_compute_wait_stage}, graphics_wait_semaphore);
+
+	async_compute_wait_semaphore = VK_NULL_HANDLE;
+
+	auto &graphics_command_buffer = get_active_frame().request_command_buffer(queue, command_buffer.get_reset_mode());
+	graphics_command_buffer.begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+
+	record_queue_transfers(graphics_command_buffer, transfers, false, compute_family, graphics_family, graphics_wait_stage);
+
+	return graphics_command_buffer;
+}
+
+void RenderContext::update_async_compute_time()
+{
+	if (active_frame_index >= async_compute_timed.size() || !async_compute_timed[active_frame_index])
+	{
+		async_compute_time = 0.0f;
+		return;
+	}
+
+	async_compute_timed[active_frame_index] = false;
+
+	// The fence of the frame was waited for, so the results are available
+	std::array<uint64_t, 2> timestamps{};
+	VkResult                result = async_compute_query_pool->get_results(active_frame_index * 2, 2, sizeof(timestamps), timestamps.data(), sizeof(uint64_t),
+                                                           VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+	if (result != VK_SUCCESS)
+	{
+		async_compute_time = 0.0f;
+		return;
+	}
+
+	uint32_t valid_bits = get_async_compute_queue().get_properties().timestampValidBits;
+	uint64_t mask       = valid_bits >= 64 ? ~0ULL : (1ULL << valid_bits) - 1;
+	uint64_t ticks      = (timestamps[1] - timestamps[0]) & mask;
+
+	async_compute_time = static_cast<float>(ticks * device.get_gpu().get_properties().limits.timestampPeriod * 1e-9);
+}
+
+float RenderContext::get_async_compute_time() const
+{
+	return async_compute_time;
 }
 
 void RenderContext::wait_frame()
@@ -424,6 +791,9 @@ void RenderContext::end_frame(VkSemaphore semaphore)
 {
 	assert(frame_active && "Frame is not active, please call begin_frame");
 
+	// All the work of the frame was submitted
+	frame_pacer.end_frame();
+
 	if (swapchain)
 	{
 		VkSwapchainKHR vk_swapchain = swapchain->get_handle();
@@ -444,14 +814,38 @@ void RenderContext::end_frame(VkSemaphore semaphore)
 			present_info.pNext = &disp_present_info;
 		}
 
+		// Identify the image to measure when it is displayed
+		VkPresentIdKHR present_id_info{VK_STRUCTURE_TYPE_PRESENT_ID_KHR};
+		uint64_t       present_id = 0;
+		if (device.is_enabled(VK_KHR_PRESENT_WAIT_EXTENSION_NAME))
+		{
+			present_id                     = frame_pacer.next_present_id();
+			present_id_info.swapchainCount = 1;
+			present_id_info.pPresentIds    = &present_id;
+			present_id_info.pNext          = present_info.pNext;
+			present_info.pNext             = &present_id_info;
+		}
+
+		Timer timer;
+		timer.start();
+
 		VkResult result = queue.present(present_info);
 
+		frame_pacer.add_present(static_cast<float>(timer.stop()));
+
+		if (present_id != 0 && (result == VK_SUCCESS || result == VK_SUBOPTIMAL_KHR))
+		{
+			frame_pacer.on_presented(present_id);
+		}
+
 		if (result == VK_SUBOPTIMAL_KHR || result == VK_ERROR_OUT_OF_DATE_KHR)
 		{
 			handle_surface_changes();
 		}
 	}
 
+	get_active_frame().mark_submitted();
+
 	// Frame is not active anymore
 	if (acquired_semaphore)
 	{
@@ -514,9 +908,6 @@ Device &RenderContext::get_device()
 
 void RenderContext::recreate_swapchain()
 {
-	device.wait_idle();
-	device.get_resource_cache().clear_framebuffers();
-
 	VkExtent2D swapchain_extent = swapchain->get_extent();
 	VkExtent3D extent{swapchain_extent.width, swapchain_extent.height, 1};
 
@@ -534,6 +925,22 @@ void RenderContext::recreate_swapchain()
 
 		++frame_it;
 	}
+
+	retire_framebuffers();
+}
+
+void RenderContext::defer_destruction(std::shared_ptr<void> &&object)
+{
+	// Every frame keeps a reference, so the object is destroyed once each of them has been reset
+	for (auto &frame : frames)
+	{
+		frame->defer_destruction(std::shared_ptr<void>{object});
+	}
+}
+
+void RenderContext::retire_framebuffers()
+{
+	defer_destruction(std::make_shared<std::unordered_map<std::size_t, Framebuffer>>(device.get_resource_cache().extract_framebuffers()));
 }
 
 bool RenderContext::has_swapchain()
@@ -562,4 +969,14 @@ std::vector<std::unique_ptr<RenderFrame>> &RenderContext::get_render_frames()
 	return frames;
 }
 
+FramePacer &RenderContext::get_frame_pacer()
+{
+	return frame_pacer;
+}
+
+const FramePacer &RenderContext::get_frame_pacer() const
+{
+	return frame_pacer;
+}
+
 }        // namespace vkb
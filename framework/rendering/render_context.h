@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2022, Arm Limited and Contributors
+/* Copyright (c) 2019-2023, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -26,10 +26,12 @@
 #include "core/framebuffer.h"
 #include "core/pipeline.h"
 #include "core/pipeline_layout.h"
+#include "core/query_pool.h"
 #include "core/queue.h"
 #include "core/render_pass.h"
 #include "core/shader_module.h"
 #include "core/swapchain.h"
+#include "rendering/frame_pacer.h"
 #include "rendering/pipeline_state.h"
 #include "rendering/render_frame.h"
 #include "rendering/render_target.h"
@@ -39,6 +41,29 @@ namespace vkb
 {
 class Window;
 
+/**
+ * @brief An image handed over between the graphics queue and the async compute queue
+ *        The layout is changed by the queue receiving the image
+ */
+struct QueueTransfer
+{
+	const core::ImageView *image_view{nullptr};
+
+	VkImageLayout old_layout{VK_IMAGE_LAYOUT_UNDEFINED};
+
+	VkImageLayout new_layout{VK_IMAGE_LAYOUT_UNDEFINED};
+
+	/// Stages and accesses of the queue handing the image over
+	VkPipelineStageFlags src_stage_mask{VK_PIPELINE_STAGE_ALL_COMMANDS_BIT};
+
+	VkAccessFlags src_access_mask{0};
+
+	/// Stages and accesses of the queue receiving the image
+	VkPipelineStageFlags dst_stage_mask{VK_PIPELINE_STAGE_ALL_COMMANDS_BIT};
+
+	VkAccessFlags dst_access_mask{0};
+};
+
 /**
  * @brief RenderContext acts as a frame manager for the sample, with a lifetime that is the
  * same as that of the Application itself. It acts as a container for RenderFrame objects,
@@ -141,7 +166,8 @@ class RenderContext
 	void recreate();
 
 	/**
-	 * @brief Recreates the swapchain
+	 * @brief Recreates the render targets of the swapchain images, for example after changing the create function
+	 *        The previous render targets and framebuffers are destroyed once the frames in flight completed
 	 */
 	void recreate_swapchain();
 
@@ -170,6 +196,13 @@ class RenderContext
 	 */
 	void begin_frame();
 
+	/**
+	 * @brief Starts the CPU work of the next frame, delaying it in latency mode
+	 *        begin_frame() calls it if it was not called since the previous frame. Call it before updating
+	 *        the scene to include the update, and the input it reads, in the delayed work
+	 */
+	void pace_frame();
+
 	VkSemaphore submit(const Queue &queue, const std::vector<CommandBuffer *> &command_buffers, VkSemaphore wait_semaphore, VkPipelineStageFlags wait_pipeline_stage);
 
 	/**
@@ -184,6 +217,35 @@ class RenderContext
 
 	void end_frame(VkSemaphore semaphore);
 
+	/**
+	 * @brief Returns the queue async compute work is submitted to
+	 *        A queue of a compute family other than the graphics one if any, else another queue of the graphics
+	 *        family, else the graphics queue itself, in which case the work is recorded inline
+	 */
+	const Queue &get_async_compute_queue();
+
+	/**
+	 * @brief Submits the graphics work recorded so far and starts recording async compute work
+	 * @param command_buffer The graphics command buffer of the frame, ended and submitted by this call
+	 * @param transfers The images used by the compute work, released by the graphics queue
+	 * @returns A command buffer of the async compute queue, or command_buffer if there is no separate queue
+	 */
+	CommandBuffer &begin_async_compute(CommandBuffer &command_buffer, const std::vector<QueueTransfer> &transfers);
+
+	/**
+	 * @brief Submits the async compute work and continues recording the graphics work of the frame
+	 *        The next graphics submission waits for the compute work, at the destination stages of the transfers
+	 * @param command_buffer The command buffer returned by begin_async_compute, ended and submitted by this call
+	 * @param transfers The images used by the following graphics work, released by the compute queue
+	 * @returns A new graphics command buffer, or command_buffer if there is no separate queue
+	 */
+	CommandBuffer &end_async_compute(CommandBuffer &command_buffer, const std::vector<QueueTransfer> &transfers);
+
+	/**
+	 * @return The GPU time in seconds of the async compute work of the last completed frame, 0 if there was none
+	 */
+	float get_async_compute_time() const;
+
 	/**
 	 * @brief An error should be raised if the frame is not active.
 	 *        A frame is active after @ref begin_frame has been called.
@@ -224,6 +286,13 @@ class RenderContext
 
 	std::vector<std::unique_ptr<RenderFrame>> &get_render_frames();
 
+	/**
+	 * @return The timings of the last frame and the latency mode
+	 */
+	FramePacer &get_frame_pacer();
+
+	const FramePacer &get_frame_pacer() const;
+
 	/**
 	 * @brief Handles surface changes, only applicable if the render_context makes use of a swapchain
 	 */
@@ -239,6 +308,44 @@ class RenderContext
 	VkExtent2D surface_extent;
 
   private:
+	/**
+	 * @brief Destroys an object once all the frames in flight completed, instead of waiting for the device to idle
+	 */
+	void defer_destruction(std::shared_ptr<void> &&object);
+
+	/**
+	 * @brief Moves the cached framebuffers, which refer to the previous render targets, into deferred destruction
+	 */
+	void retire_framebuffers();
+
+	/**
+	 * @brief Waits for the frames submitted before the active one in latency mode, before its first submission
+	 */
+	void wait_previous_frames();
+
+	/**
+	 * @brief Records the latency of the presented images displayed since the previous frame, using VK_KHR_present_wait
+	 */
+	void update_present_latency();
+
+	/**
+	 * @brief Submits command buffers of the active frame, signaling signal_semaphore if not null
+	 */
+	void submit_batch(const Queue &queue, const std::vector<CommandBuffer *> &command_buffers,
+	                  const std::vector<VkSemaphore> &wait_semaphores, const std::vector<VkPipelineStageFlags> &wait_stages, VkSemaphore signal_semaphore);
+
+	/**
+	 * @brief Records the barriers of one side of queue transfers
+	 * @param release Whether the images are released by the queue of command_buffer, else acquired by it
+	 */
+	void record_queue_transfers(CommandBuffer &command_buffer, const std::vector<QueueTransfer> &transfers, bool release,
+	                            uint32_t src_queue_family, uint32_t dst_queue_family, VkPipelineStageFlags wait_stage);
+
+	/**
+	 * @brief Reads the async compute timestamps of the active frame, once its fence was waited for
+	 */
+	void update_async_compute_time();
+
 	Device &device;
 
 	const Window &window;
@@ -277,6 +384,28 @@ class RenderContext
 	VkSurfaceTransformFlagBitsKHR pre_transform{VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR};
 
 	size_t thread_count{1};
+
+	FramePacer frame_pacer;
+
+	const Queue *async_compute_queue{nullptr};
+
+	/// Signaled by the graphics submission preceding the async compute work, waited for by the compute submission
+	VkSemaphore async_compute_wait_semaphore{VK_NULL_HANDLE};
+
+	VkPipelineStageFlags async_compute_wait_stage{VK_PIPELINE_STAGE_ALL_COMMANDS_BIT};
+
+	/// Signaled by the async compute work, waited for by the next graphics submission
+	VkSemaphore graphics_wait_semaphore{VK_NULL_HANDLE};
+
+	VkPipelineStageFlags graphics_wait_stage{VK_PIPELINE_STAGE_ALL_COMMANDS_BIT};
+
+	/// A start and an end timestamp per frame
+	std::unique_ptr<QueryPool> async_compute_query_pool;
+
+	/// Whether the async compute work of each frame was timed
+	std::vector<bool> async_compute_timed;
+
+	float async_compute_time{0.0f};
 };
 
 }        // namespace vkb
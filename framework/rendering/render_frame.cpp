@@ -59,15 +59,34 @@ Device &RenderFrame::get_device()
 
 void RenderFrame::update_render_target(std::unique_ptr<RenderTarget> &&render_target)
 {
+	// The previous render target may still be used by the work in flight of this frame
+	if (swapchain_render_target)
+	{
+		defer_destruction(std::move(swapchain_render_target));
+	}
+
 	swapchain_render_target = std::move(render_target);
 }
 
+void RenderFrame::defer_destruction(std::shared_ptr<void> &&object)
+{
+	deferred_objects.push_back(std::move(object));
+}
+
 void RenderFrame::reset()
 {
 	VK_CHECK(fence_pool.wait());
 
 	fence_pool.reset();
 
+	deferred_objects.clear();
+
+	if (submitted)
+	{
+		device.get_deletion_queue().collect(deletion_frame_index);
+		submitted = false;
+	}
+
 	for (auto &command_pools_per_queue : command_pools)
 	{
 		for (auto &command_pool : command_pools_per_queue.second)
@@ -93,6 +112,12 @@ void RenderFrame::reset()
 	}
 }
 
+void RenderFrame::mark_submitted()
+{
+	deletion_frame_index = device.get_deletion_queue().end_frame();
+	submitted            = true;
+}
+
 std::vector<std::unique_ptr<CommandPool>> &RenderFrame::get_command_pools(const Queue &queue, CommandBuffer::ResetMode reset_mode)
 {
 	auto command_pool_it = command_pools.find(queue.get_family_index());
@@ -102,9 +127,9 @@ std::vector<std::unique_ptr<CommandPool>> &RenderFrame::get_command_pools(const
 		assert(!command_pool_it->second.empty());
 		if (command_pool_it->second[0]->get_reset_mode() != reset_mode)
 		{
-			device.wait_idle();
-
-			// Delete pools
+			// Command buffers of the pools may already have been recorded in this frame,
+			// so the pools are deleted once it completed
+			device.get_deletion_queue().push(std::move(command_pool_it->second));
 			command_pools.erase(command_pool_it);
 		}
 		else
@@ -210,7 +235,7 @@ VkDescriptorSet RenderFrame::request_descriptor_set(const DescriptorSetLayout &d
 
 	assert(thread_index < descriptor_pools.size());
 	auto &descriptor_pool = request_resource(device, nullptr, *descriptor_pools[thread_index], descriptor_set_layout);
-	if (descriptor_management_strategy == DescriptorManagementStrategy::StoreInCache)
+	if (descriptor_management_strategy != DescriptorManagementStrategy::CreateDirectly)
 	{
 		// The bindings we want to update before binding, if empty we update all bindings
 		std::vector<uint32_t> bindings_to_update;
@@ -271,6 +296,11 @@ void RenderFrame::set_descriptor_management_strategy(DescriptorManagementStrateg
 	descriptor_management_strategy = new_strategy;
 }
 
+DescriptorManagementStrategy RenderFrame::get_descriptor_management_strategy() const
+{
+	return descriptor_management_strategy;
+}
+
 BufferAllocation RenderFrame::allocate_buffer(const VkBufferUsageFlags usage, const VkDeviceSize size, size_t thread_index)
 {
 	assert(thread_index < thread_count && "Thread index is out of bounds");
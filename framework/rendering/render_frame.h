@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2022, Arm Limited and Contributors
+/* Copyright (c) 2019-2023, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -43,7 +43,9 @@ enum BufferAllocationStrategy
 enum DescriptorManagementStrategy
 {
 	StoreInCache,
-	CreateDirectly
+	CreateDirectly,
+	/// Push the sets of pipeline layouts that allow it, and store the other sets in cache
+	PushDescriptors
 };
 
 /**
@@ -71,6 +73,7 @@ class RenderFrame
 	const std::unordered_map<VkBufferUsageFlags, uint32_t> supported_usage_map = {
 	    {VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, 1},
 	    {VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, 2},        // x2 the size of BUFFER_POOL_BLOCK_SIZE since SSBOs are normally much larger than other types of buffers
+	    {VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT, 2},        // Storage buffers also read through their address
 	    {VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, 1},
 	    {VK_BUFFER_USAGE_INDEX_BUFFER_BIT, 1}};
 
@@ -86,6 +89,12 @@ class RenderFrame
 
 	void reset();
 
+	/**
+	 * @brief Called once the work of the frame was submitted, the objects queued to the deletion queue
+	 *        of the device until then are destroyed the next time the frame is reset
+	 */
+	void mark_submitted();
+
 	Device &get_device();
 
 	const FencePool &get_fence_pool() const;
@@ -104,6 +113,14 @@ class RenderFrame
 	 */
 	void update_render_target(std::unique_ptr<RenderTarget> &&render_target);
 
+	/**
+	 * @brief Keeps an object alive until the work submitted with this frame completed
+	 *        The object is destroyed the next time the frame is reset, once its fences signaled,
+	 *        so that objects used by frames in flight can be retired without waiting for the device
+	 * @param object The object to destroy, such as a retired swapchain or render target
+	 */
+	void defer_destruction(std::shared_ptr<void> &&object);
+
 	RenderTarget &get_render_target();
 
 	const RenderTarget &get_render_target_const() const;
@@ -143,6 +160,8 @@ class RenderFrame
 	 */
 	void set_descriptor_management_strategy(DescriptorManagementStrategy new_strategy);
 
+	DescriptorManagementStrategy get_descriptor_management_strategy() const;
+
 	/**
 	 * @param usage Usage of the buffer
 	 * @param size Amount of memory required
@@ -185,6 +204,14 @@ class RenderFrame
 
 	std::unique_ptr<RenderTarget> swapchain_render_target;
 
+	/// Objects destroyed on the next reset of the frame
+	std::vector<std::shared_ptr<void>> deferred_objects;
+
+	/// Frame of the device's deletion queue completed by the work of this frame
+	uint64_t deletion_frame_index{0};
+
+	bool submitted{false};
+
 	BufferAllocationStrategy     buffer_allocation_strategy{BufferAllocationStrategy::MultipleAllocationsPerBuffer};
 	DescriptorManagementStrategy descriptor_management_strategy{DescriptorManagementStrategy::StoreInCache};
 
@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2020, Arm Limited and Contributors
+/* Copyright (c) 2018-2023, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -51,10 +51,53 @@ void ForwardSubpass::prepare()
 
 			variant.add_definitions(light_type_definitions);
 
-			auto &vert_module = device.get_resource_cache().request_shader_module(VK_SHADER_STAGE_VERTEX_BIT, get_vertex_shader(), variant);
-			auto &frag_module = device.get_resource_cache().request_shader_module(VK_SHADER_STAGE_FRAGMENT_BIT, get_fragment_shader(), variant);
+			// Specialized materials share one variant, so only compile the sub mesh variants if they are used
+			if (!specialized_materials)
+			{
+				auto &draw_variant = get_draw_constant_variant(variant);
+				auto &vert_module  = device.get_resource_cache().request_shader_module(VK_SHADER_STAGE_VERTEX_BIT, get_vertex_shader(), draw_variant);
+				auto &frag_module  = device.get_resource_cache().request_shader_module(VK_SHADER_STAGE_FRAGMENT_BIT, get_fragment_shader(), draw_variant);
+			}
 		}
 	}
+
+	if (specialized_materials)
+	{
+		prepare_specialized_materials();
+
+		auto &variant = get_draw_constant_variant(specialized_variant);
+		device.get_resource_cache().request_shader_module(VK_SHADER_STAGE_VERTEX_BIT, get_vertex_shader(), variant);
+		device.get_resource_cache().request_shader_module(VK_SHADER_STAGE_FRAGMENT_BIT, get_fragment_shader(), variant);
+	}
+
+	if (bindless_materials)
+	{
+		prepare_bindless_materials();
+
+		auto &variant = get_draw_constant_variant(bindless_variant);
+		device.get_resource_cache().request_shader_module(VK_SHADER_STAGE_VERTEX_BIT, get_vertex_shader(), variant);
+		device.get_resource_cache().request_shader_module(VK_SHADER_STAGE_FRAGMENT_BIT, get_fragment_shader(), variant);
+	}
+}
+
+void ForwardSubpass::prepare_bindless_materials()
+{
+	GeometrySubpass::prepare_bindless_materials();
+
+	// Same lighting definitions as the sub mesh variants
+	bindless_variant.add_definitions({"MAX_LIGHT_COUNT " + std::to_string(MAX_FORWARD_LIGHT_COUNT)});
+
+	bindless_variant.add_definitions(light_type_definitions);
+}
+
+void ForwardSubpass::prepare_specialized_materials()
+{
+	GeometrySubpass::prepare_specialized_materials();
+
+	// Same lighting definitions as the sub mesh variants
+	specialized_variant.add_definitions({"MAX_LIGHT_COUNT " + std::to_string(MAX_FORWARD_LIGHT_COUNT)});
+
+	specialized_variant.add_definitions(light_type_definitions);
 }
 
 void ForwardSubpass::draw(CommandBuffer &command_buffer)
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2022, Arm Limited and Contributors
+/* Copyright (c) 2019-2023, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -16,6 +16,7 @@
  */
 
 #include "rendering/subpasses/geometry_subpass.h"
+#include "common/logging.h"
 #include "common/utils.h"
 #include "common/vk_common.h"
 #include "rendering/render_context.h"
@@ -40,17 +41,284 @@ GeometrySubpass::GeometrySubpass(RenderContext &render_context, ShaderSource &&v
 
 void GeometrySubpass::prepare()
 {
-	// Build all shader variance upfront
 	auto &device = render_context.get_device();
+
+	if (specialized_materials)
+	{
+		// A single variant replaces the variants of the submeshes
+		prepare_specialized_materials();
+
+		auto &variant = get_draw_constant_variant(specialized_variant);
+		device.get_resource_cache().request_shader_module(VK_SHADER_STAGE_VERTEX_BIT, get_vertex_shader(), variant);
+		device.get_resource_cache().request_shader_module(VK_SHADER_STAGE_FRAGMENT_BIT, get_fragment_shader(), variant);
+	}
+	else
+	{
+		// Build all shader variance upfront
+		for (auto &mesh : meshes)
+		{
+			for (auto &sub_mesh : mesh->get_submeshes())
+			{
+				auto &variant     = get_draw_constant_variant(sub_mesh->get_shader_variant());
+				auto &vert_module = device.get_resource_cache().request_shader_module(VK_SHADER_STAGE_VERTEX_BIT, get_vertex_shader(), variant);
+				auto &frag_module = device.get_resource_cache().request_shader_module(VK_SHADER_STAGE_FRAGMENT_BIT, get_fragment_shader(), variant);
+			}
+		}
+	}
+
+	if (bindless_materials)
+	{
+		prepare_bindless_materials();
+	}
+
+	if (bindless_materials)
+	{
+		auto &variant = get_draw_constant_variant(bindless_variant);
+		device.get_resource_cache().request_shader_module(VK_SHADER_STAGE_VERTEX_BIT, get_vertex_shader(), variant);
+		device.get_resource_cache().request_shader_module(VK_SHADER_STAGE_FRAGMENT_BIT, get_fragment_shader(), variant);
+	}
+}
+
+void GeometrySubpass::prepare_bindless_materials()
+{
+	bindless_textures.clear();
+	bindless_material_indices.clear();
+
+	std::unordered_map<const sg::Texture *, int32_t> texture_indices;
+	std::vector<BindlessMaterial>                    materials;
+
 	for (auto &mesh : meshes)
 	{
 		for (auto &sub_mesh : mesh->get_submeshes())
 		{
-			auto &variant     = sub_mesh->get_shader_variant();
-			auto &vert_module = device.get_resource_cache().request_shader_module(VK_SHADER_STAGE_VERTEX_BIT, get_vertex_shader(), variant);
-			auto &frag_module = device.get_resource_cache().request_shader_module(VK_SHADER_STAGE_FRAGMENT_BIT, get_fragment_shader(), variant);
+			auto material = sub_mesh->get_material();
+
+			if (bindless_material_indices.count(material) > 0)
+			{
+				continue;
+			}
+
+			BindlessMaterial bindless_material{};
+			bindless_material.base_color_factor  = glm::vec4(1.0f);
+			bindless_material.metallic_factor    = 1.0f;
+			bindless_material.roughness_factor   = 1.0f;
+			bindless_material.base_color_texture = -1;
+
+			if (auto pbr_material = dynamic_cast<const sg::PBRMaterial *>(material))
+			{
+				bindless_material.base_color_factor = pbr_material->base_color_factor;
+				bindless_material.metallic_factor   = pbr_material->metallic_factor;
+				bindless_material.roughness_factor  = pbr_material->roughness_factor;
+			}
+
+			auto texture_it = material->textures.find("base_color_texture");
+
+			if (texture_it != material->textures.end())
+			{
+				// Textures shared by several materials only take one slot in the table
+				auto texture_index_it = texture_indices.find(texture_it->second);
+
+				if (texture_index_it == texture_indices.end())
+				{
+					texture_index_it = texture_indices.emplace(texture_it->second, static_cast<int32_t>(bindless_textures.size())).first;
+					bindless_textures.push_back(texture_it->second);
+				}
+
+				bindless_material.base_color_texture = texture_index_it->second;
+			}
+
+			bindless_material_indices.emplace(material, to_u32(materials.size()));
+			materials.push_back(bindless_material);
 		}
 	}
+
+	// The texture table is a single array of combined image samplers in the fragment shader
+	const auto &limits       = render_context.get_device().get_gpu().get_properties().limits;
+	uint32_t    max_textures = std::min(limits.maxPerStageDescriptorSamplers, limits.maxPerStageDescriptorSampledImages);
+
+	bindless_textures_exceed_limits = bindless_textures.size() > max_textures;
+
+	if (bindless_textures_exceed_limits)
+	{
+		LOGW("Bindless materials disabled, the scene has {} textures and the device supports {} per shader stage", bindless_textures.size(), max_textures);
+
+		bindless_textures.clear();
+		bindless_material_indices.clear();
+		bindless_material_buffer.reset();
+		bindless_materials = false;
+		return;
+	}
+
+	if (!materials.empty())
+	{
+		auto buffer_size = materials.size() * sizeof(BindlessMaterial);
+
+		bindless_material_buffer = std::make_unique<core::Buffer>(render_context.get_device(), buffer_size, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU);
+		bindless_material_buffer->update(reinterpret_cast<const uint8_t *>(materials.data()), buffer_size);
+	}
+
+	bindless_variant.clear();
+	bindless_variant.add_define("BINDLESS_MATERIALS");
+
+	if (!bindless_textures.empty())
+	{
+		bindless_variant.add_define("BINDLESS_TEXTURE_COUNT " + std::to_string(bindless_textures.size()));
+	}
+}
+
+void GeometrySubpass::bind_bindless_materials(CommandBuffer &command_buffer)
+{
+	if (!bindless_material_buffer)
+	{
+		return;
+	}
+
+	for (uint32_t i = 0; i < to_u32(bindless_textures.size()); ++i)
+	{
+		command_buffer.bind_image(bindless_textures[i]->get_image()->get_vk_image_view(),
+		                          bindless_textures[i]->get_sampler()->get_vk_sampler(),
+		                          1, 0, i);
+	}
+
+	command_buffer.bind_buffer(*bindless_material_buffer, 0, bindless_material_buffer->get_size(), 1, 1, 0);
+}
+
+void GeometrySubpass::prepare_specialized_materials()
+{
+	specialized_textures.clear();
+
+	for (auto &mesh : meshes)
+	{
+		for (auto &sub_mesh : mesh->get_submeshes())
+		{
+			for (auto &texture : sub_mesh->get_material()->textures)
+			{
+				// The first texture found stands in for materials without one
+				specialized_textures.emplace(texture.first, texture.second);
+			}
+		}
+	}
+
+	specialized_variant.clear();
+	specialized_variant.add_define("SPECIALIZED_MATERIALS");
+
+	for (auto &texture : specialized_textures)
+	{
+		std::string tex_name = texture.first;
+		std::transform(tex_name.begin(), tex_name.end(), tex_name.begin(), ::toupper);
+
+		// Declares the sampler, whether a submesh samples it is given by the HAS_ specialization constant
+		specialized_variant.add_define("SCENE_HAS_" + tex_name);
+	}
+}
+
+void GeometrySubpass::set_feature_constants(CommandBuffer &command_buffer, PipelineLayout &pipeline_layout, sg::SubMesh &sub_mesh)
+{
+	for (auto &constant : pipeline_layout.get_resources(ShaderResourceType::SpecializationConstant))
+	{
+		// Other specialization constants, like the light counts, are set by whoever owns them
+		if (constant.name.compare(0, 4, "HAS_") == 0)
+		{
+			command_buffer.set_specialization_constant(constant.constant_id, sub_mesh.has_feature(constant.name));
+		}
+	}
+}
+
+void GeometrySubpass::begin_draw_constants(CommandBuffer &command_buffer, uint32_t draw_count)
+{
+	draw_constant_capacity = 0;
+	draw_constant_count    = 0;
+	draw_constant_index    = 0;
+	draw_constants_thread  = std::this_thread::get_id();
+
+	if (draw_constant_strategy == DrawConstantStrategy::UniformBuffer || draw_constant_strategy == DrawConstantStrategy::DynamicUniformBuffer)
+	{
+		return;
+	}
+
+	auto &render_frame = get_render_context().get_active_frame();
+
+	// The camera constants are bound once, the model matrix of each draw is delivered by the strategy
+	GlobalUniform global_uniform;
+	global_uniform.model            = glm::mat4(1.0f);
+	global_uniform.camera_view_proj = camera.get_pre_rotation() * vkb::vulkan_style_projection(camera.get_projection()) * camera.get_view();
+	global_uniform.camera_position  = glm::vec3(glm::inverse(camera.get_view())[3]);
+
+	pass_uniform = render_frame.allocate_buffer(VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, sizeof(GlobalUniform), thread_index);
+	pass_uniform.update(global_uniform);
+
+	command_buffer.bind_buffer(pass_uniform.get_buffer(), pass_uniform.get_offset(), pass_uniform.get_size(), 0, 1, 0);
+
+	if (draw_constant_strategy == DrawConstantStrategy::PushConstants || draw_count == 0)
+	{
+		return;
+	}
+
+	VkBufferUsageFlags usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+
+	if (draw_constant_strategy == DrawConstantStrategy::BufferDeviceAddress)
+	{
+		usage |= VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+	}
+
+	draw_constants         = render_frame.allocate_buffer(usage, draw_count * sizeof(glm::mat4), thread_index);
+	draw_constant_capacity = draw_count;
+
+	if (draw_constant_strategy == DrawConstantStrategy::BufferArray)
+	{
+		command_buffer.bind_buffer(draw_constants.get_buffer(), draw_constants.get_offset(), draw_constants.get_size(), 0, 2, 0);
+	}
+	else
+	{
+		draw_constants_address = draw_constants.get_buffer().get_device_address() + draw_constants.get_offset();
+	}
+}
+
+const ShaderVariant &GeometrySubpass::get_draw_constant_variant(const ShaderVariant &variant)
+{
+	static const std::unordered_map<DrawConstantStrategy, std::string> defines{
+	    {DrawConstantStrategy::DynamicUniformBuffer, "DRAW_CONSTANTS_DYNAMIC_UNIFORM_BUFFER"},
+	    {DrawConstantStrategy::PushConstants, "DRAW_CONSTANTS_PUSH_CONSTANTS"},
+	    {DrawConstantStrategy::BufferArray, "DRAW_CONSTANTS_BUFFER_ARRAY"},
+	    {DrawConstantStrategy::BufferDeviceAddress, "DRAW_CONSTANTS_BUFFER_DEVICE_ADDRESS"}};
+
+	auto define_it = defines.find(draw_constant_strategy);
+
+	if (define_it == defines.end())
+	{
+		return variant;
+	}
+
+	size_t key = variant.get_id();
+	hash_combine(key, draw_constant_strategy);
+
+	// Draws may be recorded from several threads
+	std::lock_guard<std::mutex> guard{draw_constant_variants_mutex};
+
+	auto variant_it = draw_constant_variants.find(key);
+
+	if (variant_it == draw_constant_variants.end())
+	{
+		ShaderVariant draw_constant_variant = variant;
+		draw_constant_variant.add_define(define_it->second);
+
+		variant_it = draw_constant_variants.emplace(key, std::move(draw_constant_variant)).first;
+	}
+
+	return variant_it->second;
+}
+
+uint32_t GeometrySubpass::get_material_push_constant_offset() const
+{
+	switch (draw_constant_strategy)
+	{
+		case DrawConstantStrategy::PushConstants:
+			return sizeof(glm::mat4);
+		case DrawConstantStrategy::BufferDeviceAddress:
+			return 2 * sizeof(uint64_t);
+		default:
+			return 0;
+	}
 }
 
 void GeometrySubpass::get_sorted_nodes(std::multimap<float, std::pair<sg::Node *, sg::SubMesh *>> &opaque_nodes, std::multimap<float, std::pair<sg::Node *, sg::SubMesh *>> &transparent_nodes)
@@ -92,6 +360,27 @@ void GeometrySubpass::draw(CommandBuffer &command_buffer)
 
 	get_sorted_nodes(opaque_nodes, transparent_nodes);
 
+	if (bindless_materials)
+	{
+		// Materials are built at load time, unless bindless materials were enabled afterwards
+		if (bindless_material_indices.empty())
+		{
+			prepare_bindless_materials();
+		}
+
+		bind_bindless_materials(command_buffer);
+	}
+	else if (specialized_materials)
+	{
+		// The variant is built at load time, unless specialized materials were enabled afterwards
+		if (specialized_variant.get_preamble().empty())
+		{
+			prepare_specialized_materials();
+		}
+	}
+
+	begin_draw_constants(command_buffer, to_u32(opaque_nodes.size() + transparent_nodes.size()));
+
 	// Draw opaque objects in front-to-back order
 	{
 		ScopedDebugLabel opaque_debug_label{command_buffer, "Opaque objects"};
@@ -141,6 +430,35 @@ void GeometrySubpass::draw(CommandBuffer &command_buffer)
 
 void GeometrySubpass::update_uniform(CommandBuffer &command_buffer, sg::Node &node, size_t thread_index)
 {
+	if (draw_constant_strategy == DrawConstantStrategy::PushConstants)
+	{
+		// The material push constants follow the model matrix
+		command_buffer.push_constants(node.get_transform().get_world_matrix());
+		return;
+	}
+
+	if (draw_constant_strategy == DrawConstantStrategy::BufferArray || draw_constant_strategy == DrawConstantStrategy::BufferDeviceAddress)
+	{
+		assert(draw_constant_count < draw_constant_capacity && "More draws than passed to begin_draw_constants");
+		assert(draw_constants_thread == std::this_thread::get_id() && "Draws using a draw constant buffer must be recorded on a single thread");
+
+		draw_constant_index = draw_constant_count++;
+
+		const auto &model = node.get_transform().get_world_matrix();
+
+		draw_constants.get_buffer().update(reinterpret_cast<const uint8_t *>(&model), sizeof(glm::mat4),
+		                                   static_cast<size_t>(draw_constants.get_offset() + draw_constant_index * sizeof(glm::mat4)));
+
+		if (draw_constant_strategy == DrawConstantStrategy::BufferDeviceAddress)
+		{
+			// Padded to the 16 byte alignment of the material push constants
+			std::array<uint64_t, 2> address{draw_constants_address + draw_constant_index * sizeof(glm::mat4), 0};
+			command_buffer.push_constants(address);
+		}
+
+		return;
+	}
+
 	GlobalUniform global_uniform;
 
 	global_uniform.camera_view_proj = camera.get_pre_rotation() * vkb::vulkan_style_projection(camera.get_projection()) * camera.get_view();
@@ -172,8 +490,21 @@ void GeometrySubpass::draw_submesh(CommandBuffer &command_buffer, sg::SubMesh &s
 	multisample_state.rasterization_samples = sample_count;
 	command_buffer.set_multisample_state(multisample_state);
 
-	auto &vert_shader_module = device.get_resource_cache().request_shader_module(VK_SHADER_STAGE_VERTEX_BIT, get_vertex_shader(), sub_mesh.get_shader_variant());
-	auto &frag_shader_module = device.get_resource_cache().request_shader_module(VK_SHADER_STAGE_FRAGMENT_BIT, get_fragment_shader(), sub_mesh.get_shader_variant());
+	const ShaderVariant *shader_variant = &sub_mesh.get_shader_variant();
+
+	if (bindless_materials)
+	{
+		shader_variant = &bindless_variant;
+	}
+	else if (specialized_materials)
+	{
+		shader_variant = &specialized_variant;
+	}
+
+	auto &draw_variant = get_draw_constant_variant(*shader_variant);
+
+	auto &vert_shader_module = device.get_resource_cache().request_shader_module(VK_SHADER_STAGE_VERTEX_BIT, get_vertex_shader(), draw_variant);
+	auto &frag_shader_module = device.get_resource_cache().request_shader_module(VK_SHADER_STAGE_FRAGMENT_BIT, get_fragment_shader(), draw_variant);
 
 	std::vector<ShaderModule *> shader_modules{&vert_shader_module, &frag_shader_module};
 
@@ -181,20 +512,52 @@ void GeometrySubpass::draw_submesh(CommandBuffer &command_buffer, sg::SubMesh &s
 
 	command_buffer.bind_pipeline_layout(pipeline_layout);
 
-	if (pipeline_layout.get_push_constant_range_stage(sizeof(PBRMaterialUniform)) != 0)
+	if (bindless_materials)
 	{
-		prepare_push_constants(command_buffer, sub_mesh);
+		// The material is looked up in the tables bound at the start of the subpass
+		command_buffer.push_constants(bindless_material_indices.at(sub_mesh.get_material()));
 	}
+	else
+	{
+		if (specialized_materials)
+		{
+			set_feature_constants(command_buffer, pipeline_layout, sub_mesh);
+		}
 
-	DescriptorSetLayout &descriptor_set_layout = pipeline_layout.get_descriptor_set_layout(0);
+		if (pipeline_layout.get_push_constant_range_stage(sizeof(PBRMaterialUniform), get_material_push_constant_offset()) != 0)
+		{
+			prepare_push_constants(command_buffer, sub_mesh);
+		}
 
-	for (auto &texture : sub_mesh.get_material()->textures)
-	{
-		if (auto layout_binding = descriptor_set_layout.get_layout_binding(texture.first))
+		DescriptorSetLayout &descriptor_set_layout = pipeline_layout.get_descriptor_set_layout(0);
+
+		if (specialized_materials)
 		{
-			command_buffer.bind_image(texture.second->get_image()->get_vk_image_view(),
-			                          texture.second->get_sampler()->vk_sampler,
-			                          0, layout_binding->binding, 0);
+			// Every sampler of the shared variant needs a texture, even if the feature constants leave it unsampled
+			for (auto &specialized_texture : specialized_textures)
+			{
+				auto texture_it = sub_mesh.get_material()->textures.find(specialized_texture.first);
+				auto texture    = texture_it != sub_mesh.get_material()->textures.end() ? texture_it->second : specialized_texture.second;
+
+				if (auto layout_binding = descriptor_set_layout.get_layout_binding(specialized_texture.first))
+				{
+					command_buffer.bind_image(texture->get_image()->get_vk_image_view(),
+					                          texture->get_sampler()->get_vk_sampler(),
+					                          0, layout_binding->binding, 0);
+				}
+			}
+		}
+		else
+		{
+			for (auto &texture : sub_mesh.get_material()->textures)
+			{
+				if (auto layout_binding = descriptor_set_layout.get_layout_binding(texture.first))
+				{
+					command_buffer.bind_image(texture.second->get_image()->get_vk_image_view(),
+					                          texture.second->get_sampler()->get_vk_sampler(),
+					                          0, layout_binding->binding, 0);
+				}
+			}
 		}
 	}
 
@@ -268,6 +631,12 @@ PipelineLayout &GeometrySubpass::prepare_pipeline_layout(CommandBuffer &command_
 	// Sets any specified resource modes
 	for (auto &shader_module : shader_modules)
 	{
+		// The modules of this strategy come from their own variant, so they are not shared with the other strategies
+		if (draw_constant_strategy == DrawConstantStrategy::DynamicUniformBuffer)
+		{
+			shader_module->set_resource_mode("GlobalUniform", ShaderResourceMode::Dynamic);
+		}
+
 		for (auto &resource_mode : resource_mode_map)
 		{
 			shader_module->set_resource_mode(resource_mode.first, resource_mode.second);
@@ -303,12 +672,12 @@ void GeometrySubpass::draw_submesh_command(CommandBuffer &command_buffer, sg::Su
 		command_buffer.bind_index_buffer(*sub_mesh.index_buffer, sub_mesh.index_offset, sub_mesh.index_type);
 
 		// Draw submesh using indexed data
-		command_buffer.draw_indexed(sub_mesh.vertex_indices, 1, 0, 0, 0);
+		command_buffer.draw_indexed(sub_mesh.vertex_indices, 1, 0, 0, draw_constant_index);
 	}
 	else
 	{
 		// Draw submesh using vertices only
-		command_buffer.draw(sub_mesh.vertices_count, 1, 0, 0);
+		command_buffer.draw(sub_mesh.vertices_count, 1, 0, draw_constant_index);
 	}
 }
 
@@ -316,4 +685,55 @@ void GeometrySubpass::set_thread_index(uint32_t index)
 {
 	thread_index = index;
 }
+
+void GeometrySubpass::set_bindless_materials(bool enable)
+{
+	bindless_materials = enable && !bindless_textures_exceed_limits;
+}
+
+void GeometrySubpass::set_specialized_materials(bool enable)
+{
+	specialized_materials = enable;
+}
+
+void GeometrySubpass::set_draw_constant_strategy(DrawConstantStrategy strategy)
+{
+	if (!is_draw_constant_strategy_supported(strategy))
+	{
+		LOGW("Draw constant strategy not supported by the device, falling back to a buffer array");
+		strategy = DrawConstantStrategy::BufferArray;
+	}
+
+	draw_constant_strategy = strategy;
+}
+
+DrawConstantStrategy GeometrySubpass::get_draw_constant_strategy() const
+{
+	return draw_constant_strategy;
+}
+
+bool GeometrySubpass::is_draw_constant_strategy_supported(DrawConstantStrategy strategy) const
+{
+	auto &device = render_context.get_device();
+
+	switch (strategy)
+	{
+		case DrawConstantStrategy::PushConstants:
+			// The model matrix and the material take 88 bytes, less than the 128 bytes every device supports
+			return device.get_gpu().get_properties().limits.maxPushConstantsSize >= sizeof(glm::mat4) + sizeof(PBRMaterialUniform);
+		case DrawConstantStrategy::BufferDeviceAddress:
+		{
+			if (!device.is_enabled(VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME))
+			{
+				return false;
+			}
+
+			// The extension alone does not allow taking buffer addresses, the feature must be enabled too
+			auto *features = device.get_gpu().get_extension_features<VkPhysicalDeviceBufferDeviceAddressFeaturesKHR>(VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES_KHR);
+			return features && features->bufferDeviceAddress;
+		}
+		default:
+			return true;
+	}
+}
 }        // namespace vkb
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2022, Arm Limited and Contributors
+/* Copyright (c) 2019-2023, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -17,12 +17,16 @@
 
 #pragma once
 
+#include <mutex>
+#include <thread>
+
 #include "common/error.h"
 
 VKBP_DISABLE_WARNINGS()
 #include "common/glm_common.h"
 VKBP_ENABLE_WARNINGS()
 
+#include "core/buffer.h"
 #include "rendering/subpass.h"
 
 namespace vkb
@@ -34,6 +38,8 @@ class Node;
 class Mesh;
 class SubMesh;
 class Camera;
+class Material;
+class Texture;
 }        // namespace sg
 
 /**
@@ -60,6 +66,38 @@ struct PBRMaterialUniform
 	float roughness_factor;
 };
 
+/**
+ * @brief Material entry of the scene-wide material buffer for the bindless path of the base shader
+ */
+struct alignas(16) BindlessMaterial
+{
+	glm::vec4 base_color_factor;
+
+	float metallic_factor;
+
+	float roughness_factor;
+
+	/// Index in the bindless texture table, or -1 if the material has no base color texture
+	int32_t base_color_texture;
+};
+
+/**
+ * @brief How GeometrySubpass gives the shaders the constants that change with every draw, i.e. the model matrix
+ */
+enum class DrawConstantStrategy
+{
+	/// A uniform buffer allocated and bound for every draw
+	UniformBuffer,
+	/// The same uniform buffers, bound with dynamic offsets so that descriptor sets are reused
+	DynamicUniformBuffer,
+	/// The model matrix is pushed in front of the material push constants
+	PushConstants,
+	/// One storage buffer holds the constants of every draw of the pass, indexed with the instance index
+	BufferArray,
+	/// The same buffer, with the address of the constants of each draw pushed. Needs VK_KHR_buffer_device_address
+	BufferDeviceAddress
+};
+
 /**
  * @brief This subpass is responsible for rendering a Scene
  */
@@ -90,6 +128,42 @@ class GeometrySubpass : public Subpass
 	 */
 	void set_thread_index(uint32_t index);
 
+	/**
+	 * @brief Draws with a texture table and material buffer shared by the whole scene,
+	 *        which are bound once so that materials no longer need their own descriptor sets.
+	 *        The shaders must support the BINDLESS_MATERIALS define, as base.frag does.
+	 *        Stays disabled if the textures of the scene exceed the per-stage sampler limits of the device
+	 * @param enable Whether submeshes index their material instead of binding it
+	 */
+	void set_bindless_materials(bool enable);
+
+	/**
+	 * @brief Compiles one shader variant for the whole scene and selects the material features of each submesh
+	 *        with specialization constants, instead of compiling a variant per combination of features.
+	 *        Every boolean specialization constant named after a feature define (e.g. HAS_BASE_COLOR_TEXTURE)
+	 *        is set from the submesh. The shaders must support the SPECIALIZED_MATERIALS define, as base.frag does.
+	 *        Bindless materials take precedence when both are enabled
+	 * @param enable Whether material features are specialization constants instead of defines
+	 */
+	void set_specialized_materials(bool enable);
+
+	/**
+	 * @brief Selects how the model matrix of each draw reaches the shaders. Strategies other than UniformBuffer
+	 *        add a DRAW_CONSTANTS_ define to the shader variants, which the shaders must support as base.vert does.
+	 *        BufferArray and BufferDeviceAddress allocate the constants of the pass in draw(), and record its draws on one thread.
+	 *        A strategy the device does not support falls back to BufferArray
+	 * @param strategy Strategy used from the next draw on
+	 */
+	void set_draw_constant_strategy(DrawConstantStrategy strategy);
+
+	DrawConstantStrategy get_draw_constant_strategy() const;
+
+	/**
+	 * @return Whether the device of the render context can use the strategy. BufferDeviceAddress needs both
+	 *         the extension and the bufferDeviceAddress feature to be enabled
+	 */
+	bool is_draw_constant_strategy_supported(DrawConstantStrategy strategy) const;
+
   protected:
 	virtual void update_uniform(CommandBuffer &command_buffer, sg::Node &node, size_t thread_index);
 
@@ -103,6 +177,47 @@ class GeometrySubpass : public Subpass
 
 	virtual void draw_submesh_command(CommandBuffer &command_buffer, sg::SubMesh &sub_mesh);
 
+	/**
+	 * @brief Builds the bindless texture table, material buffer and shader variant from the materials of the scene
+	 */
+	virtual void prepare_bindless_materials();
+
+	/**
+	 * @brief Binds the bindless texture table and material buffer at set 1
+	 */
+	void bind_bindless_materials(CommandBuffer &command_buffer);
+
+	/**
+	 * @brief Builds the shader variant shared by all submeshes when materials are specialized,
+	 *        and finds a texture of the scene for each texture name so that every declared sampler can be bound
+	 */
+	virtual void prepare_specialized_materials();
+
+	/**
+	 * @brief Sets the feature specialization constants of the pipeline layout from the features of the submesh
+	 */
+	void set_feature_constants(CommandBuffer &command_buffer, PipelineLayout &pipeline_layout, sg::SubMesh &sub_mesh);
+
+	/**
+	 * @brief Allocates and binds the buffers shared by the draws of a pass, for the strategies that need them.
+	 *        Subclasses that record draws without GeometrySubpass::draw must call it first.
+	 *        With BufferArray and BufferDeviceAddress, the draws must then be recorded on the calling thread,
+	 *        as update_uniform() passes the index of each draw to the following draw_submesh() through the subpass
+	 * @param command_buffer Command buffer the draws are recorded in
+	 * @param draw_count Number of draws recorded after it
+	 */
+	void begin_draw_constants(CommandBuffer &command_buffer, uint32_t draw_count);
+
+	/**
+	 * @return The variant with the define of the draw constant strategy added, created on first use
+	 */
+	const ShaderVariant &get_draw_constant_variant(const ShaderVariant &variant);
+
+	/**
+	 * @return Offset of the material push constants, which follow the push constants of the draw
+	 */
+	uint32_t get_material_push_constant_offset() const;
+
 	/**
 	 * @brief Sorts objects based on distance from camera and classifies them
 	 *        into opaque and transparent in the arrays provided
@@ -119,6 +234,55 @@ class GeometrySubpass : public Subpass
 	uint32_t thread_index{0};
 
 	vkb::RasterizationState base_rasterization_state{};
+
+	bool bindless_materials{false};
+
+	/// Variant used for every submesh when materials are bindless, so that all draws share a pipeline layout
+	ShaderVariant bindless_variant;
+
+	std::vector<sg::Texture *> bindless_textures;
+
+	std::unordered_map<const sg::Material *, uint32_t> bindless_material_indices;
+
+	std::unique_ptr<core::Buffer> bindless_material_buffer;
+
+	/// Set when the texture table of the scene does not fit the per-stage descriptor limits of the device
+	bool bindless_textures_exceed_limits{false};
+
+	bool specialized_materials{false};
+
+	/// Variant used for every submesh when materials are specialized, declaring the textures used anywhere in the scene
+	ShaderVariant specialized_variant;
+
+	/// A texture of the scene for each texture name, bound for submeshes whose material does not have that texture
+	std::map<std::string, sg::Texture *> specialized_textures;
+
+	DrawConstantStrategy draw_constant_strategy{DrawConstantStrategy::UniformBuffer};
+
+	/// Variants with the define of a draw constant strategy, by id of the original variant and strategy
+	std::unordered_map<size_t, ShaderVariant> draw_constant_variants;
+
+	std::mutex draw_constant_variants_mutex;
+
+	/// Camera constants shared by the draws of the pass when the model matrix is delivered separately
+	BufferAllocation pass_uniform;
+
+	/// Model matrices of the draws of the pass for the BufferArray and BufferDeviceAddress strategies
+	BufferAllocation draw_constants;
+
+	uint64_t draw_constants_address{0};
+
+	/// Number of model matrices draw_constants can hold
+	uint32_t draw_constant_capacity{0};
+
+	/// Number of model matrices written to draw_constants
+	uint32_t draw_constant_count{0};
+
+	/// Index of the constants of the current draw in draw_constants, passed as the first instance
+	uint32_t draw_constant_index{0};
+
+	/// The thread recording the draws which use draw_constants, the only one allowed to update the counters above
+	std::thread::id draw_constants_thread;
 };
 
 }        // namespace vkb
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2020, Arm Limited and Contributors
+/* Copyright (c) 2019-2023, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -23,7 +23,15 @@ void ResourceBindingState::reset()
 {
 	clear_dirty();
 
-	resource_sets.clear();
+	for (uint32_t set = 0; set < max_sets; ++set)
+	{
+		if (bound_sets & (1u << set))
+		{
+			resource_sets[set].reset();
+		}
+	}
+
+	bound_sets = 0;
 }
 
 bool ResourceBindingState::is_dirty()
@@ -38,103 +46,198 @@ void ResourceBindingState::clear_dirty()
 
 void ResourceBindingState::clear_dirty(uint32_t set)
 {
+	assert(set < max_sets);
 	resource_sets[set].clear_dirty();
 }
 
 void ResourceBindingState::bind_buffer(const core::Buffer &buffer, VkDeviceSize offset, VkDeviceSize range, uint32_t set, uint32_t binding, uint32_t array_element)
 {
-	resource_sets[set].bind_buffer(buffer, offset, range, binding, array_element);
+	get_bound_set(set).bind_buffer(buffer, offset, range, binding, array_element);
 
 	dirty = true;
 }
 
 void ResourceBindingState::bind_image(const core::ImageView &image_view, const core::Sampler &sampler, uint32_t set, uint32_t binding, uint32_t array_element)
 {
-	resource_sets[set].bind_image(image_view, sampler, binding, array_element);
+	get_bound_set(set).bind_image(image_view, sampler, binding, array_element);
 
 	dirty = true;
 }
 
 void ResourceBindingState::bind_image(const core::ImageView &image_view, uint32_t set, uint32_t binding, uint32_t array_element)
 {
-	resource_sets[set].bind_image(image_view, binding, array_element);
+	get_bound_set(set).bind_image(image_view, binding, array_element);
 
 	dirty = true;
 }
 
 void ResourceBindingState::bind_input(const core::ImageView &image_view, uint32_t set, uint32_t binding, uint32_t array_element)
 {
-	resource_sets[set].bind_input(image_view, binding, array_element);
+	get_bound_set(set).bind_input(image_view, binding, array_element);
 
 	dirty = true;
 }
 
-const std::unordered_map<uint32_t, ResourceSet> &ResourceBindingState::get_resource_sets()
+uint32_t ResourceBindingState::get_bound_sets() const
 {
-	return resource_sets;
+	return bound_sets;
 }
 
-void ResourceSet::reset()
+const ResourceSet &ResourceBindingState::get_resource_set(uint32_t set) const
 {
-	clear_dirty();
+	assert(set < max_sets);
+	return resource_sets[set];
+}
+
+ResourceSet &ResourceBindingState::get_bound_set(uint32_t set)
+{
+	if (set >= max_sets)
+	{
+		throw std::runtime_error("Descriptor set index " + std::to_string(set) + " exceeds the resource binding state capacity.");
+	}
+
+	bound_sets |= 1u << set;
 
-	resource_bindings.clear();
+	return resource_sets[set];
 }
 
-bool ResourceSet::is_dirty() const
+void ResourceSet::reset()
 {
-	return dirty;
+	for (uint32_t binding = 0; binding < max_bindings; ++binding)
+	{
+		if (bound_bindings & (1u << binding))
+		{
+			bindings[binding].reset();
+		}
+	}
+
+	bound_bindings = 0;
+	dirty_bindings = 0;
 }
 
-void ResourceSet::clear_dirty()
+bool ResourceSet::is_dirty() const
 {
-	dirty = false;
+	return dirty_bindings != 0;
 }
 
-void ResourceSet::clear_dirty(uint32_t binding, uint32_t array_element)
+void ResourceSet::clear_dirty()
 {
-	resource_bindings[binding][array_element].dirty = false;
+	dirty_bindings = 0;
 }
 
 void ResourceSet::bind_buffer(const core::Buffer &buffer, VkDeviceSize offset, VkDeviceSize range, uint32_t binding, uint32_t array_element)
 {
-	resource_bindings[binding][array_element].dirty  = true;
-	resource_bindings[binding][array_element].buffer = &buffer;
-	resource_bindings[binding][array_element].offset = offset;
-	resource_bindings[binding][array_element].range  = range;
+	auto &resource_info = bind_element(binding, array_element);
 
-	dirty = true;
+	resource_info.dirty  = true;
+	resource_info.buffer = &buffer;
+	resource_info.offset = offset;
+	resource_info.range  = range;
 }
 
 void ResourceSet::bind_image(const core::ImageView &image_view, const core::Sampler &sampler, uint32_t binding, uint32_t array_element)
 {
-	resource_bindings[binding][array_element].dirty      = true;
-	resource_bindings[binding][array_element].image_view = &image_view;
-	resource_bindings[binding][array_element].sampler    = &sampler;
+	auto &resource_info = bind_element(binding, array_element);
 
-	dirty = true;
+	resource_info.dirty      = true;
+	resource_info.image_view = &image_view;
+	resource_info.sampler    = &sampler;
 }
 
 void ResourceSet::bind_image(const core::ImageView &image_view, uint32_t binding, uint32_t array_element)
 {
-	resource_bindings[binding][array_element].dirty      = true;
-	resource_bindings[binding][array_element].image_view = &image_view;
-	resource_bindings[binding][array_element].sampler    = nullptr;
+	auto &resource_info = bind_element(binding, array_element);
 
-	dirty = true;
+	resource_info.dirty      = true;
+	resource_info.image_view = &image_view;
+	resource_info.sampler    = nullptr;
 }
 
 void ResourceSet::bind_input(const core::ImageView &image_view, const uint32_t binding, const uint32_t array_element)
 {
-	resource_bindings[binding][array_element].dirty      = true;
-	resource_bindings[binding][array_element].image_view = &image_view;
+	auto &resource_info = bind_element(binding, array_element);
 
-	dirty = true;
+	resource_info.dirty      = true;
+	resource_info.image_view = &image_view;
+}
+
+uint32_t ResourceSet::get_bound_bindings() const
+{
+	return bound_bindings;
+}
+
+uint32_t ResourceSet::get_dirty_bindings() const
+{
+	return dirty_bindings;
 }
 
-const BindingMap<ResourceInfo> &ResourceSet::get_resource_bindings() const
+const ResourceBinding &ResourceSet::get_binding(uint32_t binding) const
 {
-	return resource_bindings;
+	assert(binding < max_bindings);
+	return bindings[binding];
+}
+
+ResourceInfo &ResourceSet::bind_element(uint32_t binding, uint32_t array_element)
+{
+	if (binding >= max_bindings)
+	{
+		throw std::runtime_error("Binding index " + std::to_string(binding) + " exceeds the resource set capacity.");
+	}
+
+	bound_bindings |= 1u << binding;
+	dirty_bindings |= 1u << binding;
+
+	return bindings[binding].bind_element(array_element);
+}
+
+void ResourceBinding::reset()
+{
+	for (uint32_t i = 0; i < std::min(element_count, inline_element_count); ++i)
+	{
+		inline_elements[i] = {};
+	}
+
+	// Keep the capacity of the overflow elements for the next large array
+	overflow_elements.clear();
+
+	element_count = 0;
+}
+
+uint32_t ResourceBinding::get_element_count() const
+{
+	return element_count;
+}
+
+const ResourceInfo &ResourceBinding::get_element(uint32_t array_element) const
+{
+	assert(array_element < element_count);
+
+	if (array_element < inline_element_count)
+	{
+		return inline_elements[array_element];
+	}
+
+	return overflow_elements[array_element - inline_element_count];
+}
+
+ResourceInfo &ResourceBinding::bind_element(uint32_t array_element)
+{
+	if (array_element >= element_count)
+	{
+		element_count = array_element + 1;
+
+		if (element_count > inline_element_count)
+		{
+			overflow_elements.resize(element_count - inline_element_count);
+		}
+	}
+
+	if (array_element < inline_element_count)
+	{
+		return inline_elements[array_element];
+	}
+
+	return overflow_elements[array_element - inline_element_count];
 }
 
 }        // namespace vkb
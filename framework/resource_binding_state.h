@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2020, Arm Limited and Contributors
+/* Copyright (c) 2019-2023, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <array>
+
 #include "common/vk_common.h"
 #include "core/buffer.h"
 #include "core/image_view.h"
@@ -44,6 +46,35 @@ struct ResourceInfo
 	const core::Sampler *sampler{nullptr};
 };
 
+/**
+ * @brief The array elements bound to a binding of a resource set.
+ *
+ * The first elements are stored inline, larger arrays overflow to the heap.
+ */
+class ResourceBinding
+{
+  public:
+	static constexpr uint32_t inline_element_count = 2;
+
+	void reset();
+
+	/**
+	 * @return One more than the highest array element bound, elements below it may be unbound
+	 */
+	uint32_t get_element_count() const;
+
+	const ResourceInfo &get_element(uint32_t array_element) const;
+
+	ResourceInfo &bind_element(uint32_t array_element);
+
+  private:
+	uint32_t element_count{0};
+
+	std::array<ResourceInfo, inline_element_count> inline_elements;
+
+	std::vector<ResourceInfo> overflow_elements;
+};
+
 /**
  * @brief A resource set is a set of bindings containing resources that were bound 
  *        by a command buffer.
@@ -53,14 +84,15 @@ struct ResourceInfo
 class ResourceSet
 {
   public:
+	/// Bindings are tracked with one bit each
+	static constexpr uint32_t max_bindings = 16;
+
 	void reset();
 
 	bool is_dirty() const;
 
 	void clear_dirty();
 
-	void clear_dirty(uint32_t binding, uint32_t array_element);
-
 	void bind_buffer(const core::Buffer &buffer, VkDeviceSize offset, VkDeviceSize range, uint32_t binding, uint32_t array_element);
 
 	void bind_image(const core::ImageView &image_view, const core::Sampler &sampler, uint32_t binding, uint32_t array_element);
@@ -69,12 +101,26 @@ class ResourceSet
 
 	void bind_input(const core::ImageView &image_view, uint32_t binding, uint32_t array_element);
 
-	const BindingMap<ResourceInfo> &get_resource_bindings() const;
+	/**
+	 * @return A mask with the bit of each binding that has resources bound
+	 */
+	uint32_t get_bound_bindings() const;
+
+	/**
+	 * @return A mask with the bit of each binding that changed since the dirty bits were last cleared
+	 */
+	uint32_t get_dirty_bindings() const;
+
+	const ResourceBinding &get_binding(uint32_t binding) const;
 
   private:
-	bool dirty{false};
+	ResourceInfo &bind_element(uint32_t binding, uint32_t array_element);
+
+	uint32_t bound_bindings{0};
 
-	BindingMap<ResourceInfo> resource_bindings;
+	uint32_t dirty_bindings{0};
+
+	std::array<ResourceBinding, max_bindings> bindings;
 };
 
 /**
@@ -86,6 +132,9 @@ class ResourceSet
 class ResourceBindingState
 {
   public:
+	/// Sets are tracked with one bit each
+	static constexpr uint32_t max_sets = 8;
+
 	void reset();
 
 	bool is_dirty();
@@ -102,11 +151,20 @@ class ResourceBindingState
 
 	void bind_input(const core::ImageView &image_view, uint32_t set, uint32_t binding, uint32_t array_element);
 
-	const std::unordered_map<uint32_t, ResourceSet> &get_resource_sets();
+	/**
+	 * @return A mask with the bit of each set that has resources bound
+	 */
+	uint32_t get_bound_sets() const;
+
+	const ResourceSet &get_resource_set(uint32_t set) const;
 
   private:
+	ResourceSet &get_bound_set(uint32_t set);
+
 	bool dirty{false};
 
-	std::unordered_map<uint32_t, ResourceSet> resource_sets;
+	uint32_t bound_sets{0};
+
+	std::array<ResourceSet, max_sets> resource_sets;
 };
 }        // namespace vkb
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2020, Arm Limited and Contributors
+/* Copyright (c) 2019-2023, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -63,16 +63,17 @@ ShaderModule &ResourceCache::request_shader_module(VkShaderStageFlagBits stage,
 	return request_resource(device, recorder, shader_module_mutex, state.shader_modules, stage, glsl_source, entry_point, shader_variant);
 }
 
-PipelineLayout &ResourceCache::request_pipeline_layout(const std::vector<ShaderModule *> &shader_modules)
+PipelineLayout &ResourceCache::request_pipeline_layout(const std::vector<ShaderModule *> &shader_modules, bool use_push_descriptors)
 {
-	return request_resource(device, recorder, pipeline_layout_mutex, state.pipeline_layouts, shader_modules);
+	return request_resource(device, recorder, pipeline_layout_mutex, state.pipeline_layouts, shader_modules, use_push_descriptors);
 }
 
 DescriptorSetLayout &ResourceCache::request_descriptor_set_layout(const uint32_t                     set_index,
                                                                   const std::vector<ShaderModule *> &shader_modules,
-                                                                  const std::vector<ShaderResource> &set_resources)
+                                                                  const std::vector<ShaderResource> &set_resources,
+                                                                  bool                               push_descriptor)
 {
-	return request_resource(device, recorder, descriptor_set_layout_mutex, state.descriptor_set_layouts, set_index, shader_modules, set_resources);
+	return request_resource(device, recorder, descriptor_set_layout_mutex, state.descriptor_set_layouts, set_index, shader_modules, set_resources, push_descriptor);
 }
 
 GraphicsPipeline &ResourceCache::request_graphics_pipeline(PipelineState &pipeline_state)
@@ -101,6 +102,87 @@ Framebuffer &ResourceCache::request_framebuffer(const RenderTarget &render_targe
 	return request_resource(device, recorder, framebuffer_mutex, state.framebuffers, render_target, render_pass);
 }
 
+core::Sampler &ResourceCache::request_sampler(const VkSamplerCreateInfo &info)
+{
+	std::lock_guard<std::mutex> guard(sampler_mutex);
+
+	auto &sampler = request_resource(device, &recorder, state.samplers, info);
+
+	state.sampler_references[sampler.get_handle()]++;
+
+	return sampler;
+}
+
+core::ImageView &ResourceCache::request_image_view(core::Image &image, VkImageViewType view_type, VkFormat format,
+                                                   uint32_t base_mip_level, uint32_t base_array_layer,
+                                                   uint32_t n_mip_levels, uint32_t n_array_layers)
+{
+	std::lock_guard<std::mutex> guard(image_view_mutex);
+
+	// Resolve the defaults first, so that a view requested with and without them is the same
+	format         = format == VK_FORMAT_UNDEFINED ? image.get_format() : format;
+	n_mip_levels   = n_mip_levels == 0 ? image.get_subresource().mipLevel : n_mip_levels;
+	n_array_layers = n_array_layers == 0 ? image.get_subresource().arrayLayer : n_array_layers;
+
+	std::size_t hash{0U};
+	hash_param(hash, image.get_handle(), static_cast<std::underlying_type<VkImageViewType>::type>(view_type), static_cast<std::underlying_type<VkFormat>::type>(format),
+	           base_mip_level, base_array_layer, n_mip_levels, n_array_layers);
+
+	auto it = state.image_views.find(hash);
+	if (it == state.image_views.end())
+	{
+		LOGD("Building #{} cache object ({})", state.image_views.size(), typeid(core::ImageView).name());
+
+		it = state.image_views.emplace(hash, core::ImageView{image, view_type, format, base_mip_level, base_array_layer, n_mip_levels, n_array_layers}).first;
+	}
+
+	state.image_view_references[it->second.get_handle()]++;
+
+	return it->second;
+}
+
+void ResourceCache::release_sampler(const core::Sampler &sampler)
+{
+	std::lock_guard<std::mutex> guard(sampler_mutex);
+
+	auto reference_it = state.sampler_references.find(sampler.get_handle());
+	if (reference_it == state.sampler_references.end())
+	{
+		LOGW("Released a sampler which is not in the cache");
+		return;
+	}
+
+	if (--reference_it->second == 0)
+	{
+		state.sampler_references.erase(reference_it);
+
+		auto it = std::find_if(state.samplers.begin(), state.samplers.end(),
+		                       [&sampler](const std::pair<const std::size_t, core::Sampler> &entry) { return &entry.second == &sampler; });
+		state.samplers.erase(it);
+	}
+}
+
+void ResourceCache::release_image_view(const core::ImageView &image_view)
+{
+	std::lock_guard<std::mutex> guard(image_view_mutex);
+
+	auto reference_it = state.image_view_references.find(image_view.get_handle());
+	if (reference_it == state.image_view_references.end())
+	{
+		LOGW("Released an image view which is not in the cache");
+		return;
+	}
+
+	if (--reference_it->second == 0)
+	{
+		state.image_view_references.erase(reference_it);
+
+		auto it = std::find_if(state.image_views.begin(), state.image_views.end(),
+		                       [&image_view](const std::pair<const std::size_t, core::ImageView> &entry) { return &entry.second == &image_view; });
+		state.image_views.erase(it);
+	}
+}
+
 void ResourceCache::clear_pipelines()
 {
 	state.graphics_pipelines.clear();
@@ -197,8 +279,19 @@ void ResourceCache::clear_framebuffers()
 	state.framebuffers.clear();
 }
 
+std::unordered_map<std::size_t, Framebuffer> ResourceCache::extract_framebuffers()
+{
+	std::lock_guard<std::mutex> guard(framebuffer_mutex);
+
+	std::unordered_map<std::size_t, Framebuffer> framebuffers;
+	std::swap(framebuffers, state.framebuffers);
+
+	return framebuffers;
+}
+
 void ResourceCache::clear()
 {
+	// Samplers and image views are kept, as they are destroyed by their last release
 	state.shader_modules.clear();
 	state.pipeline_layouts.clear();
 	state.descriptor_sets.clear();
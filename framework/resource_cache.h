@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2020, Arm Limited and Contributors
+/* Copyright (c) 2019-2023, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -26,7 +26,9 @@
 #include "core/descriptor_set.h"
 #include "core/descriptor_set_layout.h"
 #include "core/framebuffer.h"
+#include "core/image_view.h"
 #include "core/pipeline.h"
+#include "core/sampler.h"
 #include "resource_record.h"
 #include "resource_replay.h"
 
@@ -34,11 +36,6 @@ namespace vkb
 {
 class Device;
 
-namespace core
-{
-class ImageView;
-}
-
 /**
  * @brief Struct to hold the internal state of the Resource Cache
  *
@@ -62,6 +59,16 @@ struct ResourceCacheState
 	std::unordered_map<std::size_t, DescriptorSet> descriptor_sets;
 
 	std::unordered_map<std::size_t, Framebuffer> framebuffers;
+
+	std::unordered_map<std::size_t, core::Sampler> samplers;
+
+	std::unordered_map<std::size_t, core::ImageView> image_views;
+
+	/// Number of users of each sampler, by handle
+	std::unordered_map<VkSampler, uint32_t> sampler_references;
+
+	/// Number of users of each image view, by handle
+	std::unordered_map<VkImageView, uint32_t> image_view_references;
 };
 
 /**
@@ -75,6 +82,10 @@ struct ResourceCacheState
  * the cache on app startup by creating all necessary objects.
  * The cache holds pointers to objects and has a mapping from such pointers to hashes.
  * It can only be destroyed in bulk, single elements cannot be removed.
+ *
+ * Samplers and image views are the exception: they are reference counted, as they are owned by
+ * scene components and passes which are destroyed before the device. Each request must be paired
+ * with a release, and the object is destroyed with its last release.
  */
 class ResourceCache
 {
@@ -97,11 +108,12 @@ class ResourceCache
 
 	ShaderModule &request_shader_module(VkShaderStageFlagBits stage, const ShaderSource &glsl_source, const ShaderVariant &shader_variant = {});
 
-	PipelineLayout &request_pipeline_layout(const std::vector<ShaderModule *> &shader_modules);
+	PipelineLayout &request_pipeline_layout(const std::vector<ShaderModule *> &shader_modules, bool use_push_descriptors = false);
 
 	DescriptorSetLayout &request_descriptor_set_layout(const uint32_t                     set_index,
 	                                                   const std::vector<ShaderModule *> &shader_modules,
-	                                                   const std::vector<ShaderResource> &set_resources);
+	                                                   const std::vector<ShaderResource> &set_resources,
+	                                                   bool                               push_descriptor = false);
 
 	GraphicsPipeline &request_graphics_pipeline(PipelineState &pipeline_state);
 
@@ -118,6 +130,31 @@ class ResourceCache
 	Framebuffer &request_framebuffer(const RenderTarget &render_target,
 	                                 const RenderPass &  render_pass);
 
+	/**
+	 * @brief Returns a sampler shared by all requests with the same create info
+	 * @param info The create info, of which the pNext chain is compared by address only
+	 */
+	core::Sampler &request_sampler(const VkSamplerCreateInfo &info);
+
+	/**
+	 * @brief Returns an image view shared by all requests for the same image, type, format and subresource range
+	 *        The parameters have the defaults of the core::ImageView constructor
+	 */
+	core::ImageView &request_image_view(core::Image &image, VkImageViewType view_type, VkFormat format = VK_FORMAT_UNDEFINED,
+	                                    uint32_t base_mip_level = 0, uint32_t base_array_layer = 0,
+	                                    uint32_t n_mip_levels = 0, uint32_t n_array_layers = 0);
+
+	/**
+	 * @brief Releases a sampler returned by request_sampler, destroying it if it has no other user
+	 */
+	void release_sampler(const core::Sampler &sampler);
+
+	/**
+	 * @brief Releases an image view returned by request_image_view, destroying it if it has no other user
+	 *        Must be called before the image is destroyed
+	 */
+	void release_image_view(const core::ImageView &image_view);
+
 	void clear_pipelines();
 
 	/// @brief Update those descriptor sets referring to old views
@@ -127,6 +164,12 @@ class ResourceCache
 
 	void clear_framebuffers();
 
+	/**
+	 * @brief Removes all framebuffers from the cache without destroying them
+	 * @return The framebuffers, to be destroyed once no frame in flight uses them
+	 */
+	std::unordered_map<std::size_t, Framebuffer> extract_framebuffers();
+
 	void clear();
 
 	const ResourceCacheState &get_internal_state() const;
@@ -157,5 +200,9 @@ class ResourceCache
 	std::mutex compute_pipeline_mutex;
 
 	std::mutex framebuffer_mutex;
+
+	std::mutex sampler_mutex;
+
+	std::mutex image_view_mutex;
 };
 }        // namespace vkb
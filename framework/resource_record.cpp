@@ -75,7 +75,7 @@ size_t ResourceRecord::register_shader_module(VkShaderStageFlagBits stage, const
 	return shader_module_indices.back();
 }
 
-size_t ResourceRecord::register_pipeline_layout(const std::vector<ShaderModule *> &shader_modules)
+size_t ResourceRecord::register_pipeline_layout(const std::vector<ShaderModule *> &shader_modules, bool use_push_descriptors)
 {
 	pipeline_layout_indices.push_back(pipeline_layout_indices.size());
 
@@ -85,7 +85,8 @@ size_t ResourceRecord::register_pipeline_layout(const std::vector<ShaderModule *
 
 	write(stream,
 	      ResourceType::PipelineLayout,
-	      shader_indices);
+	      shader_indices,
+	      use_push_descriptors);
 
 	return pipeline_layout_indices.back();
 }
@@ -133,7 +134,9 @@ size_t ResourceRecord::register_graphics_pipeline(VkPipelineCache /*pipeline_cac
 	      pipeline_state.get_rasterization_state(),
 	      pipeline_state.get_viewport_state(),
 	      pipeline_state.get_multisample_state(),
-	      pipeline_state.get_depth_stencil_state());
+	      pipeline_state.get_depth_stencil_state(),
+	      pipeline_state.get_tessellation_state(),
+	      pipeline_state.get_extended_dynamic_state());
 
 	auto &color_blend_state = pipeline_state.get_color_blend_state();
 
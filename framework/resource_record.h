@@ -53,7 +53,7 @@ class ResourceRecord
 	                              const std::string &   entry_point,
 	                              const ShaderVariant & shader_variant);
 
-	size_t register_pipeline_layout(const std::vector<ShaderModule *> &shader_modules);
+	size_t register_pipeline_layout(const std::vector<ShaderModule *> &shader_modules, bool use_push_descriptors = false);
 
 	size_t register_render_pass(const std::vector<Attachment> &   attachments,
 	                            const std::vector<LoadStoreInfo> &load_store_infos,
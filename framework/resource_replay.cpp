@@ -117,9 +117,11 @@ void ResourceReplay::create_shader_module(ResourceCache &resource_cache, std::is
 void ResourceReplay::create_pipeline_layout(ResourceCache &resource_cache, std::istringstream &stream)
 {
 	std::vector<size_t> shader_indices;
+	bool                use_push_descriptors{false};
 
 	read(stream,
-	     shader_indices);
+	     shader_indices,
+	     use_push_descriptors);
 
 	std::vector<ShaderModule *> shader_stages(shader_indices.size());
 	std::transform(shader_indices.begin(),
@@ -130,7 +132,7 @@ void ResourceReplay::create_pipeline_layout(ResourceCache &resource_cache, std::
 		               return shader_modules[shader_index];
 	               });
 
-	auto &pipeline_layout = resource_cache.request_pipeline_layout(shader_stages);
+	auto &pipeline_layout = resource_cache.request_pipeline_layout(shader_stages, use_push_descriptors);
 
 	pipeline_layouts.push_back(&pipeline_layout);
 }
@@ -173,18 +175,22 @@ void ResourceReplay::create_graphics_pipeline(ResourceCache &resource_cache, std
 	     vertex_input_state.attributes,
 	     vertex_input_state.bindings);
 
-	InputAssemblyState input_assembly_state{};
-	RasterizationState rasterization_state{};
-	ViewportState      viewport_state{};
-	MultisampleState   multisample_state{};
-	DepthStencilState  depth_stencil_state{};
+	InputAssemblyState   input_assembly_state{};
+	RasterizationState   rasterization_state{};
+	ViewportState        viewport_state{};
+	MultisampleState     multisample_state{};
+	DepthStencilState    depth_stencil_state{};
+	TessellationState    tessellation_state{};
+	ExtendedDynamicState extended_dynamic_state{};
 
 	read(stream,
 	     input_assembly_state,
 	     rasterization_state,
 	     viewport_state,
 	     multisample_state,
-	     depth_stencil_state);
+	     depth_stencil_state,
+	     tessellation_state,
+	     extended_dynamic_state);
 
 	ColorBlendState color_blend_state{};
 
@@ -194,6 +200,7 @@ void ResourceReplay::create_graphics_pipeline(ResourceCache &resource_cache, std
 	     color_blend_state.attachments);
 
 	PipelineState pipeline_state{};
+	pipeline_state.set_extended_dynamic_state(extended_dynamic_state);
 	assert(pipeline_layout_index < pipeline_layouts.size());
 	pipeline_state.set_pipeline_layout(*pipeline_layouts[pipeline_layout_index]);
 	assert(render_pass_index < render_passes.size());
@@ -212,6 +219,7 @@ void ResourceReplay::create_graphics_pipeline(ResourceCache &resource_cache, std
 	pipeline_state.set_multisample_state(multisample_state);
 	pipeline_state.set_depth_stencil_state(depth_stencil_state);
 	pipeline_state.set_color_blend_state(color_blend_state);
+	pipeline_state.set_tessellation_state(tessellation_state);
 
 	auto &graphics_pipeline = resource_cache.request_graphics_pipeline(pipeline_state);
 
@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2019, Arm Limited and Contributors
+/* Copyright (c) 2018-2023, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -17,18 +17,60 @@
 
 #include "sampler.h"
 
+#include "resource_cache.h"
+
 namespace vkb
 {
 namespace sg
 {
 Sampler::Sampler(const std::string &name, core::Sampler &&vk_sampler) :
     Component{name},
-    vk_sampler{std::move(vk_sampler)}
+    owned_sampler{std::make_unique<core::Sampler>(std::move(vk_sampler))},
+    vk_sampler{owned_sampler.get()}
 {}
 
+Sampler::Sampler(const std::string &name, ResourceCache &resource_cache, const VkSamplerCreateInfo &info) :
+    Component{name},
+    resource_cache{&resource_cache}
+{
+	auto &sampler = resource_cache.request_sampler(info);
+
+	// A shared sampler keeps the name of its first user
+	if (sampler.get_debug_name().empty())
+	{
+		sampler.set_debug_name(name);
+	}
+
+	vk_sampler = &sampler;
+}
+
+Sampler::Sampler(Sampler &&other) :
+    Component{std::move(other)},
+    owned_sampler{std::move(other.owned_sampler)},
+    resource_cache{other.resource_cache},
+    vk_sampler{other.vk_sampler}
+{
+	other.resource_cache = nullptr;
+	other.vk_sampler     = nullptr;
+}
+
+Sampler::~Sampler()
+{
+	if (resource_cache && vk_sampler)
+	{
+		resource_cache->release_sampler(*vk_sampler);
+	}
+}
+
 std::type_index Sampler::get_type()
 {
 	return typeid(Sampler);
 }
+
+const core::Sampler &Sampler::get_vk_sampler() const
+{
+	assert(vk_sampler && "Sampler was moved");
+	return *vk_sampler;
+}
 }        // namespace sg
 }        // namespace vkb
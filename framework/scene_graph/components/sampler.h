@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2019, Arm Limited and Contributors
+/* Copyright (c) 2018-2023, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -27,20 +27,38 @@
 
 namespace vkb
 {
+class ResourceCache;
+
 namespace sg
 {
 class Sampler : public Component
 {
   public:
+	/**
+	 * @brief Creates a component owning its Vulkan sampler
+	 */
 	Sampler(const std::string &name, core::Sampler &&vk_sampler);
 
-	Sampler(Sampler &&other) = default;
+	/**
+	 * @brief Creates a component sharing the Vulkan sampler of the resource cache with the same create info
+	 *        The sampler is released when the component is destroyed, so the cache must outlive the component
+	 */
+	Sampler(const std::string &name, ResourceCache &resource_cache, const VkSamplerCreateInfo &info);
+
+	Sampler(Sampler &&other);
 
-	virtual ~Sampler() = default;
+	virtual ~Sampler();
 
 	virtual std::type_index get_type() override;
 
-	core::Sampler vk_sampler;
+	const core::Sampler &get_vk_sampler() const;
+
+  private:
+	std::unique_ptr<core::Sampler> owned_sampler;
+
+	ResourceCache *resource_cache{nullptr};
+
+	const core::Sampler *vk_sampler{nullptr};
 };
 }        // namespace sg
 }        // namespace vkb
@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2021, Arm Limited and Contributors
+/* Copyright (c) 2018-2023, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -74,6 +74,7 @@ const ShaderVariant &SubMesh::get_shader_variant() const
 void SubMesh::compute_shader_variant()
 {
 	shader_variant.clear();
+	features.clear();
 
 	if (material != nullptr)
 	{
@@ -83,6 +84,7 @@ void SubMesh::compute_shader_variant()
 			std::transform(tex_name.begin(), tex_name.end(), tex_name.begin(), ::toupper);
 
 			shader_variant.add_define("HAS_" + tex_name);
+			features.insert("HAS_" + tex_name);
 		}
 	}
 
@@ -91,6 +93,7 @@ void SubMesh::compute_shader_variant()
 		std::string attrib_name = attribute.first;
 		std::transform(attrib_name.begin(), attrib_name.end(), attrib_name.begin(), ::toupper);
 		shader_variant.add_define("HAS_" + attrib_name);
+		features.insert("HAS_" + attrib_name);
 	}
 }
 
@@ -98,5 +101,10 @@ ShaderVariant &SubMesh::get_mut_shader_variant()
 {
 	return shader_variant;
 }
+
+bool SubMesh::has_feature(const std::string &feature) const
+{
+	return features.count(feature) > 0;
+}
 }        // namespace sg
 }        // namespace vkb
@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2021, Arm Limited and Contributors
+/* Copyright (c) 2018-2023, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -18,6 +18,7 @@
 #pragma once
 
 #include <memory>
+#include <set>
 #include <string>
 #include <typeinfo>
 #include <unordered_map>
@@ -76,6 +77,12 @@ class SubMesh : public Component
 
 	ShaderVariant &get_mut_shader_variant();
 
+	/**
+	 * @brief Checks for a material texture or vertex attribute, by the name of the define it adds to the shader variant
+	 * @param feature Name of the define, e.g. HAS_BASE_COLOR_TEXTURE
+	 */
+	bool has_feature(const std::string &feature) const;
+
   private:
 	std::unordered_map<std::string, VertexAttribute> vertex_attributes;
 
@@ -83,6 +90,8 @@ class SubMesh : public Component
 
 	ShaderVariant shader_variant;
 
+	std::set<std::string> features;
+
 	void compute_shader_variant();
 };
 }        // namespace sg
@@ -0,0 +1,84 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "command_buffer_stats_provider.h"
+
+#include "core/device.h"
+#include "rendering/render_context.h"
+
+namespace vkb
+{
+CommandBufferStatsProvider::CommandBufferStatsProvider(std::set<StatIndex> &requested_stats, RenderContext &render_context) :
+    render_context{render_context}
+{
+	for (auto index : {StatIndex::cmd_binds_issued, StatIndex::cmd_binds_skipped, StatIndex::cmd_draws, StatIndex::cmd_dispatches, StatIndex::cmd_descriptor_writes,
+	                   StatIndex::cmd_barriers_issued, StatIndex::cmd_barriers_skipped})
+	{
+		// Remove from requested set to stop other providers looking for it
+		if (requested_stats.erase(index) > 0)
+		{
+			supported_stats.insert(index);
+		}
+	}
+}
+
+bool CommandBufferStatsProvider::is_available(StatIndex index) const
+{
+	return supported_stats.count(index) > 0;
+}
+
+StatsProvider::Counters CommandBufferStatsProvider::sample(float delta_time)
+{
+	Counters res;
+
+	// The device totals are reset on every sample, so they hold the command buffers recorded since the previous frame
+	auto stats = render_context.get_device().reset_command_buffer_stats();
+
+	for (auto index : supported_stats)
+	{
+		switch (index)
+		{
+			case StatIndex::cmd_binds_issued:
+				res[index].result = stats.binds_issued;
+				break;
+			case StatIndex::cmd_binds_skipped:
+				res[index].result = stats.binds_skipped;
+				break;
+			case StatIndex::cmd_draws:
+				res[index].result = stats.draws;
+				break;
+			case StatIndex::cmd_dispatches:
+				res[index].result = stats.dispatches;
+				break;
+			case StatIndex::cmd_descriptor_writes:
+				res[index].result = stats.descriptor_writes;
+				break;
+			case StatIndex::cmd_barriers_issued:
+				res[index].result = stats.barriers_issued;
+				break;
+			case StatIndex::cmd_barriers_skipped:
+				res[index].result = stats.barriers_skipped;
+				break;
+			default:
+				break;
+		}
+	}
+
+	return res;
+}
+
+}        // namespace vkb
@@ -0,0 +1,78 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "frame_pacing_stats_provider.h"
+
+#include "rendering/render_context.h"
+
+namespace vkb
+{
+FramePacingStatsProvider::FramePacingStatsProvider(std::set<StatIndex> &requested_stats, RenderContext &render_context) :
+    render_context{render_context}
+{
+	for (auto index : {StatIndex::frame_fence_wait, StatIndex::frame_acquire, StatIndex::frame_submit, StatIndex::frame_present, StatIndex::frame_present_latency, StatIndex::frame_pacing_delay})
+	{
+		// Remove from requested set to stop other providers looking for it
+		if (requested_stats.erase(index) > 0)
+		{
+			supported_stats.insert(index);
+		}
+	}
+}
+
+bool FramePacingStatsProvider::is_available(StatIndex index) const
+{
+	return supported_stats.count(index) > 0;
+}
+
+StatsProvider::Counters FramePacingStatsProvider::sample(float delta_time)
+{
+	Counters res;
+
+	auto &timings = render_context.get_frame_pacer().get_timings();
+
+	for (auto index : supported_stats)
+	{
+		switch (index)
+		{
+			case StatIndex::frame_fence_wait:
+				res[index].result = timings.fence_wait;
+				break;
+			case StatIndex::frame_acquire:
+				res[index].result = timings.acquire;
+				break;
+			case StatIndex::frame_submit:
+				res[index].result = timings.submit;
+				break;
+			case StatIndex::frame_present:
+				res[index].result = timings.present;
+				break;
+			case StatIndex::frame_present_latency:
+				res[index].result = timings.present_latency;
+				break;
+			case StatIndex::frame_pacing_delay:
+				res[index].result = timings.pacing_delay;
+				break;
+			default:
+				break;
+		}
+	}
+
+	return res;
+}
+
+}        // namespace vkb
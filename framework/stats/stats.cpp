@@ -19,6 +19,8 @@
 #include "stats/stats.h"
 #include "core/device.h"
 
+#include "command_buffer_stats_provider.h"
+#include "frame_pacing_stats_provider.h"
 #include "frame_time_stats_provider.h"
 #include "hwcpipe_stats_provider.h"
 #include "vulkan_stats_provider.h"
@@ -63,6 +65,8 @@ void Stats::request_stats(const std::set<StatIndex> &wanted_stats,
 	// All supported stats will be removed from the given 'stats' set by the provider's constructor
 	// so subsequent providers only see requests for stats that aren't already supported.
 	providers.emplace_back(std::make_unique<FrameTimeStatsProvider>(stats));
+	providers.emplace_back(std::make_unique<CommandBufferStatsProvider>(stats, render_context));
+	providers.emplace_back(std::make_unique<FramePacingStatsProvider>(stats, render_context));
 	providers.emplace_back(std::make_unique<HWCPipeStatsProvider>(stats));
 	providers.emplace_back(std::make_unique<VulkanStatsProvider>(stats, sampling_config, render_context));
 
@@ -70,6 +74,10 @@ void Stats::request_stats(const std::set<StatIndex> &wanted_stats,
 	// Store the frame time provider here so we can easily access it later.
 	frame_time_provider = providers[0].get();
 
+	// Command buffer counts and frame pacing timings are per frame as well, so they are also polled in continuous sampling mode
+	command_buffer_provider = providers[1].get();
+	frame_pacing_provider   = providers[2].get();
+
 	for (const auto &stat : requested_stats)
 	{
 		counters[stat] = std::vector<float>(buffer_size, 0);
@@ -202,9 +210,15 @@ void Stats::update(float delta_time)
 			// Clamp the number of samples
 			sample_count = std::max<size_t>(1, std::min<size_t>(sample_count, pending_samples.size()));
 
-			// Get the frame time stats (not a continuous stat)
+			// Get the frame time and command buffer stats (not continuous stats)
 			StatsProvider::Counters frame_time_sample = frame_time_provider->sample(delta_time);
 
+			auto command_buffer_sample = command_buffer_provider->sample(delta_time);
+			frame_time_sample.insert(command_buffer_sample.begin(), command_buffer_sample.end());
+
+			auto frame_pacing_sample = frame_pacing_provider->sample(delta_time);
+			frame_time_sample.insert(frame_pacing_sample.begin(), frame_pacing_sample.end());
+
 			// Push the samples to circular buffers
 			std::for_each(pending_samples.begin(), pending_samples.begin() + sample_count, [this, frame_time_sample](auto &s) {
 				// Write the correct frame time into the continuous stats
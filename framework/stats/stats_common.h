@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2022, Arm Limited and Contributors
+/* Copyright (c) 2018-2023, Arm Limited and Contributors
  * Copyright (c) 2020-2022, Broadcom Inc.
  *
  * SPDX-License-Identifier: Apache-2.0
@@ -63,6 +63,21 @@ enum class StatIndex
 	gpu_ext_read_bytes,
 	gpu_ext_write_bytes,
 	gpu_tex_cycles,
+
+	cmd_binds_issued,
+	cmd_binds_skipped,
+	cmd_draws,
+	cmd_dispatches,
+	cmd_descriptor_writes,
+	cmd_barriers_issued,
+	cmd_barriers_skipped,
+
+	frame_fence_wait,
+	frame_acquire,
+	frame_submit,
+	frame_present,
+	frame_present_latency,
+	frame_pacing_delay,
 };
 
 struct StatIndexHash
@@ -54,6 +54,21 @@ std::map<StatIndex, StatGraphData> StatsProvider::default_graph_map{
     {StatIndex::gpu_ext_write_stalls,  {"External Write Stalls",                       "{:4.1f} M/s",   static_cast<float>(1e-6)}},
     {StatIndex::gpu_ext_read_bytes,    {"External Read Bytes",                         "{:4.1f} MiB/s", 1.0f / (1024.0f * 1024.0f)}},
     {StatIndex::gpu_ext_write_bytes,   {"External Write Bytes",                        "{:4.1f} MiB/s", 1.0f / (1024.0f * 1024.0f)}},
+
+    {StatIndex::cmd_binds_issued,      {"Binds Issued",                                "{:4.0f}/frame"}},
+    {StatIndex::cmd_binds_skipped,     {"Binds Skipped",                               "{:4.0f}/frame"}},
+    {StatIndex::cmd_draws,             {"Draw Calls",                                  "{:4.0f}/frame"}},
+    {StatIndex::cmd_dispatches,        {"Dispatches",                                  "{:4.0f}/frame"}},
+    {StatIndex::cmd_descriptor_writes, {"Descriptor Writes",                           "{:4.0f}/frame"}},
+    {StatIndex::cmd_barriers_issued,   {"Barriers Issued",                             "{:4.0f}/frame"}},
+    {StatIndex::cmd_barriers_skipped,  {"Barriers Skipped",                            "{:4.0f}/frame"}},
+
+    {StatIndex::frame_fence_wait,      {"Fence Wait",                                  "{:3.2f} ms",    1000.0f}},
+    {StatIndex::frame_acquire,         {"Acquire",                                     "{:3.2f} ms",    1000.0f}},
+    {StatIndex::frame_submit,          {"Queue Submit",                                "{:3.2f} ms",    1000.0f}},
+    {StatIndex::frame_present,         {"Queue Present",                               "{:3.2f} ms",    1000.0f}},
+    {StatIndex::frame_present_latency, {"Present Latency",                             "{:3.1f} ms",    1000.0f}},
+    {StatIndex::frame_pacing_delay,    {"Pacing Delay",                                "{:3.2f} ms",    1000.0f}},
     // clang-format on
 };
 
@@ -30,6 +30,8 @@ VKBP_ENABLE_WARNINGS()
 #include "common/strings.h"
 #include "common/utils.h"
 #include "common/vk_common.h"
+#include "camera_path.h"
+#include "core/null_device.h"
 #include "gltf_loader.h"
 #include "platform/platform.h"
 #include "platform/window.h"
@@ -47,9 +49,13 @@ namespace vkb
 {
 VulkanSample::~VulkanSample()
 {
+	// Subpasses may own buffers and images, which must be destroyed while the device still exists
+	render_pipeline.reset();
+
 	if (device)
 	{
-		device->wait_idle();
+		// finish() waited for the device to idle, the objects queued for deletion can be destroyed
+		device->get_deletion_queue().flush();
 	}
 
 	scene.reset();
@@ -89,7 +95,8 @@ bool VulkanSample::prepare(Platform &platform)
 
 	bool headless = platform.get_window().get_window_mode() == Window::Mode::Headless;
 
-	VkResult result = volkInitialize();
+	// The null device replaces the Vulkan loader, to run without a GPU
+	VkResult result = null_device::is_enabled() ? null_device::initialize() : volkInitialize();
 	if (result)
 	{
 		throw VulkanException(result, "Failed to initialize volk.");
@@ -299,6 +306,9 @@ void VulkanSample::update_gui(float delta_time)
 
 void VulkanSample::update(float delta_time)
 {
+	// In latency mode the frame starts late, so the scene is updated with recent input
+	render_context->pace_frame();
+
 	update_scene(delta_time);
 
 	update_gui(delta_time);
@@ -462,12 +472,72 @@ void VulkanSample::input_event(const InputEvent &input_event)
 	}
 }
 
+bool VulkanSample::get_camera_pose(CameraPose &pose)
+{
+	auto camera_node = find_camera_node();
+	if (!camera_node)
+	{
+		return false;
+	}
+
+	auto &transform = camera_node->get_transform();
+	pose.position   = transform.get_translation();
+	pose.rotation   = transform.get_rotation();
+
+	return true;
+}
+
+bool VulkanSample::set_camera_pose(const CameraPose &pose)
+{
+	auto camera_node = find_camera_node();
+	if (!camera_node)
+	{
+		return false;
+	}
+
+	auto &transform = camera_node->get_transform();
+	transform.set_translation(pose.position);
+	transform.set_rotation(pose.rotation);
+
+	return true;
+}
+
+sg::Node *VulkanSample::find_camera_node()
+{
+	if (!scene)
+	{
+		return nullptr;
+	}
+
+	if (scene->has_component<sg::Script>())
+	{
+		for (auto script : scene->get_components<sg::Script>())
+		{
+			if (auto free_camera = dynamic_cast<sg::FreeCamera *>(script))
+			{
+				return &free_camera->get_node();
+			}
+		}
+	}
+
+	auto cameras = scene->get_components<sg::Camera>();
+	if (cameras.empty())
+	{
+		return nullptr;
+	}
+
+	return cameras[0]->get_node();
+}
+
 void VulkanSample::finish()
 {
 	Application::finish();
 
 	if (device)
 	{
+		LOGI("Device waited for idle {} times before teardown", device->get_wait_idle_count());
+
+		// The only wait of the teardown, before the derived sample destroys the resources its frames still use
 		device->wait_idle();
 	}
 }
@@ -499,6 +569,8 @@ void VulkanSample::update_debug_window()
 	                                                    to_string(render_context->get_swapchain().get_format()) + " (" +
 	                                                        to_string(get_bits_per_pixel(render_context->get_swapchain().get_format())) + "bpp)");
 
+	get_debug_info().insert<field::Static, std::string>("gui_cpu_time", fmt::format("{:.2f} ms", gui->get_cpu_time()));
+
 	if (scene != nullptr)
 	{
 		get_debug_info().insert<field::Static, uint32_t>("mesh_count",
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2022, Arm Limited and Contributors
+/* Copyright (c) 2019-2023, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -132,6 +132,10 @@ class VulkanSample : public Application
 
 	void input_event(const InputEvent &input_event) override;
 
+	bool get_camera_pose(CameraPose &pose) override;
+
+	bool set_camera_pose(const CameraPose &pose) override;
+
 	void finish() override;
 
 	/** 
@@ -327,6 +331,11 @@ class VulkanSample : public Application
 	}
 
   private:
+	/**
+	 * @return The node of the camera moved by the user, or of the first camera of the scene
+	 */
+	sg::Node *find_camera_node();
+
 	/** @brief Set of device extensions to be enabled for this example and whether they are optional (must be set in the derived constructor) */
 	std::unordered_map<const char *, bool> device_extensions;
 
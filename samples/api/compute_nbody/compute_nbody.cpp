@@ -22,6 +22,9 @@
 #include "compute_nbody.h"
 
 #include "benchmark_mode/benchmark_mode.h"
+#include "platform/filesystem.h"
+#include "sample_options/sample_options.h"
+#include "timer.h"
 
 ComputeNBody::ComputeNBody()
 {
@@ -210,7 +213,7 @@ void ComputeNBody::build_compute_command_buffer()
 	// -------------------------------------------------------------------------------------------------------
 	vkCmdBindPipeline(compute.command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, compute.pipeline_calculate);
 	vkCmdBindDescriptorSets(compute.command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, compute.pipeline_layout, 0, 1, &compute.descriptor_set, 0, 0);
-	vkCmdDispatch(compute.command_buffer, num_particles / work_group_size, 1, 1);
+	vkCmdDispatch(compute.command_buffer, (num_particles + work_group_size - 1) / work_group_size, 1, 1);
 
 	// Add memory barrier to ensure that the computer shader has finished writing to the buffer
 	VkBufferMemoryBarrier memory_barrier = vkb::initializers::buffer_memory_barrier();
@@ -233,7 +236,7 @@ void ComputeNBody::build_compute_command_buffer()
 	// Second pass: Integrate particles
 	// -------------------------------------------------------------------------------------------------------
 	vkCmdBindPipeline(compute.command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, compute.pipeline_integrate);
-	vkCmdDispatch(compute.command_buffer, num_particles / work_group_size, 1, 1);
+	vkCmdDispatch(compute.command_buffer, (num_particles + work_group_size - 1) / work_group_size, 1, 1);
 
 	// Release
 	if (graphics.queue_family_index != compute.queue_family_index)
@@ -266,62 +269,9 @@ void ComputeNBody::build_compute_command_buffer()
 // Setup and fill the compute shader storage buffers containing the particles
 void ComputeNBody::prepare_storage_buffers()
 {
-#if 0
-	std::vector<glm::vec3> attractors = {
-		glm::vec3(2.5f, 1.5f, 0.0f),
-		glm::vec3(-2.5f, -1.5f, 0.0f),
-	};
-#else
-	std::vector<glm::vec3> attractors = {
-	    glm::vec3(5.0f, 0.0f, 0.0f),
-	    glm::vec3(-5.0f, 0.0f, 0.0f),
-	    glm::vec3(0.0f, 0.0f, 5.0f),
-	    glm::vec3(0.0f, 0.0f, -5.0f),
-	    glm::vec3(0.0f, 4.0f, 0.0f),
-	    glm::vec3(0.0f, -8.0f, 0.0f),
-	};
-#endif
-
-	num_particles = static_cast<uint32_t>(attractors.size()) * PARTICLES_PER_ATTRACTOR;
-
-	// Initial particle positions
-	std::vector<Particle> particle_buffer(num_particles);
-
-	std::default_random_engine      rnd_engine(platform->using_plugin<::plugins::BenchmarkMode>() ? 0 : static_cast<unsigned>(time(nullptr)));
-	std::normal_distribution<float> rnd_distribution(0.0f, 1.0f);
-
-	for (uint32_t i = 0; i < static_cast<uint32_t>(attractors.size()); i++)
-	{
-		for (uint32_t j = 0; j < PARTICLES_PER_ATTRACTOR; j++)
-		{
-			Particle &particle = particle_buffer[i * PARTICLES_PER_ATTRACTOR + j];
+	std::vector<Particle> particle_buffer = create_nbody_particles(PARTICLES_PER_ATTRACTOR, platform->using_plugin<::plugins::BenchmarkMode>() ? 0 : static_cast<uint32_t>(time(nullptr)));
 
-			// First particle in group as heavy center of gravity
-			if (j == 0)
-			{
-				particle.pos = glm::vec4(attractors[i] * 1.5f, 90000.0f);
-				particle.vel = glm::vec4(glm::vec4(0.0f));
-			}
-			else
-			{
-				// Position
-				glm::vec3 position(attractors[i] + glm::vec3(rnd_distribution(rnd_engine), rnd_distribution(rnd_engine), rnd_distribution(rnd_engine)) * 0.75f);
-				float     len = glm::length(glm::normalize(position - attractors[i]));
-				position.y *= 2.0f - (len * len);
-
-				// Velocity
-				glm::vec3 angular  = glm::vec3(0.5f, 1.5f, 0.5f) * (((i % 2) == 0) ? 1.0f : -1.0f);
-				glm::vec3 velocity = glm::cross((position - attractors[i]), angular) + glm::vec3(rnd_distribution(rnd_engine), rnd_distribution(rnd_engine), rnd_distribution(rnd_engine) * 0.025f);
-
-				float mass   = (rnd_distribution(rnd_engine) * 0.5f + 0.5f) * 75.0f;
-				particle.pos = glm::vec4(position, mass);
-				particle.vel = glm::vec4(velocity, 0.0f);
-			}
-
-			// Color gradient offset
-			particle.vel.w = static_cast<float>(i) * 1.0f / static_cast<uint32_t>(attractors.size());
-		}
-	}
+	num_particles = static_cast<uint32_t>(particle_buffer.size());
 
 	compute.ubo.particle_count = num_particles;
 
@@ -608,50 +558,9 @@ void ComputeNBody::prepare_compute()
 	vkUpdateDescriptorSets(get_device().get_handle(), static_cast<uint32_t>(compute_write_descriptor_sets.size()), compute_write_descriptor_sets.data(), 0, NULL);
 
 	// Create pipelines
-	VkComputePipelineCreateInfo compute_pipeline_create_info = vkb::initializers::compute_pipeline_create_info(compute.pipeline_layout, 0);
-
-	// 1st pass - Particle movement calculations
-	compute_pipeline_create_info.stage = load_shader("compute_nbody/particle_calculate.comp", VK_SHADER_STAGE_COMPUTE_BIT);
-
-	// Set some shader parameters via specialization constants
-	struct SpecializationData
-	{
-		uint32_t workgroup_size;
-		uint32_t shared_data_size;
-		float    gravity;
-		float    power;
-		float    soften;
-	} specialization_data;
-
-	std::vector<VkSpecializationMapEntry> specialization_map_entries;
-	specialization_map_entries.push_back(vkb::initializers::specialization_map_entry(0, offsetof(SpecializationData, workgroup_size), sizeof(uint32_t)));
-	specialization_map_entries.push_back(vkb::initializers::specialization_map_entry(1, offsetof(SpecializationData, shared_data_size), sizeof(uint32_t)));
-	specialization_map_entries.push_back(vkb::initializers::specialization_map_entry(2, offsetof(SpecializationData, gravity), sizeof(float)));
-	specialization_map_entries.push_back(vkb::initializers::specialization_map_entry(3, offsetof(SpecializationData, power), sizeof(float)));
-	specialization_map_entries.push_back(vkb::initializers::specialization_map_entry(4, offsetof(SpecializationData, soften), sizeof(float)));
-
-	specialization_data.workgroup_size   = work_group_size;
-	specialization_data.shared_data_size = shared_data_size;
-	specialization_data.gravity          = 0.002f;
-	specialization_data.power            = 0.75f;
-	specialization_data.soften           = 0.05f;
-
-	VkSpecializationInfo specialization_info =
-	    vkb::initializers::specialization_info(static_cast<uint32_t>(specialization_map_entries.size()), specialization_map_entries.data(), sizeof(specialization_data), &specialization_data);
-	compute_pipeline_create_info.stage.pSpecializationInfo = &specialization_info;
-
-	VK_CHECK(vkCreateComputePipelines(get_device().get_handle(), pipeline_cache, 1, &compute_pipeline_create_info, nullptr, &compute.pipeline_calculate));
-
-	// 2nd pass - Particle integration
-	compute_pipeline_create_info.stage = load_shader("compute_nbody/particle_integrate.comp", VK_SHADER_STAGE_COMPUTE_BIT);
-
-	specialization_map_entries.clear();
-	specialization_map_entries.push_back(vkb::initializers::specialization_map_entry(0, 0, sizeof(uint32_t)));
-	specialization_info =
-	    vkb::initializers::specialization_info(1, specialization_map_entries.data(), sizeof(work_group_size), &work_group_size);
-
-	compute_pipeline_create_info.stage.pSpecializationInfo = &specialization_info;
-	VK_CHECK(vkCreateComputePipelines(get_device().get_handle(), pipeline_cache, 1, &compute_pipeline_create_info, nullptr, &compute.pipeline_integrate));
+	compute.shader_calculate = load_shader("compute_nbody/particle_calculate.comp", VK_SHADER_STAGE_COMPUTE_BIT);
+	compute.shader_integrate = load_shader("compute_nbody/particle_integrate.comp", VK_SHADER_STAGE_COMPUTE_BIT);
+	create_compute_pipelines(work_group_size, compute.pipeline_calculate, compute.pipeline_integrate);
 
 	// Separate command pool as queue family for compute may be different than graphics
 	VkCommandPoolCreateInfo command_pool_create_info = {};
@@ -769,6 +678,54 @@ void ComputeNBody::prepare_compute()
 	}
 }
 
+void ComputeNBody::create_compute_pipelines(uint32_t work_group_size, VkPipeline &pipeline_calculate, VkPipeline &pipeline_integrate)
+{
+	VkComputePipelineCreateInfo compute_pipeline_create_info = vkb::initializers::compute_pipeline_create_info(compute.pipeline_layout, 0);
+
+	// 1st pass - Particle movement calculations
+	compute_pipeline_create_info.stage = compute.shader_calculate;
+
+	// Set some shader parameters via specialization constants
+	struct SpecializationData
+	{
+		uint32_t workgroup_size;
+		uint32_t shared_data_size;
+		float    gravity;
+		float    power;
+		float    soften;
+	} specialization_data;
+
+	std::vector<VkSpecializationMapEntry> specialization_map_entries;
+	specialization_map_entries.push_back(vkb::initializers::specialization_map_entry(0, offsetof(SpecializationData, workgroup_size), sizeof(uint32_t)));
+	specialization_map_entries.push_back(vkb::initializers::specialization_map_entry(1, offsetof(SpecializationData, shared_data_size), sizeof(uint32_t)));
+	specialization_map_entries.push_back(vkb::initializers::specialization_map_entry(2, offsetof(SpecializationData, gravity), sizeof(float)));
+	specialization_map_entries.push_back(vkb::initializers::specialization_map_entry(3, offsetof(SpecializationData, power), sizeof(float)));
+	specialization_map_entries.push_back(vkb::initializers::specialization_map_entry(4, offsetof(SpecializationData, soften), sizeof(float)));
+
+	specialization_data.workgroup_size   = work_group_size;
+	specialization_data.shared_data_size = shared_data_size;
+	specialization_data.gravity          = parameters.gravity;
+	specialization_data.power            = parameters.power;
+	specialization_data.soften           = parameters.soften;
+
+	VkSpecializationInfo specialization_info =
+	    vkb::initializers::specialization_info(static_cast<uint32_t>(specialization_map_entries.size()), specialization_map_entries.data(), sizeof(specialization_data), &specialization_data);
+	compute_pipeline_create_info.stage.pSpecializationInfo = &specialization_info;
+
+	VK_CHECK(vkCreateComputePipelines(get_device().get_handle(), pipeline_cache, 1, &compute_pipeline_create_info, nullptr, &pipeline_calculate));
+
+	// 2nd pass - Particle integration
+	compute_pipeline_create_info.stage = compute.shader_integrate;
+
+	specialization_map_entries.clear();
+	specialization_map_entries.push_back(vkb::initializers::specialization_map_entry(0, 0, sizeof(uint32_t)));
+	specialization_info =
+	    vkb::initializers::specialization_info(1, specialization_map_entries.data(), sizeof(work_group_size), &work_group_size);
+
+	compute_pipeline_create_info.stage.pSpecializationInfo = &specialization_info;
+	VK_CHECK(vkCreateComputePipelines(get_device().get_handle(), pipeline_cache, 1, &compute_pipeline_create_info, nullptr, &pipeline_integrate));
+}
+
 // Prepare and initialize uniform buffer containing shader uniforms
 void ComputeNBody::prepare_uniform_buffers()
 {
@@ -837,6 +794,294 @@ void ComputeNBody::draw()
 	VK_CHECK(vkQueueSubmit(compute.queue, 1, &compute_submit_info, VK_NULL_HANDLE));
 }
 
+std::unique_ptr<ComputeNBody::Simulation> ComputeNBody::create_simulation(const std::vector<Particle> &particles, uint32_t work_group_size)
+{
+	auto simulation             = std::make_unique<Simulation>();
+	simulation->particle_count  = static_cast<uint32_t>(particles.size());
+	simulation->work_group_size = work_group_size;
+
+	VkDeviceSize storage_buffer_size = particles.size() * sizeof(Particle);
+
+	simulation->storage_buffer = std::make_unique<vkb::core::Buffer>(get_device(),
+	                                                                 storage_buffer_size,
+	                                                                 VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+	                                                                 VMA_MEMORY_USAGE_GPU_ONLY);
+	simulation->uniform_buffer = std::make_unique<vkb::core::Buffer>(get_device(),
+	                                                                 sizeof(compute.ubo),
+	                                                                 VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+	                                                                 VMA_MEMORY_USAGE_CPU_TO_GPU);
+
+	std::vector<VkDescriptorPoolSize> pool_sizes =
+	    {
+	        vkb::initializers::descriptor_pool_size(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1),
+	        vkb::initializers::descriptor_pool_size(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1)};
+	VkDescriptorPoolCreateInfo descriptor_pool_create_info =
+	    vkb::initializers::descriptor_pool_create_info(
+	        static_cast<uint32_t>(pool_sizes.size()),
+	        pool_sizes.data(),
+	        1);
+	VK_CHECK(vkCreateDescriptorPool(get_device().get_handle(), &descriptor_pool_create_info, nullptr, &simulation->descriptor_pool));
+
+	VkDescriptorSetAllocateInfo alloc_info =
+	    vkb::initializers::descriptor_set_allocate_info(
+	        simulation->descriptor_pool,
+	        &compute.descriptor_set_layout,
+	        1);
+	VK_CHECK(vkAllocateDescriptorSets(get_device().get_handle(), &alloc_info, &simulation->descriptor_set));
+
+	VkDescriptorBufferInfo            storage_buffer_descriptor = create_descriptor(*simulation->storage_buffer);
+	VkDescriptorBufferInfo            uniform_buffer_descriptor = create_descriptor(*simulation->uniform_buffer);
+	std::vector<VkWriteDescriptorSet> write_descriptor_sets =
+	    {
+	        vkb::initializers::write_descriptor_set(simulation->descriptor_set, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 0, &storage_buffer_descriptor),
+	        vkb::initializers::write_descriptor_set(simulation->descriptor_set, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, &uniform_buffer_descriptor)};
+	vkUpdateDescriptorSets(get_device().get_handle(), static_cast<uint32_t>(write_descriptor_sets.size()), write_descriptor_sets.data(), 0, NULL);
+
+	create_compute_pipelines(work_group_size, simulation->pipeline_calculate, simulation->pipeline_integrate);
+
+	VkCommandBufferAllocateInfo command_buffer_allocate_info =
+	    vkb::initializers::command_buffer_allocate_info(
+	        compute.command_pool,
+	        VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+	        1);
+	VK_CHECK(vkAllocateCommandBuffers(get_device().get_handle(), &command_buffer_allocate_info, &simulation->command_buffer));
+
+	VkFenceCreateInfo fence_create_info = vkb::initializers::fence_create_info();
+	VK_CHECK(vkCreateFence(get_device().get_handle(), &fence_create_info, nullptr, &simulation->fence));
+
+	// The simulation only ever runs on the compute queue, so the upload is done there as well and no ownership transfers are needed
+	vkb::core::Buffer staging_buffer{get_device(), storage_buffer_size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_ONLY};
+	staging_buffer.update(reinterpret_cast<const uint8_t *>(particles.data()), static_cast<size_t>(storage_buffer_size));
+
+	begin_simulation_commands(*simulation);
+
+	VkBufferCopy copy_region = {};
+	copy_region.size         = storage_buffer_size;
+	vkCmdCopyBuffer(simulation->command_buffer, staging_buffer.get_handle(), simulation->storage_buffer->get_handle(), 1, &copy_region);
+
+	VkMemoryBarrier memory_barrier = vkb::initializers::memory_barrier();
+	memory_barrier.srcAccessMask   = VK_ACCESS_TRANSFER_WRITE_BIT;
+	memory_barrier.dstAccessMask   = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+	vkCmdPipelineBarrier(simulation->command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, nullptr, 0, nullptr);
+
+	submit_simulation_commands(*simulation);
+
+	return simulation;
+}
+
+void ComputeNBody::destroy_simulation(Simulation &simulation)
+{
+	vkDestroyFence(get_device().get_handle(), simulation.fence, nullptr);
+	vkFreeCommandBuffers(get_device().get_handle(), compute.command_pool, 1, &simulation.command_buffer);
+	vkDestroyPipeline(get_device().get_handle(), simulation.pipeline_calculate, nullptr);
+	vkDestroyPipeline(get_device().get_handle(), simulation.pipeline_integrate, nullptr);
+	vkDestroyDescriptorPool(get_device().get_handle(), simulation.descriptor_pool, nullptr);
+	simulation.storage_buffer.reset();
+	simulation.uniform_buffer.reset();
+}
+
+void ComputeNBody::begin_simulation_commands(Simulation &simulation)
+{
+	VkCommandBufferBeginInfo command_buffer_begin_info = vkb::initializers::command_buffer_begin_info();
+	command_buffer_begin_info.flags                    = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+	VK_CHECK(vkBeginCommandBuffer(simulation.command_buffer, &command_buffer_begin_info));
+}
+
+void ComputeNBody::submit_simulation_commands(Simulation &simulation)
+{
+	VK_CHECK(vkEndCommandBuffer(simulation.command_buffer));
+
+	VkSubmitInfo submit_info       = vkb::initializers::submit_info();
+	submit_info.commandBufferCount = 1;
+	submit_info.pCommandBuffers    = &simulation.command_buffer;
+	VK_CHECK(vkQueueSubmit(compute.queue, 1, &submit_info, simulation.fence));
+
+	VK_CHECK(vkWaitForFences(get_device().get_handle(), 1, &simulation.fence, VK_TRUE, DEFAULT_FENCE_TIMEOUT));
+	VK_CHECK(vkResetFences(get_device().get_handle(), 1, &simulation.fence));
+}
+
+// Runs all steps in a single submission and returns the time it took in seconds
+double ComputeNBody::run_simulation(Simulation &simulation, uint32_t steps, float delta_time)
+{
+	decltype(compute.ubo) ubo;
+	ubo.delta_time     = delta_time;
+	ubo.particle_count = static_cast<int32_t>(simulation.particle_count);
+	simulation.uniform_buffer->convert_and_update(ubo);
+
+	const uint32_t group_count = (simulation.particle_count + simulation.work_group_size - 1) / simulation.work_group_size;
+
+	// Each pass reads what the previous one wrote
+	VkMemoryBarrier memory_barrier = vkb::initializers::memory_barrier();
+	memory_barrier.srcAccessMask   = VK_ACCESS_SHADER_WRITE_BIT;
+	memory_barrier.dstAccessMask   = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+	begin_simulation_commands(simulation);
+
+	vkCmdBindDescriptorSets(simulation.command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, compute.pipeline_layout, 0, 1, &simulation.descriptor_set, 0, nullptr);
+	for (uint32_t step = 0; step < steps; ++step)
+	{
+		vkCmdBindPipeline(simulation.command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, simulation.pipeline_calculate);
+		vkCmdDispatch(simulation.command_buffer, group_count, 1, 1);
+		vkCmdPipelineBarrier(simulation.command_buffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, nullptr, 0, nullptr);
+
+		vkCmdBindPipeline(simulation.command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, simulation.pipeline_integrate);
+		vkCmdDispatch(simulation.command_buffer, group_count, 1, 1);
+		vkCmdPipelineBarrier(simulation.command_buffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, nullptr, 0, nullptr);
+	}
+
+	vkb::Timer timer;
+	timer.start();
+	submit_simulation_commands(simulation);
+	return timer.stop();
+}
+
+std::vector<ComputeNBody::Particle> ComputeNBody::read_simulation_particles(Simulation &simulation)
+{
+	VkDeviceSize      size = simulation.storage_buffer->get_size();
+	vkb::core::Buffer readback_buffer{get_device(), size, VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_GPU_TO_CPU};
+
+	begin_simulation_commands(simulation);
+
+	VkMemoryBarrier memory_barrier = vkb::initializers::memory_barrier();
+	memory_barrier.srcAccessMask   = VK_ACCESS_SHADER_WRITE_BIT;
+	memory_barrier.dstAccessMask   = VK_ACCESS_TRANSFER_READ_BIT;
+	vkCmdPipelineBarrier(simulation.command_buffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &memory_barrier, 0, nullptr, 0, nullptr);
+
+	VkBufferCopy copy_region = {};
+	copy_region.size         = size;
+	vkCmdCopyBuffer(simulation.command_buffer, simulation.storage_buffer->get_handle(), readback_buffer.get_handle(), 1, &copy_region);
+
+	memory_barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	memory_barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+	vkCmdPipelineBarrier(simulation.command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &memory_barrier, 0, nullptr, 0, nullptr);
+
+	submit_simulation_commands(simulation);
+
+	std::vector<Particle> particles(simulation.particle_count);
+	readback_buffer.map();
+	vmaInvalidateAllocation(get_device().get_memory_allocator(), readback_buffer.get_allocation(), 0, VK_WHOLE_SIZE);
+	memcpy(particles.data(), readback_buffer.get_data(), static_cast<size_t>(size));
+	readback_buffer.unmap();
+
+	return particles;
+}
+
+// Runs the particle system on the GPU and on the CPU from the same initial state and compares the positions
+bool ComputeNBody::validate_simulation(uint32_t steps, float tolerance)
+{
+	const float delta_time = 1.0f / 60.0f;
+
+	std::vector<Particle> particles = create_nbody_particles(PARTICLES_PER_ATTRACTOR, 0);
+
+	LOGI("Validating {} steps of {} particles (work group size {}, shared data size {})", steps, particles.size(), work_group_size, shared_data_size);
+
+	auto simulation = create_simulation(particles, work_group_size);
+	run_simulation(*simulation, steps, delta_time);
+	std::vector<Particle> gpu_particles = read_simulation_particles(*simulation);
+	destroy_simulation(*simulation);
+
+	NBodyReference direct_sum(particles, parameters);
+	NBodyReference barnes_hut(particles, parameters);
+	barnes_hut.set_method(NBodyReference::Method::BarnesHut);
+
+	vkb::Timer timer;
+	timer.start();
+	for (uint32_t step = 0; step < steps; ++step)
+	{
+		direct_sum.step(delta_time);
+	}
+	double direct_sum_time = timer.stop();
+
+	timer.start();
+	for (uint32_t step = 0; step < steps; ++step)
+	{
+		barnes_hut.step(delta_time);
+	}
+	double barnes_hut_time = timer.stop();
+
+	// Largest distance between the positions of matching particles
+	auto get_max_error = [](const std::vector<Particle> &lhs, const std::vector<Particle> &rhs) {
+		float max_error = 0.0f;
+		for (size_t i = 0; i < lhs.size(); ++i)
+		{
+			max_error = std::max(max_error, glm::length(glm::vec3(lhs[i].pos) - glm::vec3(rhs[i].pos)));
+		}
+		return max_error;
+	};
+
+	float gpu_error        = get_max_error(gpu_particles, direct_sum.get_particles());
+	float barnes_hut_error = get_max_error(barnes_hut.get_particles(), direct_sum.get_particles());
+
+	LOGI("CPU direct sum: {:.2f} steps/s, Barnes-Hut: {:.2f} steps/s (max error {})", steps / direct_sum_time, steps / barnes_hut_time, barnes_hut_error);
+
+	if (gpu_error > tolerance)
+	{
+		LOGE("Validation failed: max GPU position error {} exceeds tolerance {}", gpu_error, tolerance);
+		return false;
+	}
+
+	LOGI("Validation passed: max GPU position error {} within tolerance {}", gpu_error, tolerance);
+	return true;
+}
+
+// Measures the GPU simulation rate for a range of particle counts and work group sizes, with the CPU reference for comparison
+void ComputeNBody::run_scaling_sweep(uint32_t steps)
+{
+	const float delta_time = 1.0f / 60.0f;
+
+	const auto &limits = get_device().get_gpu().get_properties().limits;
+
+	std::ofstream csv(vkb::fs::path::get(vkb::fs::path::Type::Logs, "compute_nbody_sweep.csv"), std::ios::out | std::ios::trunc);
+	csv << "device,method,particles,work_group_size,steps_per_second\n";
+
+	LOGI("{:>8} {:>16} {:>10} {:>10} {:>12}", "device", "method", "particles", "group size", "steps/s");
+
+	for (uint32_t particles_per_attractor : {256u, 512u, 1024u, 2048u, 4096u, 8192u})
+	{
+		std::vector<Particle> particles = create_nbody_particles(particles_per_attractor, 0);
+
+		for (uint32_t group_size : {32u, 64u, 128u, 256u, 512u, 1024u})
+		{
+			if (group_size > limits.maxComputeWorkGroupSize[0] || group_size > limits.maxComputeWorkGroupInvocations)
+			{
+				continue;
+			}
+
+			auto simulation = create_simulation(particles, group_size);
+
+			// The first submission includes one-off driver work
+			run_simulation(*simulation, 1, delta_time);
+			double steps_per_second = steps / run_simulation(*simulation, steps, delta_time);
+
+			destroy_simulation(*simulation);
+
+			LOGI("{:>8} {:>16} {:>10} {:>10} {:>12.2f}", "gpu", "shared_memory", particles.size(), group_size, steps_per_second);
+			csv << "gpu,shared_memory," << particles.size() << "," << group_size << "," << steps_per_second << "\n";
+		}
+
+		for (auto method : {NBodyReference::Method::DirectSum, NBodyReference::Method::BarnesHut})
+		{
+			NBodyReference reference(particles, parameters);
+			reference.set_method(method);
+
+			// Timed over as many steps as the GPU, so that both rates average the same amount of work
+			vkb::Timer timer;
+			timer.start();
+			for (uint32_t step = 0; step < steps; ++step)
+			{
+				reference.step(delta_time);
+			}
+			double steps_per_second = steps / timer.stop();
+
+			const char *name = method == NBodyReference::Method::DirectSum ? "direct_sum" : "barnes_hut";
+			LOGI("{:>8} {:>16} {:>10} {:>10} {:>12.2f}", "cpu", name, particles.size(), "-", steps_per_second);
+			csv << "cpu," << name << "," << particles.size() << ",0," << steps_per_second << "\n";
+		}
+	}
+
+	LOGI("Sweep results written to {}", vkb::fs::path::get(vkb::fs::path::Type::Logs, "compute_nbody_sweep.csv"));
+}
+
 bool ComputeNBody::prepare(vkb::Platform &platform)
 {
 	if (!ApiVulkanSample::prepare(platform))
@@ -858,6 +1103,30 @@ bool ComputeNBody::prepare(vkb::Platform &platform)
 	prepare_compute();
 	build_command_buffers();
 	prepared = true;
+
+	// Headless modes that exit once they are done: --option nbody_validate=<steps> and --option nbody_sweep
+	if (platform.using_plugin<::plugins::SampleOptions>())
+	{
+		auto *options = platform.get_plugin<::plugins::SampleOptions>();
+		bool  passed  = true;
+
+		if (options->contains("nbody_validate"))
+		{
+			passed = validate_simulation(options->get<uint32_t>("nbody_validate", 10), options->get<float>("nbody_tolerance", 1e-3f));
+		}
+		if (options->contains("nbody_sweep"))
+		{
+			run_scaling_sweep(options->get<uint32_t>("nbody_sweep_steps", 20));
+		}
+		if (options->contains("nbody_validate") || options->contains("nbody_sweep"))
+		{
+			platform.close();
+		}
+
+		// Fails the run so that scripts can check the validation result
+		return passed;
+	}
+
 	return true;
 }
 
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2021, Sascha Willems
+/* Copyright (c) 2019-2023, Sascha Willems
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -22,6 +22,7 @@
 #pragma once
 
 #include "api_vulkan_sample.h"
+#include "nbody_reference.h"
 
 #if defined(__ANDROID__)
 // Lower particle count on Android for performance reasons
@@ -37,6 +38,8 @@ class ComputeNBody : public ApiVulkanSample
 	uint32_t work_group_size  = 128;
 	uint32_t shared_data_size = 1024;
 
+	NBodyParameters parameters;
+
 	struct
 	{
 		Texture particle;
@@ -75,6 +78,8 @@ class ComputeNBody : public ApiVulkanSample
 		VkPipelineLayout                   pipeline_layout;              // Layout of the compute pipeline
 		VkPipeline                         pipeline_calculate;           // Compute pipeline for N-Body velocity calculation (1st pass)
 		VkPipeline                         pipeline_integrate;           // Compute pipeline for euler integration (2nd pass)
+		VkPipelineShaderStageCreateInfo    shader_calculate;             // Shader stages kept for creating pipelines with other work group sizes
+		VkPipelineShaderStageCreateInfo    shader_integrate;
 		VkPipeline                         blur;
 		VkPipelineLayout                   pipeline_layout_blur;
 		VkDescriptorSetLayout              descriptor_set_layout_blur;
@@ -87,11 +92,21 @@ class ComputeNBody : public ApiVulkanSample
 		} ubo;
 	} compute;
 
-	// SSBO particle declaration
-	struct Particle
+	using Particle = NBodyParticle;
+
+	// Standalone compute resources for the validation and scaling runs, independent of the rendered particle system
+	struct Simulation
 	{
-		glm::vec4 pos;        // xyz = position, w = mass
-		glm::vec4 vel;        // xyz = velocity, w = gradient texture position
+		uint32_t                           particle_count;
+		uint32_t                           work_group_size;
+		std::unique_ptr<vkb::core::Buffer> storage_buffer;
+		std::unique_ptr<vkb::core::Buffer> uniform_buffer;
+		VkDescriptorPool                   descriptor_pool;
+		VkDescriptorSet                    descriptor_set;
+		VkPipeline                         pipeline_calculate;
+		VkPipeline                         pipeline_integrate;
+		VkCommandBuffer                    command_buffer;
+		VkFence                            fence;
 	};
 
 	ComputeNBody();
@@ -107,10 +122,21 @@ class ComputeNBody : public ApiVulkanSample
 	void         prepare_pipelines();
 	void         prepare_graphics();
 	void         prepare_compute();
+	void         create_compute_pipelines(uint32_t work_group_size, VkPipeline &pipeline_calculate, VkPipeline &pipeline_integrate);
 	void         prepare_uniform_buffers();
 	void         update_compute_uniform_buffers(float delta_time);
 	void         update_graphics_uniform_buffers();
 	void         draw();
+
+	std::unique_ptr<Simulation> create_simulation(const std::vector<Particle> &particles, uint32_t work_group_size);
+	void                        destroy_simulation(Simulation &simulation);
+	void                        begin_simulation_commands(Simulation &simulation);
+	void                        submit_simulation_commands(Simulation &simulation);
+	double                      run_simulation(Simulation &simulation, uint32_t steps, float delta_time);
+	std::vector<Particle>       read_simulation_particles(Simulation &simulation);
+	bool                        validate_simulation(uint32_t steps, float tolerance);
+	void                        run_scaling_sweep(uint32_t steps);
+
 	bool         prepare(vkb::Platform &platform) override;
 	virtual void render(float delta_time) override;
 	virtual bool resize(const uint32_t width, const uint32_t height) override;
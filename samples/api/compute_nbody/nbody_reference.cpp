@@ -0,0 +1,315 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Multithreaded CPU reference for the compute shader N-body simulation
+ */
+
+#include "nbody_reference.h"
+
+#include <array>
+#include <numeric>
+#include <random>
+
+#include "common/helpers.h"
+
+namespace
+{
+// Octree cells with at most this many particles are not subdivided further
+constexpr uint32_t LEAF_SIZE = 8;
+
+// Limits the subdivision of particles that share the same position
+constexpr uint32_t MAX_DEPTH = 32;
+}        // namespace
+
+std::vector<NBodyParticle> create_nbody_particles(uint32_t particles_per_attractor, uint32_t seed)
+{
+	std::vector<glm::vec3> attractors = {
+	    glm::vec3(5.0f, 0.0f, 0.0f),
+	    glm::vec3(-5.0f, 0.0f, 0.0f),
+	    glm::vec3(0.0f, 0.0f, 5.0f),
+	    glm::vec3(0.0f, 0.0f, -5.0f),
+	    glm::vec3(0.0f, 4.0f, 0.0f),
+	    glm::vec3(0.0f, -8.0f, 0.0f),
+	};
+
+	std::vector<NBodyParticle> particles(attractors.size() * particles_per_attractor);
+
+	std::default_random_engine      rnd_engine(seed);
+	std::normal_distribution<float> rnd_distribution(0.0f, 1.0f);
+
+	for (uint32_t i = 0; i < static_cast<uint32_t>(attractors.size()); i++)
+	{
+		for (uint32_t j = 0; j < particles_per_attractor; j++)
+		{
+			NBodyParticle &particle = particles[i * particles_per_attractor + j];
+
+			// First particle in group as heavy center of gravity
+			if (j == 0)
+			{
+				particle.pos = glm::vec4(attractors[i] * 1.5f, 90000.0f);
+				particle.vel = glm::vec4(glm::vec4(0.0f));
+			}
+			else
+			{
+				// Position
+				glm::vec3 position(attractors[i] + glm::vec3(rnd_distribution(rnd_engine), rnd_distribution(rnd_engine), rnd_distribution(rnd_engine)) * 0.75f);
+				float     len = glm::length(glm::normalize(position - attractors[i]));
+				position.y *= 2.0f - (len * len);
+
+				// Velocity
+				glm::vec3 angular  = glm::vec3(0.5f, 1.5f, 0.5f) * (((i % 2) == 0) ? 1.0f : -1.0f);
+				glm::vec3 velocity = glm::cross((position - attractors[i]), angular) + glm::vec3(rnd_distribution(rnd_engine), rnd_distribution(rnd_engine), rnd_distribution(rnd_engine) * 0.025f);
+
+				float mass   = (rnd_distribution(rnd_engine) * 0.5f + 0.5f) * 75.0f;
+				particle.pos = glm::vec4(position, mass);
+				particle.vel = glm::vec4(velocity, 0.0f);
+			}
+
+			// Color gradient offset
+			particle.vel.w = static_cast<float>(i) * 1.0f / static_cast<uint32_t>(attractors.size());
+		}
+	}
+
+	return particles;
+}
+
+NBodyReference::NBodyReference(const std::vector<NBodyParticle> &particles, const NBodyParameters &parameters, size_t thread_count) :
+    particles{particles},
+    parameters{parameters},
+    accelerations(particles.size()),
+    thread_pool{static_cast<int>(std::max<size_t>(thread_count, 1))}
+{
+}
+
+void NBodyReference::set_method(Method method)
+{
+	this->method = method;
+}
+
+void NBodyReference::set_theta(float theta)
+{
+	this->theta = theta;
+}
+
+const std::vector<NBodyParticle> &NBodyReference::get_particles() const
+{
+	return particles;
+}
+
+void NBodyReference::step(float delta_time)
+{
+	if (particles.empty())
+	{
+		return;
+	}
+
+	if (method == Method::BarnesHut)
+	{
+		build_tree();
+	}
+
+	// Calculate pass, the particles are split into one contiguous range per thread
+	const uint32_t particle_count = vkb::to_u32(particles.size());
+	const uint32_t thread_count   = static_cast<uint32_t>(thread_pool.size());
+	const uint32_t range_size     = (particle_count + thread_count - 1) / thread_count;
+
+	std::vector<std::future<void>> futures;
+	for (uint32_t begin = 0; begin < particle_count; begin += range_size)
+	{
+		uint32_t end = std::min(begin + range_size, particle_count);
+
+		futures.push_back(thread_pool.push([this, begin, end](size_t thread_index) {
+			std::vector<uint32_t> stack;
+			for (uint32_t i = begin; i < end; ++i)
+			{
+				glm::vec3 position = glm::vec3(particles[i].pos);
+				accelerations[i]   = method == Method::BarnesHut ? get_barnes_hut_acceleration(position, stack) : get_direct_sum_acceleration(position);
+			}
+		}));
+	}
+
+	for (auto &future : futures)
+	{
+		future.get();
+	}
+
+	// Velocity update of particle_calculate.comp followed by particle_integrate.comp, with the shaders' order of operations
+	for (uint32_t i = 0; i < particle_count; ++i)
+	{
+		NBodyParticle &particle = particles[i];
+
+		particle.vel = glm::vec4(glm::vec3(particle.vel) + delta_time * parameters.time_factor * accelerations[i], particle.vel.w);
+
+		// Gradient texture position
+		particle.vel.w += 0.1f * parameters.time_factor * delta_time;
+		if (particle.vel.w > 1.0f)
+		{
+			particle.vel.w -= 1.0f;
+		}
+
+		// The shader integrates all four components, so the mass drifts with the gradient position
+		particle.pos += delta_time * parameters.time_factor * particle.vel;
+	}
+}
+
+glm::vec3 NBodyReference::get_attraction(const glm::vec3 &position, const glm::vec3 &other, float mass) const
+{
+	glm::vec3 len = other - position;
+	return parameters.gravity * len * mass / std::pow(glm::dot(len, len) + parameters.soften, parameters.power);
+}
+
+glm::vec3 NBodyReference::get_direct_sum_acceleration(const glm::vec3 &position) const
+{
+	glm::vec3 acceleration(0.0f);
+
+	for (auto &other : particles)
+	{
+		acceleration += get_attraction(position, glm::vec3(other.pos), other.pos.w);
+	}
+
+	return acceleration;
+}
+
+glm::vec3 NBodyReference::get_barnes_hut_acceleration(const glm::vec3 &position, std::vector<uint32_t> &stack) const
+{
+	glm::vec3 acceleration(0.0f);
+
+	stack.clear();
+	stack.push_back(0);
+
+	while (!stack.empty())
+	{
+		const Node &node = nodes[stack.back()];
+		stack.pop_back();
+
+		if (node.child_count == 0)
+		{
+			for (uint32_t i = node.begin; i < node.end; ++i)
+			{
+				const NBodyParticle &other = particles[indices[i]];
+				acceleration += get_attraction(position, glm::vec3(other.pos), other.pos.w);
+			}
+			continue;
+		}
+
+		// Masses can be negative, cells where they mostly cancel out have no meaningful center of mass and are always opened
+		glm::vec3 offset = node.center_of_mass - position;
+		if (node.size * node.size < theta * theta * glm::dot(offset, offset) && std::abs(node.mass) >= 0.5f * node.absolute_mass)
+		{
+			acceleration += get_attraction(position, node.center_of_mass, node.mass);
+		}
+		else
+		{
+			for (uint32_t i = 0; i < node.child_count; ++i)
+			{
+				stack.push_back(node.first_child + i);
+			}
+		}
+	}
+
+	return acceleration;
+}
+
+void NBodyReference::build_tree()
+{
+	glm::vec3 min_bounds(std::numeric_limits<float>::max());
+	glm::vec3 max_bounds(std::numeric_limits<float>::lowest());
+	for (auto &particle : particles)
+	{
+		min_bounds = glm::min(min_bounds, glm::vec3(particle.pos));
+		max_bounds = glm::max(max_bounds, glm::vec3(particle.pos));
+	}
+
+	indices.resize(particles.size());
+	std::iota(indices.begin(), indices.end(), 0);
+
+	nodes.clear();
+	nodes.push_back({});
+	nodes[0].end = vkb::to_u32(indices.size());
+
+	glm::vec3 extent = max_bounds - min_bounds;
+	build_node(0, 0.5f * (min_bounds + max_bounds), std::max(extent.x, std::max(extent.y, extent.z)), 0);
+}
+
+void NBodyReference::build_node(uint32_t node_index, const glm::vec3 &center, float size, uint32_t depth)
+{
+	const uint32_t begin = nodes[node_index].begin;
+	const uint32_t end   = nodes[node_index].end;
+
+	glm::vec3 weighted_position(0.0f);
+	float     mass          = 0.0f;
+	float     absolute_mass = 0.0f;
+	for (uint32_t i = begin; i < end; ++i)
+	{
+		const glm::vec4 &position = particles[indices[i]].pos;
+		weighted_position += glm::vec3(position) * position.w;
+		mass += position.w;
+		absolute_mass += std::abs(position.w);
+	}
+
+	Node &node          = nodes[node_index];
+	node.center_of_mass = mass != 0.0f ? weighted_position / mass : center;
+	node.mass           = mass;
+	node.absolute_mass  = absolute_mass;
+	node.size           = size;
+
+	if (end - begin <= LEAF_SIZE || depth >= MAX_DEPTH)
+	{
+		return;
+	}
+
+	// Sort the indices by octant, bit 0, 1 and 2 of the octant are set when x, y and z are above the center
+	auto below = [this, &center](uint32_t axis) {
+		return [this, &center, axis](uint32_t index) { return particles[index].pos[axis] < center[axis]; };
+	};
+
+	std::array<std::vector<uint32_t>::iterator, 9> bounds;
+	bounds[0] = indices.begin() + begin;
+	bounds[8] = indices.begin() + end;
+	bounds[4] = std::partition(bounds[0], bounds[8], below(2));
+	bounds[2] = std::partition(bounds[0], bounds[4], below(1));
+	bounds[6] = std::partition(bounds[4], bounds[8], below(1));
+	for (uint32_t octant = 0; octant < 8; octant += 2)
+	{
+		bounds[octant + 1] = std::partition(bounds[octant], bounds[octant + 2], below(0));
+	}
+
+	// Children of a node are stored next to each other
+	const uint32_t        first_child = vkb::to_u32(nodes.size());
+	std::vector<uint32_t> octants;
+	for (uint32_t octant = 0; octant < 8; ++octant)
+	{
+		if (bounds[octant] != bounds[octant + 1])
+		{
+			Node child{};
+			child.begin = static_cast<uint32_t>(bounds[octant] - indices.begin());
+			child.end   = static_cast<uint32_t>(bounds[octant + 1] - indices.begin());
+			nodes.push_back(child);
+			octants.push_back(octant);
+		}
+	}
+
+	nodes[node_index].first_child = first_child;
+	nodes[node_index].child_count = vkb::to_u32(octants.size());
+
+	for (uint32_t i = 0; i < vkb::to_u32(octants.size()); ++i)
+	{
+		glm::vec3 direction((octants[i] & 1) ? 1.0f : -1.0f, (octants[i] & 2) ? 1.0f : -1.0f, (octants[i] & 4) ? 1.0f : -1.0f);
+		build_node(first_child + i, center + direction * 0.25f * size, 0.5f * size, depth + 1);
+	}
+}
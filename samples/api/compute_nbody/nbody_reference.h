@@ -0,0 +1,119 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Multithreaded CPU reference for the compute shader N-body simulation
+ */
+
+#pragma once
+
+#include <ctpl_stl.h>
+
+#include "common/glm_common.h"
+
+// SSBO particle declaration
+struct NBodyParticle
+{
+	glm::vec4 pos;        // xyz = position, w = mass
+	glm::vec4 vel;        // xyz = velocity, w = gradient texture position
+};
+
+// Simulation constants, the force constants are passed to particle_calculate.comp as specialization constants
+struct NBodyParameters
+{
+	float gravity     = 0.002f;
+	float power       = 0.75f;
+	float soften      = 0.05f;
+	float time_factor = 0.05f;        // Must match TIME_FACTOR in the compute shaders
+};
+
+/**
+ * @brief Generates the initial particle set: one heavy center of gravity and a rotating cloud per attractor
+ * @param particles_per_attractor Number of particles around each of the attractors
+ * @param seed Seed for the random engine, the same seed gives the same particles on every run
+ */
+std::vector<NBodyParticle> create_nbody_particles(uint32_t particles_per_attractor, uint32_t seed);
+
+/**
+ * @brief Integrates the particles on the CPU with the same force law and update order as the compute shaders,
+ *        so that the GPU results can be checked against it
+ */
+class NBodyReference
+{
+  public:
+	enum class Method
+	{
+		DirectSum,        // O(n²), sums the particles in the same order as the shader
+		BarnesHut         // O(n log n), approximates distant groups of particles by their center of mass
+	};
+
+	NBodyReference(const std::vector<NBodyParticle> &particles, const NBodyParameters &parameters = {}, size_t thread_count = std::thread::hardware_concurrency());
+
+	void set_method(Method method);
+
+	/**
+	 * @brief Sets the Barnes-Hut opening angle, a cell is approximated when its size divided by its distance is below theta
+	 */
+	void set_theta(float theta);
+
+	/**
+	 * @brief Advances the simulation by one step, equivalent to one dispatch of both compute passes
+	 */
+	void step(float delta_time);
+
+	const std::vector<NBodyParticle> &get_particles() const;
+
+  private:
+	// Octree cell, leaves reference a range of the sorted particle indices
+	struct Node
+	{
+		glm::vec3 center_of_mass;
+		float     mass;
+		float     absolute_mass;
+		float     size;
+		uint32_t  first_child;
+		uint32_t  child_count;
+		uint32_t  begin;
+		uint32_t  end;
+	};
+
+	void build_tree();
+
+	void build_node(uint32_t node_index, const glm::vec3 &center, float size, uint32_t depth);
+
+	glm::vec3 get_attraction(const glm::vec3 &position, const glm::vec3 &other, float mass) const;
+
+	glm::vec3 get_direct_sum_acceleration(const glm::vec3 &position) const;
+
+	glm::vec3 get_barnes_hut_acceleration(const glm::vec3 &position, std::vector<uint32_t> &stack) const;
+
+	std::vector<NBodyParticle> particles;
+
+	NBodyParameters parameters;
+
+	Method method{Method::DirectSum};
+
+	float theta{0.5f};
+
+	std::vector<Node> nodes;
+
+	std::vector<uint32_t> indices;
+
+	std::vector<glm::vec3> accelerations;
+
+	ctpl::thread_pool thread_pool;
+};
@@ -21,8 +21,6 @@
 
 #include "terrain_tessellation.h"
 
-#include "heightmap.h"
-
 TerrainTessellation::TerrainTessellation()
 {
 	title = "Dynamic terrain tessellation";
@@ -251,8 +249,17 @@ void TerrainTessellation::build_command_buffers()
 		vkCmdBindPipeline(draw_cmd_buffers[i], VK_PIPELINE_BIND_POINT_GRAPHICS, wireframe ? pipelines.wireframe : pipelines.terrain);
 		vkCmdBindDescriptorSets(draw_cmd_buffers[i], VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_layouts.terrain, 0, 1, &descriptor_sets.terrain, 0, NULL);
 		vkCmdBindVertexBuffers(draw_cmd_buffers[i], 0, 1, terrain.vertices->get(), offsets);
-		vkCmdBindIndexBuffer(draw_cmd_buffers[i], terrain.indices->get_handle(), 0, VK_INDEX_TYPE_UINT32);
-		vkCmdDrawIndexed(draw_cmd_buffers[i], terrain.index_count, 1, 0, 0, 0);
+		if (quadtree_lod)
+		{
+			// The patches are selected on the CPU every frame, so the draw reads its index count from a buffer
+			vkCmdBindIndexBuffer(draw_cmd_buffers[i], lod.indices->get_handle(), 0, VK_INDEX_TYPE_UINT32);
+			vkCmdDrawIndexedIndirect(draw_cmd_buffers[i], lod.indirect_command->get_handle(), 0, 1, sizeof(VkDrawIndexedIndirectCommand));
+		}
+		else
+		{
+			vkCmdBindIndexBuffer(draw_cmd_buffers[i], terrain.indices->get_handle(), 0, VK_INDEX_TYPE_UINT32);
+			vkCmdDrawIndexed(draw_cmd_buffers[i], terrain.index_count, 1, 0, 0, 0);
+		}
 		if (get_device().get_gpu().get_features().pipelineStatisticsQuery)
 		{
 			// End pipeline statistics query
@@ -290,8 +297,11 @@ void TerrainTessellation::generate_terrain()
 		}
 	}
 
+	terrain.patch_size   = patch_size;
+	terrain.patch_extent = wx;
+
 	// Calculate normals from height map using a sobel filter
-	vkb::HeightMap heightmap("textures/terrain_heightmap_r16.ktx", patch_size);
+	lod.heightmap = std::make_unique<vkb::HeightMap>("textures/terrain_heightmap_r16.ktx", patch_size);
 	for (auto x = 0; x < patch_size; x++)
 	{
 		for (auto y = 0; y < patch_size; y++)
@@ -302,7 +312,7 @@ void TerrainTessellation::generate_terrain()
 			{
 				for (auto hy = -1; hy <= 1; hy++)
 				{
-					heights[hx + 1][hy + 1] = heightmap.get_height(x + hx, y + hy);
+					heights[hx + 1][hy + 1] = lod.heightmap->get_height(x + hx, y + hy);
 				}
 			}
 
@@ -402,6 +412,74 @@ void TerrainTessellation::generate_terrain()
 
 	delete[] vertices;
 	delete[] indices;
+
+	// The quadtree selects at most every patch of the grid
+	lod.indices          = std::make_unique<vkb::core::Buffer>(get_device(),
+	                                                           index_buffer_size,
+	                                                           VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+	                                                           VMA_MEMORY_USAGE_CPU_TO_GPU);
+	lod.indirect_command = std::make_unique<vkb::core::Buffer>(get_device(),
+	                                                           sizeof(VkDrawIndexedIndirectCommand),
+	                                                           VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+	                                                           VMA_MEMORY_USAGE_CPU_TO_GPU);
+	lod.index_data.reserve(index_count);
+	update_lod_patches();
+}
+
+// Fills the index buffer with the patches of the quadtree nodes selected for the current camera
+void TerrainTessellation::update_lod_patches()
+{
+	const uint32_t cell_count      = terrain.patch_size - 1;
+	const uint32_t texels_per_cell = lod.heightmap->get_dimension() / terrain.patch_size;
+
+	// Vertex x of the grid samples the heightmap at x / patch_size, the center of texel x * texels_per_cell - 0.5
+	const float first_vertex = 0.5f * terrain.patch_extent * (1.0f - static_cast<float>(terrain.patch_size));
+
+	vkb::HeightMap::LodSettings settings;
+	settings.scale        = glm::vec3(terrain.patch_extent / texels_per_cell, -ubo_tess.displacement_factor, terrain.patch_extent / texels_per_cell);
+	settings.origin       = glm::vec3(first_vertex + 0.5f * settings.scale.x, 0.0f, first_vertex + 0.5f * settings.scale.z);
+	settings.leaf_size    = texels_per_cell * lod.node_cells;
+	settings.lod_distance = lod.lod_distance;
+
+	glm::vec3 camera_position = glm::vec3(glm::inverse(camera.matrices.view)[3]);
+
+	std::vector<vkb::HeightMap::Node> nodes = lod.heightmap->select_nodes(camera_position, settings, &frustum);
+
+	// Every node is drawn with the same number of patches, the nodes on the far edges can reach past the grid
+	lod.index_data.clear();
+	for (auto &node : nodes)
+	{
+		const uint32_t first_x    = node.offset.x / texels_per_cell;
+		const uint32_t first_y    = node.offset.y / texels_per_cell;
+		const uint32_t node_size  = node.size / texels_per_cell;
+		const uint32_t patch_step = std::max(node_size / lod.node_cells, 1u);
+
+		for (uint32_t y = first_y; y < std::min(first_y + node_size, cell_count); y += patch_step)
+		{
+			for (uint32_t x = first_x; x < std::min(first_x + node_size, cell_count); x += patch_step)
+			{
+				const uint32_t next_x = std::min(x + patch_step, cell_count);
+				const uint32_t next_y = std::min(y + patch_step, cell_count);
+				lod.index_data.push_back(x + y * terrain.patch_size);
+				lod.index_data.push_back(x + next_y * terrain.patch_size);
+				lod.index_data.push_back(next_x + next_y * terrain.patch_size);
+				lod.index_data.push_back(next_x + y * terrain.patch_size);
+			}
+		}
+	}
+
+	lod.node_count  = static_cast<uint32_t>(nodes.size());
+	lod.patch_count = static_cast<uint32_t>(lod.index_data.size() / 4);
+
+	VkDrawIndexedIndirectCommand command{};
+	command.indexCount    = static_cast<uint32_t>(lod.index_data.size());
+	command.instanceCount = 1;
+
+	if (!lod.index_data.empty())
+	{
+		lod.indices->update(lod.index_data.data(), lod.index_data.size() * sizeof(uint32_t));
+	}
+	lod.indirect_command->convert_and_update(command);
 }
 
 void TerrainTessellation::setup_descriptor_pool()
@@ -710,6 +788,12 @@ void TerrainTessellation::draw()
 {
 	ApiVulkanSample::prepare_frame();
 
+	// The previous frame has finished, as submit_frame waits for the queue to be idle
+	if (quadtree_lod)
+	{
+		update_lod_patches();
+	}
+
 	// Command buffer to be sumitted to the queue
 	submit_info.commandBufferCount = 1;
 	submit_info.pCommandBuffers    = &draw_cmd_buffers[current_buffer];
@@ -782,6 +866,15 @@ void TerrainTessellation::on_update_ui_overlay(vkb::Drawer &drawer)
 		{
 			update_uniform_buffers();
 		}
+		if (drawer.checkbox("Quadtree LOD", &quadtree_lod))
+		{
+			build_command_buffers();
+		}
+		if (quadtree_lod)
+		{
+			drawer.input_float("LOD distance", &lod.lod_distance, 1.0f, 1);
+			drawer.text("Nodes: %d, patches: %d", lod.node_count, lod.patch_count);
+		}
 		if (get_device().get_gpu().get_features().fillModeNonSolid)
 		{
 			if (drawer.checkbox("Wireframe", &wireframe))
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2020, Sascha Willems
+/* Copyright (c) 2019-2023, Sascha Willems
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -24,12 +24,14 @@
 #include "api_vulkan_sample.h"
 #include "core/buffer.h"
 #include "geometry/frustum.h"
+#include "heightmap.h"
 
 class TerrainTessellation : public ApiVulkanSample
 {
   public:
 	bool wireframe    = false;
 	bool tessellation = true;
+	bool quadtree_lod = false;
 
 	struct
 	{
@@ -52,8 +54,23 @@ class TerrainTessellation : public ApiVulkanSample
 		std::unique_ptr<vkb::core::Buffer> vertices;
 		std::unique_ptr<vkb::core::Buffer> indices;
 		uint32_t                           index_count;
+		uint32_t                           patch_size;          // Number of vertices along each side of the grid
+		float                              patch_extent;        // World space size of a grid cell
 	} terrain;
 
+	// Patches of the grid selected from a quadtree over the heightmap, updated every frame
+	struct
+	{
+		std::unique_ptr<vkb::HeightMap>    heightmap;
+		std::unique_ptr<vkb::core::Buffer> indices;
+		std::unique_ptr<vkb::core::Buffer> indirect_command;
+		std::vector<uint32_t>              index_data;
+		uint32_t                           node_cells   = 4;        // Grid cells along each side of a node, larger nodes get larger patches
+		float                              lod_distance = 24.0f;
+		uint32_t                           node_count   = 0;
+		uint32_t                           patch_count  = 0;
+	} lod;
+
 	struct
 	{
 		std::unique_ptr<vkb::core::Buffer> terrain_tessellation;
@@ -125,6 +142,7 @@ class TerrainTessellation : public ApiVulkanSample
 	void         load_assets();
 	void         build_command_buffers() override;
 	void         generate_terrain();
+	void         update_lod_patches();
 	void         setup_descriptor_pool();
 	void         setup_descriptor_set_layouts();
 	void         setup_descriptor_sets();
@@ -17,6 +17,69 @@
 
 #include "patch_control_points.h"
 
+#include "timer.h"
+
+/* Same value as in the shaders, so the CPU and GPU levels match */
+static constexpr float PI = 3.14159f;
+
+/* Flags of tess_factors.comp */
+static constexpr uint32_t FRUSTUM_CULLING = 0x1;
+static constexpr uint32_t FACE_CULLING    = 0x2;
+
+/* Duration in seconds of the camera path used to compare fixed and adaptive tessellation */
+static constexpr float camera_path_duration = 10.0f;
+
+/* Same transform as tess.vert */
+static glm::vec3 get_world_position(const glm::vec3 &position, const glm::vec3 &direction)
+{
+	glm::mat4 rot_x(1.0f);
+	rot_x[1][1] = std::cos(PI);
+	rot_x[1][2] = std::sin(PI);
+	rot_x[2][1] = -std::sin(PI);
+	rot_x[2][2] = std::cos(PI);
+	return glm::vec3(rot_x * glm::vec4(position + direction, 1.0f));
+}
+
+/* Level at which the segments of an edge are target_edge_pixels long on screen */
+static float get_edge_level(const glm::vec3 &p0, const glm::vec3 &p1, const glm::mat4 &view, float projection_scale, float target_edge_pixels, float max_level)
+{
+	const glm::vec4 center = view * glm::vec4(0.5f * (p0 + p1), 1.0f);
+	const float     pixels = glm::distance(p0, p1) * projection_scale / std::max(std::abs(center.z), 0.0001f);
+	return glm::clamp(pixels / target_edge_pixels, 1.0f, max_level);
+}
+
+static bool is_patch_culled(const std::array<glm::vec4, 3> &clip, uint32_t flags)
+{
+	if (flags & FRUSTUM_CULLING)
+	{
+		const auto all_of = [&clip](auto predicate) {
+			return predicate(clip[0]) && predicate(clip[1]) && predicate(clip[2]);
+		};
+
+		if (all_of([](const glm::vec4 &c) { return c.x < -c.w; }) || all_of([](const glm::vec4 &c) { return c.x > c.w; }) ||
+		    all_of([](const glm::vec4 &c) { return c.y < -c.w; }) || all_of([](const glm::vec4 &c) { return c.y > c.w; }) ||
+		    all_of([](const glm::vec4 &c) { return c.w <= 0.0f; }))
+		{
+			return true;
+		}
+	}
+
+	if ((flags & FACE_CULLING) && clip[0].w > 0.0f && clip[1].w > 0.0f && clip[2].w > 0.0f)
+	{
+		const glm::vec2 a = glm::vec2(clip[0]) / clip[0].w;
+		const glm::vec2 b = glm::vec2(clip[1]) / clip[1].w;
+		const glm::vec2 c = glm::vec2(clip[2]) / clip[2].w;
+
+		/* The pipeline culls front faces with a counter-clockwise front face, which are the ones with a negative cross product here */
+		if ((b.x - a.x) * (c.y - a.y) - (c.x - a.x) * (b.y - a.y) < 0.0f)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
 PatchControlPoints::PatchControlPoints()
 {
 	title = "Patch Control Points";
@@ -43,7 +106,18 @@ PatchControlPoints::~PatchControlPoints()
 		vkDestroyDescriptorSetLayout(get_device().get_handle(), descriptor_set_layouts.dynamic_tessellation, VK_NULL_HANDLE);
 		vkDestroyDescriptorSetLayout(get_device().get_handle(), descriptor_set_layouts.static_tessellation, VK_NULL_HANDLE);
 
+		vkDestroyPipeline(get_device().get_handle(), factor_compute.pipeline, VK_NULL_HANDLE);
+		vkDestroyPipelineLayout(get_device().get_handle(), factor_compute.pipeline_layout, VK_NULL_HANDLE);
+		vkDestroyDescriptorSetLayout(get_device().get_handle(), factor_compute.descriptor_set_layout, VK_NULL_HANDLE);
+
 		vkDestroyDescriptorPool(get_device().get_handle(), descriptor_pool, VK_NULL_HANDLE);
+
+		if (query_pool != VK_NULL_HANDLE)
+		{
+			vkDestroyQueryPool(get_device().get_handle(), query_pool, VK_NULL_HANDLE);
+		}
+
+		patches.factor_buffer.reset();
 	}
 }
 
@@ -63,6 +137,8 @@ bool PatchControlPoints::prepare(vkb::Platform &platform)
 	camera.set_perspective(60.0f, static_cast<float>(width) / static_cast<float>(height), 256.0f, 0.1f);
 
 	load_assets();
+	load_patches();
+	create_query_pool();
 	prepare_uniform_buffers();
 	create_descriptor_pool();
 	setup_descriptor_set_layout();
@@ -79,7 +155,197 @@ bool PatchControlPoints::prepare(vkb::Platform &platform)
  */
 void PatchControlPoints::load_assets()
 {
-	model = load_model("scenes/terrain/terrain.gltf");
+	/* The mesh is also read by tess_factors.comp, and once by the CPU in load_patches() */
+	model = load_model("scenes/terrain/terrain.gltf", 0, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+}
+
+/**
+ * 	@fn void PatchControlPoints::load_patches()
+ *	@brief Reading back the patch corners of the model for the CPU computation of tessellation levels
+ */
+void PatchControlPoints::load_patches()
+{
+	auto &vertex_buffer = model->vertex_buffers.at("vertex_buffer");
+	auto &index_buffer  = *model->index_buffer;
+
+	vkb::core::Buffer vertex_staging{get_device(), vertex_buffer.get_size(), VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_GPU_TO_CPU};
+	vkb::core::Buffer index_staging{get_device(), index_buffer.get_size(), VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_GPU_TO_CPU};
+
+	with_command_buffer([&](VkCommandBuffer command_buffer) {
+		VkBufferCopy copy_region{0, 0, vertex_buffer.get_size()};
+		vkCmdCopyBuffer(command_buffer, vertex_buffer.get_handle(), vertex_staging.get_handle(), 1, &copy_region);
+
+		copy_region.size = index_buffer.get_size();
+		vkCmdCopyBuffer(command_buffer, index_buffer.get_handle(), index_staging.get_handle(), 1, &copy_region);
+	});
+
+	/* The loader always uses 32 bit indices */
+	const auto *vertices = reinterpret_cast<const Vertex *>(vertex_staging.map());
+	const auto *indices  = reinterpret_cast<const uint32_t *>(index_staging.map());
+
+	patches.count = model->vertex_indices / 3;
+	patches.positions.resize(patches.count * 3);
+	for (uint32_t i = 0; i < patches.count * 3; i++)
+	{
+		patches.positions[i] = vertices[indices[i]].pos;
+	}
+
+	vertex_staging.unmap();
+	index_staging.unmap();
+
+	/* Levels of the first model, followed by the levels of the second one */
+	patches.factors.assign(directions.size() * patches.count, glm::vec4(1.0f));
+	patches.factor_buffer = std::make_unique<vkb::core::Buffer>(get_device(),
+	                                                            patches.factors.size() * sizeof(glm::vec4),
+	                                                            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+	                                                            VMA_MEMORY_USAGE_CPU_TO_GPU);
+	patches.factor_buffer->update(reinterpret_cast<const uint8_t *>(patches.factors.data()), patches.factors.size() * sizeof(glm::vec4));
+}
+
+/**
+ * 	@fn void PatchControlPoints::update_patch_factors()
+ *	@brief Computing per-patch tessellation levels from the projected edge lengths, with culled patches set to zero
+ *	@note tess_factors.comp implements the same computation on the GPU
+ */
+void PatchControlPoints::update_patch_factors()
+{
+	vkb::Timer timer;
+	timer.start();
+
+	const glm::mat4 &view             = camera.matrices.view;
+	const glm::mat4  view_projection  = camera.matrices.perspective * view;
+	const float      projection_scale = std::abs(camera.matrices.perspective[1][1]) * 0.5f * static_cast<float>(height);
+	const uint32_t   flags            = (gui_settings.frustum_culling ? FRUSTUM_CULLING : 0) | (gui_settings.face_culling ? FACE_CULLING : 0);
+
+	patches.culled = 0;
+
+	for (size_t model_index = 0; model_index < directions.size(); model_index++)
+	{
+		for (uint32_t i = 0; i < patches.count; i++)
+		{
+			std::array<glm::vec3, 3> world;
+			std::array<glm::vec4, 3> clip;
+			for (uint32_t corner = 0; corner < 3; corner++)
+			{
+				world[corner] = get_world_position(patches.positions[i * 3 + corner], directions[model_index]);
+				clip[corner]  = view_projection * glm::vec4(world[corner], 1.0f);
+			}
+
+			auto &levels = patches.factors[model_index * patches.count + i];
+
+			if (is_patch_culled(clip, flags))
+			{
+				levels = glm::vec4(0.0f);
+				patches.culled++;
+				continue;
+			}
+
+			/* Outer level i belongs to the edge opposite to vertex i, so shared edges get the same level in both patches */
+			levels.x = get_edge_level(world[1], world[2], view, projection_scale, gui_settings.target_edge_pixels, ubo_tess.tessellation_level);
+			levels.y = get_edge_level(world[2], world[0], view, projection_scale, gui_settings.target_edge_pixels, ubo_tess.tessellation_level);
+			levels.z = get_edge_level(world[0], world[1], view, projection_scale, gui_settings.target_edge_pixels, ubo_tess.tessellation_level);
+			levels.w = std::max(levels.x, std::max(levels.y, levels.z));
+		}
+	}
+
+	patches.factor_buffer->update(reinterpret_cast<const uint8_t *>(patches.factors.data()), patches.factors.size() * sizeof(glm::vec4));
+
+	patches.update_time = static_cast<float>(timer.stop<vkb::Timer::Milliseconds>());
+}
+
+/**
+ * 	@fn void PatchControlPoints::create_query_pool()
+ *	@brief Creating a pipeline statistics query per command buffer to count the primitives generated by the tessellator
+ */
+void PatchControlPoints::create_query_pool()
+{
+	if (!get_device().get_gpu().get_features().pipelineStatisticsQuery)
+	{
+		return;
+	}
+
+	VkQueryPoolCreateInfo query_pool_info{VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO};
+	query_pool_info.queryType          = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+	query_pool_info.pipelineStatistics = VK_QUERY_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS_BIT;
+	query_pool_info.queryCount         = static_cast<uint32_t>(draw_cmd_buffers.size());
+	VK_CHECK(vkCreateQueryPool(get_device().get_handle(), &query_pool_info, VK_NULL_HANDLE, &query_pool));
+}
+
+/**
+ * 	@fn void PatchControlPoints::get_query_results()
+ *	@brief Reading the primitive count of the frame that was just submitted
+ */
+void PatchControlPoints::get_query_results()
+{
+	/* The queue is idle after submit_frame(), so the result is available */
+	vkGetQueryPoolResults(get_device().get_handle(),
+	                      query_pool,
+	                      current_buffer,
+	                      1,
+	                      sizeof(generated_primitives),
+	                      &generated_primitives,
+	                      sizeof(uint64_t),
+	                      VK_QUERY_RESULT_64_BIT);
+}
+
+/**
+ * 	@fn void PatchControlPoints::update_camera_path(float time)
+ *	@brief Moving the camera along a closed path that pulls back from the models and pans across them
+ */
+void PatchControlPoints::update_camera_path(float time)
+{
+	const float angle = glm::two_pi<float>() * time / camera_path_duration;
+	camera.set_position({-1.25f + 1.5f * std::sin(angle), -0.75f, 1.5f + (1.0f - std::cos(angle))});
+	camera.set_rotation({0.0f, 30.0f * std::sin(angle), 0.0f});
+}
+
+/**
+ * 	@fn void PatchControlPoints::update_comparison(float delta_time)
+ *	@brief Recording frame times and primitive counts of fixed, then adaptive tessellation along the camera path
+ */
+void PatchControlPoints::update_comparison(float delta_time)
+{
+	if (!comparison.running)
+	{
+		return;
+	}
+
+	auto &result = comparison.results[comparison.adaptive ? 1 : 0];
+	result.frames++;
+	result.frame_time += delta_time;
+	result.primitives += static_cast<double>(generated_primitives);
+
+	comparison.time += delta_time;
+	if (comparison.time < camera_path_duration)
+	{
+		update_camera_path(comparison.time);
+		return;
+	}
+
+	comparison.time = 0.0f;
+	update_camera_path(0.0f);
+
+	if (!comparison.adaptive)
+	{
+		comparison.adaptive   = true;
+		gui_settings.adaptive = true;
+	}
+	else
+	{
+		comparison.running    = false;
+		gui_settings.adaptive = comparison.user_adaptive;
+
+		const char *names[] = {"fixed", "adaptive"};
+		for (size_t i = 0; i < comparison.results.size(); i++)
+		{
+			const auto &mode_result = comparison.results[i];
+			LOGI("Patch control points, {} tessellation: {:.3f} ms per frame, {:.0f} primitives per frame over {} frames",
+			     names[i], 1000.0 * mode_result.frame_time / mode_result.frames, mode_result.primitives / mode_result.frames, mode_result.frames);
+		}
+	}
+
+	update_uniform_buffers();
+	build_command_buffers();
 }
 
 /**
@@ -106,6 +372,11 @@ void PatchControlPoints::render(float delta_time)
 		return;
 	}
 	draw();
+	if (query_pool != VK_NULL_HANDLE)
+	{
+		get_query_results();
+	}
+	update_comparison(delta_time);
 	if (camera.updated)
 	{
 		update_uniform_buffers();
@@ -144,19 +415,27 @@ void PatchControlPoints::update_uniform_buffers()
 	ubo_common.view       = camera.matrices.view;
 	uniform_buffers.common->convert_and_update(ubo_common);
 
-	/* Tessellation uniform buffer */
+	/* Tessellation uniform buffer, the level is the maximum level in adaptive mode */
 	ubo_tess.tessellation_level = gui_settings.tess_level;
 	if (!gui_settings.tessellation)
 	{
 		// Setting the tessellation level to 1.0 in the shader
 		ubo_tess.tessellation_level = 1.0f;
 	}
+	ubo_tess.adaptive = gui_settings.adaptive ? 1 : 0;
 
-	/* Dynamically tessellation */
+	/* Dynamically tessellation, drawing the second model */
+	ubo_tess.patch_offset = patches.count;
 	uniform_buffers.dynamic_tessellation->convert_and_update(ubo_tess);
 
-	/* Statically tessellation */
+	/* Statically tessellation, drawing the first model */
+	ubo_tess.patch_offset = 0;
 	uniform_buffers.static_tessellation->convert_and_update(ubo_tess);
+
+	if (gui_settings.adaptive && !gui_settings.gpu_factors)
+	{
+		update_patch_factors();
+	}
 }
 
 /**s
@@ -288,6 +567,12 @@ void PatchControlPoints::create_pipelines()
 	dynamic_state.dynamicStateCount = static_cast<uint32_t>(dynamic_state_enables.size());
 
 	VK_CHECK(vkCreateGraphicsPipelines(get_device().get_handle(), pipeline_cache, 1, &graphics_create, VK_NULL_HANDLE, &pipeline.dynamic_tessellation));
+
+	/* Compute pipeline writing the per-patch tessellation levels */
+	VkComputePipelineCreateInfo compute_create = vkb::initializers::compute_pipeline_create_info(factor_compute.pipeline_layout);
+	compute_create.stage                       = load_shader("patch_control_points/tess_factors.comp", VK_SHADER_STAGE_COMPUTE_BIT);
+
+	VK_CHECK(vkCreateComputePipelines(get_device().get_handle(), pipeline_cache, 1, &compute_create, VK_NULL_HANDLE, &factor_compute.pipeline));
 }
 
 /**
@@ -302,9 +587,6 @@ void PatchControlPoints::build_command_buffers()
 	clear_values[0].color        = {{0.0f, 0.0f, 0.0f, 0.0f}};
 	clear_values[1].depthStencil = {0.0f, 0};
 
-	const std::array<glm::vec3, 2> directions = {glm::vec3(2.5f, -1.0f, 3.0f),  /* first model */
-	                                             glm::vec3(0.0f, -1.0f, 3.0f)}; /* second model */
-
 	constexpr uint32_t patch_control_points = 3;
 
 	int i = -1; /* Required for accessing element in framebuffers vector */
@@ -314,6 +596,50 @@ void PatchControlPoints::build_command_buffers()
 		auto command_begin = vkb::initializers::command_buffer_begin_info();
 		VK_CHECK(vkBeginCommandBuffer(draw_cmd_buffer, &command_begin));
 
+		if (query_pool != VK_NULL_HANDLE)
+		{
+			vkCmdResetQueryPool(draw_cmd_buffer, query_pool, i, 1);
+		}
+
+		/* Computing the per-patch tessellation levels of both models before they are drawn */
+		if (gui_settings.adaptive && gui_settings.gpu_factors)
+		{
+			vkCmdBindPipeline(draw_cmd_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, factor_compute.pipeline);
+			vkCmdBindDescriptorSets(draw_cmd_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, factor_compute.pipeline_layout, 0, 1, &factor_compute.descriptor_set, 0, nullptr);
+
+			FactorPushConstants push_constants{};
+			push_constants.viewport           = glm::vec2(static_cast<float>(width), static_cast<float>(height));
+			push_constants.target_edge_pixels = gui_settings.target_edge_pixels;
+			push_constants.max_level          = ubo_tess.tessellation_level;
+			push_constants.patch_count        = patches.count;
+			push_constants.vertex_stride      = sizeof(Vertex) / sizeof(float);
+			push_constants.flags              = (gui_settings.frustum_culling ? FRUSTUM_CULLING : 0) | (gui_settings.face_culling ? FACE_CULLING : 0);
+
+			for (uint32_t model_index = 0; model_index < static_cast<uint32_t>(directions.size()); model_index++)
+			{
+				push_constants.direction    = glm::vec4(directions[model_index], 0.0f);
+				push_constants.patch_offset = model_index * patches.count;
+				vkCmdPushConstants(draw_cmd_buffer, factor_compute.pipeline_layout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push_constants), &push_constants);
+				vkCmdDispatch(draw_cmd_buffer, (patches.count + 63) / 64, 1, 1);
+			}
+
+			VkBufferMemoryBarrier barrier = vkb::initializers::buffer_memory_barrier();
+			barrier.srcAccessMask         = VK_ACCESS_SHADER_WRITE_BIT;
+			barrier.dstAccessMask         = VK_ACCESS_SHADER_READ_BIT;
+			barrier.buffer                = patches.factor_buffer->get_handle();
+			barrier.size                  = VK_WHOLE_SIZE;
+			vkCmdPipelineBarrier(draw_cmd_buffer,
+			                     VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+			                     VK_PIPELINE_STAGE_TESSELLATION_CONTROL_SHADER_BIT,
+			                     0,
+			                     0,
+			                     nullptr,
+			                     1,
+			                     &barrier,
+			                     0,
+			                     nullptr);
+		}
+
 		VkRenderPassBeginInfo render_pass_begin_info    = vkb::initializers::render_pass_begin_info();
 		render_pass_begin_info.renderPass               = render_pass;
 		render_pass_begin_info.framebuffer              = framebuffers[i];
@@ -330,6 +656,11 @@ void PatchControlPoints::build_command_buffers()
 		VkRect2D scissor = vkb::initializers::rect2D(static_cast<int>(width), static_cast<int>(height), 0, 0);
 		vkCmdSetScissor(draw_cmd_buffer, 0, 1, &scissor);
 
+		if (query_pool != VK_NULL_HANDLE)
+		{
+			vkCmdBeginQuery(draw_cmd_buffer, query_pool, i, 0);
+		}
+
 		vkCmdBindDescriptorSets(draw_cmd_buffer,
 		                        VK_PIPELINE_BIND_POINT_GRAPHICS,
 		                        pipeline_layouts.static_tessellation,
@@ -375,6 +706,11 @@ void PatchControlPoints::build_command_buffers()
 
 		draw_model(model, draw_cmd_buffer);
 
+		if (query_pool != VK_NULL_HANDLE)
+		{
+			vkCmdEndQuery(draw_cmd_buffer, query_pool, i);
+		}
+
 		/* UI */
 		draw_ui(draw_cmd_buffer);
 
@@ -391,14 +727,15 @@ void PatchControlPoints::build_command_buffers()
 void PatchControlPoints::create_descriptor_pool()
 {
 	std::vector<VkDescriptorPoolSize> pool_sizes = {
-	    vkb::initializers::descriptor_pool_size(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 4),
+	    vkb::initializers::descriptor_pool_size(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 5),
+	    vkb::initializers::descriptor_pool_size(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 5),
 	};
 
 	VkDescriptorPoolCreateInfo descriptor_pool_create_info =
 	    vkb::initializers::descriptor_pool_create_info(
 	        static_cast<uint32_t>(pool_sizes.size()),
 	        pool_sizes.data(),
-	        2);
+	        3);
 
 	VK_CHECK(vkCreateDescriptorPool(get_device().get_handle(),
 	                                &descriptor_pool_create_info,
@@ -422,6 +759,10 @@ void PatchControlPoints::setup_descriptor_set_layout()
 	        VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
 	        VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT,
 	        1),
+	    vkb::initializers::descriptor_set_layout_binding(
+	        VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+	        VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT,
+	        2),
 	};
 
 	VkDescriptorSetLayoutCreateInfo descriptor_layout_create_info =
@@ -460,6 +801,10 @@ void PatchControlPoints::setup_descriptor_set_layout()
 	        VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
 	        VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT,
 	        1),
+	    vkb::initializers::descriptor_set_layout_binding(
+	        VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+	        VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT,
+	        2),
 	};
 
 	descriptor_layout_create_info.pBindings    = set_layout_bindings.data();
@@ -476,6 +821,34 @@ void PatchControlPoints::setup_descriptor_set_layout()
 	                                &pipeline_layout_create_info,
 	                                nullptr,
 	                                &pipeline_layouts.dynamic_tessellation));
+
+	/* Descriptor set of the tessellation level compute shader */
+	set_layout_bindings = {
+	    vkb::initializers::descriptor_set_layout_binding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, 0),
+	    vkb::initializers::descriptor_set_layout_binding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, 1),
+	    vkb::initializers::descriptor_set_layout_binding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, 2),
+	    vkb::initializers::descriptor_set_layout_binding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, 3),
+	};
+
+	descriptor_layout_create_info.pBindings    = set_layout_bindings.data();
+	descriptor_layout_create_info.bindingCount = static_cast<uint32_t>(set_layout_bindings.size());
+
+	VK_CHECK(vkCreateDescriptorSetLayout(get_device().get_handle(),
+	                                     &descriptor_layout_create_info,
+	                                     nullptr,
+	                                     &factor_compute.descriptor_set_layout));
+
+	VkPushConstantRange factor_push_constant_range = vkb::initializers::push_constant_range(VK_SHADER_STAGE_COMPUTE_BIT,
+	                                                                                        sizeof(FactorPushConstants),
+	                                                                                        0);
+
+	pipeline_layout_create_info.pSetLayouts         = &factor_compute.descriptor_set_layout;
+	pipeline_layout_create_info.pPushConstantRanges = &factor_push_constant_range;
+
+	VK_CHECK(vkCreatePipelineLayout(get_device().get_handle(),
+	                                &pipeline_layout_create_info,
+	                                nullptr,
+	                                &factor_compute.pipeline_layout));
 }
 
 /**
@@ -497,6 +870,7 @@ void PatchControlPoints::create_descriptor_sets()
 
 	VkDescriptorBufferInfo matrix_common_buffer_descriptor = create_descriptor(*uniform_buffers.common);
 	VkDescriptorBufferInfo matrix_tess_buffer_descriptor   = create_descriptor(*uniform_buffers.static_tessellation);
+	VkDescriptorBufferInfo patch_factors_descriptor        = create_descriptor(*patches.factor_buffer);
 
 	std::vector<VkWriteDescriptorSet> write_descriptor_sets = {
 	    vkb::initializers::write_descriptor_set(
@@ -508,7 +882,12 @@ void PatchControlPoints::create_descriptor_sets()
 	        descriptor_sets.static_tessellation,
 	        VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
 	        1,
-	        &matrix_tess_buffer_descriptor)};
+	        &matrix_tess_buffer_descriptor),
+	    vkb::initializers::write_descriptor_set(
+	        descriptor_sets.static_tessellation,
+	        VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+	        2,
+	        &patch_factors_descriptor)};
 
 	vkUpdateDescriptorSets(get_device().get_handle(), static_cast<uint32_t>(write_descriptor_sets.size()),
 	                       write_descriptor_sets.data(), 0, VK_NULL_HANDLE);
@@ -534,7 +913,36 @@ void PatchControlPoints::create_descriptor_sets()
 	        descriptor_sets.dynamic_tessellation,
 	        VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
 	        1,
-	        &matrix_tess_buffer_descriptor)};
+	        &matrix_tess_buffer_descriptor),
+	    vkb::initializers::write_descriptor_set(
+	        descriptor_sets.dynamic_tessellation,
+	        VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+	        2,
+	        &patch_factors_descriptor)};
+
+	vkUpdateDescriptorSets(get_device().get_handle(),
+	                       static_cast<uint32_t>(write_descriptor_sets.size()),
+	                       write_descriptor_sets.data(),
+	                       0,
+	                       VK_NULL_HANDLE);
+
+	/* Tessellation level compute descriptor set */
+	alloc_info =
+	    vkb::initializers::descriptor_set_allocate_info(
+	        descriptor_pool,
+	        &factor_compute.descriptor_set_layout,
+	        1);
+
+	VK_CHECK(vkAllocateDescriptorSets(get_device().get_handle(), &alloc_info, &factor_compute.descriptor_set));
+
+	VkDescriptorBufferInfo vertex_buffer_descriptor = create_descriptor(model->vertex_buffers.at("vertex_buffer"));
+	VkDescriptorBufferInfo index_buffer_descriptor  = create_descriptor(*model->index_buffer);
+
+	write_descriptor_sets = {
+	    vkb::initializers::write_descriptor_set(factor_compute.descriptor_set, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 0, &matrix_common_buffer_descriptor),
+	    vkb::initializers::write_descriptor_set(factor_compute.descriptor_set, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, &vertex_buffer_descriptor),
+	    vkb::initializers::write_descriptor_set(factor_compute.descriptor_set, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2, &index_buffer_descriptor),
+	    vkb::initializers::write_descriptor_set(factor_compute.descriptor_set, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 3, &patch_factors_descriptor)};
 
 	vkUpdateDescriptorSets(get_device().get_handle(),
 	                       static_cast<uint32_t>(write_descriptor_sets.size()),
@@ -580,6 +988,12 @@ void PatchControlPoints::request_gpu_features(vkb::PhysicalDevice &gpu)
 	{
 		gpu.get_mutable_requested_features().samplerAnisotropy = true;
 	}
+
+	// Pipeline statistics are used to count generated primitives
+	if (gpu.get_features().pipelineStatisticsQuery)
+	{
+		requested_features.pipelineStatisticsQuery = VK_TRUE;
+	}
 }
 
 /**
@@ -593,12 +1007,76 @@ void PatchControlPoints::on_update_ui_overlay(vkb::Drawer &drawer)
 		if (drawer.checkbox("Tessellation Enable", &gui_settings.tessellation))
 		{
 			update_uniform_buffers();
+			build_command_buffers();
 		}
 
 		/* Maximum tessellation level is set to 7.0 */
 		if (drawer.slider_float("Tessellation level", &gui_settings.tess_level, 3.0f, 7.0f))
 		{
 			update_uniform_buffers();
+			build_command_buffers();
+		}
+
+		/* The mode is driven by the comparison while it runs */
+		if (!comparison.running && drawer.checkbox("Adaptive tessellation", &gui_settings.adaptive))
+		{
+			update_uniform_buffers();
+			build_command_buffers();
+		}
+
+		if (gui_settings.adaptive && !comparison.running)
+		{
+			/* The GPU path reads these settings from push constants recorded in the command buffers */
+			bool changed = drawer.checkbox("Compute levels on GPU", &gui_settings.gpu_factors);
+			changed |= drawer.slider_float("Target edge size (px)", &gui_settings.target_edge_pixels, 4.0f, 64.0f);
+			changed |= drawer.checkbox("Frustum culling", &gui_settings.frustum_culling);
+			changed |= drawer.checkbox("Back-face culling", &gui_settings.face_culling);
+			if (changed)
+			{
+				update_uniform_buffers();
+				build_command_buffers();
+			}
+		}
+	}
+
+	if (drawer.header("Statistics"))
+	{
+		if (query_pool != VK_NULL_HANDLE)
+		{
+			drawer.text("Generated primitives: %llu", static_cast<unsigned long long>(generated_primitives));
+		}
+
+		if (gui_settings.adaptive && !gui_settings.gpu_factors)
+		{
+			drawer.text("Culled patches: %u / %u", patches.culled, static_cast<uint32_t>(patches.factors.size()));
+			drawer.text("Level update: %.3f ms", patches.update_time);
+		}
+
+		if (comparison.running)
+		{
+			drawer.text("Running %s tessellation...", comparison.adaptive ? "adaptive" : "fixed");
+		}
+		else if (drawer.button("Compare fixed and adaptive"))
+		{
+			comparison.running       = true;
+			comparison.adaptive      = false;
+			comparison.time          = 0.0f;
+			comparison.results       = {};
+			comparison.user_adaptive = gui_settings.adaptive;
+			gui_settings.adaptive    = false;
+			update_camera_path(0.0f);
+			update_uniform_buffers();
+			build_command_buffers();
+		}
+
+		const char *names[] = {"Fixed", "Adaptive"};
+		for (size_t i = 0; i < comparison.results.size(); i++)
+		{
+			const auto &result = comparison.results[i];
+			if (result.frames > 0 && !comparison.running)
+			{
+				drawer.text("%s: %.3f ms, %.0f primitives", names[i], 1000.0 * result.frame_time / result.frames, result.primitives / result.frames);
+			}
 		}
 	}
 }
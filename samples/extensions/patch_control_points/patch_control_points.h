@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <string>
 #include <vector>
@@ -29,8 +30,13 @@ class PatchControlPoints : public ApiVulkanSample
   public:
 	struct
 	{
-		bool  tessellation = true;
-		float tess_level   = 3.0f;
+		bool  tessellation       = true;
+		float tess_level         = 3.0f;
+		bool  adaptive           = false;
+		bool  gpu_factors        = false;
+		bool  frustum_culling    = true;
+		bool  face_culling       = true;
+		float target_edge_pixels = 16.0f;
 	} gui_settings;
 
 	/* Buffer used in both pipelines */
@@ -42,9 +48,68 @@ class PatchControlPoints : public ApiVulkanSample
 
 	struct UBOTESS
 	{
-		float tessellation_level = 3.0f;
+		float    tessellation_level = 3.0f;
+		uint32_t adaptive           = 0;
+		uint32_t patch_offset       = 0;
 	} ubo_tess;
 
+	/* Offsets applied in tess.vert to the two drawn models */
+	const std::array<glm::vec3, 2> directions = {glm::vec3(2.5f, -1.0f, 3.0f),  /* first model */
+	                                             glm::vec3(0.0f, -1.0f, 3.0f)}; /* second model */
+
+	/* Per-patch tessellation levels of both models, all zero for culled patches */
+	struct
+	{
+		std::vector<glm::vec3>             positions;        // Three corners per patch, in model space
+		uint32_t                           count{0};
+		std::vector<glm::vec4>             factors;
+		std::unique_ptr<vkb::core::Buffer> factor_buffer;
+		uint32_t                           culled{0};
+		float                              update_time{0.0f};        // CPU time of the last update in ms
+	} patches;
+
+	/* Push constants of tess_factors.comp */
+	struct FactorPushConstants
+	{
+		glm::vec4 direction;
+		glm::vec2 viewport;
+		float     target_edge_pixels;
+		float     max_level;
+		uint32_t  patch_offset;
+		uint32_t  patch_count;
+		uint32_t  vertex_stride;
+		uint32_t  flags;
+	};
+
+	struct
+	{
+		VkDescriptorSetLayout descriptor_set_layout{VK_NULL_HANDLE};
+		VkPipelineLayout      pipeline_layout{VK_NULL_HANDLE};
+		VkDescriptorSet       descriptor_set{VK_NULL_HANDLE};
+		VkPipeline            pipeline{VK_NULL_HANDLE};
+	} factor_compute;
+
+	/* Primitives generated by the tessellator, if pipeline statistics are supported */
+	VkQueryPool query_pool{VK_NULL_HANDLE};
+	uint64_t    generated_primitives{0};
+
+	/* Fixed and adaptive tessellation run over the same camera path */
+	struct ComparisonResult
+	{
+		uint32_t frames{0};
+		double   frame_time{0.0};
+		double   primitives{0.0};
+	};
+
+	struct
+	{
+		bool                            running{false};
+		bool                            adaptive{false};
+		float                           time{0.0f};
+		std::array<ComparisonResult, 2> results{};
+		bool                            user_adaptive{false};
+	} comparison;
+
 	VkDescriptorPool descriptor_pool{VK_NULL_HANDLE};
 
 	struct
@@ -99,6 +164,13 @@ class PatchControlPoints : public ApiVulkanSample
 	void create_pipelines();
 	void draw();
 
+	void load_patches();
+	void update_patch_factors();
+	void create_query_pool();
+	void get_query_results();
+	void update_camera_path(float time);
+	void update_comparison(float delta_time);
+
 	void load_assets();
 	void create_descriptor_pool();
 	void setup_descriptor_set_layout();
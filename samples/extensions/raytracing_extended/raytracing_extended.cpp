@@ -400,9 +400,16 @@ void RaytracingExtended::create_bottom_level_acceleration_structure(bool is_upda
 			    model_buffer.vertex_offset + (model_buffer.is_static ? static_vertex_handle : dynamic_vertex_handle),
 			    model_buffer.index_offset + (model_buffer.is_static ? static_index_handle : dynamic_index_handle));
 		}
-		model_buffer.bottom_level_acceleration_structure->build(queue,
-		                                                        model_buffer.is_static ? VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR : VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_BUILD_BIT_KHR | VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR,
-		                                                        is_update ? VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR : VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR);
+		// Static objects are compacted once, dynamic objects are refitted every frame
+		if (is_update)
+		{
+			acceleration_structure_builder->add_refit(*model_buffer.bottom_level_acceleration_structure);
+		}
+		else
+		{
+			acceleration_structure_builder->add_build(*model_buffer.bottom_level_acceleration_structure,
+			                                          model_buffer.is_static ? VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR | VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR : VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_BUILD_BIT_KHR | VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR);
+		}
 #else
 		VkDeviceOrHostAddressConstKHR vertex_data_device_address{};
 		VkDeviceOrHostAddressConstKHR index_data_device_address{};
@@ -525,6 +532,22 @@ void RaytracingExtended::create_bottom_level_acceleration_structure(bool is_upda
 		bottom_level_acceleration_structure.device_address             = vkGetAccelerationStructureDeviceAddressKHR(device->get_handle(), &acceleration_device_address_info);
 #endif
 	}
+
+#ifdef USE_FRAMEWORK_ACCELERATION_STRUCTURE
+	// All bottom level structures are built with a single submission
+	auto &stats = acceleration_structure_builder->build(queue);
+	if (print_time)
+	{
+		LOGI("BLAS batch: {} builds, {} refits, {:.1f} KiB scratch, {:.3f} ms",
+		     stats.build_count, stats.refit_count, stats.scratch_size / 1024.0, stats.build_time);
+	}
+	if (stats.compaction_count > 0)
+	{
+		LOGI("BLAS compaction: {} structures from {:.1f} KiB to {:.1f} KiB, {:.1f} KiB saved",
+		     stats.compaction_count, stats.uncompacted_size / 1024.0, stats.compacted_size / 1024.0,
+		     (stats.uncompacted_size - stats.compacted_size) / 1024.0);
+	}
+#endif
 }
 
 VkTransformMatrixKHR RaytracingExtended::calculate_rotation(glm::vec3 pt, float scale, bool freeze_z)
@@ -653,7 +676,8 @@ void RaytracingExtended::create_top_level_acceleration_structure(bool print_time
 	{
 		top_level_acceleration_structure->update_instance_geometry(instance_uid, instances_buffer, instances.size());
 	}
-	top_level_acceleration_structure->build(queue);
+	acceleration_structure_builder->add_build(*top_level_acceleration_structure);
+	acceleration_structure_builder->build(queue);
 #else
 	VkDeviceOrHostAddressConstKHR instance_data_device_address{};
 	instance_data_device_address.deviceAddress = get_buffer_device_address(instances_buffer->get_handle());
@@ -818,6 +842,9 @@ void RaytracingExtended::create_scene()
 	create_flame_model();
 	create_static_object_buffers();
 	create_dynamic_object_buffers(0.f);
+#ifdef USE_FRAMEWORK_ACCELERATION_STRUCTURE
+	acceleration_structure_builder = std::make_unique<vkb::core::AccelerationStructureBuilder>(get_device());
+#endif
 	create_bottom_level_acceleration_structure(false);
 #ifdef USE_FRAMEWORK_ACCELERATION_STRUCTURE
 	top_level_acceleration_structure = std::make_unique<vkb::core::AccelerationStructure>(get_device(), VK_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL_KHR);
@@ -1508,7 +1535,7 @@ RaytracingExtended::RaytracingScene::RaytracingScene(vkb::Device &device, const
 					VkDescriptorImageInfo imageInfo;
 					imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 					imageInfo.imageView   = image->get_vk_image_view().get_handle();
-					imageInfo.sampler     = baseTextureIter->second->get_sampler()->vk_sampler.get_handle();
+					imageInfo.sampler     = baseTextureIter->second->get_sampler()->get_vk_sampler().get_handle();
 					imageInfos.push_back(imageInfo);
 				}
 
@@ -1,4 +1,4 @@
-/* Copyright (c) 2021 Holochip Corporation
+/* Copyright (c) 2021-2023 Holochip Corporation
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -26,6 +26,7 @@
 #include "api_vulkan_sample.h"
 #include "glsl_compiler.h"
 #include <core/acceleration_structure.h>
+#include <core/acceleration_structure_builder.h>
 
 class RaytracingExtended : public ApiVulkanSample
 {
@@ -207,7 +208,8 @@ class RaytracingExtended : public ApiVulkanSample
 	Texture                          flame_texture;
 
 #ifdef USE_FRAMEWORK_ACCELERATION_STRUCTURE
-	std::unique_ptr<vkb::core::AccelerationStructure> top_level_acceleration_structure = nullptr;
+	std::unique_ptr<vkb::core::AccelerationStructure>        top_level_acceleration_structure = nullptr;
+	std::unique_ptr<vkb::core::AccelerationStructureBuilder> acceleration_structure_builder   = nullptr;
 #else
 	AccelerationStructureExtended top_level_acceleration_structure;
 #endif
@@ -0,0 +1,321 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "async_postprocessing.h"
+
+#include "common/vk_common.h"
+#include "gltf_loader.h"
+#include "gui.h"
+#include "platform/platform.h"
+#include "rendering/subpasses/forward_subpass.h"
+#include "scene_graph/components/light.h"
+#include "stats/stats.h"
+
+namespace
+{
+/// Number of blur levels of the bloom chain, the first one is half the size of the frame
+constexpr uint32_t bloom_levels = 6;
+
+/// Attachments of the render targets of the swapchain images
+constexpr uint32_t i_swapchain = 0;
+constexpr uint32_t i_depth     = 1;
+constexpr uint32_t i_hdr       = 2;
+
+/// Push constants of the threshold and blur shaders of the async compute sample
+struct BloomPushConstants
+{
+	uint32_t width, height;
+	float    inv_width, inv_height;
+	float    inv_input_width, inv_input_height;
+};
+}        // namespace
+
+AsyncPostprocessing::AsyncPostprocessing()
+{
+	auto &config = get_configuration();
+
+	config.insert<vkb::BoolSetting>(0, async_compute, false);
+	config.insert<vkb::BoolSetting>(1, async_compute, true);
+}
+
+bool AsyncPostprocessing::prepare(vkb::Platform &platform)
+{
+	if (!VulkanSample::prepare(platform))
+	{
+		return false;
+	}
+
+	load_scene("scenes/sponza/Sponza01.gltf");
+
+	// Brighter lights, so that the highlights exceed the bloom threshold
+	for (auto *light : scene->get_components<vkb::sg::Light>())
+	{
+		auto properties = light->get_properties();
+		properties.intensity *= 4.0f;
+		light->set_properties(properties);
+	}
+
+	auto &camera_node = vkb::add_free_camera(*scene, "main_camera", get_render_context().get_surface_extent());
+	camera            = &camera_node.get_component<vkb::sg::Camera>();
+
+	// The scene is rendered to the HDR attachment only
+	vkb::ShaderSource scene_vs("base.vert");
+	vkb::ShaderSource scene_fs("base.frag");
+	auto              scene_subpass = std::make_unique<vkb::ForwardSubpass>(get_render_context(), std::move(scene_vs), std::move(scene_fs), *scene, *camera);
+	scene_subpass->set_output_attachments({i_hdr});
+
+	vkb::RenderPipeline scene_pipeline;
+	scene_pipeline.add_subpass(std::move(scene_subpass));
+	scene_pipeline.set_load_store({{VK_ATTACHMENT_LOAD_OP_DONT_CARE, VK_ATTACHMENT_STORE_OP_DONT_CARE},
+	                               {VK_ATTACHMENT_LOAD_OP_CLEAR, VK_ATTACHMENT_STORE_OP_DONT_CARE},
+	                               {VK_ATTACHMENT_LOAD_OP_CLEAR, VK_ATTACHMENT_STORE_OP_STORE}});
+	set_render_pipeline(std::move(scene_pipeline));
+
+	// A basic bloom: the bright parts of the HDR image are downsampled and blurred, then upsampled again
+	vkb::ShaderSource postprocessing_vs("postprocessing/postprocessing.vert");
+	postprocessing_pipeline = std::make_unique<vkb::PostProcessingPipeline>(get_render_context(), std::move(postprocessing_vs));
+
+	bloom_passes.push_back(&postprocessing_pipeline->add_pass<vkb::PostProcessingComputePass>(vkb::ShaderSource("async_compute/threshold.comp")));
+	for (uint32_t level = 1; level < bloom_levels; level++)
+	{
+		bloom_passes.push_back(&postprocessing_pipeline->add_pass<vkb::PostProcessingComputePass>(vkb::ShaderSource("async_compute/blur_down.comp")));
+	}
+	for (uint32_t level = bloom_levels - 2; level >= 1; level--)
+	{
+		bloom_passes.push_back(&postprocessing_pipeline->add_pass<vkb::PostProcessingComputePass>(vkb::ShaderSource("async_compute/blur_up.comp")));
+	}
+
+	composite_pass = &postprocessing_pipeline->add_pass();
+	composite_pass->add_subpass(vkb::ShaderSource("async_compute/composite.frag"))
+	    .bind_sampled_image("hdr_tex", i_hdr);
+
+	stats->request_stats({vkb::StatIndex::frame_times, vkb::StatIndex::cmd_barriers_issued, vkb::StatIndex::cmd_barriers_skipped});
+	gui = std::make_unique<vkb::Gui>(*this, platform.get_window(), stats.get());
+
+	return true;
+}
+
+void AsyncPostprocessing::prepare_render_context()
+{
+	get_render_context().prepare(1, std::bind(&AsyncPostprocessing::create_render_target, this, std::placeholders::_1));
+}
+
+std::unique_ptr<vkb::RenderTarget> AsyncPostprocessing::create_render_target(vkb::core::Image &&swapchain_image)
+{
+	auto &device = swapchain_image.get_device();
+	auto &extent = swapchain_image.get_extent();
+
+	vkb::core::Image depth_image{device,
+	                             extent,
+	                             vkb::get_suitable_depth_format(device.get_gpu().get_handle()),
+	                             VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT,
+	                             VMA_MEMORY_USAGE_GPU_ONLY};
+
+	// One HDR image per swapchain image, so that the next frame can be rendered while the bloom passes read this one
+	vkb::core::Image hdr_image{device,
+	                           extent,
+	                           VK_FORMAT_R16G16B16A16_SFLOAT,
+	                           VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+	                           VMA_MEMORY_USAGE_GPU_ONLY};
+
+	std::vector<vkb::core::Image> images;
+	images.push_back(std::move(swapchain_image));
+	images.push_back(std::move(depth_image));
+	images.push_back(std::move(hdr_image));
+
+	return std::make_unique<vkb::RenderTarget>(std::move(images));
+}
+
+void AsyncPostprocessing::prepare_bloom_chain(const VkExtent2D &extent)
+{
+	// Only on resize, the previous targets may be used by the frames in flight
+	get_device().wait_idle();
+
+	bloom_targets.clear();
+	for (uint32_t level = 1; level <= bloom_levels; level++)
+	{
+		VkExtent3D level_extent{std::max(1u, extent.width >> level), std::max(1u, extent.height >> level), 1};
+
+		std::vector<vkb::core::Image> images;
+		images.emplace_back(get_device(), level_extent, VK_FORMAT_R16G16B16A16_SFLOAT,
+		                    VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VMA_MEMORY_USAGE_GPU_ONLY);
+		bloom_targets.push_back(std::make_unique<vkb::RenderTarget>(std::move(images)));
+	}
+
+	bloom_extent = extent;
+
+	const auto bind_pass = [](vkb::PostProcessingComputePass &pass, vkb::core::SampledImage &&input, const VkExtent2D &input_extent, vkb::RenderTarget &output) {
+		const auto &output_extent = output.get_extent();
+
+		BloomPushConstants push{};
+		push.width            = output_extent.width;
+		push.height           = output_extent.height;
+		push.inv_width        = 1.0f / static_cast<float>(output_extent.width);
+		push.inv_height       = 1.0f / static_cast<float>(output_extent.height);
+		push.inv_input_width  = 1.0f / static_cast<float>(input_extent.width);
+		push.inv_input_height = 1.0f / static_cast<float>(input_extent.height);
+
+		pass.bind_sampled_image("in_tex", std::move(input))
+		    .bind_storage_image("out_tex", {0, &output})
+		    .set_push_constants(push)
+		    .set_dispatch_size({(output_extent.width + 7) / 8, (output_extent.height + 7) / 8, 1});
+	};
+
+	size_t pass_index = 0;
+
+	// The threshold pass reads the HDR attachment of the render target drawn to
+	bind_pass(*bloom_passes[pass_index++], {i_hdr}, extent, *bloom_targets[0]);
+
+	for (uint32_t level = 1; level < bloom_levels; level++)
+	{
+		bind_pass(*bloom_passes[pass_index++], {0, bloom_targets[level - 1].get()}, bloom_targets[level - 1]->get_extent(), *bloom_targets[level]);
+	}
+
+	for (uint32_t level = bloom_levels - 2; level >= 1; level--)
+	{
+		bind_pass(*bloom_passes[pass_index++], {0, bloom_targets[level + 1].get()}, bloom_targets[level + 1]->get_extent(), *bloom_targets[level]);
+	}
+
+	composite_pass->get_subpass(0).bind_sampled_image("bloom_tex", {0, bloom_targets[1].get()});
+}
+
+void AsyncPostprocessing::update(float delta_time)
+{
+	if (async_compute != last_async_compute)
+	{
+		for (auto *pass : bloom_passes)
+		{
+			pass->set_async_compute(async_compute);
+		}
+
+		last_async_compute = async_compute;
+	}
+
+	auto &average = average_frame_time[async_compute ? 1 : 0];
+	average       = average == 0.0f ? delta_time : glm::mix(average, delta_time, 0.05f);
+
+	// As VulkanSample::update, but the frame is submitted in several command buffers when the bloom passes are async.
+	// It is not sampled, as the queries of the stats cannot span several command buffers
+	get_render_context().pace_frame();
+
+	update_scene(delta_time);
+
+	update_gui(delta_time);
+
+	auto &command_buffer = get_render_context().begin();
+
+	auto &render_target = get_render_context().get_active_frame().get_render_target();
+	if (render_target.get_extent().width != bloom_extent.width || render_target.get_extent().height != bloom_extent.height)
+	{
+		prepare_bloom_chain(render_target.get_extent());
+	}
+
+	// Collect the performance data for the sample graphs
+	update_stats(delta_time);
+
+	command_buffer.begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+
+	auto &last_command_buffer = record(command_buffer, render_target);
+
+	last_command_buffer.end();
+
+	get_render_context().submit(last_command_buffer);
+
+	platform->on_post_draw(get_render_context());
+}
+
+vkb::CommandBuffer &AsyncPostprocessing::record(vkb::CommandBuffer &command_buffer, vkb::RenderTarget &render_target)
+{
+	auto &views = render_target.get_views();
+
+	// The barriers are computed from the state the images track, and recorded together
+	vkb::ImageUsage color_usage{VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT};
+	vkb::ImageUsage depth_usage{VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+	                            VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+	                            VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT};
+
+	command_buffer.image_usage_barriers({{&views[i_swapchain], color_usage},
+	                                     {&views[i_hdr], color_usage},
+	                                     {&views[i_depth], depth_usage}});
+
+	// The post-processing passes start from the layouts of the render target
+	render_target.set_layout(i_swapchain, color_usage.layout);
+	render_target.set_layout(i_hdr, color_usage.layout);
+	render_target.set_layout(i_depth, depth_usage.layout);
+
+	set_viewport_and_scissor(command_buffer, render_target.get_extent());
+
+	render_pipeline->draw(command_buffer, render_target);
+
+	command_buffer.end_render_pass();
+
+	// The async bloom passes submit the scene and continue the frame in another command buffer
+	auto &composite_command_buffer = postprocessing_pipeline->draw(command_buffer, render_target);
+
+	// The composite pass is the last one, the GUI is drawn in its render pass
+	if (gui)
+	{
+		gui->draw(composite_command_buffer);
+	}
+
+	composite_command_buffer.end_render_pass();
+
+	composite_command_buffer.image_usage_barrier(views[i_swapchain], {VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0});
+
+	return composite_command_buffer;
+}
+
+void AsyncPostprocessing::draw_gui()
+{
+	auto &render_context = get_render_context();
+	auto &compute_queue  = render_context.get_async_compute_queue();
+	bool  inline_queue   = &compute_queue == &render_context.get_device().get_suitable_graphics_queue();
+
+	gui->show_options_window(
+	    /* body = */ [&]() {
+		    ImGui::Checkbox("Async compute", &async_compute);
+		    ImGui::SameLine();
+		    if (inline_queue)
+		    {
+			    ImGui::Text("(no separate compute queue, recorded inline)");
+		    }
+		    else
+		    {
+			    ImGui::Text("(queue family %u, index %u)", compute_queue.get_family_index(), compute_queue.get_index());
+		    }
+
+		    ImGui::Text("Async compute GPU time: %.2f ms", render_context.get_async_compute_time() * 1000.0f);
+
+		    // The frame time saved by the overlap, once both modes were measured
+		    if (average_frame_time[0] > 0.0f && average_frame_time[1] > 0.0f)
+		    {
+			    ImGui::Text("Frame time: %.2f ms inline, %.2f ms async (%.2f ms overlapped)",
+			                average_frame_time[0] * 1000.0f, average_frame_time[1] * 1000.0f,
+			                (average_frame_time[0] - average_frame_time[1]) * 1000.0f);
+		    }
+		    else
+		    {
+			    ImGui::Text("Frame time: %.2f ms, toggle async compute to compare", average_frame_time[async_compute ? 1 : 0] * 1000.0f);
+		    }
+	    },
+	    /* lines = */ 3);
+}
+
+std::unique_ptr<vkb::VulkanSample> create_async_postprocessing()
+{
+	return std::make_unique<AsyncPostprocessing>();
+}
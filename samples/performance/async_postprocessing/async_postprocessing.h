@@ -0,0 +1,84 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "rendering/postprocessing_computepass.h"
+#include "rendering/postprocessing_pipeline.h"
+#include "rendering/postprocessing_renderpass.h"
+#include "scene_graph/components/camera.h"
+#include "vulkan_sample.h"
+
+/**
+ * @brief Running the compute passes of a post-processing pipeline on an async compute queue
+ *
+ * The scene is rendered to an HDR attachment, which a bloom chain of compute passes blurs before a render pass
+ * composites both to the swapchain. Tagged as async compute, the bloom passes are submitted to a compute queue
+ * by the render context, overlapping the rendering of the next frame.
+ */
+class AsyncPostprocessing : public vkb::VulkanSample
+{
+  public:
+	AsyncPostprocessing();
+
+	virtual ~AsyncPostprocessing() = default;
+
+	virtual bool prepare(vkb::Platform &platform) override;
+
+	virtual void update(float delta_time) override;
+
+  private:
+	virtual void prepare_render_context() override;
+
+	virtual void draw_gui() override;
+
+	std::unique_ptr<vkb::RenderTarget> create_render_target(vkb::core::Image &&swapchain_image);
+
+	/**
+	 * @brief Creates the bloom targets for the given extent and binds them to the passes
+	 */
+	void prepare_bloom_chain(const VkExtent2D &extent);
+
+	/**
+	 * @brief Records the frame, the post-processing continues in another command buffer if it was submitted
+	 * @returns The command buffer to submit
+	 */
+	vkb::CommandBuffer &record(vkb::CommandBuffer &command_buffer, vkb::RenderTarget &render_target);
+
+	vkb::sg::Camera *camera{nullptr};
+
+	std::unique_ptr<vkb::PostProcessingPipeline> postprocessing_pipeline{};
+
+	/// Threshold, blur down and blur up passes, in the order of the pipeline
+	std::vector<vkb::PostProcessingComputePass *> bloom_passes;
+
+	vkb::PostProcessingRenderPass *composite_pass{nullptr};
+
+	/// One storage image per blur level, each half the size of the previous one
+	std::vector<std::unique_ptr<vkb::RenderTarget>> bloom_targets;
+
+	VkExtent2D bloom_extent{};
+
+	bool async_compute{true};
+
+	bool last_async_compute{false};
+
+	/// Average frame time in seconds with the bloom passes recorded inline and with them on the async compute queue
+	float average_frame_time[2]{};
+};
+
+std::unique_ptr<vkb::VulkanSample> create_async_postprocessing();
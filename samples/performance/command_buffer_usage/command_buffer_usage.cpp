@@ -71,7 +71,7 @@ bool CommandBufferUsage::prepare(vkb::Platform &platform)
 
 	set_render_pipeline(std::move(render_pipeline));
 
-	stats->request_stats({vkb::StatIndex::frame_times, vkb::StatIndex::cpu_cycles});
+	stats->request_stats({vkb::StatIndex::frame_times, vkb::StatIndex::cpu_cycles, vkb::StatIndex::cmd_binds_issued, vkb::StatIndex::cmd_binds_skipped});
 
 	gui = std::make_unique<vkb::Gui>(*this, platform.get_window(), stats.get());
 
@@ -24,6 +24,7 @@
 #include "platform/platform.h"
 #include "rendering/subpasses/forward_subpass.h"
 #include "stats/stats.h"
+#include "timer.h"
 
 DescriptorManagement::DescriptorManagement()
 {
@@ -34,6 +35,13 @@ DescriptorManagement::DescriptorManagement()
 
 	config.insert<vkb::IntSetting>(1, descriptor_caching.value, 1);
 	config.insert<vkb::IntSetting>(1, buffer_allocation.value, 1);
+
+	config.insert<vkb::IntSetting>(2, descriptor_caching.value, 2);
+	config.insert<vkb::IntSetting>(2, buffer_allocation.value, 0);
+
+	config.insert<vkb::IntSetting>(3, descriptor_caching.value, 1);
+	config.insert<vkb::IntSetting>(3, buffer_allocation.value, 0);
+	config.insert<vkb::IntSetting>(3, bindless_materials.value, 1);
 }
 
 bool DescriptorManagement::prepare(vkb::Platform &platform)
@@ -52,18 +60,29 @@ bool DescriptorManagement::prepare(vkb::Platform &platform)
 
 	vkb::ShaderSource vert_shader("base.vert");
 	vkb::ShaderSource frag_shader("base.frag");
-	auto              scene_subpass   = std::make_unique<vkb::ForwardSubpass>(get_render_context(), std::move(vert_shader), std::move(frag_shader), *scene, *camera);
+	auto              subpass         = std::make_unique<vkb::ForwardSubpass>(get_render_context(), std::move(vert_shader), std::move(frag_shader), *scene, *camera);
 	auto              render_pipeline = vkb::RenderPipeline();
-	render_pipeline.add_subpass(std::move(scene_subpass));
+	scene_subpass                     = subpass.get();
+	render_pipeline.add_subpass(std::move(subpass));
 	set_render_pipeline(std::move(render_pipeline));
 
 	// Add a GUI with the stats you want to monitor
-	stats->request_stats({vkb::StatIndex::frame_times});
+	stats->request_stats({vkb::StatIndex::frame_times, vkb::StatIndex::cmd_descriptor_writes});
 	gui = std::make_unique<vkb::Gui>(*this, platform.get_window(), stats.get());
 
 	return true;
 }
 
+void DescriptorManagement::request_gpu_features(vkb::PhysicalDevice &gpu)
+{
+	// Bindless materials index an array of textures with the material index of the draw
+	if (gpu.get_features().shaderSampledImageArrayDynamicIndexing)
+	{
+		gpu.get_mutable_requested_features().shaderSampledImageArrayDynamicIndexing = VK_TRUE;
+		bindless_supported                                                        = true;
+	}
+}
+
 void DescriptorManagement::update(float delta_time)
 {
 	update_scene(delta_time);
@@ -83,17 +102,37 @@ void DescriptorManagement::update(float delta_time)
 
 	render_context.get_active_frame().set_buffer_allocation_strategy(buffer_alloc_strategy);
 
-	auto descriptor_management_strategy = (descriptor_caching.value == 0) ?
-	                                          vkb::DescriptorManagementStrategy::CreateDirectly :
-	                                          vkb::DescriptorManagementStrategy::StoreInCache;
+	auto descriptor_management_strategy = vkb::DescriptorManagementStrategy::CreateDirectly;
+
+	if (descriptor_caching.value == 1)
+	{
+		descriptor_management_strategy = vkb::DescriptorManagementStrategy::StoreInCache;
+	}
+	else if (descriptor_caching.value == 2)
+	{
+		descriptor_management_strategy = vkb::DescriptorManagementStrategy::PushDescriptors;
+	}
 
 	render_context.get_active_frame().set_descriptor_management_strategy(descriptor_management_strategy);
 
+	scene_subpass->set_bindless_materials(bindless_supported && bindless_materials.value == 1);
+
 	command_buffer.begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
 	stats->begin_sampling(command_buffer);
 
+	vkb::Timer recording_timer;
+	recording_timer.start();
+
 	draw(command_buffer, render_context.get_active_frame().get_render_target());
 
+	// Measure the CPU cost of recording a draw, which includes the descriptor set management
+	auto draws = command_buffer.get_stats().draws;
+	if (draws > 0)
+	{
+		auto time_per_draw      = static_cast<float>(recording_timer.stop<vkb::Timer::Microseconds>()) / draws;
+		recording_time_per_draw = recording_time_per_draw * 0.95f + time_per_draw * 0.05f;
+	}
+
 	stats->end_sampling(command_buffer);
 	command_buffer.end();
 
@@ -109,6 +148,9 @@ void DescriptorManagement::draw_gui()
 		lines = lines * 2;
 	}
 
+	// Recording time
+	lines++;
+
 	gui->show_options_window(
 	    /* body = */ [this, lines]() {
 		    // For every option set
@@ -140,6 +182,8 @@ void DescriptorManagement::draw_gui()
 
 			    ImGui::PopID();
 		    }
+
+		    ImGui::Text("CPU recording time: %.2f us/draw", recording_time_per_draw);
 	    },
 	    /* lines = */ vkb::to_u32(lines));
 }
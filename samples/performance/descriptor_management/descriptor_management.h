@@ -18,6 +18,7 @@
 #pragma once
 
 #include "rendering/render_pipeline.h"
+#include "rendering/subpasses/forward_subpass.h"
 #include "scene_graph/components/perspective_camera.h"
 #include "vulkan_sample.h"
 
@@ -32,6 +33,8 @@ class DescriptorManagement : public vkb::VulkanSample
 
 	virtual void update(float delta_time) override;
 
+	virtual void request_gpu_features(vkb::PhysicalDevice &gpu) override;
+
   private:
 	/**
 	  * @brief Struct that contains radio button labeling and the value
@@ -45,8 +48,8 @@ class DescriptorManagement : public vkb::VulkanSample
 	};
 
 	RadioButtonGroup descriptor_caching{
-	    "Descriptor set caching",
-	    {"Disabled", "Enabled"},
+	    "Descriptor sets",
+	    {"Create directly", "Cache", "Push"},
 	    0};
 
 	RadioButtonGroup buffer_allocation{
@@ -54,10 +57,22 @@ class DescriptorManagement : public vkb::VulkanSample
 	    {"Disabled", "Enabled"},
 	    0};
 
-	std::vector<RadioButtonGroup *> radio_buttons = {&descriptor_caching, &buffer_allocation};
+	RadioButtonGroup bindless_materials{
+	    "Bindless materials",
+	    {"Disabled", "Enabled"},
+	    0};
+
+	std::vector<RadioButtonGroup *> radio_buttons = {&descriptor_caching, &buffer_allocation, &bindless_materials};
+
+	vkb::ForwardSubpass *scene_subpass{nullptr};
+
+	bool bindless_supported{false};
 
 	vkb::sg::PerspectiveCamera *camera{nullptr};
 
+	/// CPU time spent recording the scene, averaged over the draws of a frame and smoothed over frames
+	float recording_time_per_draw{0.0f};
+
 	virtual void draw_gui() override;
 };
 
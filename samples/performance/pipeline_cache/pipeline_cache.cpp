@@ -55,6 +55,10 @@ PipelineCache::~PipelineCache()
 		vkDestroyPipelineCache(device->get_handle(), pipeline_cache, nullptr);
 	}
 
+	LOGI("Graphics pipelines created: {} (extended dynamic state {})",
+	     device->get_resource_cache().get_internal_state().graphics_pipelines.size(),
+	     enable_extended_dynamic_state && device->get_supported_extended_dynamic_state().extended_dynamic_state ? "on" : "off");
+
 	vkb::fs::write_temp(device->get_resource_cache().serialize(), "cache.data");
 }
 
@@ -159,6 +163,19 @@ void PipelineCache::draw_gui()
 			    record_frame_time_next_frame = true;
 		    }
 
+		    if (device->get_supported_extended_dynamic_state().extended_dynamic_state)
+		    {
+			    if (ImGui::Checkbox("Extended dynamic state", &enable_extended_dynamic_state))
+			    {
+				    // Pipelines created with and without dynamic state differ, so both sets stay cached
+				    device->set_extended_dynamic_state_enabled(enable_extended_dynamic_state);
+			    }
+
+			    ImGui::SameLine();
+		    }
+
+		    ImGui::Text("Graphics pipelines: %zu", device->get_resource_cache().get_internal_state().graphics_pipelines.size());
+
 		    if (rebuild_pipelines_frame_time_ms > 0.0f)
 		    {
 			    ImGui::Text("Pipeline rebuild frame time: %.1f ms", rebuild_pipelines_frame_time_ms);
@@ -168,7 +185,7 @@ void PipelineCache::draw_gui()
 			    ImGui::Text("Pipeline rebuild frame time: N/A");
 		    }
 	    },
-	    /* lines = */ 2);
+	    /* lines = */ 3);
 }
 
 void PipelineCache::update(float delta_time)
@@ -46,6 +46,8 @@ class PipelineCache : public vkb::VulkanSample
 
 	bool enable_pipeline_cache{true};
 
+	bool enable_extended_dynamic_state{true};
+
 	bool record_frame_time_next_frame{false};
 
 	float rebuild_pipelines_frame_time_ms{0.0f};
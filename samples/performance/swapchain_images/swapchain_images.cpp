@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2020, Arm Limited and Contributors
+/* Copyright (c) 2019-2023, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -62,7 +62,10 @@ bool SwapchainImages::prepare(vkb::Platform &platform)
 
 	set_render_pipeline(std::move(render_pipeline));
 
-	stats->request_stats({vkb::StatIndex::frame_times});
+	stats->request_stats({vkb::StatIndex::frame_times,
+	                      vkb::StatIndex::frame_fence_wait,
+	                      vkb::StatIndex::frame_acquire,
+	                      vkb::StatIndex::frame_present_latency});
 	gui = std::make_unique<vkb::Gui>(*this, platform.get_window(), stats.get());
 
 	return true;
@@ -81,6 +84,8 @@ void SwapchainImages::update(float delta_time)
 		last_swapchain_image_count = swapchain_image_count;
 	}
 
+	get_render_context().get_frame_pacer().set_latency_mode(latency_mode);
+
 	VulkanSample::update(delta_time);
 }
 
@@ -92,6 +97,7 @@ void SwapchainImages::draw_gui()
 		    ImGui::SameLine();
 		    ImGui::RadioButton("Triple buffering", &swapchain_image_count, 3);
 		    ImGui::SameLine();
+		    ImGui::Checkbox("Latency mode", &latency_mode);
 	    },
 	    /* lines = */ 1);
 }
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019, Arm Limited and Contributors
+/* Copyright (c) 2019-2023, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -44,6 +44,9 @@ class SwapchainImages : public vkb::VulkanSample
 	int swapchain_image_count{3};
 
 	int last_swapchain_image_count{3};
+
+	/// Delays the start of frames so that the CPU does not run ahead of the GPU
+	bool latency_mode{false};
 };
 
 std::unique_ptr<vkb::VulkanSample> create_swapchain_images();
@@ -1,5 +1,5 @@
 #version 320 es
-/* Copyright (c) 2019-2020, Arm Limited and Contributors
+/* Copyright (c) 2019-2023, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -18,10 +18,6 @@
 
 precision highp float;
 
-#ifdef HAS_BASE_COLOR_TEXTURE
-layout(set = 0, binding = 0) uniform sampler2D base_color_texture;
-#endif
-
 layout(location = 0) in vec4 in_pos;
 layout(location = 1) in vec2 in_uv;
 layout(location = 2) in vec3 in_normal;
@@ -36,15 +32,60 @@ layout(set = 0, binding = 1) uniform GlobalUniform
 }
 global_uniform;
 
+// The material push constants follow those of the draw, see base.vert
+#if defined(DRAW_CONSTANTS_PUSH_CONSTANTS)
+#define MATERIAL_PUSH_CONSTANT_OFFSET 64
+#elif defined(DRAW_CONSTANTS_BUFFER_DEVICE_ADDRESS)
+#define MATERIAL_PUSH_CONSTANT_OFFSET 16
+#else
+#define MATERIAL_PUSH_CONSTANT_OFFSET 0
+#endif
+
+#ifdef BINDLESS_MATERIALS
+// Scene-wide tables bound once, indexed by the material index of the draw
+#ifdef BINDLESS_TEXTURE_COUNT
+layout(set = 1, binding = 0) uniform sampler2D bindless_textures[BINDLESS_TEXTURE_COUNT];
+#endif
+
+struct BindlessMaterial
+{
+	vec4  base_color_factor;
+	float metallic_factor;
+	float roughness_factor;
+	int   base_color_texture;
+};
+
+layout(set = 1, binding = 1, std430) readonly buffer BindlessMaterials
+{
+	BindlessMaterial materials[];
+}
+bindless_materials;
+
+layout(push_constant, std430) uniform BindlessMaterialIndex
+{
+	layout(offset = MATERIAL_PUSH_CONSTANT_OFFSET) uint material_index;
+}
+bindless_material_index;
+#else
+#if defined(HAS_BASE_COLOR_TEXTURE) || defined(SCENE_HAS_BASE_COLOR_TEXTURE)
+layout(set = 0, binding = 0) uniform sampler2D base_color_texture;
+#endif
+
+#ifdef SPECIALIZED_MATERIALS
+// One variant for the whole scene, the features of each material are set when its pipeline is created
+layout(constant_id = 3) const bool HAS_BASE_COLOR_TEXTURE = false;
+#endif
+
 // Push constants come with a limitation in the size of data.
 // The standard requires at least 128 bytes
 layout(push_constant, std430) uniform PBRMaterialUniform
 {
-	vec4  base_color_factor;
+	layout(offset = MATERIAL_PUSH_CONSTANT_OFFSET) vec4 base_color_factor;
 	float metallic_factor;
 	float roughness_factor;
 }
 pbr_material_uniform;
+#endif
 
 #include "lighting.h"
 
@@ -83,7 +124,25 @@ void main(void)
 
 	vec4 base_color = vec4(1.0, 0.0, 0.0, 1.0);
 
-#ifdef HAS_BASE_COLOR_TEXTURE
+#if defined(BINDLESS_MATERIALS)
+	BindlessMaterial material = bindless_materials.materials[bindless_material_index.material_index];
+
+	base_color = material.base_color_factor;
+#ifdef BINDLESS_TEXTURE_COUNT
+	if (material.base_color_texture >= 0)
+	{
+		base_color = texture(bindless_textures[material.base_color_texture], in_uv);
+	}
+#endif
+#elif defined(SPECIALIZED_MATERIALS)
+	base_color = pbr_material_uniform.base_color_factor;
+#ifdef SCENE_HAS_BASE_COLOR_TEXTURE
+	if (HAS_BASE_COLOR_TEXTURE)
+	{
+		base_color = texture(base_color_texture, in_uv);
+	}
+#endif
+#elif defined(HAS_BASE_COLOR_TEXTURE)
 	base_color = texture(base_color_texture, in_uv);
 #else
 	base_color = pbr_material_uniform.base_color_factor;
@@ -1,5 +1,5 @@
 #version 320 es
-/* Copyright (c) 2019, Arm Limited and Contributors
+/* Copyright (c) 2019-2023, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -16,6 +16,10 @@
  * limitations under the License.
  */
 
+#ifdef DRAW_CONSTANTS_BUFFER_DEVICE_ADDRESS
+#extension GL_EXT_buffer_reference : require
+#endif
+
 layout(location = 0) in vec3 position;
 layout(location = 1) in vec2 texcoord_0;
 layout(location = 2) in vec3 normal;
@@ -26,17 +30,51 @@ layout(set = 0, binding = 1) uniform GlobalUniform {
     vec3 camera_position;
 } global_uniform;
 
+// Unless the model matrix comes with the global uniform, it is delivered separately for each draw
+#if defined(DRAW_CONSTANTS_PUSH_CONSTANTS)
+layout(push_constant, std430) uniform DrawConstants {
+    mat4 model;
+} draw_constants;
+#elif defined(DRAW_CONSTANTS_BUFFER_ARRAY)
+layout(set = 0, binding = 2, std430) readonly buffer DrawConstants {
+    mat4 models[];
+} draw_constants;
+#elif defined(DRAW_CONSTANTS_BUFFER_DEVICE_ADDRESS)
+layout(buffer_reference, std430, buffer_reference_align = 16) readonly buffer DrawConstantsReference {
+    mat4 model;
+};
+
+layout(push_constant, std430) uniform DrawConstants {
+    DrawConstantsReference constants;
+} draw_constants;
+#endif
+
+mat4 get_model()
+{
+#if defined(DRAW_CONSTANTS_PUSH_CONSTANTS)
+    return draw_constants.model;
+#elif defined(DRAW_CONSTANTS_BUFFER_ARRAY)
+    return draw_constants.models[gl_InstanceIndex];
+#elif defined(DRAW_CONSTANTS_BUFFER_DEVICE_ADDRESS)
+    return draw_constants.constants.model;
+#else
+    return global_uniform.model;
+#endif
+}
+
 layout (location = 0) out vec4 o_pos;
 layout (location = 1) out vec2 o_uv;
 layout (location = 2) out vec3 o_normal;
 
 void main(void)
 {
-    o_pos = global_uniform.model * vec4(position, 1.0);
+    mat4 model = get_model();
+
+    o_pos = model * vec4(position, 1.0);
 
     o_uv = texcoord_0;
 
-    o_normal = mat3(global_uniform.model) * normal;
+    o_normal = mat3(model) * normal;
 
     gl_Position = global_uniform.view_proj * o_pos;
 }
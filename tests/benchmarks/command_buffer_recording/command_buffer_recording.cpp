@@ -0,0 +1,160 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "command_buffer_recording.h"
+
+#include "common/logging.h"
+#include "platform/platform.h"
+#include "rendering/render_context.h"
+#include "rendering/subpasses/forward_subpass.h"
+#include "timer.h"
+
+namespace
+{
+/// Interleaved position, texcoord and normal of the vertex inputs of the base shaders
+struct Vertex
+{
+	glm::vec3 position;
+	glm::vec2 texcoord_0;
+	glm::vec3 normal;
+};
+}        // namespace
+
+CommandBufferRecordingTest::RecordingSubpass::RecordingSubpass(vkb::RenderContext &render_context, vkb::ShaderSource &&vertex_shader, vkb::ShaderSource &&fragment_shader) :
+    vkb::Subpass{render_context, std::move(vertex_shader), std::move(fragment_shader)}
+{
+}
+
+void CommandBufferRecordingTest::RecordingSubpass::prepare()
+{
+	auto &device = render_context.get_device();
+
+	shader_variant.add_definitions({"MAX_LIGHT_COUNT " + std::to_string(MAX_FORWARD_LIGHT_COUNT)});
+	shader_variant.add_definitions(vkb::light_type_definitions);
+
+	device.get_resource_cache().request_shader_module(VK_SHADER_STAGE_VERTEX_BIT, get_vertex_shader(), shader_variant);
+	device.get_resource_cache().request_shader_module(VK_SHADER_STAGE_FRAGMENT_BIT, get_fragment_shader(), shader_variant);
+
+	std::vector<Vertex> vertices{{{-1.0f, -1.0f, 0.0f}, {0.0f, 0.0f}, {0.0f, 0.0f, 1.0f}},
+	                             {{3.0f, -1.0f, 0.0f}, {2.0f, 0.0f}, {0.0f, 0.0f, 1.0f}},
+	                             {{-1.0f, 3.0f, 0.0f}, {0.0f, 2.0f}, {0.0f, 0.0f, 1.0f}}};
+
+	vertex_buffer = std::make_unique<vkb::core::Buffer>(device,
+	                                                    vertices.size() * sizeof(Vertex),
+	                                                    VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+	                                                    VMA_MEMORY_USAGE_CPU_TO_GPU);
+	vertex_buffer->update(vertices.data(), vertices.size() * sizeof(Vertex));
+}
+
+void CommandBufferRecordingTest::RecordingSubpass::draw(vkb::CommandBuffer &command_buffer)
+{
+	auto &device       = render_context.get_device();
+	auto &render_frame = render_context.get_active_frame();
+
+	// Two global uniforms at different offsets, so that every iteration rebinds set 0
+	std::array<vkb::BufferAllocation, 2> global_allocations{
+	    render_frame.allocate_buffer(VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, sizeof(vkb::GlobalUniform)),
+	    render_frame.allocate_buffer(VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, sizeof(vkb::GlobalUniform))};
+
+	for (auto &allocation : global_allocations)
+	{
+		vkb::GlobalUniform global_uniform{};
+		global_uniform.model            = glm::mat4(1.0f);
+		global_uniform.camera_view_proj = glm::mat4(1.0f);
+
+		allocation.update(global_uniform);
+	}
+
+	auto light_allocation = render_frame.allocate_buffer(VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, sizeof(vkb::ForwardLights));
+	light_allocation.update(vkb::ForwardLights{});
+
+	auto &vert_shader_module = device.get_resource_cache().request_shader_module(VK_SHADER_STAGE_VERTEX_BIT, get_vertex_shader(), shader_variant);
+	auto &frag_shader_module = device.get_resource_cache().request_shader_module(VK_SHADER_STAGE_FRAGMENT_BIT, get_fragment_shader(), shader_variant);
+
+	auto &pipeline_layout = device.get_resource_cache().request_pipeline_layout({&vert_shader_module, &frag_shader_module});
+
+	vkb::VertexInputState vertex_input_state;
+	vertex_input_state.bindings   = {{0, sizeof(Vertex), VK_VERTEX_INPUT_RATE_VERTEX}};
+	vertex_input_state.attributes = {{0, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(Vertex, position)},
+	                                 {1, 0, VK_FORMAT_R32G32_SFLOAT, offsetof(Vertex, texcoord_0)},
+	                                 {2, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(Vertex, normal)}};
+
+	command_buffer.bind_pipeline_layout(pipeline_layout);
+	command_buffer.set_vertex_input_state(vertex_input_state);
+	command_buffer.bind_vertex_buffers(0, {*vertex_buffer}, {0});
+
+	vkb::PBRMaterialUniform material_uniform{};
+	material_uniform.base_color_factor = glm::vec4(1.0f);
+
+	vkb::Timer timer;
+	timer.start();
+
+	for (uint32_t i = 0; i < iteration_count; ++i)
+	{
+		auto &global_allocation = global_allocations[i % global_allocations.size()];
+
+		command_buffer.bind_buffer(global_allocation.get_buffer(), global_allocation.get_offset(), global_allocation.get_size(), 0, 1, 0);
+		command_buffer.bind_buffer(light_allocation.get_buffer(), light_allocation.get_offset(), light_allocation.get_size(), 0, 4, 0);
+
+		material_uniform.metallic_factor = static_cast<float>(i % 2);
+		command_buffer.push_constants(material_uniform);
+
+		command_buffer.draw(3, 1, 0, 0);
+	}
+
+	auto elapsed = timer.stop<vkb::Timer::Microseconds>();
+
+	auto &stats = command_buffer.get_stats();
+
+	LOGI("Recorded {} bind and draw iterations in {:.2f} ms, {:.1f} ns per iteration",
+	     iteration_count, elapsed / 1000.0, elapsed * 1000.0 / iteration_count);
+	LOGI("Binds issued: {}, binds skipped: {}, descriptor writes: {}",
+	     stats.binds_issued, stats.binds_skipped, stats.descriptor_writes);
+}
+
+bool CommandBufferRecordingTest::prepare(vkb::Platform &platform)
+{
+	if (!VulkanTest::prepare(platform))
+	{
+		return false;
+	}
+
+	vkb::ShaderSource vert_shader("base.vert");
+	vkb::ShaderSource frag_shader("base.frag");
+
+	auto subpass = std::make_unique<RecordingSubpass>(get_render_context(), std::move(vert_shader), std::move(frag_shader));
+
+	auto render_pipeline = vkb::RenderPipeline();
+	render_pipeline.add_subpass(std::move(subpass));
+
+	set_render_pipeline(std::move(render_pipeline));
+
+	return true;
+}
+
+void CommandBufferRecordingTest::update(float delta_time)
+{
+	// Record a single frame, the timings are logged instead of comparing a screenshot
+	vkb::VulkanSample::update(delta_time);
+
+	end();
+}
+
+std::unique_ptr<vkb::VulkanSample> create_command_buffer_recording_test()
+{
+	return std::make_unique<CommandBufferRecordingTest>();
+}
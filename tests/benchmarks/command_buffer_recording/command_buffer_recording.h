@@ -0,0 +1,60 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "rendering/subpass.h"
+#include "vulkan_test.h"
+
+/**
+ * @brief Measures the CPU cost of recording binds and draws
+ *
+ * Records a large number of draws, each preceded by the descriptor binds and push constants
+ * of a typical mesh, and logs the recording time. No image is compared.
+ */
+class CommandBufferRecordingTest : public vkbtest::VulkanTest
+{
+  public:
+	/// Number of bind and draw iterations recorded
+	static constexpr uint32_t iteration_count = 100000;
+
+	CommandBufferRecordingTest() = default;
+
+	virtual ~CommandBufferRecordingTest() = default;
+
+	virtual bool prepare(vkb::Platform &platform) override;
+
+	virtual void update(float delta_time) override;
+
+  private:
+	class RecordingSubpass : public vkb::Subpass
+	{
+	  public:
+		RecordingSubpass(vkb::RenderContext &render_context, vkb::ShaderSource &&vertex_shader, vkb::ShaderSource &&fragment_shader);
+
+		virtual void prepare() override;
+
+		virtual void draw(vkb::CommandBuffer &command_buffer) override;
+
+	  private:
+		vkb::ShaderVariant shader_variant;
+
+		std::unique_ptr<vkb::core::Buffer> vertex_buffer;
+	};
+};
+
+std::unique_ptr<vkb::VulkanSample> create_command_buffer_recording_test();
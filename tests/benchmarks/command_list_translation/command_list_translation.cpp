@@ -0,0 +1,293 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "command_list_translation.h"
+
+#include "common/logging.h"
+#include "core/render_pass.h"
+#include "platform/platform.h"
+#include "rendering/render_context.h"
+#include "rendering/subpasses/forward_subpass.h"
+#include "timer.h"
+
+namespace
+{
+/// Interleaved position, texcoord and normal of the vertex inputs of the base shaders
+struct Vertex
+{
+	glm::vec3 position;
+	glm::vec2 texcoord_0;
+	glm::vec3 normal;
+};
+
+uint32_t count_draws(const std::vector<vkb::CommandBuffer *> &command_buffers)
+{
+	uint32_t draws = 0;
+
+	for (auto command_buffer : command_buffers)
+	{
+		draws += command_buffer->get_stats().draws;
+	}
+
+	return draws;
+}
+
+/**
+ * @return The binds recorded or skipped by the command buffers, each draw flushes the same binds
+ *         whether the list is translated in one command buffer or split between several
+ */
+uint32_t count_binds(const std::vector<vkb::CommandBuffer *> &command_buffers)
+{
+	uint32_t binds = 0;
+
+	for (auto command_buffer : command_buffers)
+	{
+		binds += command_buffer->get_stats().binds_issued + command_buffer->get_stats().binds_skipped;
+	}
+
+	return binds;
+}
+}        // namespace
+
+CommandListTranslationTest::TranslationSubpass::TranslationSubpass(vkb::RenderContext &render_context, vkb::ShaderSource &&vertex_shader, vkb::ShaderSource &&fragment_shader) :
+    vkb::Subpass{render_context, std::move(vertex_shader), std::move(fragment_shader)}
+{
+}
+
+void CommandListTranslationTest::TranslationSubpass::prepare()
+{
+	auto &device = render_context.get_device();
+
+	shader_variant.add_definitions({"MAX_LIGHT_COUNT " + std::to_string(MAX_FORWARD_LIGHT_COUNT)});
+	shader_variant.add_definitions(vkb::light_type_definitions);
+
+	device.get_resource_cache().request_shader_module(VK_SHADER_STAGE_VERTEX_BIT, get_vertex_shader(), shader_variant);
+	device.get_resource_cache().request_shader_module(VK_SHADER_STAGE_FRAGMENT_BIT, get_fragment_shader(), shader_variant);
+
+	std::vector<Vertex> vertices{{{-1.0f, -1.0f, 0.0f}, {0.0f, 0.0f}, {0.0f, 0.0f, 1.0f}},
+	                             {{3.0f, -1.0f, 0.0f}, {2.0f, 0.0f}, {0.0f, 0.0f, 1.0f}},
+	                             {{-1.0f, 3.0f, 0.0f}, {0.0f, 2.0f}, {0.0f, 0.0f, 1.0f}}};
+
+	vertex_buffer = std::make_unique<vkb::core::Buffer>(device,
+	                                                    vertices.size() * sizeof(Vertex),
+	                                                    VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+	                                                    VMA_MEMORY_USAGE_CPU_TO_GPU);
+	vertex_buffer->update(vertices.data(), vertices.size() * sizeof(Vertex));
+
+	// The list is recorded once, so it references buffers that live as long as the subpass
+	// instead of allocations from the buffer pools of a frame
+	for (auto &global_uniform_buffer : global_uniform_buffers)
+	{
+		vkb::GlobalUniform global_uniform{};
+		global_uniform.model            = glm::mat4(1.0f);
+		global_uniform.camera_view_proj = glm::mat4(1.0f);
+
+		global_uniform_buffer = std::make_unique<vkb::core::Buffer>(device,
+		                                                            sizeof(vkb::GlobalUniform),
+		                                                            VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+		                                                            VMA_MEMORY_USAGE_CPU_TO_GPU);
+		global_uniform_buffer->convert_and_update(global_uniform);
+	}
+
+	light_buffer = std::make_unique<vkb::core::Buffer>(device,
+	                                                   sizeof(vkb::ForwardLights),
+	                                                   VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+	                                                   VMA_MEMORY_USAGE_CPU_TO_GPU);
+	light_buffer->convert_and_update(vkb::ForwardLights{});
+
+	record_command_list();
+}
+
+void CommandListTranslationTest::TranslationSubpass::record_command_list()
+{
+	auto &device = render_context.get_device();
+
+	auto &vert_shader_module = device.get_resource_cache().request_shader_module(VK_SHADER_STAGE_VERTEX_BIT, get_vertex_shader(), shader_variant);
+	auto &frag_shader_module = device.get_resource_cache().request_shader_module(VK_SHADER_STAGE_FRAGMENT_BIT, get_fragment_shader(), shader_variant);
+
+	auto &pipeline_layout = device.get_resource_cache().request_pipeline_layout({&vert_shader_module, &frag_shader_module});
+
+	vkb::VertexInputState vertex_input_state;
+	vertex_input_state.bindings   = {{0, sizeof(Vertex), VK_VERTEX_INPUT_RATE_VERTEX}};
+	vertex_input_state.attributes = {{0, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(Vertex, position)},
+	                                 {1, 0, VK_FORMAT_R32G32_SFLOAT, offsetof(Vertex, texcoord_0)},
+	                                 {2, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(Vertex, normal)}};
+
+	command_list.bind_pipeline_layout(pipeline_layout);
+	command_list.set_vertex_input_state(vertex_input_state);
+	command_list.bind_vertex_buffers(0, {*vertex_buffer}, {0});
+
+	vkb::PBRMaterialUniform material_uniform{};
+	material_uniform.base_color_factor = glm::vec4(1.0f);
+
+	vkb::Timer timer;
+	timer.start();
+
+	for (uint32_t i = 0; i < draw_count; ++i)
+	{
+		auto &global_uniform_buffer = *global_uniform_buffers[i % global_uniform_buffers.size()];
+
+		command_list.bind_buffer(global_uniform_buffer, 0, global_uniform_buffer.get_size(), 0, 1, 0);
+		command_list.bind_buffer(*light_buffer, 0, light_buffer->get_size(), 0, 4, 0);
+
+		material_uniform.metallic_factor = static_cast<float>(i % 2);
+		command_list.push_constants(material_uniform);
+
+		command_list.draw(3, 1, 0, 0);
+	}
+
+	auto elapsed = timer.stop<vkb::Timer::Microseconds>();
+
+	LOGI("Recorded {} draws into a command list in {:.2f} ms, {} commands in {} KiB",
+	     draw_count, elapsed / 1000.0, command_list.get_command_count(), command_list.get_size() / 1024);
+}
+
+std::vector<vkb::CommandBuffer *> CommandListTranslationTest::TranslationSubpass::begin_secondary_command_buffers(vkb::CommandBuffer &primary_command_buffer, uint32_t count)
+{
+	auto &render_frame = render_context.get_active_frame();
+	auto &queue        = render_context.get_device().get_queue_by_flags(VK_QUEUE_GRAPHICS_BIT, 0);
+	auto  extent       = render_frame.get_render_target().get_extent();
+
+	// Secondary command buffers inherit neither the viewport nor the blend state of the primary one
+	VkViewport viewport{};
+	viewport.width    = static_cast<float>(extent.width);
+	viewport.height   = static_cast<float>(extent.height);
+	viewport.minDepth = 0.0f;
+	viewport.maxDepth = 1.0f;
+
+	VkRect2D scissor{};
+	scissor.extent = extent;
+
+	vkb::ColorBlendState color_blend_state;
+	color_blend_state.attachments.resize(primary_command_buffer.get_current_render_pass().render_pass->get_color_output_count(0));
+
+	std::vector<vkb::CommandBuffer *> command_buffers;
+
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		// Each command buffer is recorded by a different thread, so it uses the pools of its thread index
+		auto &command_buffer = render_frame.request_command_buffer(queue, vkb::CommandBuffer::ResetMode::ResetPool, VK_COMMAND_BUFFER_LEVEL_SECONDARY, i);
+
+		command_buffer.begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT, &primary_command_buffer);
+		command_buffer.set_viewport(0, {viewport});
+		command_buffer.set_scissor(0, {scissor});
+		command_buffer.set_color_blend_state(color_blend_state);
+
+		command_buffers.push_back(&command_buffer);
+	}
+
+	return command_buffers;
+}
+
+void CommandListTranslationTest::TranslationSubpass::draw(vkb::CommandBuffer &command_buffer)
+{
+	vkb::Timer timer;
+
+	// Translate the whole list on this thread
+	auto serial_command_buffers = begin_secondary_command_buffers(command_buffer, 1);
+
+	timer.start();
+	command_list.execute(*serial_command_buffers[0]);
+	auto serial_elapsed = timer.stop<vkb::Timer::Microseconds>();
+
+	serial_command_buffers[0]->end();
+
+	// Translate the same list split between the threads of the pool
+	auto parallel_command_buffers = begin_secondary_command_buffers(command_buffer, thread_count);
+
+	timer.start();
+	command_list.execute(parallel_command_buffers, thread_pool);
+	auto parallel_elapsed = timer.stop<vkb::Timer::Microseconds>();
+
+	for (auto parallel_command_buffer : parallel_command_buffers)
+	{
+		parallel_command_buffer->end();
+	}
+
+	command_buffer.execute_commands(serial_command_buffers);
+	command_buffer.execute_commands(parallel_command_buffers);
+
+	LOGI("Translated {} draws in {:.2f} ms on one thread, {:.2f} ms on {} threads",
+	     draw_count, serial_elapsed / 1000.0, parallel_elapsed / 1000.0, thread_count);
+
+	auto serial_draws   = count_draws(serial_command_buffers);
+	auto parallel_draws = count_draws(parallel_command_buffers);
+
+	if (serial_draws != command_list.get_action_count() || parallel_draws != command_list.get_action_count())
+	{
+		LOGE("Expected {} draws, translated {} on one thread and {} on {} threads",
+		     command_list.get_action_count(), serial_draws, parallel_draws, thread_count);
+		throw std::runtime_error("Command list translation recorded the wrong number of draws");
+	}
+
+	// Each further command buffer binds the pipeline and the vertex buffer once more, any other
+	// difference means that the state of some draws, like their push constants, was lost or duplicated
+	auto serial_binds   = count_binds(serial_command_buffers);
+	auto parallel_binds = count_binds(parallel_command_buffers);
+
+	if (parallel_binds != serial_binds + 2 * (thread_count - 1))
+	{
+		LOGE("Translated {} binds on one thread and {} on {} threads, expected {}",
+		     serial_binds, parallel_binds, thread_count, serial_binds + 2 * (thread_count - 1));
+		throw std::runtime_error("Command list translation on several threads differs from the translation on one thread");
+	}
+}
+
+bool CommandListTranslationTest::prepare(vkb::Platform &platform)
+{
+	if (!VulkanTest::prepare(platform))
+	{
+		return false;
+	}
+
+	vkb::ShaderSource vert_shader("base.vert");
+	vkb::ShaderSource frag_shader("base.frag");
+
+	auto subpass = std::make_unique<TranslationSubpass>(get_render_context(), std::move(vert_shader), std::move(frag_shader));
+
+	auto render_pipeline = vkb::RenderPipeline();
+	render_pipeline.add_subpass(std::move(subpass));
+
+	set_render_pipeline(std::move(render_pipeline));
+
+	return true;
+}
+
+void CommandListTranslationTest::prepare_render_context()
+{
+	// One set of command, descriptor and buffer pools per translation thread
+	get_render_context().prepare(thread_count);
+}
+
+void CommandListTranslationTest::render(vkb::CommandBuffer &command_buffer)
+{
+	// The subpass is drawn with secondary command buffers only
+	get_render_pipeline().draw(command_buffer, get_render_context().get_active_frame().get_render_target(), VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+}
+
+void CommandListTranslationTest::update(float delta_time)
+{
+	// Translate a single frame, the timings are logged instead of comparing a screenshot
+	vkb::VulkanSample::update(delta_time);
+
+	end();
+}
+
+std::unique_ptr<vkb::VulkanSample> create_command_list_translation_test()
+{
+	return std::make_unique<CommandListTranslationTest>();
+}
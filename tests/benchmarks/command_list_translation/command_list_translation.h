@@ -0,0 +1,88 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <ctpl_stl.h>
+
+#include "rendering/command_list.h"
+#include "rendering/subpass.h"
+#include "vulkan_test.h"
+
+/**
+ * @brief Measures the CPU cost of translating a command list into command buffers
+ *
+ * Records a command list of static draws once, then translates it into a single secondary
+ * command buffer and in parallel into one secondary command buffer per thread, checks that
+ * both translations record the same draws and binds and logs their timings. No image is compared.
+ *
+ * Run it with --null-device to translate the same list without a GPU.
+ */
+class CommandListTranslationTest : public vkbtest::VulkanTest
+{
+  public:
+	/// Number of draws in the command list
+	static constexpr uint32_t draw_count = 100000;
+
+	/// Number of threads and command buffers the list is translated into in parallel
+	static constexpr uint32_t thread_count = 4;
+
+	CommandListTranslationTest() = default;
+
+	virtual ~CommandListTranslationTest() = default;
+
+	virtual bool prepare(vkb::Platform &platform) override;
+
+	virtual void update(float delta_time) override;
+
+  private:
+	class TranslationSubpass : public vkb::Subpass
+	{
+	  public:
+		TranslationSubpass(vkb::RenderContext &render_context, vkb::ShaderSource &&vertex_shader, vkb::ShaderSource &&fragment_shader);
+
+		virtual void prepare() override;
+
+		virtual void draw(vkb::CommandBuffer &command_buffer) override;
+
+	  private:
+		void record_command_list();
+
+		/**
+		 * @brief Requests and begins secondary command buffers inheriting the render pass of the primary command buffer
+		 */
+		std::vector<vkb::CommandBuffer *> begin_secondary_command_buffers(vkb::CommandBuffer &primary_command_buffer, uint32_t count);
+
+		vkb::ShaderVariant shader_variant;
+
+		std::unique_ptr<vkb::core::Buffer> vertex_buffer;
+
+		std::array<std::unique_ptr<vkb::core::Buffer>, 2> global_uniform_buffers;
+
+		std::unique_ptr<vkb::core::Buffer> light_buffer;
+
+		vkb::CommandList command_list;
+
+		ctpl::thread_pool thread_pool{thread_count};
+	};
+
+	virtual void prepare_render_context() override;
+
+	virtual void render(vkb::CommandBuffer &command_buffer) override;
+};
+
+std::unique_ptr<vkb::VulkanSample> create_command_list_translation_test();
@@ -0,0 +1,175 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "draw_constant_delivery.h"
+
+#include "common/logging.h"
+#include "platform/platform.h"
+#include "rendering/render_context.h"
+#include "scene_graph/components/camera.h"
+#include "scene_graph/components/light.h"
+#include "scene_graph/node.h"
+#include "scene_graph/scene.h"
+#include "timer.h"
+
+VKBP_DISABLE_WARNINGS()
+#include "common/glm_common.h"
+#include <glm/gtx/quaternion.hpp>
+VKBP_ENABLE_WARNINGS()
+
+namespace
+{
+const char *to_string(vkb::DrawConstantStrategy strategy)
+{
+	switch (strategy)
+	{
+		case vkb::DrawConstantStrategy::UniformBuffer:
+			return "uniform buffer";
+		case vkb::DrawConstantStrategy::DynamicUniformBuffer:
+			return "dynamic uniform buffer";
+		case vkb::DrawConstantStrategy::PushConstants:
+			return "push constants";
+		case vkb::DrawConstantStrategy::BufferArray:
+			return "buffer array";
+		case vkb::DrawConstantStrategy::BufferDeviceAddress:
+			return "buffer device address";
+		default:
+			return "unknown";
+	}
+}
+}        // namespace
+
+DrawConstantDeliveryTest::TimingSubpass::TimingSubpass(vkb::RenderContext &render_context, vkb::ShaderSource &&vertex_shader, vkb::ShaderSource &&fragment_shader, vkb::sg::Scene &scene, vkb::sg::Camera &camera) :
+    vkb::ForwardSubpass{render_context, std::move(vertex_shader), std::move(fragment_shader), scene, camera}
+{
+}
+
+void DrawConstantDeliveryTest::TimingSubpass::draw(vkb::CommandBuffer &command_buffer)
+{
+	const std::array<vkb::DrawConstantStrategy, 5> strategies{vkb::DrawConstantStrategy::UniformBuffer,
+	                                                          vkb::DrawConstantStrategy::DynamicUniformBuffer,
+	                                                          vkb::DrawConstantStrategy::PushConstants,
+	                                                          vkb::DrawConstantStrategy::BufferArray,
+	                                                          vkb::DrawConstantStrategy::BufferDeviceAddress};
+
+	for (auto strategy : strategies)
+	{
+		if (!is_draw_constant_strategy_supported(strategy))
+		{
+			LOGI("Draw constants through {}: not supported", to_string(strategy));
+			continue;
+		}
+
+		set_draw_constant_strategy(strategy);
+
+		// Untimed recording, so that shader modules and pipelines are already cached
+		vkb::ForwardSubpass::draw(command_buffer);
+
+		auto draws_before = command_buffer.get_stats().draws;
+
+		vkb::Timer timer;
+		timer.start();
+
+		for (uint32_t i = 0; i < repetition_count; ++i)
+		{
+			vkb::ForwardSubpass::draw(command_buffer);
+		}
+
+		auto elapsed = timer.stop<vkb::Timer::Microseconds>();
+
+		auto draw_count = command_buffer.get_stats().draws - draws_before;
+
+		if (draw_count == 0)
+		{
+			LOGW("Draw constants through {}: nothing was drawn", to_string(strategy));
+			continue;
+		}
+
+		LOGI("Draw constants through {}: {} draws in {:.2f} ms, {:.1f} ns per draw",
+		     to_string(strategy), draw_count, elapsed / 1000.0, elapsed * 1000.0 / draw_count);
+	}
+
+	set_draw_constant_strategy(vkb::DrawConstantStrategy::UniformBuffer);
+}
+
+DrawConstantDeliveryTest::DrawConstantDeliveryTest()
+{
+	add_instance_extension(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME, true);
+	add_device_extension(VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME, true);
+}
+
+void DrawConstantDeliveryTest::request_gpu_features(vkb::PhysicalDevice &gpu)
+{
+	// Buffer device address is optional, the strategy is skipped when the feature is missing
+	if (gpu.get_instance().is_enabled(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME))
+	{
+		auto &requested_features = gpu.request_extension_features<VkPhysicalDeviceBufferDeviceAddressFeaturesKHR>(VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES_KHR);
+
+		if (!requested_features.bufferDeviceAddress)
+		{
+			LOGW("Buffer device address is not supported by the GPU");
+		}
+	}
+}
+
+bool DrawConstantDeliveryTest::prepare(vkb::Platform &platform)
+{
+	if (!VulkanTest::prepare(platform))
+	{
+		return false;
+	}
+
+	load_scene("scenes/sponza/Sponza01.gltf");
+
+	get_scene().clear_components<vkb::sg::Light>();
+
+	vkb::add_directional_light(get_scene(), glm::quat({glm::radians(-90.0f), 0.0f, glm::radians(30.0f)}));
+
+	auto camera_node = get_scene().find_node("main_camera");
+
+	if (!camera_node)
+	{
+		camera_node = get_scene().find_node("default_camera");
+	}
+
+	auto &camera = camera_node->get_component<vkb::sg::Camera>();
+
+	vkb::ShaderSource vert_shader("base.vert");
+	vkb::ShaderSource frag_shader("base.frag");
+
+	auto subpass = std::make_unique<TimingSubpass>(get_render_context(), std::move(vert_shader), std::move(frag_shader), get_scene(), camera);
+
+	auto render_pipeline = vkb::RenderPipeline();
+	render_pipeline.add_subpass(std::move(subpass));
+
+	set_render_pipeline(std::move(render_pipeline));
+
+	return true;
+}
+
+void DrawConstantDeliveryTest::update(float delta_time)
+{
+	// Record a single frame, the timings are logged instead of comparing a screenshot
+	vkb::VulkanSample::update(delta_time);
+
+	end();
+}
+
+std::unique_ptr<vkb::VulkanSample> create_draw_constant_delivery_test()
+{
+	return std::make_unique<DrawConstantDeliveryTest>();
+}
@@ -0,0 +1,55 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "rendering/subpasses/forward_subpass.h"
+#include "vulkan_test.h"
+
+/**
+ * @brief Measures the CPU cost per draw of each draw constant strategy of the geometry subpass
+ *
+ * Records the Sponza scene repeatedly with every strategy the device supports and logs
+ * the recording time per draw. No image is compared.
+ */
+class DrawConstantDeliveryTest : public vkbtest::VulkanTest
+{
+  public:
+	/// Number of timed recordings of the scene per strategy
+	static constexpr uint32_t repetition_count = 20;
+
+	DrawConstantDeliveryTest();
+
+	virtual ~DrawConstantDeliveryTest() = default;
+
+	virtual bool prepare(vkb::Platform &platform) override;
+
+	virtual void update(float delta_time) override;
+
+  private:
+	class TimingSubpass : public vkb::ForwardSubpass
+	{
+	  public:
+		TimingSubpass(vkb::RenderContext &render_context, vkb::ShaderSource &&vertex_shader, vkb::ShaderSource &&fragment_shader, vkb::sg::Scene &scene, vkb::sg::Camera &camera);
+
+		virtual void draw(vkb::CommandBuffer &command_buffer) override;
+	};
+
+	virtual void request_gpu_features(vkb::PhysicalDevice &gpu) override;
+};
+
+std::unique_ptr<vkb::VulkanSample> create_draw_constant_delivery_test();
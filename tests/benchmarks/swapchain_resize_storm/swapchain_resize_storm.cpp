@@ -0,0 +1,135 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "swapchain_resize_storm.h"
+
+#include <algorithm>
+
+#include "common/logging.h"
+#include "platform/platform.h"
+#include "rendering/render_context.h"
+#include "timer.h"
+
+namespace
+{
+/// The extents the swapchain alternates between, which the surface may clamp
+const std::vector<VkExtent2D> resize_extents{{1280, 720}, {640, 480}, {1024, 1024}, {800, 600}};
+}        // namespace
+
+SwapchainResizeStormTest::ClearSubpass::ClearSubpass(vkb::RenderContext &render_context, vkb::ShaderSource &&vertex_shader, vkb::ShaderSource &&fragment_shader) :
+    vkb::Subpass{render_context, std::move(vertex_shader), std::move(fragment_shader)}
+{
+}
+
+void SwapchainResizeStormTest::ClearSubpass::prepare()
+{
+}
+
+void SwapchainResizeStormTest::ClearSubpass::draw(vkb::CommandBuffer &command_buffer)
+{
+	// The attachments are cleared by the load operation of the render pass
+}
+
+bool SwapchainResizeStormTest::prepare(vkb::Platform &platform)
+{
+	if (!VulkanTest::prepare(platform))
+	{
+		return false;
+	}
+
+	if (!get_render_context().has_swapchain())
+	{
+		LOGE("The swapchain resize storm needs a swapchain, run it with a window, with --headless-surface on a driver supporting VK_EXT_headless_surface or with --null-device");
+		return false;
+	}
+
+	vkb::ShaderSource vert_shader("base.vert");
+	vkb::ShaderSource frag_shader("base.frag");
+
+	auto render_pipeline = vkb::RenderPipeline();
+	render_pipeline.add_subpass(std::make_unique<ClearSubpass>(get_render_context(), std::move(vert_shader), std::move(frag_shader)));
+
+	set_render_pipeline(std::move(render_pipeline));
+
+	resize_frame_times.reserve(frame_count / resize_interval + 1);
+	steady_frame_times.reserve(frame_count);
+
+	return true;
+}
+
+void SwapchainResizeStormTest::update(float delta_time)
+{
+	if (frame_index == warmup_frame_count)
+	{
+		warmup_wait_idle_count = get_device().get_wait_idle_count();
+	}
+
+	bool resize = frame_index >= warmup_frame_count && (frame_index - warmup_frame_count) % resize_interval == 0;
+
+	vkb::Timer timer;
+	timer.start();
+
+	if (resize)
+	{
+		auto &extent = resize_extents[(frame_index / resize_interval) % resize_extents.size()];
+		get_render_context().update_swapchain(extent);
+	}
+
+	vkb::VulkanSample::update(delta_time);
+
+	auto elapsed = timer.stop<vkb::Timer::Milliseconds>();
+
+	if (frame_index >= warmup_frame_count)
+	{
+		(resize ? resize_frame_times : steady_frame_times).push_back(elapsed);
+	}
+
+	if (++frame_index < warmup_frame_count + frame_count)
+	{
+		return;
+	}
+
+	log_frame_times("recreating the swapchain", resize_frame_times);
+	log_frame_times("without recreation", steady_frame_times);
+
+	auto wait_idle_count = get_device().get_wait_idle_count() - warmup_wait_idle_count;
+	if (wait_idle_count > 0)
+	{
+		LOGE("The device waited for idle {} times during the timed frames", wait_idle_count);
+		throw std::runtime_error("Swapchain recreation waited for the device to idle");
+	}
+
+	end();
+}
+
+void SwapchainResizeStormTest::log_frame_times(const char *description, std::vector<double> &frame_times)
+{
+	if (frame_times.empty())
+	{
+		return;
+	}
+
+	std::sort(frame_times.begin(), frame_times.end());
+
+	LOGI("{} frames {}: median {:.3f} ms, worst {:.3f} ms",
+	     frame_times.size(), description, frame_times[frame_times.size() / 2], frame_times.back());
+}
+
+std::unique_ptr<vkb::VulkanSample> create_swapchain_resize_storm_test()
+{
+	return std::make_unique<SwapchainResizeStormTest>();
+}
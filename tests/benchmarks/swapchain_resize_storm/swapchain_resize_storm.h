@@ -0,0 +1,82 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "rendering/subpass.h"
+#include "vulkan_test.h"
+
+/**
+ * @brief Measures the frame times while the swapchain is recreated every few frames
+ *
+ * Renders an empty render pass and alternates the swapchain between several extents, then logs
+ * the median and worst frame time of the frames recreating the swapchain and of the other frames.
+ * Retired swapchains are destroyed once the frames in flight completed, so the test fails if the
+ * device waited for idle during the timed frames. No image is compared.
+ *
+ * It needs a swapchain: run it with a window, or with --headless-surface on a driver supporting
+ * VK_EXT_headless_surface, or with --null-device.
+ */
+class SwapchainResizeStormTest : public vkbtest::VulkanTest
+{
+  public:
+	/// Number of frames rendered before the first recreation
+	static constexpr uint32_t warmup_frame_count = 10;
+
+	/// Number of frames timed after the warmup frames
+	static constexpr uint32_t frame_count = 300;
+
+	/// The swapchain is recreated every resize_interval frames
+	static constexpr uint32_t resize_interval = 3;
+
+	SwapchainResizeStormTest() = default;
+
+	virtual ~SwapchainResizeStormTest() = default;
+
+	virtual bool prepare(vkb::Platform &platform) override;
+
+	virtual void update(float delta_time) override;
+
+  private:
+	/**
+	 * @brief Only clears the render target, so that the frame time is dominated by the swapchain recreation
+	 */
+	class ClearSubpass : public vkb::Subpass
+	{
+	  public:
+		ClearSubpass(vkb::RenderContext &render_context, vkb::ShaderSource &&vertex_shader, vkb::ShaderSource &&fragment_shader);
+
+		virtual void prepare() override;
+
+		virtual void draw(vkb::CommandBuffer &command_buffer) override;
+	};
+
+	void log_frame_times(const char *description, std::vector<double> &frame_times);
+
+	uint32_t frame_index{0};
+
+	/// Device wait idle count once the warmup frames were rendered
+	uint32_t warmup_wait_idle_count{0};
+
+	/// Frame times in milliseconds of the frames recreating the swapchain
+	std::vector<double> resize_frame_times;
+
+	/// Frame times in milliseconds of the other frames
+	std::vector<double> steady_frame_times;
+};
+
+std::unique_ptr<vkb::VulkanSample> create_swapchain_resize_storm_test();
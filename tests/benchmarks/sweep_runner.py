@@ -0,0 +1,233 @@
+'''
+Copyright (c) 2023, Arm Limited and Contributors
+
+SPDX-License-Identifier: Apache-2.0
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+'''
+
+# Runs a matrix of samples x configurations x options, each run in its own process,
+# and writes one report with the frame time statistics of every combination.
+#
+# The matrix is a JSON file:
+# {
+#     "frames": 600,
+#     "warmup": 60,
+#     "repeat": 3,
+#     "arguments": ["--headless"],
+#     "runs": [
+#         { "sample": "constant_data", "configurations": [0, 1, 2, 3, 4] },
+#         { "sample": "compute_nbody", "options": { "nbody_particles": ["4096", "16384"] } }
+#     ]
+# }
+#
+# "frames", "warmup", "repeat" and "arguments" can also be set per run. Every value of every
+# option is combined with every configuration. The frame times come from --benchmark-output.
+
+import sys, os, json, math, csv, argparse, itertools, subprocess, platform
+from concurrent.futures import ThreadPoolExecutor
+
+script_path  = os.path.dirname(os.path.realpath(__file__))
+root_path    = os.path.normpath(os.path.join(script_path, "../../"))
+logs_path    = "output/logs/"
+output_stem  = "sweep_run_"
+
+class Run:
+    def __init__(self, index, sample, configuration, options, arguments, frames, warmup, repetition):
+        self.index         = index
+        self.sample        = sample
+        self.configuration = configuration
+        self.options       = options
+        self.arguments     = arguments
+        self.frames        = frames
+        self.warmup        = warmup
+        self.repetition    = repetition
+        self.frame_times   = []
+        self.error         = ""
+
+    def key(self):
+        return (self.sample, self.configuration, tuple(sorted(self.options.items())), tuple(self.arguments))
+
+    def output_name(self):
+        return "{}{}.json".format(output_stem, self.index)
+
+    def command(self, application):
+        command = [application, "sample", self.sample,
+                   "--benchmark", "--benchmark-output", self.output_name(),
+                   "--stop-after-frame", str(self.frames + self.warmup),
+                   "--force-close"]
+        if self.configuration is not None:
+            command += ["--configuration", str(self.configuration)]
+        for key, value in sorted(self.options.items()):
+            command += ["--option", "{}={}".format(key, value)]
+        return command + self.arguments
+
+def expand_matrix(matrix):
+    runs = []
+    for entry in matrix["runs"]:
+        frames         = entry.get("frames", matrix.get("frames", 600))
+        warmup         = entry.get("warmup", matrix.get("warmup", 60))
+        repeat         = entry.get("repeat", matrix.get("repeat", 1))
+        arguments      = matrix.get("arguments", []) + entry.get("arguments", [])
+        configurations = entry.get("configurations", [None])
+        option_keys    = sorted(entry.get("options", {}))
+        option_values  = [entry["options"][key] for key in option_keys]
+
+        for configuration in configurations:
+            for values in itertools.product(*option_values):
+                for repetition in range(repeat):
+                    options = dict(zip(option_keys, [str(value) for value in values]))
+                    runs.append(Run(len(runs), entry["sample"], configuration, options, arguments, frames, warmup, repetition))
+    return runs
+
+def execute(run, application, environment, timeout):
+    output_path = os.path.join(root_path, logs_path, run.output_name())
+    if os.path.exists(output_path):
+        os.remove(output_path)
+
+    log_path = os.path.join(root_path, logs_path, "{}{}.log".format(output_stem, run.index))
+    try:
+        with open(log_path, "w") as log:
+            result = subprocess.run(run.command(application), cwd=root_path, env=environment, stdout=log, stderr=subprocess.STDOUT, timeout=timeout)
+        if result.returncode != 0:
+            run.error = "exit code {}".format(result.returncode)
+    except subprocess.TimeoutExpired:
+        run.error = "timed out"
+    except OSError as error:
+        run.error = str(error)
+
+    try:
+        with open(output_path) as file:
+            run.frame_times = json.load(file)["frame_times_ms"][run.warmup:]
+    except (OSError, ValueError, KeyError):
+        if not run.error:
+            run.error = "no benchmark output"
+
+    print("\t{} {} {}: {}".format(run.sample, describe(run.configuration, run.options), "#{}".format(run.repetition), run.error if run.error else "{} frames".format(len(run.frame_times))))
+    return run
+
+def describe(configuration, options):
+    parts = []
+    if configuration is not None:
+        parts.append("configuration={}".format(configuration))
+    parts += ["{}={}".format(key, value) for key, value in sorted(options.items())]
+    return " ".join(parts)
+
+def percentile(ordered, fraction):
+    # Nearest rank
+    if not ordered:
+        return float("nan")
+    rank = max(int(math.ceil(fraction * len(ordered))), 1)
+    return ordered[rank - 1]
+
+def median(ordered):
+    if not ordered:
+        return float("nan")
+    middle = len(ordered) // 2
+    if len(ordered) % 2:
+        return ordered[middle]
+    return (ordered[middle - 1] + ordered[middle]) / 2.0
+
+def summarize(runs):
+    groups = {}
+    for run in runs:
+        groups.setdefault(run.key(), []).append(run)
+
+    rows = []
+    for group in groups.values():
+        first       = group[0]
+        frame_times = sorted(time for run in group for time in run.frame_times)
+        failed      = [run for run in group if run.error]
+        rows.append({
+            "sample":        first.sample,
+            "configuration": "" if first.configuration is None else first.configuration,
+            "options":       describe(None, first.options),
+            "arguments":     " ".join(first.arguments),
+            "runs":          len(group),
+            "failed":        len(failed),
+            "frames":        len(frame_times),
+            "mean_ms":       sum(frame_times) / len(frame_times) if frame_times else float("nan"),
+            "median_ms":     median(frame_times),
+            "p99_ms":        percentile(frame_times, 0.99),
+            "min_ms":        frame_times[0] if frame_times else float("nan"),
+            "max_ms":        frame_times[-1] if frame_times else float("nan"),
+            "errors":        "; ".join(sorted(set(run.error for run in failed)))
+        })
+    return rows
+
+def write_report(rows, runs, output):
+    with open(output + ".csv", "w", newline="") as file:
+        writer = csv.DictWriter(file, fieldnames=list(rows[0].keys()))
+        writer.writeheader()
+        for row in rows:
+            writer.writerow({key: "{:.3f}".format(value) if isinstance(value, float) else value for key, value in row.items()})
+
+    report = {
+        "system":  {"platform": platform.platform(), "machine": platform.machine()},
+        "results": [{key: (None if isinstance(value, float) and math.isnan(value) else value) for key, value in row.items()} for row in rows],
+        "runs":    [{"sample": run.sample, "configuration": run.configuration, "options": run.options, "arguments": run.arguments,
+                     "repetition": run.repetition, "error": run.error, "frame_times_ms": run.frame_times} for run in runs]
+    }
+    with open(output + ".json", "w") as file:
+        json.dump(report, file, indent=1)
+
+def main():
+    parser = argparse.ArgumentParser(description="Run a matrix of samples and options, and report their frame times")
+    parser.add_argument("matrix", help="JSON file describing the runs")
+    parser.add_argument("-a", "--app", required=True, help="Path to the vulkan_samples executable")
+    parser.add_argument("-o", "--output", default="sweep", help="Path of the report, without extension (default sweep)")
+    parser.add_argument("-j", "--jobs", type=int, default=1, help="Number of runs at the same time, only used with a software device")
+    parser.add_argument("--icd", help="Vulkan ICD manifest of a software device, such as lavapipe or SwiftShader, to run on")
+    parser.add_argument("--timeout", type=float, default=600.0, help="Seconds after which a run is stopped (default 600)")
+    args = parser.parse_args()
+
+    with open(args.matrix) as file:
+        runs = expand_matrix(json.load(file))
+
+    if not runs:
+        print("No runs in {}".format(args.matrix))
+        sys.exit(1)
+
+    application = os.path.abspath(args.app)
+    environment = dict(os.environ)
+    if args.icd:
+        environment["VK_ICD_FILENAMES"] = os.path.abspath(args.icd)
+
+    # Runs sharing a GPU would skew each other's frame times, on the CPU they only share cores
+    jobs        = args.jobs
+    on_software = args.icd is not None or all("--null-device" in run.arguments for run in runs)
+    if jobs > 1 and not on_software:
+        print("Running one job at a time, parallel runs need --icd with a software device or --null-device")
+        jobs = 1
+
+    os.makedirs(os.path.join(root_path, logs_path), exist_ok=True)
+
+    print("Running {} runs, {} at a time".format(len(runs), jobs))
+    with ThreadPoolExecutor(max_workers=jobs) as executor:
+        runs = list(executor.map(lambda run: execute(run, application, environment, args.timeout), runs))
+
+    rows = summarize(runs)
+    write_report(rows, runs, args.output)
+
+    name_width = max(len(row["sample"]) + len(row["options"]) + len(str(row["configuration"])) for row in rows) + 2
+    print("{:<{}}  {:>10}  {:>10}  {:>8}".format("Run", name_width, "Median ms", "P99 ms", "Failed"))
+    for row in rows:
+        name = " ".join(str(part) for part in (row["sample"], row["configuration"], row["options"]) if part != "")
+        print("{:<{}}  {:>10.3f}  {:>10.3f}  {:>8}".format(name, name_width, row["median_ms"], row["p99_ms"], row["failed"]))
+    print("Report written to {}.csv and {}.json".format(args.output, args.output))
+
+    if any(row["failed"] for row in rows):
+        sys.exit(1)
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,323 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "image_compare.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image_write.h>
+
+namespace vkbcompare
+{
+namespace
+{
+/**
+ * @brief Sums of one tile, reduced in tile order once all threads finished so that the result does not depend on the thread count
+ */
+struct TileSums
+{
+	uint64_t absolute_error{0};
+
+	uint64_t squared_error{0};
+
+	double ssim{0.0};
+
+	uint32_t ssim_windows{0};
+};
+
+constexpr uint32_t color_channels = 3;
+
+// Keeps the squared error of a tile row within 32 bits
+constexpr uint32_t max_tile_size = 4096;
+
+constexpr double ssim_c1 = (0.01 * 255.0) * (0.01 * 255.0);
+
+constexpr double ssim_c2 = (0.03 * 255.0) * (0.03 * 255.0);
+
+inline float get_luma(const uint8_t *pixel)
+{
+	return 0.299f * pixel[0] + 0.587f * pixel[1] + 0.114f * pixel[2];
+}
+
+/**
+ * @brief Structural similarity of the luminance of a window of at most ssim_window x ssim_window pixels
+ */
+double get_window_ssim(const Image &base, const Image &test, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+{
+	float base_luma[ssim_window * ssim_window];
+	float test_luma[ssim_window * ssim_window];
+
+	uint32_t count = 0;
+	for (uint32_t row = y; row < y + height; ++row)
+	{
+		const uint8_t *base_pixel = &base.pixels[(row * base.width + x) * 4];
+		const uint8_t *test_pixel = &test.pixels[(row * test.width + x) * 4];
+
+		for (uint32_t column = 0; column < width; ++column, ++count)
+		{
+			base_luma[count] = get_luma(base_pixel + column * 4);
+			test_luma[count] = get_luma(test_pixel + column * 4);
+		}
+	}
+
+	float base_sum = 0.0f;
+	float test_sum = 0.0f;
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		base_sum += base_luma[i];
+		test_sum += test_luma[i];
+	}
+
+	float base_mean = base_sum / count;
+	float test_mean = test_sum / count;
+
+	float base_variance = 0.0f;
+	float test_variance = 0.0f;
+	float covariance    = 0.0f;
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		float base_delta = base_luma[i] - base_mean;
+		float test_delta = test_luma[i] - test_mean;
+		base_variance += base_delta * base_delta;
+		test_variance += test_delta * test_delta;
+		covariance += base_delta * test_delta;
+	}
+
+	base_variance /= count;
+	test_variance /= count;
+	covariance /= count;
+
+	return ((2.0 * base_mean * test_mean + ssim_c1) * (2.0 * covariance + ssim_c2)) /
+	       ((static_cast<double>(base_mean) * base_mean + static_cast<double>(test_mean) * test_mean + ssim_c1) * (static_cast<double>(base_variance) + test_variance + ssim_c2));
+}
+
+void compare_tile(const Image &base, const Image &test, const Options &options, uint32_t tile_size, TileDifference &tile, TileSums &sums, Image *diff)
+{
+	uint32_t width  = std::min(tile_size, base.width - tile.x);
+	uint32_t height = std::min(tile_size, base.height - tile.y);
+
+	uint32_t max_error = 0;
+
+	for (uint32_t row = tile.y; row < tile.y + height; ++row)
+	{
+		size_t         offset     = (static_cast<size_t>(row) * base.width + tile.x) * 4;
+		const uint8_t *base_pixel = &base.pixels[offset];
+		const uint8_t *test_pixel = &test.pixels[offset];
+
+		// Branch free loop over a row, which the compiler vectorizes
+		uint32_t row_absolute_error = 0;
+		uint32_t row_squared_error  = 0;
+		uint32_t row_max_error      = 0;
+		uint32_t row_different      = 0;
+		for (uint32_t i = 0; i < width * 4; i += 4)
+		{
+			int32_t r = std::abs(static_cast<int32_t>(base_pixel[i]) - test_pixel[i]);
+			int32_t g = std::abs(static_cast<int32_t>(base_pixel[i + 1]) - test_pixel[i + 1]);
+			int32_t b = std::abs(static_cast<int32_t>(base_pixel[i + 2]) - test_pixel[i + 2]);
+
+			uint32_t pixel_error = static_cast<uint32_t>(std::max(r, std::max(g, b)));
+
+			row_absolute_error += r + g + b;
+			row_squared_error += r * r + g * g + b * b;
+			row_max_error = std::max(row_max_error, pixel_error);
+			row_different += pixel_error > options.pixel_tolerance ? 1 : 0;
+		}
+
+		sums.absolute_error += row_absolute_error;
+		sums.squared_error += row_squared_error;
+		max_error = std::max(max_error, row_max_error);
+		tile.different_pixels += row_different;
+
+		if (diff)
+		{
+			uint8_t *diff_pixel = &diff->pixels[offset];
+			for (uint32_t i = 0; i < width * 4; i += 4)
+			{
+				uint32_t pixel_error = std::max(std::abs(base_pixel[i] - test_pixel[i]),
+				                                std::max(std::abs(base_pixel[i + 1] - test_pixel[i + 1]), std::abs(base_pixel[i + 2] - test_pixel[i + 2])));
+				if (pixel_error > options.pixel_tolerance)
+				{
+					// Stronger red for larger errors, so that small rounding differences stay visible but distinct
+					diff_pixel[i]     = 255;
+					diff_pixel[i + 1] = static_cast<uint8_t>(std::max(0, 160 - static_cast<int32_t>(pixel_error)));
+					diff_pixel[i + 2] = diff_pixel[i + 1];
+				}
+				else
+				{
+					uint8_t grey      = static_cast<uint8_t>(192 + static_cast<uint32_t>(get_luma(test_pixel + i)) / 4);
+					diff_pixel[i]     = grey;
+					diff_pixel[i + 1] = grey;
+					diff_pixel[i + 2] = grey;
+				}
+				diff_pixel[i + 3] = 255;
+			}
+		}
+	}
+
+	for (uint32_t y = tile.y; y < tile.y + height; y += ssim_window)
+	{
+		for (uint32_t x = tile.x; x < tile.x + width; x += ssim_window)
+		{
+			sums.ssim += get_window_ssim(base, test, x, y, std::min(ssim_window, tile.x + width - x), std::min(ssim_window, tile.y + height - y));
+			sums.ssim_windows++;
+		}
+	}
+
+	tile.mean_error = static_cast<float>(sums.absolute_error / (255.0 * color_channels * width * height));
+	tile.max_error  = max_error / 255.0f;
+
+	// Outline the tile, which is only written by this thread
+	if (diff && tile.different_pixels > 0)
+	{
+		for (uint32_t y = tile.y; y < tile.y + height; ++y)
+		{
+			for (uint32_t x = tile.x; x < tile.x + width; ++x)
+			{
+				if (y == tile.y || y == tile.y + height - 1 || x == tile.x || x == tile.x + width - 1)
+				{
+					uint8_t *diff_pixel = &diff->pixels[(static_cast<size_t>(y) * diff->width + x) * 4];
+					diff_pixel[0]       = 255;
+					diff_pixel[1]       = 160;
+					diff_pixel[2]       = 0;
+				}
+			}
+		}
+	}
+}
+}        // namespace
+
+Image load_image(const std::string &filename)
+{
+	int width;
+	int height;
+	int components;
+
+	stbi_uc *data = stbi_load(filename.c_str(), &width, &height, &components, 4);
+	if (!data)
+	{
+		throw std::runtime_error("Failed to load " + filename + ": " + stbi_failure_reason());
+	}
+
+	Image image;
+	image.width  = static_cast<uint32_t>(width);
+	image.height = static_cast<uint32_t>(height);
+	image.pixels.assign(data, data + static_cast<size_t>(width) * height * 4);
+
+	stbi_image_free(data);
+
+	return image;
+}
+
+void save_image(const Image &image, const std::string &filename)
+{
+	if (!stbi_write_png(filename.c_str(), image.width, image.height, 4, image.pixels.data(), image.width * 4))
+	{
+		throw std::runtime_error("Failed to write " + filename);
+	}
+}
+
+Comparison compare(const Image &base, const Image &test, const Options &options, Image *diff)
+{
+	if (base.width != test.width || base.height != test.height)
+	{
+		throw std::runtime_error("Image sizes differ: " + std::to_string(base.width) + "x" + std::to_string(base.height) +
+		                         " and " + std::to_string(test.width) + "x" + std::to_string(test.height));
+	}
+
+	Comparison comparison;
+	comparison.tile_size    = std::max(ssim_window, (std::min(options.tile_size, max_tile_size) + ssim_window - 1) / ssim_window * ssim_window);
+	comparison.tile_columns = (base.width + comparison.tile_size - 1) / comparison.tile_size;
+	comparison.tile_rows    = (base.height + comparison.tile_size - 1) / comparison.tile_size;
+
+	uint32_t tile_count = comparison.tile_columns * comparison.tile_rows;
+	if (tile_count == 0)
+	{
+		comparison.psnr = max_psnr;
+		comparison.ssim = 1.0;
+		return comparison;
+	}
+
+	comparison.tiles.resize(tile_count);
+	for (uint32_t i = 0; i < tile_count; ++i)
+	{
+		comparison.tiles[i].x = (i % comparison.tile_columns) * comparison.tile_size;
+		comparison.tiles[i].y = (i / comparison.tile_columns) * comparison.tile_size;
+	}
+
+	if (diff)
+	{
+		diff->width  = base.width;
+		diff->height = base.height;
+		diff->pixels.resize(base.pixels.size());
+	}
+
+	std::vector<TileSums> sums(tile_count);
+
+	// Threads take the next tile until none are left, which balances tiles of different cost
+	std::atomic<uint32_t> next_tile{0};
+
+	auto worker = [&]() {
+		for (uint32_t i = next_tile++; i < tile_count; i = next_tile++)
+		{
+			compare_tile(base, test, options, comparison.tile_size, comparison.tiles[i], sums[i], diff);
+		}
+	};
+
+	uint32_t thread_count = options.thread_count ? options.thread_count : std::max(1u, std::thread::hardware_concurrency());
+	thread_count          = std::min(thread_count, tile_count);
+
+	std::vector<std::thread> threads;
+	for (uint32_t i = 1; i < thread_count; ++i)
+	{
+		threads.emplace_back(worker);
+	}
+	worker();
+	for (auto &thread : threads)
+	{
+		thread.join();
+	}
+
+	uint64_t absolute_error = 0;
+	uint64_t squared_error  = 0;
+	double   ssim           = 0.0;
+	uint32_t ssim_windows   = 0;
+	for (uint32_t i = 0; i < tile_count; ++i)
+	{
+		absolute_error += sums[i].absolute_error;
+		squared_error += sums[i].squared_error;
+		ssim += sums[i].ssim;
+		ssim_windows += sums[i].ssim_windows;
+		comparison.different_pixels += comparison.tiles[i].different_pixels;
+	}
+
+	double samples = static_cast<double>(base.width) * base.height * color_channels;
+
+	comparison.mae  = absolute_error / (255.0 * samples);
+	comparison.rmse = std::sqrt(squared_error / samples) / 255.0;
+	comparison.psnr = comparison.rmse > 0.0 ? std::min(max_psnr, -20.0 * std::log10(comparison.rmse)) : max_psnr;
+	comparison.ssim = ssim / ssim_windows;
+
+	return comparison;
+}
+}        // namespace vkbcompare
@@ -0,0 +1,125 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace vkbcompare
+{
+/**
+ * @brief An 8-bit RGBA image
+ */
+struct Image
+{
+	uint32_t width{0};
+
+	uint32_t height{0};
+
+	std::vector<uint8_t> pixels;
+};
+
+/**
+ * @brief Loads a PNG, JPEG, TGA or BMP file as RGBA
+ * @throws std::runtime_error if the file cannot be read
+ */
+Image load_image(const std::string &filename);
+
+/**
+ * @brief Writes an image as PNG
+ * @throws std::runtime_error if the file cannot be written
+ */
+void save_image(const Image &image, const std::string &filename);
+
+struct Options
+{
+	/// Width and height of the tiles of the difference map, rounded up to a multiple of the SSIM window
+	uint32_t tile_size{32};
+
+	/// Number of threads comparing tiles, 0 for one per hardware thread
+	uint32_t thread_count{0};
+
+	/// Largest channel difference of a pixel still counted as identical
+	uint8_t pixel_tolerance{0};
+};
+
+/**
+ * @brief Errors of a square region of the images
+ */
+struct TileDifference
+{
+	uint32_t x{0};
+
+	uint32_t y{0};
+
+	/// Mean absolute error of the color channels, between 0 and 1
+	float mean_error{0.0f};
+
+	/// Largest channel difference, between 0 and 1
+	float max_error{0.0f};
+
+	uint32_t different_pixels{0};
+};
+
+/**
+ * @brief Result of comparing two images of the same size
+ *
+ * The errors are measured on the color channels only, alpha is ignored.
+ */
+struct Comparison
+{
+	/// Mean absolute error, between 0 and 1
+	double mae{0.0};
+
+	/// Root mean squared error, between 0 and 1
+	double rmse{0.0};
+
+	/// Peak signal to noise ratio in dB, capped to max_psnr for identical images
+	double psnr{0.0};
+
+	/// Mean structural similarity of the luminance over 8x8 windows, 1 for identical images
+	double ssim{0.0};
+
+	uint32_t different_pixels{0};
+
+	uint32_t tile_size{0};
+
+	uint32_t tile_columns{0};
+
+	uint32_t tile_rows{0};
+
+	/// Row major, tile_columns x tile_rows
+	std::vector<TileDifference> tiles;
+};
+
+constexpr double max_psnr = 100.0;
+
+constexpr uint32_t ssim_window = 8;
+
+/**
+ * @brief Compares two images tile by tile on several threads
+ * @param base The reference image
+ * @param test The image to check
+ * @param options Tile size, thread count and tolerance
+ * @param diff If not null, receives the test image faded to grey, with the different pixels in red
+ *             and the tiles containing them outlined
+ * @throws std::runtime_error if the images have different sizes
+ */
+Comparison compare(const Image &base, const Image &test, const Options &options, Image *diff = nullptr);
+}        // namespace vkbcompare
@@ -0,0 +1,249 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+#include <json.hpp>
+
+#include "image_compare.h"
+
+namespace
+{
+struct Pair
+{
+	std::string base;
+
+	std::string test;
+
+	/// Written when the images differ, empty for none
+	std::string diff;
+};
+
+void print_usage()
+{
+	std::cout << "Usage: vkb_image_compare [options] <base> <test> [<diff>]\n"
+	          << "       vkb_image_compare [options] --list <file>\n"
+	          << "  --list <file>        Compare the pairs of a file, one per line: base, test and optionally diff, separated by tabs\n"
+	          << "  --output <file>      Write the metrics of every pair to a JSON file\n"
+	          << "  --threshold <value>  Fail the pairs with a similarity (1 - MAE) below the value (default 0)\n"
+	          << "  --tolerance <value>  Largest channel difference of a pixel still counted as identical (default 0)\n"
+	          << "  --tile <size>        Size of the tiles of the difference map in pixels (default 32)\n"
+	          << "  --threads <count>    Number of threads (default: one per hardware thread)\n";
+}
+
+std::vector<Pair> read_pairs(const std::string &filename)
+{
+	std::ifstream file{filename};
+	if (!file)
+	{
+		throw std::runtime_error("Failed to open " + filename);
+	}
+
+	std::vector<Pair> pairs;
+
+	std::string line;
+	while (std::getline(file, line))
+	{
+		if (!line.empty() && line.back() == '\r')
+		{
+			line.pop_back();
+		}
+		if (line.empty())
+		{
+			continue;
+		}
+
+		std::vector<std::string> fields;
+		size_t                   start = 0;
+		for (size_t tab = line.find('\t'); tab != std::string::npos; tab = line.find('\t', start))
+		{
+			fields.push_back(line.substr(start, tab - start));
+			start = tab + 1;
+		}
+		fields.push_back(line.substr(start));
+
+		if (fields.size() < 2 || fields.size() > 3)
+		{
+			throw std::runtime_error("Invalid line in " + filename + ": " + line);
+		}
+
+		pairs.push_back({fields[0], fields[1], fields.size() == 3 ? fields[2] : ""});
+	}
+
+	return pairs;
+}
+
+nlohmann::json to_json(const vkbcompare::Comparison &comparison)
+{
+	// Only the tiles with differences, which is what the diff image highlights
+	nlohmann::json tiles = nlohmann::json::array();
+	for (auto &tile : comparison.tiles)
+	{
+		if (tile.different_pixels > 0)
+		{
+			tiles.push_back({{"x", tile.x},
+			                 {"y", tile.y},
+			                 {"mean_error", tile.mean_error},
+			                 {"max_error", tile.max_error},
+			                 {"different_pixels", tile.different_pixels}});
+		}
+	}
+
+	return {{"similarity", 1.0 - comparison.mae},
+	        {"mae", comparison.mae},
+	        {"rmse", comparison.rmse},
+	        {"psnr", comparison.psnr},
+	        {"ssim", comparison.ssim},
+	        {"different_pixels", comparison.different_pixels},
+	        {"tile_size", comparison.tile_size},
+	        {"tiles", tiles}};
+}
+}        // namespace
+
+int main(int argc, char *argv[])
+{
+	vkbcompare::Options options;
+	std::vector<Pair>   pairs;
+	std::string         output;
+	double              threshold = 0.0;
+
+	std::vector<std::string> positional;
+
+	try
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			std::string argument  = argv[i];
+			bool        has_value = i + 1 < argc;
+
+			if (argument == "--list" && has_value)
+			{
+				auto listed = read_pairs(argv[++i]);
+				pairs.insert(pairs.end(), listed.begin(), listed.end());
+			}
+			else if (argument == "--output" && has_value)
+			{
+				output = argv[++i];
+			}
+			else if (argument == "--threshold" && has_value)
+			{
+				threshold = std::stod(argv[++i]);
+			}
+			else if (argument == "--tolerance" && has_value)
+			{
+				options.pixel_tolerance = static_cast<uint8_t>(std::min(255, std::max(0, std::stoi(argv[++i]))));
+			}
+			else if (argument == "--tile" && has_value)
+			{
+				options.tile_size = static_cast<uint32_t>(std::max(1, std::stoi(argv[++i])));
+			}
+			else if (argument == "--threads" && has_value)
+			{
+				options.thread_count = static_cast<uint32_t>(std::max(0, std::stoi(argv[++i])));
+			}
+			else if (argument.compare(0, 2, "--") != 0)
+			{
+				positional.push_back(argument);
+			}
+			else
+			{
+				print_usage();
+				return argument == "--help" ? 0 : 1;
+			}
+		}
+	}
+	catch (const std::exception &e)
+	{
+		std::cerr << e.what() << "\n";
+		return 1;
+	}
+
+	if (positional.size() == 2 || positional.size() == 3)
+	{
+		pairs.push_back({positional[0], positional[1], positional.size() == 3 ? positional[2] : ""});
+	}
+	else if (!positional.empty() || pairs.empty())
+	{
+		print_usage();
+		return 1;
+	}
+
+	nlohmann::json results = nlohmann::json::array();
+	uint32_t       failed  = 0;
+
+	// The pairs are compared one after the other, each of them on all threads
+	for (auto &pair : pairs)
+	{
+		nlohmann::json result = {{"base", pair.base}, {"test", pair.test}};
+
+		try
+		{
+			auto base = vkbcompare::load_image(pair.base);
+			auto test = vkbcompare::load_image(pair.test);
+
+			vkbcompare::Image diff;
+			auto              comparison = vkbcompare::compare(base, test, options, pair.diff.empty() ? nullptr : &diff);
+
+			bool passed = 1.0 - comparison.mae >= threshold;
+			if (!pair.diff.empty() && comparison.different_pixels > 0)
+			{
+				vkbcompare::save_image(diff, pair.diff);
+				result["diff"] = pair.diff;
+			}
+
+			result.update(to_json(comparison));
+			result["width"]  = base.width;
+			result["height"] = base.height;
+			result["passed"] = passed;
+
+			std::cout << std::fixed << std::setprecision(4)
+			          << pair.test << ": similarity " << 100.0 * (1.0 - comparison.mae) << "%, RMSE " << comparison.rmse
+			          << ", PSNR " << std::setprecision(2) << comparison.psnr << " dB, SSIM " << std::setprecision(4) << comparison.ssim
+			          << ", " << comparison.different_pixels << " different pixels" << (passed ? "" : " (failed)") << "\n";
+
+			failed += passed ? 0 : 1;
+		}
+		catch (const std::exception &e)
+		{
+			std::cerr << pair.test << ": " << e.what() << "\n";
+
+			result["passed"] = false;
+			result["error"]  = e.what();
+			failed++;
+		}
+
+		results.push_back(result);
+	}
+
+	if (!output.empty())
+	{
+		std::ofstream file{output};
+		if (!file)
+		{
+			std::cerr << "Failed to open " << output << " for writing\n";
+			return 1;
+		}
+
+		file << nlohmann::json{{"threshold", threshold}, {"results", results}}.dump(2) << "\n";
+	}
+
+	return failed == 0 ? 0 : 1;
+}
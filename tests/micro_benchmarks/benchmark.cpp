@@ -0,0 +1,219 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "common/error.h"
+#include "common/logging.h"
+#include "core/debug.h"
+#include "core/device.h"
+#include "core/instance.h"
+#include "core/null_device.h"
+#include "platform/headless_window.h"
+#include "rendering/render_context.h"
+#include "timer.h"
+
+namespace vkbbench
+{
+namespace
+{
+volatile uint64_t sink{0};
+
+/// Iteration counts are never raised above this, to bound the duration of very cheap benchmarks
+constexpr uint64_t max_iterations = uint64_t{1} << 30;
+
+double time_iterations(const BenchmarkFunction &function, uint64_t iterations)
+{
+	vkb::Timer timer;
+	timer.start();
+
+	function(iterations);
+
+	return timer.stop<vkb::Timer::Milliseconds>();
+}
+
+double median(std::vector<double> values)
+{
+	std::sort(values.begin(), values.end());
+
+	size_t middle = values.size() / 2;
+
+	return values.size() % 2 ? values[middle] : (values[middle - 1] + values[middle]) / 2.0;
+}
+}        // namespace
+
+Context::Context() = default;
+
+Context::~Context()
+{
+	render_context.reset();
+	window.reset();
+	device.reset();
+	instance.reset();
+}
+
+vkb::Device &Context::get_device()
+{
+	if (!device)
+	{
+		vkb::null_device::enable();
+
+		VkResult result = vkb::null_device::initialize();
+		if (result)
+		{
+			throw vkb::VulkanException(result, "Failed to initialize the null device.");
+		}
+
+		instance = std::make_unique<vkb::Instance>("vkb_benchmarks", std::unordered_map<const char *, bool>{}, std::vector<const char *>{}, true);
+
+		auto &gpu = instance->get_suitable_gpu(VK_NULL_HANDLE);
+
+		device = std::make_unique<vkb::Device>(gpu, VK_NULL_HANDLE, std::make_unique<vkb::DummyDebugUtils>(), std::unordered_map<const char *, bool>{});
+	}
+
+	return *device;
+}
+
+vkb::RenderContext &Context::get_render_context()
+{
+	if (!render_context)
+	{
+		auto &device = get_device();
+
+		vkb::Window::Properties properties;
+		properties.title = "vkb_benchmarks";
+		properties.mode  = vkb::Window::Mode::Headless;
+
+		window = std::make_unique<vkb::HeadlessWindow>(properties);
+
+		render_context = std::make_unique<vkb::RenderContext>(device, VK_NULL_HANDLE, *window);
+		render_context->prepare();
+	}
+
+	return *render_context;
+}
+
+void Registry::add(const std::string &name, BenchmarkSetup &&setup)
+{
+	assert(std::none_of(entries.begin(), entries.end(), [&name](const Entry &entry) { return entry.name == name; }) &&
+	       "Benchmark names must be unique");
+
+	entries.push_back({name, std::move(setup)});
+}
+
+const std::vector<Registry::Entry> &Registry::get_entries() const
+{
+	return entries;
+}
+
+std::vector<Result> run(const Registry &registry, Context &context, const Options &options)
+{
+	std::vector<Result> results;
+
+	for (auto &entry : registry.get_entries())
+	{
+		if (entry.name.find(options.filter) == std::string::npos)
+		{
+			continue;
+		}
+
+		BenchmarkFunction function;
+
+		try
+		{
+			function = entry.setup(context);
+		}
+		catch (const std::exception &e)
+		{
+			LOGW("Skipping benchmark {}: {}", entry.name, e.what());
+			continue;
+		}
+
+		if (!function)
+		{
+			LOGW("Skipping benchmark {}", entry.name);
+			continue;
+		}
+
+		Result result;
+		result.name = entry.name;
+
+		// Warm up caches and lazily created objects before measuring
+		double elapsed = time_iterations(function, 1);
+
+		result.iterations = 1;
+		while (elapsed < options.min_sample_time && result.iterations < max_iterations)
+		{
+			result.iterations *= 2;
+			elapsed = time_iterations(function, result.iterations);
+		}
+
+		for (uint32_t i = 0; i < options.repetitions; ++i)
+		{
+			elapsed = time_iterations(function, result.iterations);
+			result.samples.push_back(elapsed * 1e6 / static_cast<double>(result.iterations));
+		}
+
+		LOGI("{:<48} {:>14.1f} ns {:>12} iterations", result.name, median(result.samples), result.iterations);
+
+		results.push_back(std::move(result));
+	}
+
+	return results;
+}
+
+nlohmann::json to_json(const std::vector<Result> &results, const Options &options)
+{
+	nlohmann::json benchmarks = nlohmann::json::array();
+
+	for (auto &result : results)
+	{
+		double mean     = std::accumulate(result.samples.begin(), result.samples.end(), 0.0) / result.samples.size();
+		double variance = 0.0;
+
+		for (auto sample : result.samples)
+		{
+			variance += (sample - mean) * (sample - mean);
+		}
+
+		if (result.samples.size() > 1)
+		{
+			variance /= result.samples.size() - 1;
+		}
+
+		benchmarks.push_back({{"name", result.name},
+		                      {"iterations", result.iterations},
+		                      {"samples_ns", result.samples},
+		                      {"median_ns", median(result.samples)},
+		                      {"mean_ns", mean},
+		                      {"stddev_ns", std::sqrt(variance)}});
+	}
+
+	return nlohmann::json{{"repetitions", options.repetitions},
+	                      {"min_sample_time_ms", options.min_sample_time},
+	                      {"benchmarks", benchmarks}};
+}
+
+void do_not_optimize(uint64_t value)
+{
+	sink = sink + value;
+}
+}        // namespace vkbbench
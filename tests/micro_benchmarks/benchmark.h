@@ -0,0 +1,153 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <json.hpp>
+
+namespace vkb
+{
+class Device;
+class Instance;
+class RenderContext;
+class Window;
+}        // namespace vkb
+
+namespace vkbbench
+{
+/**
+ * @brief Objects shared by the benchmarks, created the first time a benchmark requests them
+ *
+ * The device is a null device, so that benchmarks of framework code that needs Vulkan objects
+ * measure the CPU cost of the framework only, and run on machines without a GPU.
+ */
+class Context
+{
+  public:
+	Context();
+
+	~Context();
+
+	vkb::Device &get_device();
+
+	/**
+	 * @return A render context without a surface, rendering to headless render targets
+	 */
+	vkb::RenderContext &get_render_context();
+
+  private:
+	std::unique_ptr<vkb::Instance> instance;
+
+	std::unique_ptr<vkb::Device> device;
+
+	std::unique_ptr<vkb::Window> window;
+
+	std::unique_ptr<vkb::RenderContext> render_context;
+};
+
+/// The measured part of a benchmark, which runs the given number of iterations
+using BenchmarkFunction = std::function<void(uint64_t iteration_count)>;
+
+/**
+ * @brief Prepares the dataset of a benchmark, outside of the measurement
+ * @return The function to measure, or an empty function if the benchmark cannot run,
+ *         for example because an asset is missing
+ */
+using BenchmarkSetup = std::function<BenchmarkFunction(Context &context)>;
+
+class Registry
+{
+  public:
+	struct Entry
+	{
+		std::string name;
+
+		BenchmarkSetup setup;
+	};
+
+	/**
+	 * @brief Adds a benchmark
+	 * @param name Unique name of the benchmark, in the form group/case
+	 * @param setup Function preparing the benchmark
+	 */
+	void add(const std::string &name, BenchmarkSetup &&setup);
+
+	const std::vector<Entry> &get_entries() const;
+
+  private:
+	std::vector<Entry> entries;
+};
+
+struct Options
+{
+	/// Only the benchmarks with a name containing this string run
+	std::string filter;
+
+	/// Number of timed samples per benchmark
+	uint32_t repetitions{10};
+
+	/// Minimum duration of a sample in milliseconds, used to choose the iteration count of a benchmark
+	double min_sample_time{20.0};
+};
+
+struct Result
+{
+	std::string name;
+
+	/// Number of iterations run in each sample
+	uint64_t iterations{0};
+
+	/// Time per iteration of each sample, in nanoseconds
+	std::vector<double> samples;
+};
+
+/**
+ * @brief Runs the benchmarks of a registry
+ *
+ * Each benchmark is set up once and warmed up, then its iteration count is doubled until
+ * a sample lasts at least the minimum sample time, and that many iterations are timed for
+ * each repetition.
+ */
+std::vector<Result> run(const Registry &registry, Context &context, const Options &options);
+
+/**
+ * @brief Converts results to the JSON format read by compare_benchmarks.py
+ */
+nlohmann::json to_json(const std::vector<Result> &results, const Options &options);
+
+/**
+ * @brief Consumes a value computed by a benchmark, so that the compiler cannot remove its computation
+ */
+void do_not_optimize(uint64_t value);
+
+void register_hashing_benchmarks(Registry &registry);
+
+void register_resource_cache_benchmarks(Registry &registry);
+
+void register_geometry_benchmarks(Registry &registry);
+
+void register_heightmap_benchmarks(Registry &registry);
+
+void register_scene_graph_benchmarks(Registry &registry);
+
+void register_stats_benchmarks(Registry &registry);
+}        // namespace vkbbench
@@ -0,0 +1,119 @@
+'''
+Copyright (c) 2023, Arm Limited and Contributors
+
+SPDX-License-Identifier: Apache-2.0
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+'''
+
+# Compares two result files written by vkb_benchmarks --output.
+# A benchmark is flagged when a Mann-Whitney U test over the samples of both runs
+# is significant and the median changed by more than the threshold.
+# Exits with 1 if any benchmark regressed.
+
+import sys, json, math, argparse
+
+def load_results(path):
+    with open(path) as file:
+        data = json.load(file)
+    return {benchmark["name"]: benchmark for benchmark in data["benchmarks"]}
+
+def median(samples):
+    ordered = sorted(samples)
+    middle  = len(ordered) // 2
+    if len(ordered) % 2:
+        return ordered[middle]
+    return (ordered[middle - 1] + ordered[middle]) / 2.0
+
+def mann_whitney_p_value(a, b):
+    # Two-sided p-value using the normal approximation with tie correction
+    n_a, n_b = len(a), len(b)
+    if n_a == 0 or n_b == 0:
+        return 1.0
+
+    values = sorted([(value, 0) for value in a] + [(value, 1) for value in b])
+    ranks  = [0.0] * len(values)
+    ties   = 0.0
+
+    i = 0
+    while i < len(values):
+        j = i
+        while j + 1 < len(values) and values[j + 1][0] == values[i][0]:
+            j += 1
+        for k in range(i, j + 1):
+            ranks[k] = (i + j) / 2.0 + 1.0
+        count = j - i + 1
+        ties += count ** 3 - count
+        i = j + 1
+
+    rank_sum_a = sum(rank for rank, (_, group) in zip(ranks, values) if group == 0)
+    u_a        = rank_sum_a - n_a * (n_a + 1) / 2.0
+    mean       = n_a * n_b / 2.0
+    n          = n_a + n_b
+    variance   = n_a * n_b / 12.0 * ((n + 1) - ties / (n * (n - 1)))
+
+    if variance <= 0.0:
+        return 1.0
+
+    # Continuity correction
+    z = (abs(u_a - mean) - 0.5) / math.sqrt(variance)
+    z = max(z, 0.0)
+    return math.erfc(z / math.sqrt(2.0))
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare two vkb_benchmarks result files")
+    parser.add_argument("baseline", help="Result file of the reference run")
+    parser.add_argument("candidate", help="Result file of the run to check")
+    parser.add_argument("--alpha", type=float, default=0.05, help="Significance level of the Mann-Whitney U test (default 0.05)")
+    parser.add_argument("--threshold", type=float, default=5.0, help="Minimum change of the median in percent to flag (default 5)")
+    args = parser.parse_args()
+
+    baseline  = load_results(args.baseline)
+    candidate = load_results(args.candidate)
+
+    regressions = 0
+    name_width  = max([len(name) for name in baseline] + [len("Benchmark")])
+
+    print("{:<{}}  {:>14}  {:>14}  {:>8}  {:>8}  {}".format("Benchmark", name_width, "Baseline (ns)", "Candidate (ns)", "Change", "p-value", "Result"))
+
+    for name in sorted(baseline):
+        if name not in candidate:
+            print("{:<{}}  missing from {}".format(name, name_width, args.candidate))
+            continue
+
+        before  = baseline[name]["samples_ns"]
+        after   = candidate[name]["samples_ns"]
+        old     = median(before)
+        new     = median(after)
+        change  = (new - old) / old * 100.0 if old > 0.0 else 0.0
+        p_value = mann_whitney_p_value(before, after)
+
+        result = "same"
+        if p_value < args.alpha and abs(change) > args.threshold:
+            if change > 0.0:
+                result       = "REGRESSION"
+                regressions += 1
+            else:
+                result = "improvement"
+
+        print("{:<{}}  {:>14.1f}  {:>14.1f}  {:>+7.1f}%  {:>8.4f}  {}".format(name, name_width, old, new, change, p_value, result))
+
+    for name in sorted(set(candidate) - set(baseline)):
+        print("{:<{}}  new in {}".format(name, name_width, args.candidate))
+
+    if regressions:
+        print("{} benchmark(s) regressed".format(regressions))
+        sys.exit(1)
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,90 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark.h"
+
+#include <random>
+
+#include "geometry/frustum.h"
+
+namespace vkbbench
+{
+namespace
+{
+/// Number of spheres tested per iteration
+constexpr size_t object_count = 4096;
+
+/// Seed of the synthetic datasets, so that every run tests the same spheres
+constexpr uint32_t seed = 42;
+
+/**
+ * @brief A camera looking at the origin, seeing part of the volume the spheres are spread in
+ */
+glm::mat4 create_view_projection()
+{
+	auto projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+	auto view       = glm::lookAt(glm::vec3(0.0f, 10.0f, 50.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+	return projection * view;
+}
+}        // namespace
+
+void register_geometry_benchmarks(Registry &registry)
+{
+	registry.add("frustum/update", [](Context &) -> BenchmarkFunction {
+		return [view_projection = create_view_projection()](uint64_t iteration_count) {
+			vkb::Frustum frustum;
+
+			for (uint64_t i = 0; i < iteration_count; ++i)
+			{
+				frustum.update(view_projection);
+			}
+
+			do_not_optimize(static_cast<uint64_t>(frustum.get_planes()[0].w));
+		};
+	});
+
+	registry.add("frustum/check_sphere", [](Context &) -> BenchmarkFunction {
+		std::mt19937                          random{seed};
+		std::uniform_real_distribution<float> position{-100.0f, 100.0f};
+		std::uniform_real_distribution<float> radius{0.1f, 5.0f};
+
+		std::vector<glm::vec4> spheres(object_count);
+		for (auto &sphere : spheres)
+		{
+			sphere = glm::vec4(position(random), position(random), position(random), radius(random));
+		}
+
+		auto frustum = std::make_shared<vkb::Frustum>();
+		frustum->update(create_view_projection());
+
+		return [frustum, spheres](uint64_t iteration_count) {
+			uint64_t visible_count = 0;
+
+			for (uint64_t i = 0; i < iteration_count; ++i)
+			{
+				for (auto &sphere : spheres)
+				{
+					visible_count += frustum->check_sphere(glm::vec3(sphere), sphere.w) ? 1 : 0;
+				}
+			}
+
+			do_not_optimize(visible_count);
+		};
+	});
+}
+}        // namespace vkbbench
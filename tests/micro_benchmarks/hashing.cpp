@@ -0,0 +1,95 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark.h"
+
+#include <algorithm>
+#include <random>
+
+#include "common/helpers.h"
+#include "common/resource_caching.h"
+
+namespace vkbbench
+{
+namespace
+{
+/// Number of values hashed per iteration
+constexpr size_t value_count = 1024;
+
+/// Seed of the synthetic datasets, so that every run hashes the same values
+constexpr uint32_t seed = 42;
+
+template <class T>
+BenchmarkFunction hash_values(std::vector<T> &&values)
+{
+	return [values = std::move(values)](uint64_t iteration_count) {
+		for (uint64_t i = 0; i < iteration_count; ++i)
+		{
+			size_t result = 0;
+
+			for (auto &value : values)
+			{
+				vkb::hash_combine(result, value);
+			}
+
+			do_not_optimize(result);
+		}
+	};
+}
+}        // namespace
+
+void register_hashing_benchmarks(Registry &registry)
+{
+	registry.add("hash_combine/uint64", [](Context &) {
+		std::mt19937_64       random{seed};
+		std::vector<uint64_t> values(value_count);
+		std::generate(values.begin(), values.end(), random);
+
+		return hash_values(std::move(values));
+	});
+
+	registry.add("hash_combine/vertex_input_attribute", [](Context &) {
+		std::mt19937                                   random{seed};
+		std::vector<VkVertexInputAttributeDescription> values(value_count);
+
+		for (auto &value : values)
+		{
+			value.location = random() % 16;
+			value.binding  = random() % 4;
+			value.format   = (random() % 2) ? VK_FORMAT_R32G32B32_SFLOAT : VK_FORMAT_R32G32_SFLOAT;
+			value.offset   = (random() % 64) * 4;
+		}
+
+		return hash_values(std::move(values));
+	});
+
+	registry.add("hash_combine/color_blend_attachment", [](Context &) {
+		std::mt19937                                random{seed};
+		std::vector<vkb::ColorBlendAttachmentState> values(value_count);
+
+		for (auto &value : values)
+		{
+			value.blend_enable           = random() % 2;
+			value.src_color_blend_factor = (random() % 2) ? VK_BLEND_FACTOR_SRC_ALPHA : VK_BLEND_FACTOR_ONE;
+			value.dst_color_blend_factor = (random() % 2) ? VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA : VK_BLEND_FACTOR_ZERO;
+			value.color_write_mask       = random() % 16;
+		}
+
+		return hash_values(std::move(values));
+	});
+}
+}        // namespace vkbbench
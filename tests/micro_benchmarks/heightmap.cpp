@@ -0,0 +1,157 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark.h"
+
+#include <cmath>
+#include <random>
+
+#include "geometry/frustum.h"
+#include "heightmap.h"
+
+namespace vkbbench
+{
+namespace
+{
+/// Size of the synthetic heightmap, the same as the terrain of the terrain_tessellation sample
+constexpr uint32_t dimension = 1024;
+
+/// Number of positions sampled per iteration
+constexpr size_t sample_count = 4096;
+
+/// Seed of the synthetic datasets, so that every run uses the same heights
+constexpr uint32_t seed = 42;
+
+/**
+ * @brief Rolling hills with some noise, so that the height ranges vary across the quadtree
+ */
+std::vector<uint16_t> create_heights()
+{
+	std::mt19937                            random{seed};
+	std::uniform_int_distribution<uint32_t> noise{0, 1024};
+
+	std::vector<uint16_t> heights(dimension * dimension);
+	for (uint32_t y = 0; y < dimension; ++y)
+	{
+		for (uint32_t x = 0; x < dimension; ++x)
+		{
+			float hills = 0.5f + 0.25f * std::sin(x * 0.013f) + 0.25f * std::cos(y * 0.021f);
+
+			heights[x + y * dimension] = static_cast<uint16_t>(hills * 60000.0f + noise(random));
+		}
+	}
+
+	return heights;
+}
+
+std::shared_ptr<vkb::HeightMap> create_heightmap()
+{
+	return std::make_shared<vkb::HeightMap>(create_heights(), dimension, 64);
+}
+
+/**
+ * @brief Settings of a terrain 1024 units wide, seen from above one of its corners
+ */
+vkb::HeightMap::LodSettings create_lod_settings()
+{
+	vkb::HeightMap::LodSettings settings;
+	settings.scale        = glm::vec3(1.0f, 64.0f, 1.0f);
+	settings.leaf_size    = 32;
+	settings.lod_distance = 48.0f;
+
+	return settings;
+}
+}        // namespace
+
+void register_heightmap_benchmarks(Registry &registry)
+{
+	registry.add("heightmap/build", [](Context &) -> BenchmarkFunction {
+		return [heights = create_heights()](uint64_t iteration_count) {
+			uint64_t level_count = 0;
+
+			for (uint64_t i = 0; i < iteration_count; ++i)
+			{
+				auto data = heights;
+				vkb::HeightMap heightmap(std::move(data), dimension, 64);
+				level_count += heightmap.get_level_count();
+			}
+
+			do_not_optimize(level_count);
+		};
+	});
+
+	registry.add("heightmap/get_height", [](Context &) -> BenchmarkFunction {
+		return [heightmap = create_heightmap()](uint64_t iteration_count) {
+			float total = 0.0f;
+
+			for (uint64_t i = 0; i < iteration_count; ++i)
+			{
+				for (uint32_t j = 0; j < sample_count; ++j)
+				{
+					total += heightmap->get_height(j % 64, (j / 64) % 64);
+				}
+			}
+
+			do_not_optimize(static_cast<uint64_t>(total));
+		};
+	});
+
+	registry.add("heightmap/sample", [](Context &) -> BenchmarkFunction {
+		std::mt19937                          random{seed};
+		std::uniform_real_distribution<float> coordinate{0.0f, 1.0f};
+
+		std::vector<glm::vec2> uvs(sample_count);
+		for (auto &uv : uvs)
+		{
+			uv = glm::vec2(coordinate(random), coordinate(random));
+		}
+
+		return [heightmap = create_heightmap(), uvs](uint64_t iteration_count) {
+			float total = 0.0f;
+
+			for (uint64_t i = 0; i < iteration_count; ++i)
+			{
+				for (auto &uv : uvs)
+				{
+					total += heightmap->sample(uv);
+				}
+			}
+
+			do_not_optimize(static_cast<uint64_t>(total));
+		};
+	});
+
+	registry.add("heightmap/select_nodes", [](Context &) -> BenchmarkFunction {
+		auto projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 2048.0f);
+		auto view       = glm::lookAt(glm::vec3(0.0f, 96.0f, 0.0f), glm::vec3(512.0f, 0.0f, 512.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+		auto frustum = std::make_shared<vkb::Frustum>();
+		frustum->update(projection * view);
+
+		return [heightmap = create_heightmap(), frustum, settings = create_lod_settings()](uint64_t iteration_count) {
+			uint64_t node_count = 0;
+
+			for (uint64_t i = 0; i < iteration_count; ++i)
+			{
+				node_count += heightmap->select_nodes(glm::vec3(0.0f, 96.0f, 0.0f), settings, frustum.get()).size();
+			}
+
+			do_not_optimize(node_count);
+		};
+	});
+}
+}        // namespace vkbbench
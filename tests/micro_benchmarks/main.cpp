@@ -0,0 +1,126 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+#include "benchmark.h"
+#include "common/logging.h"
+#include "platform/platform.h"
+
+namespace
+{
+void print_usage()
+{
+	std::cout << "Usage: vkb_benchmarks [options]\n"
+	          << "  --filter <text>       Only run the benchmarks with a name containing the text\n"
+	          << "  --repetitions <count> Number of timed samples per benchmark (default 10)\n"
+	          << "  --min-time <ms>       Minimum duration of a sample in milliseconds (default 20)\n"
+	          << "  --output <file>       Write the results to a JSON file\n"
+	          << "  --root <dir>          Directory containing the assets and shaders folders (default: working directory)\n"
+	          << "  --list                List the benchmarks and exit\n";
+}
+}        // namespace
+
+int main(int argc, char *argv[])
+{
+	vkbbench::Options options;
+	std::string       output;
+	bool              list = false;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string argument  = argv[i];
+		bool        has_value = i + 1 < argc;
+
+		if (argument == "--filter" && has_value)
+		{
+			options.filter = argv[++i];
+		}
+		else if (argument == "--repetitions" && has_value)
+		{
+			options.repetitions = static_cast<uint32_t>(std::max(1, std::stoi(argv[++i])));
+		}
+		else if (argument == "--min-time" && has_value)
+		{
+			options.min_sample_time = std::stod(argv[++i]);
+		}
+		else if (argument == "--output" && has_value)
+		{
+			output = argv[++i];
+		}
+		else if (argument == "--root" && has_value)
+		{
+			std::string root = argv[++i];
+			if (!root.empty() && root.back() != '/')
+			{
+				root += '/';
+			}
+			vkb::Platform::set_external_storage_directory(root);
+		}
+		else if (argument == "--list")
+		{
+			list = true;
+		}
+		else
+		{
+			print_usage();
+			return argument == "--help" ? 0 : 1;
+		}
+	}
+
+	vkbbench::Registry registry;
+	vkbbench::register_hashing_benchmarks(registry);
+	vkbbench::register_resource_cache_benchmarks(registry);
+	vkbbench::register_geometry_benchmarks(registry);
+	vkbbench::register_heightmap_benchmarks(registry);
+	vkbbench::register_scene_graph_benchmarks(registry);
+	vkbbench::register_stats_benchmarks(registry);
+
+	if (list)
+	{
+		for (auto &entry : registry.get_entries())
+		{
+			std::cout << entry.name << "\n";
+		}
+		return 0;
+	}
+
+	std::vector<vkbbench::Result> results;
+
+	{
+		vkbbench::Context context;
+		results = vkbbench::run(registry, context, options);
+	}
+
+	if (!output.empty())
+	{
+		std::ofstream file{output};
+		if (!file)
+		{
+			LOGE("Failed to open {} for writing", output);
+			return 1;
+		}
+
+		file << vkbbench::to_json(results, options).dump(2) << "\n";
+
+		LOGI("Results written to {}", output);
+	}
+
+	return 0;
+}
@@ -0,0 +1,199 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark.h"
+
+#include <cstdint>
+
+#include "common/resource_caching.h"
+#include "core/device.h"
+#include "rendering/pipeline_state.h"
+#include "rendering/subpasses/forward_subpass.h"
+#include "resource_cache.h"
+
+namespace vkbbench
+{
+namespace
+{
+/// Number of pipeline state variants of the synthetic dataset
+constexpr uint32_t pipeline_state_count = 64;
+
+/**
+ * @brief Objects needed to build pipeline states, requested from the resource cache of the null device
+ */
+struct PipelineResources
+{
+	vkb::ShaderSource vertex_shader{"base.vert"};
+
+	vkb::ShaderSource fragment_shader{"base.frag"};
+
+	vkb::ShaderVariant shader_variant;
+
+	std::vector<vkb::Attachment> attachments{{VK_FORMAT_R8G8B8A8_UNORM, VK_SAMPLE_COUNT_1_BIT, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT},
+	                                         {VK_FORMAT_D32_SFLOAT, VK_SAMPLE_COUNT_1_BIT, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT}};
+
+	std::vector<vkb::LoadStoreInfo> load_store_infos = std::vector<vkb::LoadStoreInfo>(2);
+
+	std::vector<vkb::SubpassInfo> subpasses = std::vector<vkb::SubpassInfo>(1);
+
+	std::vector<vkb::ShaderModule *> shader_modules;
+
+	vkb::PipelineLayout *pipeline_layout{nullptr};
+
+	vkb::RenderPass *render_pass{nullptr};
+
+	explicit PipelineResources(vkb::ResourceCache &resource_cache)
+	{
+		shader_variant.add_definitions({"MAX_LIGHT_COUNT " + std::to_string(MAX_FORWARD_LIGHT_COUNT)});
+		shader_variant.add_definitions(vkb::light_type_definitions);
+
+		shader_modules = {&resource_cache.request_shader_module(VK_SHADER_STAGE_VERTEX_BIT, vertex_shader, shader_variant),
+		                  &resource_cache.request_shader_module(VK_SHADER_STAGE_FRAGMENT_BIT, fragment_shader, shader_variant)};
+
+		pipeline_layout = &resource_cache.request_pipeline_layout(shader_modules);
+
+		subpasses[0].output_attachments = {0};
+
+		render_pass = &resource_cache.request_render_pass(attachments, load_store_infos, subpasses);
+	}
+};
+
+/**
+ * @brief Creates pipeline states that differ by the states typically changed between the meshes of a scene
+ */
+std::vector<vkb::PipelineState> create_pipeline_states(PipelineResources &resources)
+{
+	std::vector<vkb::PipelineState> pipeline_states(pipeline_state_count);
+
+	vkb::VertexInputState vertex_input_state;
+	vertex_input_state.bindings   = {{0, 8 * sizeof(float), VK_VERTEX_INPUT_RATE_VERTEX}};
+	vertex_input_state.attributes = {{0, 0, VK_FORMAT_R32G32B32_SFLOAT, 0},
+	                                 {1, 0, VK_FORMAT_R32G32_SFLOAT, 3 * sizeof(float)},
+	                                 {2, 0, VK_FORMAT_R32G32B32_SFLOAT, 5 * sizeof(float)}};
+
+	for (uint32_t i = 0; i < pipeline_state_count; ++i)
+	{
+		auto &pipeline_state = pipeline_states[i];
+
+		vkb::RasterizationState rasterization_state;
+		rasterization_state.cull_mode  = (i % 2) ? VK_CULL_MODE_NONE : VK_CULL_MODE_BACK_BIT;
+		rasterization_state.front_face = ((i / 2) % 2) ? VK_FRONT_FACE_CLOCKWISE : VK_FRONT_FACE_COUNTER_CLOCKWISE;
+
+		vkb::DepthStencilState depth_stencil_state;
+		depth_stencil_state.depth_write_enable = ((i / 4) % 2) ? VK_FALSE : VK_TRUE;
+		depth_stencil_state.depth_compare_op   = ((i / 8) % 2) ? VK_COMPARE_OP_LESS_OR_EQUAL : VK_COMPARE_OP_GREATER;
+
+		vkb::ColorBlendState color_blend_state;
+		color_blend_state.attachments.resize(1);
+		color_blend_state.attachments[0].blend_enable = ((i / 16) % 2) ? VK_TRUE : VK_FALSE;
+
+		vkb::InputAssemblyState input_assembly_state;
+		input_assembly_state.topology = ((i / 32) % 2) ? VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP : VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+		pipeline_state.set_pipeline_layout(*resources.pipeline_layout);
+		pipeline_state.set_render_pass(*resources.render_pass);
+		pipeline_state.set_subpass_index(0);
+		pipeline_state.set_vertex_input_state(vertex_input_state);
+		pipeline_state.set_input_assembly_state(input_assembly_state);
+		pipeline_state.set_rasterization_state(rasterization_state);
+		pipeline_state.set_depth_stencil_state(depth_stencil_state);
+		pipeline_state.set_color_blend_state(color_blend_state);
+	}
+
+	return pipeline_states;
+}
+}        // namespace
+
+void register_resource_cache_benchmarks(Registry &registry)
+{
+	registry.add("pipeline_state/hash", [](Context &context) -> BenchmarkFunction {
+		auto resources       = std::make_shared<PipelineResources>(context.get_device().get_resource_cache());
+		auto pipeline_states = create_pipeline_states(*resources);
+
+		return [resources, pipeline_states](uint64_t iteration_count) {
+			std::hash<vkb::PipelineState> hasher;
+
+			for (uint64_t i = 0; i < iteration_count; ++i)
+			{
+				for (auto &pipeline_state : pipeline_states)
+				{
+					do_not_optimize(hasher(pipeline_state));
+				}
+			}
+		};
+	});
+
+	registry.add("resource_cache/request_graphics_pipeline", [](Context &context) -> BenchmarkFunction {
+		auto &resource_cache  = context.get_device().get_resource_cache();
+		auto  resources       = std::make_shared<PipelineResources>(resource_cache);
+		auto  pipeline_states = create_pipeline_states(*resources);
+
+		// Only measure lookups of pipelines already in the cache
+		for (auto &pipeline_state : pipeline_states)
+		{
+			resource_cache.request_graphics_pipeline(pipeline_state);
+		}
+
+		return [&resource_cache, resources, pipeline_states](uint64_t iteration_count) mutable {
+			for (uint64_t i = 0; i < iteration_count; ++i)
+			{
+				for (auto &pipeline_state : pipeline_states)
+				{
+					do_not_optimize(reinterpret_cast<uintptr_t>(&resource_cache.request_graphics_pipeline(pipeline_state)));
+				}
+			}
+		};
+	});
+
+	registry.add("resource_cache/request_pipeline_layout", [](Context &context) -> BenchmarkFunction {
+		auto &resource_cache = context.get_device().get_resource_cache();
+		auto  resources      = std::make_shared<PipelineResources>(resource_cache);
+
+		return [&resource_cache, resources](uint64_t iteration_count) {
+			for (uint64_t i = 0; i < iteration_count; ++i)
+			{
+				do_not_optimize(reinterpret_cast<uintptr_t>(&resource_cache.request_pipeline_layout(resources->shader_modules)));
+			}
+		};
+	});
+
+	registry.add("resource_cache/request_render_pass", [](Context &context) -> BenchmarkFunction {
+		auto &resource_cache = context.get_device().get_resource_cache();
+		auto  resources      = std::make_shared<PipelineResources>(resource_cache);
+
+		return [&resource_cache, resources](uint64_t iteration_count) {
+			for (uint64_t i = 0; i < iteration_count; ++i)
+			{
+				do_not_optimize(reinterpret_cast<uintptr_t>(&resource_cache.request_render_pass(resources->attachments, resources->load_store_infos, resources->subpasses)));
+			}
+		};
+	});
+
+	registry.add("resource_cache/request_shader_module", [](Context &context) -> BenchmarkFunction {
+		auto &resource_cache = context.get_device().get_resource_cache();
+		auto  resources      = std::make_shared<PipelineResources>(resource_cache);
+
+		return [&resource_cache, resources](uint64_t iteration_count) {
+			for (uint64_t i = 0; i < iteration_count; ++i)
+			{
+				auto &shader_module = resource_cache.request_shader_module(VK_SHADER_STAGE_FRAGMENT_BIT, resources->fragment_shader, resources->shader_variant);
+				do_not_optimize(reinterpret_cast<uintptr_t>(&shader_module));
+			}
+		};
+	});
+}
+}        // namespace vkbbench
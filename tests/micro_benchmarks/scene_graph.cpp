@@ -0,0 +1,290 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark.h"
+
+#include <random>
+
+#include "common/error.h"
+
+VKBP_DISABLE_WARNINGS()
+#include <stb_image_write.h>
+VKBP_ENABLE_WARNINGS()
+
+#include "common/logging.h"
+#include "common/utils.h"
+#include "core/device.h"
+#include "gltf_loader.h"
+#include "platform/filesystem.h"
+#include "rendering/render_context.h"
+#include "rendering/subpasses/forward_subpass.h"
+#include "scene_graph/components/camera.h"
+#include "scene_graph/components/image.h"
+#include "scene_graph/components/image/stb.h"
+#include "scene_graph/components/sub_mesh.h"
+#include "scene_graph/node.h"
+#include "scene_graph/scene.h"
+#include "scene_graph/scripts/animation.h"
+
+namespace vkbbench
+{
+namespace
+{
+/// Seed of the synthetic datasets, so that every run uses the same data
+constexpr uint32_t seed = 42;
+
+/// Number of animated nodes, each with a translation, rotation and scale channel
+constexpr size_t animated_node_count = 256;
+
+/// Number of keyframes of each animation channel
+constexpr size_t keyframe_count = 64;
+
+/**
+ * @brief Creates RGBA pixels of a gradient with noise, so that they compress like a texture rather than a flat color
+ */
+std::vector<uint8_t> create_pixels(uint32_t width, uint32_t height)
+{
+	std::mt19937                            random{seed};
+	std::uniform_int_distribution<uint32_t> noise{0, 31};
+
+	std::vector<uint8_t> pixels(width * height * 4);
+
+	for (uint32_t y = 0; y < height; ++y)
+	{
+		for (uint32_t x = 0; x < width; ++x)
+		{
+			auto pixel = &pixels[(y * width + x) * 4];
+			pixel[0]   = static_cast<uint8_t>(x * 224 / width + noise(random));
+			pixel[1]   = static_cast<uint8_t>(y * 224 / height + noise(random));
+			pixel[2]   = static_cast<uint8_t>(((x + y) % 64) * 3 + noise(random));
+			pixel[3]   = 255;
+		}
+	}
+
+	return pixels;
+}
+
+std::vector<uint8_t> encode_png(const std::vector<uint8_t> &pixels, uint32_t width, uint32_t height)
+{
+	std::vector<uint8_t> png;
+
+	auto write = [](void *context, void *data, int size) {
+		auto bytes = static_cast<uint8_t *>(data);
+		static_cast<std::vector<uint8_t> *>(context)->insert(static_cast<std::vector<uint8_t> *>(context)->end(), bytes, bytes + size);
+	};
+
+	if (!stbi_write_png_to_func(write, &png, static_cast<int>(width), static_cast<int>(height), 4, pixels.data(), static_cast<int>(width * 4)))
+	{
+		throw std::runtime_error("Failed to encode the synthetic image");
+	}
+
+	return png;
+}
+
+vkb::sg::AnimationSampler create_sampler(std::mt19937 &random, vkb::sg::AnimationTarget target)
+{
+	std::uniform_real_distribution<float> value{-1.0f, 1.0f};
+
+	vkb::sg::AnimationSampler sampler;
+	sampler.type = vkb::sg::AnimationType::Linear;
+
+	for (size_t i = 0; i < keyframe_count; ++i)
+	{
+		sampler.inputs.push_back(static_cast<float>(i) / 30.0f);
+
+		glm::vec4 output{value(random), value(random), value(random), value(random)};
+
+		if (target == vkb::sg::AnimationTarget::Rotation)
+		{
+			output = glm::normalize(output);
+		}
+		else if (target == vkb::sg::AnimationTarget::Scale)
+		{
+			output = glm::vec4(1.0f) + output * 0.5f;
+		}
+
+		sampler.outputs.push_back(output);
+	}
+
+	return sampler;
+}
+
+BenchmarkFunction load_scene(Context &context, const std::string &file_name)
+{
+	if (!vkb::fs::is_file(vkb::fs::path::get(vkb::fs::path::Assets, file_name)))
+	{
+		LOGW("Asset {} not found, pass the directory containing the assets folder with --root", file_name);
+		return {};
+	}
+
+	auto &device = context.get_device();
+
+	return [&device, file_name](uint64_t iteration_count) {
+		for (uint64_t i = 0; i < iteration_count; ++i)
+		{
+			vkb::GLTFLoader loader{device};
+
+			auto scene = loader.read_scene_from_file(file_name);
+
+			do_not_optimize(scene->get_components<vkb::sg::SubMesh>().size());
+		}
+	};
+}
+/**
+ * @brief Loads a scene and compiles the shader variants of a forward subpass rendering it, from an empty resource cache
+ */
+BenchmarkFunction prepare_scene_shaders(Context &context, const std::string &file_name, bool specialized_materials)
+{
+	if (!vkb::fs::is_file(vkb::fs::path::get(vkb::fs::path::Assets, file_name)))
+	{
+		LOGW("Asset {} not found, pass the directory containing the assets folder with --root", file_name);
+		return {};
+	}
+
+	auto &render_context = context.get_render_context();
+
+	auto prepare = [&render_context, file_name, specialized_materials]() {
+		auto &resource_cache = render_context.get_device().get_resource_cache();
+		resource_cache.clear();
+
+		vkb::GLTFLoader loader{render_context.get_device()};
+
+		auto scene = loader.read_scene_from_file(file_name);
+
+		auto &camera_node = vkb::add_free_camera(*scene, "main_camera", render_context.get_surface_extent());
+		auto &camera      = camera_node.get_component<vkb::sg::Camera>();
+
+		vkb::ForwardSubpass subpass{render_context, vkb::ShaderSource{"base.vert"}, vkb::ShaderSource{"base.frag"}, *scene, camera};
+		subpass.set_specialized_materials(specialized_materials);
+		subpass.prepare();
+
+		return resource_cache.get_internal_state().shader_modules.size();
+	};
+
+	LOGI("{} compiles {} shader modules {}", file_name, prepare(),
+	     specialized_materials ? "with specialized materials" : "with a variant per material");
+
+	return [prepare](uint64_t iteration_count) {
+		for (uint64_t i = 0; i < iteration_count; ++i)
+		{
+			do_not_optimize(prepare());
+		}
+	};
+}
+}        // namespace
+
+void register_scene_graph_benchmarks(Registry &registry)
+{
+	registry.add("image/decode_png", [](Context &) -> BenchmarkFunction {
+		const uint32_t size = 512;
+
+		auto png = encode_png(create_pixels(size, size), size, size);
+
+		return [png](uint64_t iteration_count) {
+			for (uint64_t i = 0; i < iteration_count; ++i)
+			{
+				vkb::sg::Stb image{"synthetic", png, vkb::sg::Image::Color};
+
+				do_not_optimize(image.get_data().size());
+			}
+		};
+	});
+
+	registry.add("image/generate_mipmaps", [](Context &) -> BenchmarkFunction {
+		const uint32_t size = 1024;
+
+		auto pixels = create_pixels(size, size);
+
+		return [pixels, size](uint64_t iteration_count) {
+			for (uint64_t i = 0; i < iteration_count; ++i)
+			{
+				// Copying the top level is part of the measurement, it is small compared to resizing the levels
+				vkb::sg::Mipmap mipmap{};
+				mipmap.extent = {size, size, 1u};
+
+				vkb::sg::Image image{"synthetic", std::vector<uint8_t>{pixels}, {mipmap}};
+				image.generate_mipmaps();
+
+				do_not_optimize(image.get_mipmaps().size());
+			}
+		};
+	});
+
+	registry.add("image/load_ktx", [](Context &) -> BenchmarkFunction {
+		const std::string uri = "textures/checkerboard_rgba.ktx";
+
+		if (!vkb::fs::is_file(vkb::fs::path::get(vkb::fs::path::Assets, uri)))
+		{
+			LOGW("Asset {} not found, pass the directory containing the assets folder with --root", uri);
+			return {};
+		}
+
+		return [uri](uint64_t iteration_count) {
+			for (uint64_t i = 0; i < iteration_count; ++i)
+			{
+				auto image = vkb::sg::Image::load(uri, uri, vkb::sg::Image::Color);
+
+				do_not_optimize(image->get_data().size());
+			}
+		};
+	});
+
+	registry.add("animation/update", [](Context &) -> BenchmarkFunction {
+		std::mt19937 random{seed};
+
+		auto nodes     = std::make_shared<std::vector<std::unique_ptr<vkb::sg::Node>>>();
+		auto animation = std::make_shared<vkb::sg::Animation>("synthetic");
+
+		for (size_t i = 0; i < animated_node_count; ++i)
+		{
+			nodes->push_back(std::make_unique<vkb::sg::Node>(i, "node_" + std::to_string(i)));
+
+			auto &node = *nodes->back();
+
+			for (auto target : {vkb::sg::AnimationTarget::Translation, vkb::sg::AnimationTarget::Rotation, vkb::sg::AnimationTarget::Scale})
+			{
+				animation->add_channel(node, target, create_sampler(random, target));
+			}
+		}
+
+		animation->update_times(0.0f, static_cast<float>(keyframe_count - 1) / 30.0f);
+
+		return [nodes, animation](uint64_t iteration_count) {
+			for (uint64_t i = 0; i < iteration_count; ++i)
+			{
+				animation->update(1.0f / 60.0f);
+			}
+		};
+	});
+
+	registry.add("gltf/load_scene/cube", [](Context &context) {
+		return load_scene(context, "scenes/cube.gltf");
+	});
+
+	registry.add("gltf/load_scene/sponza", [](Context &context) {
+		return load_scene(context, "scenes/sponza/Sponza01.gltf");
+	});
+
+	registry.add("gltf/prepare_shaders/sponza", [](Context &context) {
+		return prepare_scene_shaders(context, "scenes/sponza/Sponza01.gltf", false);
+	});
+
+	registry.add("gltf/prepare_shaders/sponza_specialized", [](Context &context) {
+		return prepare_scene_shaders(context, "scenes/sponza/Sponza01.gltf", true);
+	});
+}
+}        // namespace vkbbench
@@ -0,0 +1,50 @@
+/* Copyright (c) 2023, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark.h"
+
+#include "rendering/render_context.h"
+#include "stats/stats.h"
+
+namespace vkbbench
+{
+void register_stats_benchmarks(Registry &registry)
+{
+	registry.add("stats/update", [](Context &context) -> BenchmarkFunction {
+		auto stats = std::make_shared<vkb::Stats>(context.get_render_context());
+
+		// The statistics every sample can show, which do not depend on hardware counters
+		stats->request_stats({vkb::StatIndex::frame_times,
+		                      vkb::StatIndex::cmd_binds_issued,
+		                      vkb::StatIndex::cmd_binds_skipped,
+		                      vkb::StatIndex::cmd_draws,
+		                      vkb::StatIndex::cmd_dispatches,
+		                      vkb::StatIndex::cmd_descriptor_writes,
+		                      vkb::StatIndex::cmd_barriers_issued,
+		                      vkb::StatIndex::cmd_barriers_skipped});
+
+		return [stats](uint64_t iteration_count) {
+			for (uint64_t i = 0; i < iteration_count; ++i)
+			{
+				stats->update(1.0f / 60.0f);
+			}
+
+			do_not_optimize(static_cast<uint64_t>(stats->get_data(vkb::StatIndex::frame_times).back() * 1000.0f));
+		};
+	});
+}
+}        // namespace vkbbench
@@ -1,5 +1,5 @@
 '''
-Copyright (c) 2019-2021, Arm Limited and Contributors
+Copyright (c) 2019-2023, Arm Limited and Contributors
 
 SPDX-License-Identifier: Apache-2.0
 
@@ -16,17 +16,17 @@ See the License for the specific language governing permissions and
 limitations under the License.
 '''
 
-import sys, os, math, platform, threading, datetime, subprocess, zipfile, argparse, shutil, struct, imghdr
+import sys, os, math, platform, threading, datetime, subprocess, zipfile, argparse, shutil, struct, imghdr, json, glob
 from time import sleep
 from threading import Thread
 
 # Settings (changing these may cause instabilities)
-dependencies      = ("magick", "cmake", "git", "adb")
+dependencies      = ("cmake", "git", "adb")
 multithread       = False
 sub_tests         = []
 test_desktop      = True
 test_android      = True
-comparison_metric = "MAE"
+compare_tool      = ""
 current_dir       = os.getcwd()
 script_path       = os.path.dirname(os.path.realpath(__file__))
 root_path         = os.path.join(script_path, "../../")
@@ -44,6 +44,7 @@ class Subtest:
     result = False
     test_name = ""
     platform = ""
+    comparison = None
 
     def __init__(self, test_name, platform):
         self.test_name = test_name
@@ -64,21 +65,16 @@ class Subtest:
         return result
 
     def test(self):
-        print("\t\t=== Test started: {} ===".format(self.test_name))
-        self.result = True
+        """
+        @brief Collects the screenshot of the test, which is compared with the others once all tests ran
+        """
         screenshot_path = tmp_path + self.platform + "/"
         try:
             shutil.move(os.path.join(root_path, outputs_path) + self.test_name + image_ext, screenshot_path + self.test_name + image_ext)
         except FileNotFoundError:
             print("\t\t\t(Error) Couldn't find screenshot ({}), perhaps test crashed".format(os.path.join(root_path, outputs_path) + self.test_name + image_ext))
-            self.result = False
             return
-        if not test(self.test_name, screenshot_path):
-            self.result = False
-        if self.result:
-            print("\t\t=== Passed! ===")
-        else:
-            print("\t\t=== Failed. ===")
+        self.comparison = prepare_comparison(self.test_name, screenshot_path)
 
     def passed(self):
         return self.result
@@ -151,54 +147,83 @@ def get_command(command):
 def get_resolution(image):
     """
     @brief   Gets the width and height of a given image
-    @param   image The path to the image relative to this script
+    @param   image The path to the PNG image relative to this script
     @return  A string denoting the resolution in the format (WxH)
     """
-    return subprocess.check_output([get_command("magick"), "identify", "-format", "\"%[fx:w]x%[fx:h]\"", image]).decode("utf-8")[1:-1]
+    with open(image, "rb") as file:
+        header = file.read(24)
+    # The IHDR chunk, which PNG requires first, starts with the width and height
+    width, height = struct.unpack(">II", header[16:24])
+    return "{}x{}".format(width, height)
 
-def compare(metric, base_image, test_image, diff_image = "null:"):
+def find_compare_tool():
     """
-    @brief   Compares two images by their mean absolute error (changing the order of these parameters will change the contents of diff_image)
-    @param   metric     The type of image comparison you want to invoke
-    @param   base_image The relative path to the image to base the test on
-    @param   test_image The relative path to compare the base_image with
-    @param   diff_image The relative path to the output image of the difference between the two images, default "null:"
-    @return  A float clamped between 0 and 1 denoting how similar the images are (1 being identical, 0 being opposite)
+    @brief   Finds the vkb_image_compare executable in the build directory
+    @return  The path to the executable, or None if it was not built
     """
-    output = ""
-    try:
-        output = subprocess.check_output([get_command("magick"), "compare", "-metric", metric, base_image, test_image, diff_image], stderr=subprocess.STDOUT)
-    except subprocess.CalledProcessError as e:
-        output = e.output
-        pass
-    output = output.decode("utf-8")
-    return max(0.0, min(1.0 - float(output[output.find("(")+1:output.find(")")]), 1.0))
-
-def test(test_name, screenshot_path):
+    candidates = glob.glob(os.path.join(root_path, build_path, "tests", "image_compare", "**", get_command("vkb_image_compare")), recursive=True)
+    candidates = [candidate for candidate in candidates if os.path.isfile(candidate)]
+    preferred  = [candidate for candidate in candidates if build_config.lower() in candidate.lower()]
+    if preferred:
+        return preferred[0]
+    return candidates[0] if candidates else None
+
+def prepare_comparison(test_name, screenshot_path):
     """
-    @brief   Tests each screenshot within the tmp/ folder against the goldtest, saving the results if it fails
-    @param   test_name       The name of the test, used to retrieve the respective goldtest image
-    @param   screenshot_path The directory where to store screenshots
-    @return  True if the image tests pass
+    @brief   Finds the gold image of a screenshot
+    @param   test_name       The name of the test, used to retrieve the respective gold image
+    @param   screenshot_path The directory where the screenshots are stored
+    @return  The screenshot, gold and diff image paths, or None if there is no gold image for the resolution of the screenshot
     """
-    # Run test
-    result = False
     image = test_name + image_ext
     base_image = screenshot_path + image
     test_image = root_path + "assets/gold/{0}/{1}.png".format(test_name, get_resolution(base_image))
     if not os.path.isfile(test_image):
         print("\t\t\t(Error) Resolution not supported, gold image not found ({})".format(test_image))
-        return False
-    diff_image = "{0}{1}-diff.png".format(screenshot_path, image[0:image.find(".")])
-    print("\t\t\t(Comparing images...) '{0}' with '{1}':".format(base_image, test_image), end = " ", flush = True)
-    similarity = compare(comparison_metric, base_image, test_image, diff_image)
-    print("{}%".format(100*math.floor(similarity*10000)/10000))
-    # Remove images if it is identical
-    if similarity >= threshold:
-        os.remove(base_image)
-        os.remove(diff_image)
-        result = True
-    return result
+        return None
+    diff_image = "{0}{1}-diff.png".format(screenshot_path, test_name)
+    return (base_image, test_image, diff_image)
+
+def compare_all(apps):
+    """
+    @brief   Compares the screenshots of all tests with their gold images in one run of vkb_image_compare, saving the results of the ones that fail
+    @param   apps The tests that ran, their result is set from the comparison
+    """
+    compared = [app for app in apps if app.comparison is not None]
+    if not compared:
+        return
+
+    list_path   = tmp_path + "comparisons.txt"
+    report_path = tmp_path + "comparisons.json"
+    with open(list_path, "w") as file:
+        for app in compared:
+            file.write("\t".join(app.comparison) + "\n")
+
+    print("=== Comparing {} screenshots ===".format(len(compared)))
+    subprocess.run([compare_tool, "--list", list_path, "--output", report_path, "--threshold", str(threshold)])
+
+    try:
+        with open(report_path) as file:
+            results = json.load(file)["results"]
+    except (OSError, ValueError, KeyError):
+        print("\t(Error) Image comparison failed, no report written ({})".format(report_path))
+        results = []
+
+    for app, result in zip(compared, results):
+        base_image, test_image, diff_image = app.comparison
+        if "error" in result:
+            print("\t{} on {}: (Error) {}".format(app.test_name, app.platform, result["error"]))
+            continue
+        print("\t{} on {}: {}%, PSNR {:.2f} dB, SSIM {:.4f}".format(app.test_name, app.platform, 100*math.floor(result["similarity"]*10000)/10000, result["psnr"], result["ssim"]))
+        app.result = result["passed"]
+        # Remove images if it is identical
+        if app.result:
+            os.remove(base_image)
+            if os.path.isfile(diff_image):
+                os.remove(diff_image)
+
+    os.remove(list_path)
+    os.remove(report_path)
 
 def execute(app):
     print("\t=== Running {} on {} ===".format(app.test_name, app.platform))
@@ -239,6 +264,9 @@ def main():
         for thread in threads:
             thread.join()
 
+    # Compare all screenshots at once
+    compare_all(apps)
+
     # Evaluate system test
     passed = 0
     failed = 0
@@ -270,6 +298,7 @@ if __name__ == "__main__":
     argparser.add_argument("-C", "--config", required=True, help="build configuration to use")
     argparser.add_argument("-S", "--subtests", default=os.listdir(os.path.join(script_path, "sub_tests")), nargs="+", help="if set the specified sub tests will be run instead")
     argparser.add_argument("-P", "--parallel", action='store_true', help="flag to deploy tests in parallel")
+    argparser.add_argument("-T", "--compare-tool", help="path to vkb_image_compare, found in the build directory if not set")
     build_group = argparser.add_mutually_exclusive_group()
     build_group.add_argument("-D", "--desktop", action='store_false', help="flag to only deploy tests on desktop")
     build_group.add_argument("-A", "--android", action='store_false', help="flag to only deploy tests on android")
@@ -281,6 +310,7 @@ if __name__ == "__main__":
     test_desktop  = args["android"]
     test_android  = args["desktop"]
     multithread   = args["parallel"]
+    compare_tool  = args["compare_tool"]
 
     if build_path[-1] != "/":
         build_path += "/"
@@ -297,6 +327,12 @@ if __name__ == "__main__":
         else:
             print("Unix based system detected. Allowing script to continue to account for aliasing. Please ensure you have the dependencies installed or aliased otherwise the script will fail.")
 
+    if compare_tool is None:
+        compare_tool = find_compare_tool()
+    if compare_tool is None:
+        print("Error: Couldn't find vkb_image_compare in the build directory, build it with VKB_BUILD_TESTS or pass --compare-tool")
+        exit(1)
+
     # If building for android check that a valid device is plugged in
     if test_android:
         try: